@@ -0,0 +1,197 @@
+//
+// Created by Ploxie on 2023-06-30.
+//
+
+#include "core/Clock.h"
+#include "core/Logger.h"
+#include "EASTL/algorithm.h"
+#include "rendering/GraphicsAdapter.h"
+#include "rendering/rendergraph/RenderGraph.h"
+#include "rendering/ResourceViewRegistry.h"
+#include "utility/memory/DefaultAllocator.h"
+#include "utility/ThreadPool.h"
+#include <cstdlib>
+#include <glm/glm.hpp>
+
+#undef CreateSemaphore
+
+// usage: RenderGraphBenchmark [passCount] [iterationCount]
+// builds and executes a synthetic graph of graphics queue passes doing transfer usages on its own render graph and logs the AddPass and CreateSynchronization timings,
+// then executes the same graph with the compilation cache enabled and logs the compile times of cache hits and misses.
+// the heap allocations made by AddPass are counted, with empty record functions and with ones capturing as much as a CubePass,
+// if the engine is configured with ALLOCATION_TRACKING
+
+static constexpr uint32_t BENCHMARK_BUFFER_COUNT = 256;
+static constexpr uint32_t BENCHMARK_IMAGE_COUNT	 = 64;
+
+// as large as the data CubePass captures
+struct BenchmarkPassData
+{
+    glm::mat4 ModelMatrix;
+    glm::mat4 ViewMatrix;
+    glm::mat4 ProjectionMatrix;
+    glm::vec3 CameraPosition;
+    uint32_t FrameWidth;
+    uint32_t FrameHeight;
+};
+
+struct BenchmarkTiming
+{
+    uint64_t AddPassTime;
+    uint64_t AddPassAllocationCount;
+    uint64_t SynchronizationTime;
+};
+
+static uint64_t GetAllocationCount()
+{
+#ifdef ALLOCATION_TRACKING_ENABLED
+    return DefaultAllocator::Get()->GetAllocationCount();
+#else
+    return 0;
+#endif // ALLOCATION_TRACKING_ENABLED
+}
+
+static BenchmarkTiming RunIteration(RenderGraph* renderGraph, ResourceViewRegistry* resourceViewRegistry, uint32_t passCount, bool captureData = false)
+{
+    renderGraph->NextFrame();
+
+    ResourceViewHandle views[BENCHMARK_BUFFER_COUNT + BENCHMARK_IMAGE_COUNT];
+    for(uint32_t i = 0; i < BENCHMARK_BUFFER_COUNT; ++i)
+    {
+	ResourceHandle buffer = renderGraph->CreateBuffer(BufferDescription::Create("Benchmark Buffer", 1024, {}));
+	views[i]	      = renderGraph->CreateBufferView(BufferViewDescription::CreateDefault("Benchmark Buffer View", buffer, renderGraph));
+	renderGraph->MarkOutput(buffer);
+    }
+    for(uint32_t i = 0; i < BENCHMARK_IMAGE_COUNT; ++i)
+    {
+	ResourceHandle image		  = renderGraph->CreateImage(ImageDescription::Create("Benchmark Image", Format::R8G8B8A8_UNORM, {}, 64, 64, 1, 1, 4));
+	views[BENCHMARK_BUFFER_COUNT + i] = renderGraph->CreateImageView(ImageViewDescription::CreateDefault("Benchmark Image View", image, renderGraph));
+	renderGraph->MarkOutput(image);
+    }
+
+    // deterministic pseudo random access pattern so runs are comparable
+    uint32_t seed = 1;
+    auto nextView = [&]()
+    {
+	seed = seed * 1664525u + 1013904223u;
+	return views[(seed >> 8) % eastl::size(views)];
+    };
+
+    const BenchmarkPassData passData = {};
+
+    const uint64_t allocationCount = GetAllocationCount();
+    const uint64_t addPassStart	   = Clock::Now();
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	ResourceUsageDescription usageDescs[] = {
+	    { nextView(), { ResourceState::READ_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	    { nextView(), { ResourceState::READ_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	    { nextView(), { ResourceState::WRITE_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	};
+
+	// a pass may not use the same view twice
+	if(usageDescs[1].ViewHandle == usageDescs[0].ViewHandle)
+	{
+	    usageDescs[1].ViewHandle = usageDescs[0].ViewHandle == views[0] ? views[1] : views[0];
+	}
+	while(usageDescs[2].ViewHandle == usageDescs[0].ViewHandle || usageDescs[2].ViewHandle == usageDescs[1].ViewHandle)
+	{
+	    usageDescs[2].ViewHandle = nextView();
+	}
+
+	if(captureData)
+	{
+	    renderGraph->AddPass("Benchmark Pass", QueueType::GRAPHICS, eastl::size(usageDescs), usageDescs, [=](Command*, const Registry&)
+	    {
+		(void) passData;
+	    });
+	}
+	else
+	{
+	    renderGraph->AddPass("Benchmark Pass", QueueType::GRAPHICS, eastl::size(usageDescs), usageDescs, [](Command*, const Registry&)
+	    {
+	    });
+	}
+    }
+    const uint64_t addPassTime		  = Clock::Now() - addPassStart;
+    const uint64_t addPassAllocationCount = GetAllocationCount() - allocationCount;
+
+    resourceViewRegistry->FlushChanges();
+    renderGraph->Execute();
+    resourceViewRegistry->SwapSets();
+
+    return { addPassTime, addPassAllocationCount, renderGraph->GetStatistics().SynchronizationTime };
+}
+
+int main(int argc, char* argv[])
+{
+    const uint32_t passCount	  = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 5000;
+    const uint32_t iterationCount = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 20;
+
+    Logger::Initialize();
+
+    GraphicsAdapter* adapter = GraphicsAdapter::Create(nullptr, false, GraphicsBackendType::HEADLESS);
+
+    Semaphore* semaphores[3]	= {};
+    uint64_t semaphoreValues[3] = {};
+    for(auto*& semaphore: semaphores)
+    {
+	adapter->CreateSemaphore(0, &semaphore);
+    }
+
+    auto* threadPool	       = new ThreadPool();
+    auto* resourceViewRegistry = new ResourceViewRegistry(adapter);
+    auto* renderGraph	       = new RenderGraph(adapter, semaphores, semaphoreValues, resourceViewRegistry, threadPool);
+
+    // measure the full compilation path rather than a cache hit
+    renderGraph->SetCompilationCacheEnabled(false);
+
+    // the first iteration also creates the resources and grows the frame arena, it is not measured
+    RunIteration(renderGraph, resourceViewRegistry, passCount);
+
+    BenchmarkTiming best  = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+    BenchmarkTiming total = {};
+    for(uint32_t i = 0; i < iterationCount; ++i)
+    {
+	const BenchmarkTiming timing = RunIteration(renderGraph, resourceViewRegistry, passCount);
+	best.AddPassTime	     = eastl::min(best.AddPassTime, timing.AddPassTime);
+	best.SynchronizationTime     = eastl::min(best.SynchronizationTime, timing.SynchronizationTime);
+	total.AddPassTime += timing.AddPassTime;
+	total.SynchronizationTime += timing.SynchronizationTime;
+    }
+
+    const auto& statistics = renderGraph->GetStatistics();
+    LOG_CORE_INFO("Render graph benchmark: {0} passes, {1} subresource usages, {2} barriers, {3} iterations", passCount, statistics.SubresourceUsageCount, statistics.BarrierCount, iterationCount);
+    LOG_CORE_INFO("AddPass: best {0:.3f}ms, mean {1:.3f}ms", Clock::ToMilliseconds(best.AddPassTime), Clock::ToMilliseconds(total.AddPassTime) / iterationCount);
+    LOG_CORE_INFO("CreateSynchronization: best {0:.3f}ms, mean {1:.3f}ms", Clock::ToMilliseconds(best.SynchronizationTime), Clock::ToMilliseconds(total.SynchronizationTime) / iterationCount);
+
+    // the first frame with the cache enabled misses and stores the compilation, every following one hits it
+    const uint64_t missCount	   = statistics.CompilationCacheMisses;
+    const uint64_t missCompileTime = statistics.MissCompileTime;
+    renderGraph->SetCompilationCacheEnabled(true);
+    for(uint32_t i = 0; i < iterationCount + 1; ++i)
+    {
+	RunIteration(renderGraph, resourceViewRegistry, passCount);
+    }
+
+    const uint64_t cachedMissCount = statistics.CompilationCacheMisses - missCount;
+    LOG_CORE_INFO("Compile: {0} cache misses, mean {1:.3f}ms, {2:.3f}ms when also storing the compilation", statistics.CompilationCacheMisses, Clock::ToMilliseconds(statistics.MissCompileTime) / statistics.CompilationCacheMisses, Clock::ToMilliseconds(statistics.MissCompileTime - missCompileTime) / cachedMissCount);
+    LOG_CORE_INFO("Compile: {0} cache hits, mean {1:.3f}ms", statistics.CompilationCacheHits, Clock::ToMilliseconds(statistics.HitCompileTime) / statistics.CompilationCacheHits);
+
+#ifdef ALLOCATION_TRACKING_ENABLED
+    // the frame arena grows in the first frame with the larger closures, the second one shows what every frame after it allocates
+    const uint64_t allocationCount = RunIteration(renderGraph, resourceViewRegistry, passCount).AddPassAllocationCount;
+    RunIteration(renderGraph, resourceViewRegistry, passCount, true);
+    const uint64_t captureAllocationCount = RunIteration(renderGraph, resourceViewRegistry, passCount, true).AddPassAllocationCount;
+    LOG_CORE_INFO("AddPass allocations: {0:.3f} per pass, {1:.3f} per pass capturing {2} bytes", static_cast<double>(allocationCount) / passCount, static_cast<double>(captureAllocationCount) / passCount, sizeof(BenchmarkPassData));
+#else
+    LOG_CORE_INFO("AddPass allocations: not counted, configure the engine with ALLOCATION_TRACKING=ON");
+#endif // ALLOCATION_TRACKING_ENABLED
+
+    delete renderGraph;
+    delete resourceViewRegistry;
+    delete threadPool;
+    delete adapter;
+
+    return 0;
+}
\ No newline at end of file
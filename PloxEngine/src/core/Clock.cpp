@@ -0,0 +1,23 @@
+//
+// Created by Ploxie on 2023-06-08.
+//
+
+#include "Clock.h"
+#include <chrono>
+
+static_assert(std::chrono::steady_clock::is_steady);
+
+uint64_t Clock::Now() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+double Clock::ToSeconds(uint64_t nanoseconds) noexcept
+{
+    return static_cast<double>(nanoseconds) * 1e-9;
+}
+
+double Clock::ToMilliseconds(uint64_t nanoseconds) noexcept
+{
+    return static_cast<double>(nanoseconds) * 1e-6;
+}
\ No newline at end of file
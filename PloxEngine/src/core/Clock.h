@@ -0,0 +1,16 @@
+//
+// Created by Ploxie on 2023-06-08.
+//
+
+#pragma once
+#include <cstdint>
+
+// monotonic high-resolution clock, timestamps are in nanoseconds since an unspecified epoch
+class Clock
+{
+public:
+    static uint64_t Now() noexcept;
+
+    static double ToSeconds(uint64_t nanoseconds) noexcept;
+    static double ToMilliseconds(uint64_t nanoseconds) noexcept;
+};
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "GameLogic.h"
 #include "Logger.h"
 #include "platform/Platform.h"
+#include "Profiler.h"
+#include <cstring>
 
 void* __cdecl operator new[](size_t size,
 			     const char* /*name*/,
@@ -55,6 +57,27 @@ Renderer& Engine::GetRenderer()
     return s_instance.m_renderer;
 }
 
+void Engine::SetFrameLatency(uint32_t frameLatency)
+{
+    s_instance.m_renderSnapshots.SetMaxLatency(frameLatency);
+}
+
+void Engine::SetTargetFrameRate(float framesPerSecond)
+{
+    s_instance.m_frameTimer.SetTargetFrameRate(framesPerSecond);
+}
+
+FrameStatistics Engine::GetFrameStatistics()
+{
+    return s_instance.m_frameTimer.GetStatistics();
+}
+
+FrameStatistics Engine::GetRenderFrameStatistics()
+{
+    SpinLockHolder lockHolder(s_instance.m_renderFrameTimerLock);
+    return s_instance.m_renderFrameTimer.GetStatistics();
+}
+
 void Engine::Initialize(int argc, char* argv[], GameLogic* gameLogic)
 {
     m_gameLogic = gameLogic;
@@ -62,21 +85,49 @@ void Engine::Initialize(int argc, char* argv[], GameLogic* gameLogic)
     Logger::Initialize();
     Platform::Initialize("PloxieApplication");
 
+    // --headless renders with the null backend, the window still drives input and the message loop
+    bool headless = false;
+    for(int i = 1; i < argc; ++i)
+    {
+	headless |= strcmp(argv[i], "--headless") == 0;
+    }
+
     m_window = Platform::CreatePlatformWindow("TestWindow", -1, -1, 1024, 768);
-    m_renderer.Initialize(Platform::GetWindow(m_window), GraphicsBackendType::VULKAN);
+    if(headless)
+    {
+	m_renderer.Initialize(nullptr, GraphicsBackendType::HEADLESS);
+    }
+    else
+    {
+	m_renderer.Initialize(Platform::GetWindow(m_window), GraphicsBackendType::VULKAN);
+    }
 
     m_gameLogic->Initialize(this);
 
-    m_isRunning = true;
+    PROFILE_THREAD("Main Thread");
+
+    m_isRunning	   = true;
+    m_renderThread = std::thread(&Engine::RenderThreadLoop, this);
 }
 
 static bool asd = false;
 
 bool Engine::Run()
 {
+    PROFILE_FRAME();
+
+    const float deltaTime = m_frameTimer.Tick();
+
     m_isRunning = Platform::PumpMessages();
 
-    m_gameLogic->Update(0.0F);
+    // blocks while the render thread is more than the configured frame latency behind
+    RenderSnapshot* snapshot = m_renderSnapshots.BeginWrite();
+    snapshot->DeltaTime	     = deltaTime;
+
+    {
+	PROFILE_ZONE("GameLogic::Update");
+	m_gameLogic->Update(deltaTime);
+    }
 
     if(Input::IsKeyDown(Key::K))
     {
@@ -87,12 +138,43 @@ bool Engine::Run()
 	}
     }
 
-    m_renderer.Render();
+#ifdef PROFILER_ENABLED
+    if(Input::IsKeyDown(Key::F11, true))
+    {
+	Profiler::CaptureFrames(16, "profiler_capture.json");
+    }
+#endif // PROFILER_ENABLED
+
+    m_gameLogic->WriteRenderSnapshot(*snapshot);
+    m_renderSnapshots.EndWrite();
+
+    {
+	PROFILE_ZONE("WaitForTargetFrameTime");
+	m_frameTimer.WaitForTargetFrameTime();
+    }
 
     return m_isRunning;
 }
 void Engine::Shutdown()
 {
+    // lets the render thread finish the frames already in flight
+    m_renderSnapshots.Close();
+    m_renderThread.join();
+
     m_gameLogic->Shutdown();
     m_renderer.Shutdown();
 }
+
+void Engine::RenderThreadLoop()
+{
+    PROFILE_THREAD("Render Thread");
+
+    while(const RenderSnapshot* snapshot = m_renderSnapshots.BeginRead())
+    {
+	m_renderer.Render(*snapshot);
+	m_renderSnapshots.EndRead();
+
+	SpinLockHolder lockHolder(m_renderFrameTimerLock);
+	m_renderFrameTimer.Tick();
+    }
+}
@@ -5,8 +5,12 @@
 #pragma once
 #include "eastl/vector.h"
 #include "Event.h"
+#include "FrameTimer.h"
 #include "platform/window/window.h"
 #include "rendering/renderer.h"
+#include "rendering/RenderSnapshotQueue.h"
+#include "utility/SpinLock.h"
+#include <thread>
 
 class GameLogic;
 
@@ -18,10 +22,20 @@ public:
     static Window* GetWindow();
     static Renderer& GetRenderer();
 
+    // number of frames the simulation may run ahead of the render thread, 0 runs them in lock-step
+    static void SetFrameLatency(uint32_t frameLatency);
+    // 0 disables frame pacing
+    static void SetTargetFrameRate(float framesPerSecond);
+
+    // frame times over the last FrameTimer::HISTORY_SIZE frames of the simulation and the render thread
+    static FrameStatistics GetFrameStatistics();
+    static FrameStatistics GetRenderFrameStatistics();
+
 private:
     void Initialize(int argc, char* argv[], GameLogic* gameLogic);
     bool Run();
     void Shutdown();
+    void RenderThreadLoop();
 
 private:
     static Engine s_instance;
@@ -32,4 +46,9 @@ private:
     EventManager m_eventManager;
     WindowHandle m_window;
     Renderer m_renderer;
+    RenderSnapshotQueue m_renderSnapshots;
+    std::thread m_renderThread;
+    FrameTimer m_frameTimer;
+    FrameTimer m_renderFrameTimer;
+    mutable SpinLock m_renderFrameTimerLock;
 };
@@ -0,0 +1,105 @@
+//
+// Created by Ploxie on 2023-06-08.
+//
+
+#include "FrameTimer.h"
+#include "Clock.h"
+#include "EASTL/sort.h"
+#include "utility/Utilities.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+// the OS scheduler can oversleep by a timer tick, so the last part of the wait is spun
+static constexpr uint64_t SPIN_THRESHOLD_NS = 2'000'000;
+
+float FrameTimer::Tick() noexcept
+{
+    const uint64_t now = Clock::Now();
+
+    if(m_lastTickTime == 0)
+    {
+	m_lastTickTime = now;
+	return 0.0f;
+    }
+
+    const uint64_t frameTime = now - m_lastTickTime;
+    m_lastTickTime	     = now;
+
+    m_history[m_frameIndex % HISTORY_SIZE] = frameTime;
+    m_historyCount			   = MIN(m_historyCount + 1, HISTORY_SIZE);
+    ++m_frameIndex;
+
+    return static_cast<float>(Clock::ToSeconds(frameTime));
+}
+
+void FrameTimer::SetTargetFrameRate(float framesPerSecond) noexcept
+{
+    m_targetFrameTime = framesPerSecond > 0.0f ? static_cast<uint64_t>(1e9 / framesPerSecond) : 0;
+}
+
+float FrameTimer::GetTargetFrameRate() const noexcept
+{
+    return m_targetFrameTime > 0 ? static_cast<float>(1e9 / static_cast<double>(m_targetFrameTime)) : 0.0f;
+}
+
+void FrameTimer::WaitForTargetFrameTime() const noexcept
+{
+    if(m_targetFrameTime == 0 || m_lastTickTime == 0)
+    {
+	return;
+    }
+
+    const uint64_t targetTime = m_lastTickTime + m_targetFrameTime;
+
+    uint64_t now = Clock::Now();
+    if(now + SPIN_THRESHOLD_NS < targetTime)
+    {
+	std::this_thread::sleep_for(std::chrono::nanoseconds(targetTime - now - SPIN_THRESHOLD_NS));
+    }
+
+    while(Clock::Now() < targetTime)
+    {
+	std::this_thread::yield();
+    }
+}
+
+FrameStatistics FrameTimer::GetStatistics() const noexcept
+{
+    FrameStatistics statistics = {};
+    if(m_historyCount == 0)
+    {
+	return statistics;
+    }
+
+    uint64_t total = 0;
+    for(uint32_t i = 0; i < m_historyCount; ++i)
+    {
+	total += m_history[i];
+    }
+
+    uint64_t sorted[HISTORY_SIZE];
+    memcpy(sorted, m_history, m_historyCount * sizeof(uint64_t));
+    eastl::sort(sorted, sorted + m_historyCount);
+
+    // nearest-rank percentile
+    auto percentile = [&](uint32_t percent)
+    {
+	const uint32_t rank = (m_historyCount * percent + 99) / 100;
+	return Clock::ToMilliseconds(sorted[MIN(rank, m_historyCount) - 1]);
+    };
+
+    statistics.MeanMs	  = Clock::ToMilliseconds(total) / m_historyCount;
+    statistics.P50Ms	  = percentile(50);
+    statistics.P95Ms	  = percentile(95);
+    statistics.P99Ms	  = percentile(99);
+    statistics.WorstMs	  = Clock::ToMilliseconds(sorted[m_historyCount - 1]);
+    statistics.FrameCount = m_historyCount;
+
+    return statistics;
+}
+
+uint64_t FrameTimer::GetFrameIndex() const noexcept
+{
+    return m_frameIndex;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+//
+// Created by Ploxie on 2023-06-08.
+//
+
+#pragma once
+#include <cstdint>
+
+struct FrameStatistics
+{
+    double MeanMs	= 0.0;
+    double P50Ms	= 0.0;
+    double P95Ms	= 0.0;
+    double P99Ms	= 0.0;
+    double WorstMs	= 0.0;
+    uint32_t FrameCount = 0;
+};
+
+class FrameTimer
+{
+public:
+    static constexpr uint32_t HISTORY_SIZE = 256;
+
+public:
+    explicit FrameTimer() noexcept = default;
+
+    // call once per frame, returns the real delta time in seconds since the previous call
+    float Tick() noexcept;
+
+    // 0 disables the limiter
+    void SetTargetFrameRate(float framesPerSecond) noexcept;
+    float GetTargetFrameRate() const noexcept;
+
+    // sleeps and then spins until the target frame time, measured from the last Tick, has passed
+    void WaitForTargetFrameTime() const noexcept;
+
+    // rolling statistics over the last HISTORY_SIZE frames
+    FrameStatistics GetStatistics() const noexcept;
+    uint64_t GetFrameIndex() const noexcept;
+
+private:
+    uint64_t m_lastTickTime	     = 0;
+    uint64_t m_targetFrameTime	     = 0;
+    uint64_t m_frameIndex	     = 0;
+    uint64_t m_history[HISTORY_SIZE] = {};
+    uint32_t m_historyCount	     = 0;
+};
\ No newline at end of file
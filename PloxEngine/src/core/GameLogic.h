@@ -5,6 +5,7 @@
 #pragma once
 
 class Engine;
+struct RenderSnapshot;
 
 class GameLogic
 {
@@ -12,6 +13,8 @@ public:
 
     virtual void Initialize(Engine* engine) noexcept = 0;
     virtual void Update(float deltaTime) noexcept = 0;
+    // called after Update, the snapshot is handed to the render thread and must not reference simulation memory
+    virtual void WriteRenderSnapshot(RenderSnapshot& /*snapshot*/) noexcept {}
     virtual void Shutdown() noexcept = 0;
 
 };
@@ -0,0 +1,305 @@
+//
+// Created by Ploxie on 2023-06-12.
+//
+
+#include "Profiler.h"
+
+#ifdef PROFILER_ENABLED
+    #include "Clock.h"
+    #include "EASTL/atomic.h"
+    #include "EASTL/string.h"
+    #include "EASTL/vector.h"
+    #include "Logger.h"
+    #include "platform/Platform.h"
+    #include "utility/SpinLock.h"
+    #include <cstdio>
+    #include <cstring>
+
+namespace
+{
+    // the writer keeps going while a capture is written, the sequence of a slot is odd while it is being written and
+    // 2 * (index + 1) once zone index is complete. the fields are atomics so a torn read is detected instead of undefined
+    struct ZoneSlot
+    {
+	eastl::atomic<uint64_t> Sequence = 0;
+	eastl::atomic<const char*> Name	 = nullptr;
+	eastl::atomic<uint64_t> Begin	 = 0;
+	eastl::atomic<uint64_t> End	 = 0;
+	eastl::atomic<uint32_t> Depth	 = 0;
+    };
+
+    // written by a single thread, read by whoever writes the capture
+    struct ZoneBuffer
+    {
+	ZoneSlot Zones[Profiler::ZONES_PER_THREAD];
+	eastl::atomic<uint64_t> WriteIndex = 0;
+	uint32_t Depth			   = 0;
+	uint32_t TrackId		   = 0;
+	char Name[64]			   = {};
+    };
+
+    struct CaptureState
+    {
+	eastl::string Path;
+	uint32_t RequestedFrames = 0;
+	uint32_t FramesLeft	 = 0;
+	uint64_t Begin		 = 0;
+	uint64_t End		 = 0;
+	uint64_t LastFrameMark	 = 0;
+	bool Active		 = false;
+    };
+
+    // buffers are intentionally never freed, zones of exited threads stay valid until the process ends
+    SpinLock s_buffersLock;
+    eastl::vector<ZoneBuffer*> s_buffers;
+    eastl::vector<ZoneBuffer*> s_tracks;
+    SpinLock s_captureLock;
+    CaptureState s_capture;
+    thread_local ZoneBuffer* t_buffer = nullptr;
+
+    ZoneBuffer* CreateBuffer(const char* name) noexcept
+    {
+	auto* buffer = new ZoneBuffer();
+
+	SpinLockHolder lockHolder(s_buffersLock);
+	buffer->TrackId = static_cast<uint32_t>(s_buffers.size());
+	if(name)
+	{
+	    strncpy(buffer->Name, name, sizeof(buffer->Name) - 1);
+	}
+	else
+	{
+	    snprintf(buffer->Name, sizeof(buffer->Name), "Thread %u", buffer->TrackId);
+	}
+	s_buffers.push_back(buffer);
+
+	return buffer;
+    }
+
+    ZoneBuffer* GetThreadBuffer() noexcept
+    {
+	if(!t_buffer)
+	{
+	    t_buffer = CreateBuffer(nullptr);
+	}
+	return t_buffer;
+    }
+
+    void PushZone(ZoneBuffer* buffer, const char* name, uint64_t begin, uint64_t end, uint32_t depth) noexcept
+    {
+	const uint64_t index = buffer->WriteIndex.load(eastl::memory_order_relaxed);
+
+	auto& slot = buffer->Zones[index % Profiler::ZONES_PER_THREAD];
+	slot.Sequence.store(index * 2 + 1, eastl::memory_order_relaxed);
+	eastl::atomic_thread_fence(eastl::memory_order_release);
+
+	slot.Name.store(name, eastl::memory_order_relaxed);
+	slot.Begin.store(begin, eastl::memory_order_relaxed);
+	slot.End.store(end, eastl::memory_order_relaxed);
+	slot.Depth.store(depth, eastl::memory_order_relaxed);
+
+	slot.Sequence.store(index * 2 + 2, eastl::memory_order_release);
+	buffer->WriteIndex.store(index + 1, eastl::memory_order_release);
+    }
+
+    // false if the slot no longer holds zone index or was overwritten while it was copied
+    bool ReadZone(const ZoneBuffer* buffer, uint64_t index, ProfilerZone& zone) noexcept
+    {
+	const auto& slot	= buffer->Zones[index % Profiler::ZONES_PER_THREAD];
+	const uint64_t sequence = index * 2 + 2;
+	if(slot.Sequence.load(eastl::memory_order_acquire) != sequence)
+	{
+	    return false;
+	}
+
+	zone.Name  = slot.Name.load(eastl::memory_order_relaxed);
+	zone.Begin = slot.Begin.load(eastl::memory_order_relaxed);
+	zone.End   = slot.End.load(eastl::memory_order_relaxed);
+	zone.Depth = slot.Depth.load(eastl::memory_order_relaxed);
+
+	eastl::atomic_thread_fence(eastl::memory_order_acquire);
+	return slot.Sequence.load(eastl::memory_order_relaxed) == sequence;
+    }
+
+    void AppendEscaped(eastl::string& json, const char* text) noexcept
+    {
+	for(const char* c = text; *c; ++c)
+	{
+	    if(*c == '"' || *c == '\\')
+	    {
+		json.push_back('\\');
+	    }
+	    json.push_back(*c);
+	}
+    }
+} // namespace
+
+void Profiler::SetThreadName(const char* name) noexcept
+{
+    ZoneBuffer* buffer = GetThreadBuffer();
+
+    SpinLockHolder lockHolder(s_buffersLock);
+    strncpy(buffer->Name, name, sizeof(buffer->Name) - 1);
+}
+
+void Profiler::MarkFrame() noexcept
+{
+    const uint64_t now = Clock::Now();
+
+    bool writeCapture = false;
+    {
+	SpinLockHolder lockHolder(s_captureLock);
+
+	if(s_capture.Active)
+	{
+	    RecordZone("Frames", "Frame", s_capture.LastFrameMark, now);
+
+	    if(--s_capture.FramesLeft == 0)
+	    {
+		s_capture.End	 = now;
+		s_capture.Active = false;
+		writeCapture	 = true;
+	    }
+	}
+	else if(s_capture.RequestedFrames > 0)
+	{
+	    s_capture.FramesLeft      = s_capture.RequestedFrames;
+	    s_capture.RequestedFrames = 0;
+	    s_capture.Begin	      = now;
+	    s_capture.Active	      = true;
+	}
+
+	s_capture.LastFrameMark = now;
+    }
+
+    if(writeCapture)
+    {
+	WriteCapture();
+    }
+}
+
+void Profiler::CaptureFrames(uint32_t frameCount, const char* path) noexcept
+{
+    SpinLockHolder lockHolder(s_captureLock);
+    if(s_capture.Active || frameCount == 0)
+    {
+	return;
+    }
+
+    s_capture.Path	      = path;
+    s_capture.RequestedFrames = frameCount;
+}
+
+bool Profiler::IsCapturing() noexcept
+{
+    SpinLockHolder lockHolder(s_captureLock);
+    return s_capture.Active || s_capture.RequestedFrames > 0;
+}
+
+void Profiler::RecordZone(const char* track, const char* name, uint64_t begin, uint64_t end, uint32_t depth) noexcept
+{
+    static SpinLock s_tracksLock;
+    SpinLockHolder lockHolder(s_tracksLock);
+
+    ZoneBuffer* buffer = nullptr;
+    for(auto* trackBuffer: s_tracks)
+    {
+	if(strcmp(trackBuffer->Name, track) == 0)
+	{
+	    buffer = trackBuffer;
+	    break;
+	}
+    }
+
+    if(!buffer)
+    {
+	buffer = CreateBuffer(track);
+	s_tracks.push_back(buffer);
+    }
+
+    PushZone(buffer, name, begin, end, depth);
+}
+
+void Profiler::BeginZone() noexcept
+{
+    GetThreadBuffer()->Depth++;
+}
+
+void Profiler::EndZone(const char* name, uint64_t begin) noexcept
+{
+    ZoneBuffer* buffer = t_buffer;
+    PushZone(buffer, name, begin, Clock::Now(), --buffer->Depth);
+}
+
+void Profiler::WriteCapture() noexcept
+{
+    eastl::string path;
+    uint64_t captureBegin = 0;
+    uint64_t captureEnd	  = 0;
+    {
+	SpinLockHolder lockHolder(s_captureLock);
+	path	     = s_capture.Path;
+	captureBegin = s_capture.Begin;
+	captureEnd   = s_capture.End;
+    }
+
+    eastl::vector<ZoneBuffer*> buffers;
+    {
+	SpinLockHolder lockHolder(s_buffersLock);
+	buffers = s_buffers;
+    }
+
+    eastl::string json;
+    json.reserve(1024 * 1024);
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    bool first = true;
+    for(const auto* buffer: buffers)
+    {
+	json.append_sprintf("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",", buffer->TrackId);
+	AppendEscaped(json, buffer->Name);
+	json.append("\"}}");
+	first = false;
+
+	// only the last ZONES_PER_THREAD zones of every buffer survive, zones the writer wraps over while they are read are dropped
+	const uint64_t writeIndex = buffer->WriteIndex.load(eastl::memory_order_acquire);
+	const uint64_t readIndex  = writeIndex > ZONES_PER_THREAD ? writeIndex - ZONES_PER_THREAD : 0;
+	for(uint64_t i = readIndex; i < writeIndex; ++i)
+	{
+	    ProfilerZone zone;
+	    if(!ReadZone(buffer, i, zone) || zone.Begin < captureBegin || zone.End > captureEnd)
+	    {
+		continue;
+	    }
+
+	    json.append(",{\"name\":\"");
+	    AppendEscaped(json, zone.Name);
+	    json.append_sprintf("\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%u}}", buffer->TrackId, (zone.Begin - captureBegin) / 1000.0, (zone.End - zone.Begin) / 1000.0, zone.Depth);
+	}
+    }
+
+    json.append("]}");
+
+    if(Platform::WriteFile(path.c_str(), json.size(), json.data(), false))
+    {
+	LOG_CORE_INFO("Wrote profiler capture to {0}", path.c_str());
+    }
+    else
+    {
+	LOG_CORE_ERROR("Failed to write profiler capture to {0}", path.c_str());
+    }
+}
+
+ScopedProfilerZone::ScopedProfilerZone(const char* name) noexcept
+    : m_name(name)
+{
+    Profiler::BeginZone();
+    m_begin = Clock::Now();
+}
+
+ScopedProfilerZone::~ScopedProfilerZone() noexcept
+{
+    Profiler::EndZone(m_name, m_begin);
+}
+
+#endif // PROFILER_ENABLED
\ No newline at end of file
@@ -0,0 +1,75 @@
+//
+// Created by Ploxie on 2023-06-12.
+//
+
+#pragma once
+#include <cstdint>
+
+// PROFILER_ENABLED comes from the PROFILER CMake option, without it all profiling zones compile out
+#ifdef PROFILER_ENABLED
+
+struct ProfilerZone
+{
+    const char* Name;
+    uint64_t Begin;
+    uint64_t End;
+    uint32_t Depth;
+};
+
+class Profiler
+{
+public:
+    static constexpr uint32_t ZONES_PER_THREAD = 1u << 15;
+
+public:
+    static void SetThreadName(const char* name) noexcept;
+
+    // marks a frame boundary, captures start and end on frame marks
+    static void MarkFrame() noexcept;
+
+    // records the next frameCount frames and writes them as a Chrome trace (chrome://tracing, Perfetto) to path
+    static void CaptureFrames(uint32_t frameCount, const char* path) noexcept;
+    static bool IsCapturing() noexcept;
+
+    // for zones measured elsewhere, e.g. on the GPU, timestamps must be in the Clock domain
+    static void RecordZone(const char* track, const char* name, uint64_t begin, uint64_t end, uint32_t depth = 0) noexcept;
+
+private:
+    friend class ScopedProfilerZone;
+
+    static void BeginZone() noexcept;
+    static void EndZone(const char* name, uint64_t begin) noexcept;
+    static void WriteCapture() noexcept;
+};
+
+class ScopedProfilerZone
+{
+public:
+    explicit ScopedProfilerZone(const char* name) noexcept;
+    ~ScopedProfilerZone() noexcept;
+
+    ScopedProfilerZone(const ScopedProfilerZone&)	      = delete;
+    ScopedProfilerZone(const ScopedProfilerZone&&)	      = delete;
+    ScopedProfilerZone& operator=(const ScopedProfilerZone&)  = delete;
+    ScopedProfilerZone& operator=(const ScopedProfilerZone&&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_begin;
+};
+
+    #define PROFILER_CONCAT_IMPL(a, b) a##b
+    #define PROFILER_CONCAT(a, b)      PROFILER_CONCAT_IMPL(a, b)
+    #define PROFILE_ZONE(name)	       ScopedProfilerZone PROFILER_CONCAT(profilerZone, __LINE__)(name)
+    #define PROFILE_FUNCTION()	       PROFILE_ZONE(__FUNCTION__)
+    #define PROFILE_THREAD(name)       Profiler::SetThreadName(name)
+    #define PROFILE_FRAME()	       Profiler::MarkFrame()
+
+#else
+
+    #define PROFILE_ZONE(name)
+    #define PROFILE_FUNCTION()
+    #define PROFILE_THREAD(name)
+    #define PROFILE_FRAME()
+
+#endif // PROFILER_ENABLED
\ No newline at end of file
@@ -0,0 +1,701 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+#include "CommandStream.h"
+#include "core/Assert.h"
+#include "EASTL/algorithm.h"
+#include "EASTL/type_traits.h"
+#include "utility/Utilities.h"
+#include <cstring>
+#include <new>
+
+namespace
+{
+    struct PipelineArguments
+    {
+	const void* Pipeline;
+    };
+
+    struct RangeArguments
+    {
+	uint32_t First;
+	uint32_t Count;
+    };
+
+    struct DepthBiasArguments
+    {
+	float ConstantFactor;
+	float Clamp;
+	float SlopeFactor;
+    };
+
+    struct FloatArguments
+    {
+	float Values[4];
+    };
+
+    struct StencilArguments
+    {
+	StencilFaceFlags FaceMask;
+	uint32_t Value;
+    };
+
+    // followed by the sets and the dynamic offsets
+    struct DescriptorSetArguments
+    {
+	const void* Pipeline;
+	uint32_t FirstSet;
+	uint32_t Count;
+	uint32_t OffsetCount;
+    };
+
+    struct IndexBufferArguments
+    {
+	const Buffer* Buffer;
+	uint64_t Offset;
+	IndexType IndexType;
+    };
+
+    // followed by the buffers and their offsets
+    struct VertexBufferArguments
+    {
+	uint32_t FirstBinding;
+	uint32_t Count;
+    };
+
+    struct DrawArguments
+    {
+	uint32_t VertexCount;
+	uint32_t InstanceCount;
+	uint32_t FirstVertex;
+	int32_t VertexOffset;
+	uint32_t FirstInstance;
+    };
+
+    struct DispatchArguments
+    {
+	uint32_t GroupCountX;
+	uint32_t GroupCountY;
+	uint32_t GroupCountZ;
+    };
+
+    struct BufferOffsetArguments
+    {
+	const Buffer* Buffer;
+	uint64_t Offset;
+    };
+
+    // followed by the regions
+    struct CopyArguments
+    {
+	const void* Source;
+	const void* Destination;
+	uint32_t RegionCount;
+    };
+
+    // followed by the data
+    struct UpdateBufferArguments
+    {
+	const Buffer* Buffer;
+	uint64_t Offset;
+	uint64_t Size;
+    };
+
+    // followed by the ranges
+    struct ClearColorArguments
+    {
+	const Image* Image;
+	ClearColorValue Color;
+	uint32_t RangeCount;
+    };
+
+    // followed by the ranges
+    struct ClearDepthStencilArguments
+    {
+	const Image* Image;
+	ClearDepthStencilValue DepthStencil;
+	uint32_t RangeCount;
+    };
+
+    struct EmptyArguments
+    {
+    };
+
+    // followed by the barriers
+    struct BarrierArguments
+    {
+	uint32_t Count;
+    };
+
+    struct LoweredBarrierArguments
+    {
+	const LoweredBarriers* Barriers;
+	uint32_t Group;
+    };
+
+    struct QueryArguments
+    {
+	const QueryPool* QueryPool;
+	uint32_t Query;
+	uint32_t QueryCount;
+	PipelineStageFlags Stage;
+    };
+
+    struct CopyQueryResultsArguments
+    {
+	const QueryPool* QueryPool;
+	uint32_t FirstQuery;
+	uint32_t QueryCount;
+	const Buffer* Buffer;
+	uint64_t Offset;
+    };
+
+    // followed by the values
+    struct PushConstantArguments
+    {
+	const void* Pipeline;
+	ShaderStageFlags StageFlags;
+	uint32_t Offset;
+	uint32_t Size;
+    };
+
+    // followed by the color attachments and the depth stencil attachment
+    struct RenderPassArguments
+    {
+	Rect RenderArea;
+	uint32_t ColorAttachmentCount;
+	bool DepthStencil;
+	bool RWTextureBufferAccess;
+    };
+} // namespace
+
+template<typename T>
+T* CommandStream::Write(CommandStreamOpcode opcode, size_t arrayDataSize)
+{
+    static_assert(alignof(T) <= PACKET_ALIGNMENT && alignof(PacketHeader) <= PACKET_ALIGNMENT);
+    ASSERT(m_recording);
+
+    const uint64_t packetSize = Util::AlignUp<uint64_t>(sizeof(PacketHeader) + Util::AlignUp<uint64_t>(sizeof(T), PACKET_ALIGNMENT) + arrayDataSize, PACKET_ALIGNMENT);
+    ASSERT(packetSize <= UINT32_MAX);
+
+    const uint64_t offset = m_size;
+    m_size += packetSize;
+    if(m_data.size() * sizeof(uint64_t) < m_size)
+    {
+	m_data.resize(eastl::max<size_t>(m_data.size() * 2, m_size / sizeof(uint64_t)));
+    }
+    ++m_commandCount;
+
+    auto* packet   = reinterpret_cast<uint8_t*>(m_data.data()) + offset;
+    auto* header   = reinterpret_cast<PacketHeader*>(packet);
+    header->Opcode = opcode;
+    header->Size   = static_cast<uint32_t>(packetSize);
+
+    return new(packet + sizeof(PacketHeader)) T {};
+}
+
+template<typename T, typename Arguments>
+T* CommandStream::GetArrayData(Arguments* arguments, size_t offset)
+{
+    using ByteType = eastl::conditional_t<eastl::is_const<Arguments>::value, const uint8_t, uint8_t>;
+    return reinterpret_cast<T*>(reinterpret_cast<ByteType*>(arguments) + Util::AlignUp<size_t>(sizeof(Arguments), PACKET_ALIGNMENT) + offset);
+}
+
+void* CommandStream::GetNativeHandle() const
+{
+    return nullptr;
+}
+
+void CommandStream::Begin()
+{
+    ASSERT(!m_recording);
+    Clear();
+    m_recording = true;
+}
+
+void CommandStream::End()
+{
+    ASSERT(m_recording);
+    m_recording = false;
+}
+
+void CommandStream::BindPipeline(const GraphicsPipeline* pipeline)
+{
+    Write<PipelineArguments>(CommandStreamOpcode::BIND_GRAPHICS_PIPELINE)->Pipeline = pipeline;
+}
+
+void CommandStream::BindPipeline(const ComputePipeline* pipeline)
+{
+    Write<PipelineArguments>(CommandStreamOpcode::BIND_COMPUTE_PIPELINE)->Pipeline = pipeline;
+}
+
+void CommandStream::SetViewports(uint32_t firstViewport, uint32_t viewportCount, const Viewport* viewports)
+{
+    auto* arguments  = Write<RangeArguments>(CommandStreamOpcode::SET_VIEWPORTS, sizeof(Viewport) * viewportCount);
+    arguments->First = firstViewport;
+    arguments->Count = viewportCount;
+    memcpy(GetArrayData<Viewport>(arguments), viewports, sizeof(Viewport) * viewportCount);
+}
+
+void CommandStream::SetScissors(uint32_t firstScissor, uint32_t scissorCount, const Rect* scissors)
+{
+    auto* arguments  = Write<RangeArguments>(CommandStreamOpcode::SET_SCISSORS, sizeof(Rect) * scissorCount);
+    arguments->First = firstScissor;
+    arguments->Count = scissorCount;
+    memcpy(GetArrayData<Rect>(arguments), scissors, sizeof(Rect) * scissorCount);
+}
+
+void CommandStream::SetLineWidth(float lineWidth)
+{
+    Write<FloatArguments>(CommandStreamOpcode::SET_LINE_WIDTH)->Values[0] = lineWidth;
+}
+
+void CommandStream::SetDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor)
+{
+    auto* arguments	      = Write<DepthBiasArguments>(CommandStreamOpcode::SET_DEPTH_BIAS);
+    arguments->ConstantFactor = depthBiasConstantFactor;
+    arguments->Clamp	      = depthBiasClamp;
+    arguments->SlopeFactor    = depthBiasSlopeFactor;
+}
+
+void CommandStream::SetBlendConstants(const float blendConstants[4])
+{
+    memcpy(Write<FloatArguments>(CommandStreamOpcode::SET_BLEND_CONSTANTS)->Values, blendConstants, sizeof(float) * 4);
+}
+
+void CommandStream::SetDepthBounds(float minDepthBounds, float maxDepthBounds)
+{
+    auto* arguments	 = Write<FloatArguments>(CommandStreamOpcode::SET_DEPTH_BOUNDS);
+    arguments->Values[0] = minDepthBounds;
+    arguments->Values[1] = maxDepthBounds;
+}
+
+void CommandStream::SetStencilCompareMask(StencilFaceFlags faceMask, uint32_t compareMask)
+{
+    *Write<StencilArguments>(CommandStreamOpcode::SET_STENCIL_COMPARE_MASK) = { faceMask, compareMask };
+}
+
+void CommandStream::SetStencilWriteMask(StencilFaceFlags faceMask, uint32_t writeMask)
+{
+    *Write<StencilArguments>(CommandStreamOpcode::SET_STENCIL_WRITE_MASK) = { faceMask, writeMask };
+}
+
+void CommandStream::SetStencilReference(StencilFaceFlags faceMask, uint32_t reference)
+{
+    *Write<StencilArguments>(CommandStreamOpcode::SET_STENCIL_REFERENCE) = { faceMask, reference };
+}
+
+void CommandStream::BindDescriptorSets(const GraphicsPipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)
+{
+    const size_t setSize = Util::AlignUp<size_t>(sizeof(DescriptorSet*) * count, PACKET_ALIGNMENT);
+    auto* arguments	 = Write<DescriptorSetArguments>(CommandStreamOpcode::BIND_GRAPHICS_DESCRIPTOR_SETS, setSize + sizeof(uint32_t) * offsetCount);
+    *arguments		 = { pipeline, firstSet, count, offsetCount };
+    memcpy(GetArrayData<const DescriptorSet*>(arguments), sets, sizeof(DescriptorSet*) * count);
+    memcpy(GetArrayData<uint32_t>(arguments, setSize), offsets, sizeof(uint32_t) * offsetCount);
+}
+
+void CommandStream::BindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)
+{
+    const size_t setSize = Util::AlignUp<size_t>(sizeof(DescriptorSet*) * count, PACKET_ALIGNMENT);
+    auto* arguments	 = Write<DescriptorSetArguments>(CommandStreamOpcode::BIND_COMPUTE_DESCRIPTOR_SETS, setSize + sizeof(uint32_t) * offsetCount);
+    *arguments		 = { pipeline, firstSet, count, offsetCount };
+    memcpy(GetArrayData<const DescriptorSet*>(arguments), sets, sizeof(DescriptorSet*) * count);
+    memcpy(GetArrayData<uint32_t>(arguments, setSize), offsets, sizeof(uint32_t) * offsetCount);
+}
+
+void CommandStream::BindIndexBuffer(const Buffer* buffer, uint64_t offset, IndexType indexType)
+{
+    *Write<IndexBufferArguments>(CommandStreamOpcode::BIND_INDEX_BUFFER) = { buffer, offset, indexType };
+}
+
+void CommandStream::BindVertexBuffers(uint32_t firstBinding, uint32_t count, const Buffer* const* buffers, uint64_t* offsets)
+{
+    const size_t bufferSize = sizeof(Buffer*) * count;
+    auto* arguments	    = Write<VertexBufferArguments>(CommandStreamOpcode::BIND_VERTEX_BUFFERS, bufferSize + sizeof(uint64_t) * count);
+    *arguments		    = { firstBinding, count };
+    memcpy(GetArrayData<const Buffer*>(arguments), buffers, bufferSize);
+    memcpy(GetArrayData<uint64_t>(arguments, bufferSize), offsets, sizeof(uint64_t) * count);
+}
+
+void CommandStream::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    *Write<DrawArguments>(CommandStreamOpcode::DRAW) = { vertexCount, instanceCount, firstVertex, 0, firstInstance };
+}
+
+void CommandStream::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    *Write<DrawArguments>(CommandStreamOpcode::DRAW_INDEXED) = { indexCount, instanceCount, firstIndex, vertexOffset, firstInstance };
+}
+
+void CommandStream::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    *Write<DispatchArguments>(CommandStreamOpcode::DISPATCH) = { groupCountX, groupCountY, groupCountZ };
+}
+
+void CommandStream::DispatchIndirect(const Buffer* buffer, uint64_t offset)
+{
+    *Write<BufferOffsetArguments>(CommandStreamOpcode::DISPATCH_INDIRECT) = { buffer, offset };
+}
+
+void CommandStream::CopyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions)
+{
+    auto* arguments = Write<CopyArguments>(CommandStreamOpcode::COPY_BUFFER, sizeof(BufferCopy) * regionCount);
+    *arguments	    = { srcBuffer, dstBuffer, regionCount };
+    memcpy(GetArrayData<BufferCopy>(arguments), regions, sizeof(BufferCopy) * regionCount);
+}
+
+void CommandStream::CopyImage(const Image* srcImage, const Image* dstImage, uint32_t regionCount, const ImageCopy* regions)
+{
+    auto* arguments = Write<CopyArguments>(CommandStreamOpcode::COPY_IMAGE, sizeof(ImageCopy) * regionCount);
+    *arguments	    = { srcImage, dstImage, regionCount };
+    memcpy(GetArrayData<ImageCopy>(arguments), regions, sizeof(ImageCopy) * regionCount);
+}
+
+void CommandStream::CopyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions)
+{
+    auto* arguments = Write<CopyArguments>(CommandStreamOpcode::COPY_BUFFER_TO_IMAGE, sizeof(BufferImageCopy) * regionCount);
+    *arguments	    = { srcBuffer, dstImage, regionCount };
+    memcpy(GetArrayData<BufferImageCopy>(arguments), regions, sizeof(BufferImageCopy) * regionCount);
+}
+
+void CommandStream::UpdateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data)
+{
+    auto* arguments = Write<UpdateBufferArguments>(CommandStreamOpcode::UPDATE_BUFFER, dataSize);
+    *arguments	    = { dstBuffer, dstOffset, dataSize };
+    memcpy(GetArrayData<uint8_t>(arguments), data, dataSize);
+}
+
+void CommandStream::ClearColorImage(const Image* image, const ClearColorValue* color, uint32_t rangeCount, const ImageSubresourceRange* ranges)
+{
+    auto* arguments	  = Write<ClearColorArguments>(CommandStreamOpcode::CLEAR_COLOR_IMAGE, sizeof(ImageSubresourceRange) * rangeCount);
+    arguments->Image	  = image;
+    arguments->Color	  = *color;
+    arguments->RangeCount = rangeCount;
+    memcpy(GetArrayData<ImageSubresourceRange>(arguments), ranges, sizeof(ImageSubresourceRange) * rangeCount);
+}
+
+void CommandStream::ClearDepthStencilImage(const Image* image, const ClearDepthStencilValue* depthStencil, uint32_t rangeCount, const ImageSubresourceRange* ranges)
+{
+    auto* arguments	    = Write<ClearDepthStencilArguments>(CommandStreamOpcode::CLEAR_DEPTH_STENCIL_IMAGE, sizeof(ImageSubresourceRange) * rangeCount);
+    arguments->Image	    = image;
+    arguments->DepthStencil = *depthStencil;
+    arguments->RangeCount   = rangeCount;
+    memcpy(GetArrayData<ImageSubresourceRange>(arguments), ranges, sizeof(ImageSubresourceRange) * rangeCount);
+}
+
+void CommandStream::Barrier(uint32_t count, const class Barrier* barriers)
+{
+    auto* arguments  = Write<BarrierArguments>(CommandStreamOpcode::BARRIER, sizeof(class Barrier) * count);
+    arguments->Count = count;
+    memcpy(GetArrayData<class Barrier>(arguments), barriers, sizeof(class Barrier) * count);
+}
+
+void CommandStream::Barrier(const LoweredBarriers* loweredBarriers, uint32_t group)
+{
+    *Write<LoweredBarrierArguments>(CommandStreamOpcode::LOWERED_BARRIER) = { loweredBarriers, group };
+}
+
+void CommandStream::BeginQuery(const QueryPool* queryPool, uint32_t query)
+{
+    *Write<QueryArguments>(CommandStreamOpcode::BEGIN_QUERY) = { queryPool, query, 1, {} };
+}
+
+void CommandStream::EndQuery(const QueryPool* queryPool, uint32_t query)
+{
+    *Write<QueryArguments>(CommandStreamOpcode::END_QUERY) = { queryPool, query, 1, {} };
+}
+
+void CommandStream::ResetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+    *Write<QueryArguments>(CommandStreamOpcode::RESET_QUERY_POOL) = { queryPool, firstQuery, queryCount, {} };
+}
+
+void CommandStream::WriteTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query)
+{
+    *Write<QueryArguments>(CommandStreamOpcode::WRITE_TIMESTAMP) = { queryPool, query, 1, pipelineStage };
+}
+
+void CommandStream::CopyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset)
+{
+    *Write<CopyQueryResultsArguments>(CommandStreamOpcode::COPY_QUERY_POOL_RESULTS) = { queryPool, firstQuery, queryCount, dstBuffer, dstOffset };
+}
+
+void CommandStream::PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    auto* arguments = Write<PushConstantArguments>(CommandStreamOpcode::GRAPHICS_PUSH_CONSTANTS, size);
+    *arguments	    = { pipeline, stageFlags, offset, size };
+    memcpy(GetArrayData<uint8_t>(arguments), values, size);
+}
+
+void CommandStream::PushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    auto* arguments = Write<PushConstantArguments>(CommandStreamOpcode::COMPUTE_PUSH_CONSTANTS, size);
+    *arguments	    = { pipeline, stageFlags, offset, size };
+    memcpy(GetArrayData<uint8_t>(arguments), values, size);
+}
+
+void CommandStream::BeginRenderPass(uint32_t colorAttachmentCount, ColorAttachmentDescription* colorAttachments, DepthStencilAttachmentDescription* depthStencilAttachment, const Rect& renderArea, bool rwTextureBufferAccess)
+{
+    const size_t colorSize = Util::AlignUp<size_t>(sizeof(ColorAttachmentDescription) * colorAttachmentCount, PACKET_ALIGNMENT);
+    const size_t depthSize = depthStencilAttachment ? sizeof(DepthStencilAttachmentDescription) : 0;
+
+    auto* arguments = Write<RenderPassArguments>(CommandStreamOpcode::BEGIN_RENDER_PASS, colorSize + depthSize);
+    *arguments	    = { renderArea, colorAttachmentCount, depthStencilAttachment != nullptr, rwTextureBufferAccess };
+    memcpy(GetArrayData<ColorAttachmentDescription>(arguments), colorAttachments, sizeof(ColorAttachmentDescription) * colorAttachmentCount);
+    if(depthStencilAttachment)
+    {
+	memcpy(GetArrayData<DepthStencilAttachmentDescription>(arguments, colorSize), depthStencilAttachment, depthSize);
+    }
+}
+
+void CommandStream::EndRenderPass()
+{
+    Write<EmptyArguments>(CommandStreamOpcode::END_RENDER_PASS);
+}
+
+void CommandStream::Replay(Command* command) const
+{
+    ASSERT(!m_recording);
+
+    // the Command interface takes some arrays as non-const pointers, they are only read
+    auto* data = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(m_data.data()));
+    for(uint64_t offset = 0; offset < m_size;)
+    {
+	const auto* header = reinterpret_cast<const PacketHeader*>(data + offset);
+	void* packet	   = data + offset + sizeof(PacketHeader);
+	offset += header->Size;
+
+	switch(header->Opcode)
+	{
+	    case CommandStreamOpcode::BIND_GRAPHICS_PIPELINE:
+		command->BindPipeline(static_cast<const GraphicsPipeline*>(static_cast<PipelineArguments*>(packet)->Pipeline));
+		break;
+	    case CommandStreamOpcode::BIND_COMPUTE_PIPELINE:
+		command->BindPipeline(static_cast<const ComputePipeline*>(static_cast<PipelineArguments*>(packet)->Pipeline));
+		break;
+	    case CommandStreamOpcode::SET_VIEWPORTS:
+	    {
+		auto* arguments = static_cast<RangeArguments*>(packet);
+		command->SetViewports(arguments->First, arguments->Count, GetArrayData<Viewport>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::SET_SCISSORS:
+	    {
+		auto* arguments = static_cast<RangeArguments*>(packet);
+		command->SetScissors(arguments->First, arguments->Count, GetArrayData<Rect>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::SET_LINE_WIDTH:
+		command->SetLineWidth(static_cast<FloatArguments*>(packet)->Values[0]);
+		break;
+	    case CommandStreamOpcode::SET_DEPTH_BIAS:
+	    {
+		auto* arguments = static_cast<DepthBiasArguments*>(packet);
+		command->SetDepthBias(arguments->ConstantFactor, arguments->Clamp, arguments->SlopeFactor);
+		break;
+	    }
+	    case CommandStreamOpcode::SET_BLEND_CONSTANTS:
+		command->SetBlendConstants(static_cast<FloatArguments*>(packet)->Values);
+		break;
+	    case CommandStreamOpcode::SET_DEPTH_BOUNDS:
+	    {
+		auto* arguments = static_cast<FloatArguments*>(packet);
+		command->SetDepthBounds(arguments->Values[0], arguments->Values[1]);
+		break;
+	    }
+	    case CommandStreamOpcode::SET_STENCIL_COMPARE_MASK:
+	    {
+		auto* arguments = static_cast<StencilArguments*>(packet);
+		command->SetStencilCompareMask(arguments->FaceMask, arguments->Value);
+		break;
+	    }
+	    case CommandStreamOpcode::SET_STENCIL_WRITE_MASK:
+	    {
+		auto* arguments = static_cast<StencilArguments*>(packet);
+		command->SetStencilWriteMask(arguments->FaceMask, arguments->Value);
+		break;
+	    }
+	    case CommandStreamOpcode::SET_STENCIL_REFERENCE:
+	    {
+		auto* arguments = static_cast<StencilArguments*>(packet);
+		command->SetStencilReference(arguments->FaceMask, arguments->Value);
+		break;
+	    }
+	    case CommandStreamOpcode::BIND_GRAPHICS_DESCRIPTOR_SETS:
+	    {
+		auto* arguments	     = static_cast<DescriptorSetArguments*>(packet);
+		const size_t setSize = Util::AlignUp<size_t>(sizeof(DescriptorSet*) * arguments->Count, PACKET_ALIGNMENT);
+		command->BindDescriptorSets(static_cast<const GraphicsPipeline*>(arguments->Pipeline), arguments->FirstSet, arguments->Count, GetArrayData<const DescriptorSet*>(arguments), arguments->OffsetCount, GetArrayData<uint32_t>(arguments, setSize));
+		break;
+	    }
+	    case CommandStreamOpcode::BIND_COMPUTE_DESCRIPTOR_SETS:
+	    {
+		auto* arguments	     = static_cast<DescriptorSetArguments*>(packet);
+		const size_t setSize = Util::AlignUp<size_t>(sizeof(DescriptorSet*) * arguments->Count, PACKET_ALIGNMENT);
+		command->BindDescriptorSets(static_cast<const ComputePipeline*>(arguments->Pipeline), arguments->FirstSet, arguments->Count, GetArrayData<const DescriptorSet*>(arguments), arguments->OffsetCount, GetArrayData<uint32_t>(arguments, setSize));
+		break;
+	    }
+	    case CommandStreamOpcode::BIND_INDEX_BUFFER:
+	    {
+		auto* arguments = static_cast<IndexBufferArguments*>(packet);
+		command->BindIndexBuffer(arguments->Buffer, arguments->Offset, arguments->IndexType);
+		break;
+	    }
+	    case CommandStreamOpcode::BIND_VERTEX_BUFFERS:
+	    {
+		auto* arguments = static_cast<VertexBufferArguments*>(packet);
+		command->BindVertexBuffers(arguments->FirstBinding, arguments->Count, GetArrayData<const Buffer*>(arguments), GetArrayData<uint64_t>(arguments, sizeof(Buffer*) * arguments->Count));
+		break;
+	    }
+	    case CommandStreamOpcode::DRAW:
+	    {
+		auto* arguments = static_cast<DrawArguments*>(packet);
+		command->Draw(arguments->VertexCount, arguments->InstanceCount, arguments->FirstVertex, arguments->FirstInstance);
+		break;
+	    }
+	    case CommandStreamOpcode::DRAW_INDEXED:
+	    {
+		auto* arguments = static_cast<DrawArguments*>(packet);
+		command->DrawIndexed(arguments->VertexCount, arguments->InstanceCount, arguments->FirstVertex, arguments->VertexOffset, arguments->FirstInstance);
+		break;
+	    }
+	    case CommandStreamOpcode::DISPATCH:
+	    {
+		auto* arguments = static_cast<DispatchArguments*>(packet);
+		command->Dispatch(arguments->GroupCountX, arguments->GroupCountY, arguments->GroupCountZ);
+		break;
+	    }
+	    case CommandStreamOpcode::DISPATCH_INDIRECT:
+	    {
+		auto* arguments = static_cast<BufferOffsetArguments*>(packet);
+		command->DispatchIndirect(arguments->Buffer, arguments->Offset);
+		break;
+	    }
+	    case CommandStreamOpcode::COPY_BUFFER:
+	    {
+		auto* arguments = static_cast<CopyArguments*>(packet);
+		command->CopyBuffer(static_cast<const Buffer*>(arguments->Source), static_cast<const Buffer*>(arguments->Destination), arguments->RegionCount, GetArrayData<BufferCopy>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::COPY_IMAGE:
+	    {
+		auto* arguments = static_cast<CopyArguments*>(packet);
+		command->CopyImage(static_cast<const Image*>(arguments->Source), static_cast<const Image*>(arguments->Destination), arguments->RegionCount, GetArrayData<ImageCopy>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::COPY_BUFFER_TO_IMAGE:
+	    {
+		auto* arguments = static_cast<CopyArguments*>(packet);
+		command->CopyBufferToImage(static_cast<const Buffer*>(arguments->Source), static_cast<const Image*>(arguments->Destination), arguments->RegionCount, GetArrayData<BufferImageCopy>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::UPDATE_BUFFER:
+	    {
+		auto* arguments = static_cast<UpdateBufferArguments*>(packet);
+		command->UpdateBuffer(arguments->Buffer, arguments->Offset, arguments->Size, GetArrayData<uint8_t>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::CLEAR_COLOR_IMAGE:
+	    {
+		auto* arguments = static_cast<ClearColorArguments*>(packet);
+		command->ClearColorImage(arguments->Image, &arguments->Color, arguments->RangeCount, GetArrayData<ImageSubresourceRange>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::CLEAR_DEPTH_STENCIL_IMAGE:
+	    {
+		auto* arguments = static_cast<ClearDepthStencilArguments*>(packet);
+		command->ClearDepthStencilImage(arguments->Image, &arguments->DepthStencil, arguments->RangeCount, GetArrayData<ImageSubresourceRange>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::BARRIER:
+	    {
+		auto* arguments = static_cast<BarrierArguments*>(packet);
+		command->Barrier(arguments->Count, GetArrayData<class Barrier>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::LOWERED_BARRIER:
+	    {
+		auto* arguments = static_cast<LoweredBarrierArguments*>(packet);
+		command->Barrier(arguments->Barriers, arguments->Group);
+		break;
+	    }
+	    case CommandStreamOpcode::BEGIN_QUERY:
+	    {
+		auto* arguments = static_cast<QueryArguments*>(packet);
+		command->BeginQuery(arguments->QueryPool, arguments->Query);
+		break;
+	    }
+	    case CommandStreamOpcode::END_QUERY:
+	    {
+		auto* arguments = static_cast<QueryArguments*>(packet);
+		command->EndQuery(arguments->QueryPool, arguments->Query);
+		break;
+	    }
+	    case CommandStreamOpcode::RESET_QUERY_POOL:
+	    {
+		auto* arguments = static_cast<QueryArguments*>(packet);
+		command->ResetQueryPool(arguments->QueryPool, arguments->Query, arguments->QueryCount);
+		break;
+	    }
+	    case CommandStreamOpcode::WRITE_TIMESTAMP:
+	    {
+		auto* arguments = static_cast<QueryArguments*>(packet);
+		command->WriteTimestamp(arguments->Stage, arguments->QueryPool, arguments->Query);
+		break;
+	    }
+	    case CommandStreamOpcode::COPY_QUERY_POOL_RESULTS:
+	    {
+		auto* arguments = static_cast<CopyQueryResultsArguments*>(packet);
+		command->CopyQueryPoolResults(arguments->QueryPool, arguments->FirstQuery, arguments->QueryCount, arguments->Buffer, arguments->Offset);
+		break;
+	    }
+	    case CommandStreamOpcode::GRAPHICS_PUSH_CONSTANTS:
+	    {
+		auto* arguments = static_cast<PushConstantArguments*>(packet);
+		command->PushConstants(static_cast<const GraphicsPipeline*>(arguments->Pipeline), arguments->StageFlags, arguments->Offset, arguments->Size, GetArrayData<uint8_t>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::COMPUTE_PUSH_CONSTANTS:
+	    {
+		auto* arguments = static_cast<PushConstantArguments*>(packet);
+		command->PushConstants(static_cast<const ComputePipeline*>(arguments->Pipeline), arguments->StageFlags, arguments->Offset, arguments->Size, GetArrayData<uint8_t>(arguments));
+		break;
+	    }
+	    case CommandStreamOpcode::BEGIN_RENDER_PASS:
+	    {
+		auto* arguments	       = static_cast<RenderPassArguments*>(packet);
+		const size_t colorSize = Util::AlignUp<size_t>(sizeof(ColorAttachmentDescription) * arguments->ColorAttachmentCount, PACKET_ALIGNMENT);
+		auto* depthStencil     = arguments->DepthStencil ? GetArrayData<DepthStencilAttachmentDescription>(arguments, colorSize) : nullptr;
+		command->BeginRenderPass(arguments->ColorAttachmentCount, GetArrayData<ColorAttachmentDescription>(arguments), depthStencil, arguments->RenderArea, arguments->RWTextureBufferAccess);
+		break;
+	    }
+	    case CommandStreamOpcode::END_RENDER_PASS:
+		command->EndRenderPass();
+		break;
+	    default:
+		ASSERT_MSG(false, "Unknown command stream opcode");
+		break;
+	}
+    }
+}
+
+void CommandStream::Clear()
+{
+    m_size	   = 0;
+    m_commandCount = 0;
+}
+
+bool CommandStream::IsEmpty() const
+{
+    return m_commandCount == 0;
+}
+
+uint32_t CommandStream::GetCommandCount() const
+{
+    return m_commandCount;
+}
+
+uint64_t CommandStream::GetSize() const
+{
+    return m_size;
+}
\ No newline at end of file
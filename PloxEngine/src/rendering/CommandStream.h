@@ -0,0 +1,131 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/Command.h"
+#include <cstdint>
+
+enum class CommandStreamOpcode : uint32_t
+{
+    BIND_GRAPHICS_PIPELINE,
+    BIND_COMPUTE_PIPELINE,
+    SET_VIEWPORTS,
+    SET_SCISSORS,
+    SET_LINE_WIDTH,
+    SET_DEPTH_BIAS,
+    SET_BLEND_CONSTANTS,
+    SET_DEPTH_BOUNDS,
+    SET_STENCIL_COMPARE_MASK,
+    SET_STENCIL_WRITE_MASK,
+    SET_STENCIL_REFERENCE,
+    BIND_GRAPHICS_DESCRIPTOR_SETS,
+    BIND_COMPUTE_DESCRIPTOR_SETS,
+    BIND_INDEX_BUFFER,
+    BIND_VERTEX_BUFFERS,
+    DRAW,
+    DRAW_INDEXED,
+    DISPATCH,
+    DISPATCH_INDIRECT,
+    COPY_BUFFER,
+    COPY_IMAGE,
+    COPY_BUFFER_TO_IMAGE,
+    UPDATE_BUFFER,
+    CLEAR_COLOR_IMAGE,
+    CLEAR_DEPTH_STENCIL_IMAGE,
+    BARRIER,
+    LOWERED_BARRIER,
+    BEGIN_QUERY,
+    END_QUERY,
+    RESET_QUERY_POOL,
+    WRITE_TIMESTAMP,
+    COPY_QUERY_POOL_RESULTS,
+    GRAPHICS_PUSH_CONSTANTS,
+    COMPUTE_PUSH_CONSTANTS,
+    BEGIN_RENDER_PASS,
+    END_RENDER_PASS,
+};
+
+// records the calls of any Command into a linear packet stream without touching the backend.
+// every packet is a header, the arguments and the copied arrays, so the stream owns everything it references except the gpu objects.
+// Replay translates the stream into a backend command list and can be called any number of times, e.g. to benchmark the translation
+class CommandStream : public Command
+{
+public:
+    explicit CommandStream() = default;
+
+    // there is no native command list, passes that need one require deferred recording to be disabled
+    void* GetNativeHandle() const override;
+    // starts a new stream, the memory of the previous one is reused
+    void Begin() override;
+    void End() override;
+    void BindPipeline(const GraphicsPipeline* pipeline) override;
+    void BindPipeline(const ComputePipeline* pipeline) override;
+    void SetViewports(uint32_t firstViewport, uint32_t viewportCount, const Viewport* viewports) override;
+    void SetScissors(uint32_t firstScissor, uint32_t scissorCount, const Rect* scissors) override;
+    void SetLineWidth(float lineWidth) override;
+    void SetDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) override;
+    void SetBlendConstants(const float blendConstants[4]) override;
+    void SetDepthBounds(float minDepthBounds, float maxDepthBounds) override;
+    void SetStencilCompareMask(StencilFaceFlags faceMask, uint32_t compareMask) override;
+    void SetStencilWriteMask(StencilFaceFlags faceMask, uint32_t writeMask) override;
+    void SetStencilReference(StencilFaceFlags faceMask, uint32_t reference) override;
+    void BindDescriptorSets(const GraphicsPipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets) override;
+    void BindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets) override;
+    void BindIndexBuffer(const Buffer* buffer, uint64_t offset, IndexType indexType) override;
+    void BindVertexBuffers(uint32_t firstBinding, uint32_t count, const Buffer* const* buffers, uint64_t* offsets) override;
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+    void DispatchIndirect(const Buffer* buffer, uint64_t offset) override;
+    void CopyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions) override;
+    void CopyImage(const Image* srcImage, const Image* dstImage, uint32_t regionCount, const ImageCopy* regions) override;
+    void CopyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions) override;
+    void UpdateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data) override;
+    void ClearColorImage(const Image* image, const ClearColorValue* color, uint32_t rangeCount, const ImageSubresourceRange* ranges) override;
+    void ClearDepthStencilImage(const Image* image, const ClearDepthStencilValue* depthStencil, uint32_t rangeCount, const ImageSubresourceRange* ranges) override;
+    void Barrier(uint32_t count, const class Barrier* barriers) override;
+    // the lowered barriers are referenced, they have to stay unchanged until the stream was replayed
+    void Barrier(const LoweredBarriers* loweredBarriers, uint32_t group) override;
+    void BeginQuery(const QueryPool* queryPool, uint32_t query) override;
+    void EndQuery(const QueryPool* queryPool, uint32_t query) override;
+    void ResetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount) override;
+    void WriteTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query) override;
+    void CopyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset) override;
+    void PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values) override;
+    void PushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values) override;
+    void BeginRenderPass(uint32_t colorAttachmentCount, ColorAttachmentDescription* colorAttachments, DepthStencilAttachmentDescription* depthStencilAttachment, const Rect& renderArea, bool rwTextureBufferAccess) override;
+    void EndRenderPass() override;
+
+    // records the stream into command, which has to be between Begin and End
+    void Replay(Command* command) const;
+    void Clear();
+    bool IsEmpty() const;
+    uint32_t GetCommandCount() const;
+    // in bytes
+    uint64_t GetSize() const;
+
+private:
+    static constexpr size_t PACKET_ALIGNMENT = 8;
+
+    struct PacketHeader
+    {
+	CommandStreamOpcode Opcode;
+	// of the whole packet including the header, a multiple of PACKET_ALIGNMENT
+	uint32_t Size;
+    };
+
+    // appends a packet with arrayDataSize bytes behind the arguments and returns the arguments, the pointer is valid until the next Write
+    template<typename T>
+    T* Write(CommandStreamOpcode opcode, size_t arrayDataSize = 0);
+    // arrays start at PACKET_ALIGNMENT aligned offsets behind the arguments
+    template<typename T, typename Arguments>
+    static T* GetArrayData(Arguments* arguments, size_t offset = 0);
+
+private:
+    eastl::vector<uint64_t> m_data;
+    uint64_t m_size	    = 0;
+    uint32_t m_commandCount = 0;
+    bool m_recording	    = false;
+};
\ No newline at end of file
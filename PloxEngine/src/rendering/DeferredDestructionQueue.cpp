@@ -0,0 +1,91 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+#include "DeferredDestructionQueue.h"
+#include "core/Profiler.h"
+#include "rendering/types/Semaphore.h"
+
+DeferredDestructionQueue::DeferredDestructionQueue(GraphicsAdapter* adapter, Semaphore** semaphores, const uint64_t* semaphoreValues) noexcept
+    : m_adapter(adapter), m_semaphores { semaphores[0], semaphores[1], semaphores[2] }, m_semaphoreValues(semaphoreValues)
+{
+}
+
+DeferredDestructionQueue::~DeferredDestructionQueue() noexcept
+{
+    Flush();
+}
+
+void DeferredDestructionQueue::Collect() noexcept
+{
+    PROFILE_FUNCTION();
+    SpinLockHolder lockHolder(m_lock);
+
+    const uint64_t completedValues[3] = { m_semaphores[0]->GetCompletedValue(), m_semaphores[1]->GetCompletedValue(), m_semaphores[2]->GetCompletedValue() };
+
+    size_t completedCount = 0;
+    for(; completedCount < m_pending.size(); ++completedCount)
+    {
+	const auto& pending = m_pending[completedCount];
+	if(pending.SemaphoreValues[0] > completedValues[0] || pending.SemaphoreValues[1] > completedValues[1] || pending.SemaphoreValues[2] > completedValues[2])
+	{
+	    break;
+	}
+	pending.Destroy(m_adapter, pending.Object);
+    }
+
+    m_pending.erase(m_pending.begin(), m_pending.begin() + completedCount);
+    m_destroyedCount += completedCount;
+}
+
+void DeferredDestructionQueue::Flush() noexcept
+{
+    uint64_t waitValues[3] = {};
+    {
+	SpinLockHolder lockHolder(m_lock);
+	if(m_pending.empty())
+	{
+	    return;
+	}
+
+	const auto& lastPending = m_pending.back();
+	waitValues[0]		= lastPending.SemaphoreValues[0];
+	waitValues[1]		= lastPending.SemaphoreValues[1];
+	waitValues[2]		= lastPending.SemaphoreValues[2];
+    }
+
+    // not waiting under the lock, objects handed over in the meantime are destroyed by a later Collect
+    for(size_t i = 0; i < 3; ++i)
+    {
+	m_semaphores[i]->Wait(waitValues[i]);
+    }
+
+    Collect();
+}
+
+DeferredDestructionStatistics DeferredDestructionQueue::GetStatistics() const noexcept
+{
+    SpinLockHolder lockHolder(m_lock);
+
+    DeferredDestructionStatistics statistics = {};
+    statistics.PendingCount		     = m_pending.size();
+    statistics.DestroyedCount		     = m_destroyedCount;
+    return statistics;
+}
+
+void DeferredDestructionQueue::Enqueue(void* object, DestroyFunction destroy) noexcept
+{
+    if(!object)
+    {
+	return;
+    }
+
+    PendingDestruction pending = {};
+    pending.Object	       = object;
+    pending.Destroy	       = destroy;
+    pending.SemaphoreValues[0] = m_semaphoreValues[0];
+    pending.SemaphoreValues[1] = m_semaphoreValues[1];
+    pending.SemaphoreValues[2] = m_semaphoreValues[2];
+
+    SpinLockHolder lockHolder(m_lock);
+    m_pending.push_back(pending);
+}
\ No newline at end of file
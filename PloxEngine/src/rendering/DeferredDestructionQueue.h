@@ -0,0 +1,66 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "utility/SpinLock.h"
+#include <cstdint>
+
+class GraphicsAdapter;
+class Semaphore;
+
+struct DeferredDestructionStatistics
+{
+    // objects handed over that the gpu may still be using
+    uint64_t PendingCount;
+    uint64_t DestroyedCount;
+};
+
+// destroys gpu objects once the queues are done with them. every object is tagged with the last submitted semaphore value of every queue
+// when it is handed over, Collect destroys the objects whose values all queues have passed without ever waiting on the gpu.
+// objects are handed over by the GraphicsAdapter Destroy functions once the queue is set on the adapter. the pending list is guarded by a lock,
+// so objects may be handed over from any thread, but the semaphore values are the ones last submitted when Enqueue runs,
+// the caller has to make sure nothing submitted after that uses the object
+class DeferredDestructionQueue
+{
+public:
+    explicit DeferredDestructionQueue(GraphicsAdapter* adapter, Semaphore** semaphores, const uint64_t* semaphoreValues) noexcept;
+    // blocks until the gpu is done with all pending objects
+    ~DeferredDestructionQueue() noexcept;
+
+    DeferredDestructionQueue(const DeferredDestructionQueue&)		  = delete;
+    DeferredDestructionQueue(const DeferredDestructionQueue&&)		  = delete;
+    DeferredDestructionQueue& operator=(const DeferredDestructionQueue&)  = delete;
+    DeferredDestructionQueue& operator=(const DeferredDestructionQueue&&) = delete;
+
+    using DestroyFunction = void (*)(GraphicsAdapter* adapter, void* object);
+
+    // object may still be used by everything submitted so far, but not by anything submitted afterwards
+    void Enqueue(void* object, DestroyFunction destroy) noexcept;
+
+    // destroys the objects the gpu is done with, never blocks
+    void Collect() noexcept;
+    // blocks until the gpu is done with all pending objects and destroys them
+    void Flush() noexcept;
+
+    DeferredDestructionStatistics GetStatistics() const noexcept;
+
+private:
+    struct PendingDestruction
+    {
+	void* Object;
+	DestroyFunction Destroy;
+	uint64_t SemaphoreValues[3];
+    };
+
+private:
+    GraphicsAdapter* m_adapter;
+    Semaphore* m_semaphores[3];
+    const uint64_t* m_semaphoreValues;
+
+    // in the order the objects were handed over, so the values of every queue only grow and the completed objects are at the front
+    eastl::vector<PendingDestruction> m_pending;
+    uint64_t m_destroyedCount = 0;
+    mutable SpinLock m_lock;
+};
\ No newline at end of file
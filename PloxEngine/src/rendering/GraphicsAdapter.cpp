@@ -2,6 +2,8 @@
 // Created by Ploxie on 2023-05-09.
 //
 #include "GraphicsAdapter.h"
+#include "DeferredDestructionQueue.h"
+#include "rendering/null/NullGraphicsAdapter.h"
 #include "rendering/vulkan/VulkanGraphicsAdapter.h"
 #include "core/Logger.h"
 
@@ -11,6 +13,8 @@ GraphicsAdapter* GraphicsAdapter::Create(void* windowHandle, bool debugLayer, Gr
 	{
 	case GraphicsBackendType::VULKAN:
 		return new VulkanGraphicsAdapter(windowHandle, debugLayer);
+	case GraphicsBackendType::HEADLESS:
+		return new NullGraphicsAdapter();
 	default:
 		LOG_CRITICAL("Render backend type {0} not supported!", (int)backend);
 		break;
@@ -22,3 +26,88 @@ void GraphicsAdapter::Destroy(const GraphicsAdapter* adapter)
 {
 
 }
+
+void GraphicsAdapter::SetDeferredDestructionQueue(DeferredDestructionQueue* deferredDestructionQueue)
+{
+	m_deferredDestructionQueue = deferredDestructionQueue;
+}
+
+template<typename T, void (GraphicsAdapter::*DestroyImmediate)(T*)>
+void GraphicsAdapter::DeferDestruction(T* object)
+{
+	if (!m_deferredDestructionQueue)
+	{
+		(this->*DestroyImmediate)(object);
+		return;
+	}
+
+	m_deferredDestructionQueue->Enqueue(object, [](GraphicsAdapter* adapter, void* deferredObject)
+	{
+		(adapter->*DestroyImmediate)(static_cast<T*>(deferredObject));
+	});
+}
+
+void GraphicsAdapter::DestroyGraphicsPipeline(GraphicsPipeline* pipeline)
+{
+	DeferDestruction<GraphicsPipeline, &GraphicsAdapter::DestroyGraphicsPipelineImmediate>(pipeline);
+}
+
+void GraphicsAdapter::DestroyComputePipeline(ComputePipeline* pipeline)
+{
+	DeferDestruction<ComputePipeline, &GraphicsAdapter::DestroyComputePipelineImmediate>(pipeline);
+}
+
+void GraphicsAdapter::DestroyCommandPool(CommandPool* commandPool)
+{
+	DeferDestruction<CommandPool, &GraphicsAdapter::DestroyCommandPoolImmediate>(commandPool);
+}
+
+void GraphicsAdapter::DestroySemaphore(Semaphore* semaphore)
+{
+	DeferDestruction<Semaphore, &GraphicsAdapter::DestroySemaphoreImmediate>(semaphore);
+}
+
+void GraphicsAdapter::DestroyImage(Image* image)
+{
+	DeferDestruction<Image, &GraphicsAdapter::DestroyImageImmediate>(image);
+}
+
+void GraphicsAdapter::DestroyImageView(ImageView* imageView)
+{
+	DeferDestruction<ImageView, &GraphicsAdapter::DestroyImageViewImmediate>(imageView);
+}
+
+void GraphicsAdapter::DestroyBuffer(Buffer* buffer)
+{
+	DeferDestruction<Buffer, &GraphicsAdapter::DestroyBufferImmediate>(buffer);
+}
+
+void GraphicsAdapter::DestroyBufferView(BufferView* bufferView)
+{
+	DeferDestruction<BufferView, &GraphicsAdapter::DestroyBufferViewImmediate>(bufferView);
+}
+
+void GraphicsAdapter::DestroyDescriptorSetPool(DescriptorSetPool* descriptorSetPool)
+{
+	DeferDestruction<DescriptorSetPool, &GraphicsAdapter::DestroyDescriptorSetPoolImmediate>(descriptorSetPool);
+}
+
+void GraphicsAdapter::DestroyDescriptorSetLayout(DescriptorSetLayout* descriptorSetLayout)
+{
+	DeferDestruction<DescriptorSetLayout, &GraphicsAdapter::DestroyDescriptorSetLayoutImmediate>(descriptorSetLayout);
+}
+
+void GraphicsAdapter::DestroyQueryPool(QueryPool* queryPool)
+{
+	DeferDestruction<QueryPool, &GraphicsAdapter::DestroyQueryPoolImmediate>(queryPool);
+}
+
+void GraphicsAdapter::DestroyEvent(Event* event)
+{
+	DeferDestruction<Event, &GraphicsAdapter::DestroyEventImmediate>(event);
+}
+
+void GraphicsAdapter::DestroyMemoryHeap(MemoryHeap* memoryHeap)
+{
+	DeferDestruction<MemoryHeap, &GraphicsAdapter::DestroyMemoryHeapImmediate>(memoryHeap);
+}
@@ -5,14 +5,18 @@
 #pragma once
 #include "rendering/types/Buffer.h"
 #include "rendering/types/DescriptorSet.h"
+#include "rendering/types/MemoryHeap.h"
 #include "rendering/types/Swapchain.h"
 #include <cstdint>
 
 #undef CreateSemaphore
+#undef CreateEvent
 
 class Window;
 struct GraphicsPipelineCreateInfo;
 class GraphicsPipeline;
+struct ComputePipelineCreateInfo;
+class ComputePipeline;
 class CommandPool;
 class ImageView;
 class DescriptorSetLayout;
@@ -20,11 +24,19 @@ class DescriptorSetPool;
 struct DescriptorSetLayoutBinding;
 class ImageViewCreateInfo;
 class BufferViewCreateInfo;
+class QueryPool;
+struct QueryPoolCreateInfo;
+class Event;
+class LoweredBarriers;
+class DeferredDestructionQueue;
+struct Barrier;
 
 enum class GraphicsBackendType
 {
     VULKAN,
-    DX12
+    DX12,
+    // records commands without a gpu, for tests and benchmarks
+    HEADLESS
 };
 
 enum class ObjectType
@@ -56,6 +68,7 @@ public:
     static void Destroy(const GraphicsAdapter* adapter);
 
     virtual void CreateGraphicsPipeline(uint32_t count, const GraphicsPipelineCreateInfo* createInfo, GraphicsPipeline** pipelines)									    = 0;
+    virtual void CreateComputePipeline(uint32_t count, const ComputePipelineCreateInfo* createInfo, ComputePipeline** pipelines)									    = 0;
     virtual void CreateCommandPool(const Queue* queue, CommandPool** commandPool)															    = 0;
     virtual void CreateSwapchain(const Queue* presentQueue, unsigned int width, unsigned int height, Window* window, PresentMode presentMode, Swapchain** swapchain)					    = 0;
     virtual void CreateSemaphore(uint64_t initialValue, Semaphore** semaphore)																    = 0;
@@ -66,14 +79,36 @@ public:
     virtual void CreateBufferView(const BufferViewCreateInfo* bufferViewCreateInfo, BufferView** bufferView)												    = 0;
     virtual void CreateDescriptorSetPool(uint32_t maxSets, const DescriptorSetLayout* descriptorSetLayout, DescriptorSetPool** descriptorSetPool)							    = 0;
     virtual void CreateDescriptorSetLayout(uint32_t bindingCount, const DescriptorSetLayoutBinding* bindings, DescriptorSetLayout** descriptorSetLayout)						    = 0;
+    virtual void CreateQueryPool(const QueryPoolCreateInfo& queryPoolCreateInfo, QueryPool** queryPool)													    = 0;
+    virtual void CreateEvent(Event** event)																				    = 0;
+    virtual void CreateMemoryHeap(const MemoryHeapCreateInfo& memoryHeapCreateInfo, MemoryHeap** memoryHeap)												    = 0;
+    // images and buffers without memory, they have to be placed into a MemoryHeap with BindMemory before use
+    virtual void CreateUnboundImage(const ImageCreateInfo& imageCreateInfo, Image** image)	     = 0;
+    virtual void CreateUnboundBuffer(const BufferCreateInfo& bufferCreateInfo, Buffer** buffer)	     = 0;
+    virtual void GetMemoryRequirements(const Image* image, MemoryRequirements* memoryRequirements)   = 0;
+    virtual void GetMemoryRequirements(const Buffer* buffer, MemoryRequirements* memoryRequirements) = 0;
+    virtual void BindMemory(Image* image, MemoryHeap* memoryHeap, uint64_t offset)		     = 0;
+    virtual void BindMemory(Buffer* buffer, MemoryHeap* memoryHeap, uint64_t offset)		     = 0;
+    // groupOffsets has groupCount + 1 entries, group i covers the barriers [groupOffsets[i], groupOffsets[i + 1]) and is recorded by one Command::Barrier
+    virtual void CreateLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets, LoweredBarriers** loweredBarriers) = 0;
 
-    virtual void DestroyCommandPool(CommandPool* commandPool)			      = 0;
-    virtual void DestroyImage(Image* image)					      = 0;
-    virtual void DestroyImageView(ImageView* imageView)				      = 0;
-    virtual void DestroyBuffer(Buffer* buffer)					      = 0;
-    virtual void DestroyBufferView(BufferView* bufferView)			      = 0;
-    virtual void DestroyDescriptorSetPool(DescriptorSetPool* descriptorSetPool)	      = 0;
-    virtual void DestroyDescriptorSetLayout(DescriptorSetLayout* descriptorSetLayout) = 0;
+    // the gpu may still be using the objects. with a DeferredDestructionQueue set they are destroyed once every queue is past the work
+    // submitted so far, right away otherwise
+    void DestroyGraphicsPipeline(GraphicsPipeline* pipeline);
+    void DestroyComputePipeline(ComputePipeline* pipeline);
+    void DestroyCommandPool(CommandPool* commandPool);
+    void DestroySemaphore(Semaphore* semaphore);
+    void DestroyImage(Image* image);
+    void DestroyImageView(ImageView* imageView);
+    void DestroyBuffer(Buffer* buffer);
+    void DestroyBufferView(BufferView* bufferView);
+    void DestroyDescriptorSetPool(DescriptorSetPool* descriptorSetPool);
+    void DestroyDescriptorSetLayout(DescriptorSetLayout* descriptorSetLayout);
+    void DestroyQueryPool(QueryPool* queryPool);
+    void DestroyEvent(Event* event);
+    void DestroyMemoryHeap(MemoryHeap* memoryHeap);
+    // host memory only, always destroyed right away
+    virtual void DestroyLoweredBarriers(LoweredBarriers* loweredBarriers) = 0;
 
     virtual bool ActivateFullscreen(Window* window) = 0;
 
@@ -81,5 +116,34 @@ public:
     virtual Queue* GetComputeQueue()  = 0;
     virtual Queue* GetTransferQueue() = 0;
 
+    virtual bool IsPipelineStatisticsQuerySupported() const = 0;
+    // samples the device timestamp counter together with Clock::Now(), used to move GPU timestamps into the CPU time domain
+    virtual bool GetCalibratedTimestamp(uint64_t* gpuTimestamp, uint64_t* cpuTimestamp) = 0;
+
     virtual void SetDebugObjectName(ObjectType type, void* object, const char* name) = 0;
+
+    // the queue has to outlive every Destroy call made while it is set, nullptr destroys right away again
+    void SetDeferredDestructionQueue(DeferredDestructionQueue* deferredDestructionQueue);
+
+protected:
+    virtual void DestroyGraphicsPipelineImmediate(GraphicsPipeline* pipeline)		       = 0;
+    virtual void DestroyComputePipelineImmediate(ComputePipeline* pipeline)		       = 0;
+    virtual void DestroyCommandPoolImmediate(CommandPool* commandPool)			       = 0;
+    virtual void DestroySemaphoreImmediate(Semaphore* semaphore)			       = 0;
+    virtual void DestroyImageImmediate(Image* image)					       = 0;
+    virtual void DestroyImageViewImmediate(ImageView* imageView)			       = 0;
+    virtual void DestroyBufferImmediate(Buffer* buffer)					       = 0;
+    virtual void DestroyBufferViewImmediate(BufferView* bufferView)			       = 0;
+    virtual void DestroyDescriptorSetPoolImmediate(DescriptorSetPool* descriptorSetPool)       = 0;
+    virtual void DestroyDescriptorSetLayoutImmediate(DescriptorSetLayout* descriptorSetLayout) = 0;
+    virtual void DestroyQueryPoolImmediate(QueryPool* queryPool)			       = 0;
+    virtual void DestroyEventImmediate(Event* event)					       = 0;
+    virtual void DestroyMemoryHeapImmediate(MemoryHeap* memoryHeap)			       = 0;
+
+private:
+    template<typename T, void (GraphicsAdapter::*DestroyImmediate)(T*)>
+    void DeferDestruction(T* object);
+
+private:
+    DeferredDestructionQueue* m_deferredDestructionQueue = nullptr;
 };
\ No newline at end of file
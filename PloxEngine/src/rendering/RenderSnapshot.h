@@ -0,0 +1,17 @@
+//
+// Created by Ploxie on 2023-06-05.
+//
+
+#pragma once
+#include <cstdint>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec3.hpp>
+
+// immutable copy of the simulation state a frame is rendered from
+struct RenderSnapshot
+{
+    uint64_t FrameIndex	     = 0;
+    float DeltaTime	     = 0.0f;
+    glm::quat CameraRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 CameraPosition = { 0, 0, 2.0f };
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+//
+// Created by Ploxie on 2023-06-05.
+//
+
+#include "RenderSnapshotQueue.h"
+#include "core/Assert.h"
+#include "utility/Utilities.h"
+
+RenderSnapshotQueue::RenderSnapshotQueue(uint32_t maxLatency) noexcept
+    : m_maxLatency(MIN(maxLatency, MAX_LATENCY))
+{
+}
+
+void RenderSnapshotQueue::SetMaxLatency(uint32_t maxLatency) noexcept
+{
+    {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_maxLatency = MIN(maxLatency, MAX_LATENCY);
+    }
+    m_writeCondition.notify_all();
+}
+
+uint32_t RenderSnapshotQueue::GetMaxLatency() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxLatency;
+}
+
+RenderSnapshot* RenderSnapshotQueue::BeginWrite() noexcept
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // m_readCount only advances once the consumer is done with a snapshot, so this also keeps the slot being written out of use
+    m_writeCondition.wait(lock, [this]()
+    {
+	return m_closed || m_writeCount - m_readCount <= m_maxLatency;
+    });
+
+    RenderSnapshot* snapshot = &m_snapshots[m_writeCount % SNAPSHOT_COUNT];
+    *snapshot		     = {};
+    snapshot->FrameIndex     = m_writeCount;
+
+    return snapshot;
+}
+
+void RenderSnapshotQueue::EndWrite() noexcept
+{
+    {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++m_writeCount;
+    }
+    m_readCondition.notify_one();
+}
+
+const RenderSnapshot* RenderSnapshotQueue::BeginRead() noexcept
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_readCondition.wait(lock, [this]()
+    {
+	return m_closed || m_readCount < m_writeCount;
+    });
+
+    // drain published snapshots before honouring close, so every simulated frame gets rendered
+    if(m_readCount == m_writeCount)
+    {
+	return nullptr;
+    }
+
+    return &m_snapshots[m_readCount % SNAPSHOT_COUNT];
+}
+
+void RenderSnapshotQueue::EndRead() noexcept
+{
+    {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	ASSERT(m_readCount < m_writeCount);
+	++m_readCount;
+    }
+    m_writeCondition.notify_one();
+}
+
+void RenderSnapshotQueue::Close() noexcept
+{
+    {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_closed = true;
+    }
+    m_readCondition.notify_all();
+    m_writeCondition.notify_all();
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+//
+// Created by Ploxie on 2023-06-05.
+//
+
+#pragma once
+#include "RenderSnapshot.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+class RenderSnapshotQueue
+{
+public:
+    static constexpr uint32_t SNAPSHOT_COUNT = 3;
+    static constexpr uint32_t MAX_LATENCY    = SNAPSHOT_COUNT - 1;
+
+public:
+    explicit RenderSnapshotQueue(uint32_t maxLatency = 1) noexcept;
+
+    RenderSnapshotQueue(const RenderSnapshotQueue&)		= delete;
+    RenderSnapshotQueue(const RenderSnapshotQueue&&)		= delete;
+    RenderSnapshotQueue& operator=(const RenderSnapshotQueue&)	= delete;
+    RenderSnapshotQueue& operator=(const RenderSnapshotQueue&&) = delete;
+
+    // number of frames the simulation may run ahead of rendering, 0 runs both stages in lock-step
+    void SetMaxLatency(uint32_t maxLatency) noexcept;
+    uint32_t GetMaxLatency() const noexcept;
+
+    // producer side, blocks while the simulation is too far ahead
+    RenderSnapshot* BeginWrite() noexcept;
+    void EndWrite() noexcept;
+
+    // consumer side, blocks until a snapshot is published and returns nullptr once the queue is closed
+    const RenderSnapshot* BeginRead() noexcept;
+    void EndRead() noexcept;
+
+    void Close() noexcept;
+
+private:
+    RenderSnapshot m_snapshots[SNAPSHOT_COUNT];
+    mutable std::mutex m_mutex;
+    std::condition_variable m_writeCondition;
+    std::condition_variable m_readCondition;
+    uint64_t m_writeCount = 0;
+    uint64_t m_readCount  = 0;
+    uint32_t m_maxLatency = 1;
+    bool m_closed	  = false;
+};
\ No newline at end of file
@@ -3,6 +3,9 @@
 //
 
 #include "Renderer.h"
+#include "core/Assert.h"
+#include "core/Profiler.h"
+#include "DeferredDestructionQueue.h"
 #include "platform/window/window.h"
 #include "rendergraph/Registry.h"
 #include "rendergraph/RenderGraph.h"
@@ -10,18 +13,22 @@
 #include "rendering/types/CommandPool.h"
 #include "renderview/RenderView.h"
 #include "ResourceViewRegistry.h"
+#include "StreamingUploader.h"
+#include "utility/ThreadPool.h"
 #include <glm/gtx/transform.hpp>
 
 #undef CreateSemaphore
 
 void Renderer::Initialize(Window* window, GraphicsBackendType backend)
 {
+    ASSERT(window || backend == GraphicsBackendType::HEADLESS);
+
     bool debugLayer   = true;
-    m_swapchainWidth  = window->GetWidth();
-    m_swapchainHeight = window->GetHeight();
+    m_swapchainWidth  = window ? window->GetWidth() : HEADLESS_WIDTH;
+    m_swapchainHeight = window ? window->GetHeight() : HEADLESS_HEIGHT;
 
-    m_graphicsAdapter = GraphicsAdapter::Create(window->GetRawHandle(), debugLayer, backend);
-    m_graphicsAdapter->CreateSwapchain(m_graphicsAdapter->GetGraphicsQueue(), window->GetWidth(), window->GetHeight(), window, PresentMode::IMMEDIATE, &m_swapchain);
+    m_graphicsAdapter = GraphicsAdapter::Create(window ? window->GetRawHandle() : nullptr, debugLayer, backend);
+    m_graphicsAdapter->CreateSwapchain(m_graphicsAdapter->GetGraphicsQueue(), m_swapchainWidth, m_swapchainHeight, window, PresentMode::IMMEDIATE, &m_swapchain);
 
     m_graphicsAdapter->CreateSemaphore(0, &m_semaphores[0]);
     m_graphicsAdapter->CreateSemaphore(0, &m_semaphores[1]);
@@ -45,26 +52,70 @@ void Renderer::Initialize(Window* window, GraphicsBackendType backend)
 	m_offsetBufferDescriptorSets[i]->Update(1, &update);
     }
 
+    // everything destroyed through the adapter from here on waits for the gpu to be done with it
+    m_deferredDestructionQueue = new DeferredDestructionQueue(m_graphicsAdapter, m_semaphores, m_semaphoreValues);
+    m_graphicsAdapter->SetDeferredDestructionQueue(m_deferredDestructionQueue);
+
+    m_threadPool   = new ThreadPool();
     m_viewRegistry = new ResourceViewRegistry(m_graphicsAdapter);
-    m_renderGraph  = new RenderGraph(m_graphicsAdapter, m_semaphores, m_semaphoreValues, m_viewRegistry);
-    m_renderView   = new RenderView(m_graphicsAdapter, m_viewRegistry, m_offsetBufferDescriptorSetLayout, m_swapchainWidth, m_swapchainHeight);
+    m_renderGraph  = new RenderGraph(m_graphicsAdapter, m_semaphores, m_semaphoreValues, m_viewRegistry, m_threadPool);
+    // shares the transfer queue semaphore with the render graph, which waits for the uploads through it
+    m_streamingUploader = new StreamingUploader(m_graphicsAdapter, m_semaphores[2], &m_semaphoreValues[2]);
+    m_renderView	= new RenderView(m_graphicsAdapter, m_viewRegistry, m_streamingUploader, m_offsetBufferDescriptorSetLayout, m_swapchainWidth, m_swapchainHeight);
 }
 
 void Renderer::Shutdown()
 {
+    // the render thread has stopped, wait for everything it submitted
+    for(size_t i = 0; i < 3; ++i)
+    {
+	m_semaphores[i]->Wait(m_semaphoreValues[i]);
+    }
+
+    delete m_renderView;
+    delete m_streamingUploader;
+    delete m_renderGraph;
+    delete m_viewRegistry;
+    delete m_threadPool;
+
+    m_graphicsAdapter->DestroyDescriptorSetPool(m_offsetBufferDescriptorSetPool);
+    m_graphicsAdapter->DestroyDescriptorSetLayout(m_offsetBufferDescriptorSetLayout);
+    m_graphicsAdapter->DestroyBuffer(m_mappableConstantBuffers[0]);
+    m_graphicsAdapter->DestroyBuffer(m_mappableConstantBuffers[1]);
+
+    // the queue waits on the semaphores, so they can only be destroyed once it is empty and detached from the adapter
+    m_deferredDestructionQueue->Flush();
+    m_graphicsAdapter->SetDeferredDestructionQueue(nullptr);
+    delete m_deferredDestructionQueue;
+
+    m_graphicsAdapter->DestroySemaphore(m_semaphores[0]);
+    m_graphicsAdapter->DestroySemaphore(m_semaphores[1]);
+    m_graphicsAdapter->DestroySemaphore(m_semaphores[2]);
+
+    // also destroys the swapchain
+    delete m_graphicsAdapter;
 }
 
-void Renderer::Render() noexcept
+void Renderer::Render(const RenderSnapshot& snapshot) noexcept
 {
+    PROFILE_FUNCTION();
+
+    Window* fullscreenWindow = m_pendingFullscreenWindow.exchange(nullptr);
+    if(fullscreenWindow)
+    {
+	m_graphicsAdapter->ActivateFullscreen(fullscreenWindow);
+    }
+
     m_renderGraph->NextFrame();
+    m_deferredDestructionQueue->Collect();
 
     RenderView::Data renderViewData = {};
     {
 	renderViewData.CameraData = {};
 	{
-	    renderViewData.CameraData.ViewMatrix       = glm::mat4_cast(glm::inverse(m_rotation)) * glm::translate(-m_position);
+	    renderViewData.CameraData.ViewMatrix       = glm::mat4_cast(glm::inverse(snapshot.CameraRotation)) * glm::translate(-snapshot.CameraPosition);
 	    renderViewData.CameraData.ProjectionMatrix = glm::perspective(1.57079632679f, 1.0f, 0.1f, 300.0f);
-	    renderViewData.CameraData.CameraPosition   = m_position;
+	    renderViewData.CameraData.CameraPosition   = snapshot.CameraPosition;
 	}
 	renderViewData.OffsetBufferSet = m_offsetBufferDescriptorSets[m_frame & 1];
 	renderViewData.ConstantBuffer  = m_mappableConstantBuffers[m_frame & 1];
@@ -72,7 +123,10 @@ void Renderer::Render() noexcept
 	renderViewData.FrameHeight     = m_swapchainHeight;
     }
 
-    m_renderView->Render(renderViewData, m_renderGraph);
+    {
+	PROFILE_ZONE("RenderView::Render");
+	m_renderView->Render(renderViewData, m_renderGraph);
+    }
 
     if(m_swapchainWidth != 0 && m_swapchainHeight != 0)
     {
@@ -104,11 +158,13 @@ void Renderer::Render() noexcept
 	});
     }
 
+    m_streamingUploader->Flush();
     m_viewRegistry->FlushChanges();
     m_renderGraph->Execute();
 
     if(m_swapchainWidth != 0 && m_swapchainHeight != 0)
     {
+	PROFILE_ZONE("Present");
 	m_swapchain->Present(m_semaphores[0], m_semaphoreValues[0], m_semaphores[0], m_semaphoreValues[0] + 1);
 	m_semaphoreValues[0]++;
     }
@@ -120,5 +176,6 @@ void Renderer::Render() noexcept
 
 bool Renderer::ActivateFullscreen(Window* window)
 {
-    return m_graphicsAdapter->ActivateFullscreen(window);
+    m_pendingFullscreenWindow.store(window);
+    return true;
 }
\ No newline at end of file
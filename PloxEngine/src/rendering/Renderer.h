@@ -3,32 +3,42 @@
 //
 
 #pragma once
+#include "EASTL/atomic.h"
 #include "GraphicsAdapter.h"
 #include "rendering/rendergraph/RenderGraph.h"
+#include "RenderSnapshot.h"
 #include "types/Semaphore.h"
 #include "types/Swapchain.h"
-#include <glm/gtc/quaternion.hpp>
-#include <glm/vec3.hpp>
 
 class Window;
 
 class CommandPool;
+class DeferredDestructionQueue;
 class Command;
 class RenderGraph;
 class ResourceViewRegistry;
 class RenderView;
+class StreamingUploader;
+class ThreadPool;
 
 class Renderer
 {
+public:
+    // swapchain size used when rendering without a window
+    static constexpr uint32_t HEADLESS_WIDTH  = 1280;
+    static constexpr uint32_t HEADLESS_HEIGHT = 720;
+
 public:
     explicit Renderer() = default;
     ~Renderer()		= default;
 
+    // window may be nullptr with the headless backend
     void Initialize(Window* window, GraphicsBackendType backend);
     void Shutdown();
 
-    void Render() noexcept;
+    void Render(const RenderSnapshot& snapshot) noexcept;
 
+    // deferred to the start of the next Render call, as rendering may run on its own thread
     bool ActivateFullscreen(Window* window);
 
 private:
@@ -40,16 +50,17 @@ private:
     unsigned int m_swapchainWidth  = 1;
     unsigned int m_swapchainHeight = 1;
 
+    ThreadPool* m_threadPool;
+    DeferredDestructionQueue* m_deferredDestructionQueue;
     RenderGraph* m_renderGraph;
     ResourceViewRegistry* m_viewRegistry;
     RenderView* m_renderView;
+    StreamingUploader* m_streamingUploader;
 
     DescriptorSetLayout* m_offsetBufferDescriptorSetLayout = nullptr;
     DescriptorSetPool* m_offsetBufferDescriptorSetPool	   = nullptr;
     DescriptorSet* m_offsetBufferDescriptorSets[2]	   = {};
     Buffer* m_mappableConstantBuffers[2]		   = {};
 
-    //CAMERA
-    glm::quat m_rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-    glm::vec3 m_position = { 0, 0, 2.0f };
+    eastl::atomic<Window*> m_pendingFullscreenWindow = nullptr;
 };
@@ -113,32 +113,32 @@ void ResourceViewRegistry::UpdateHandle(RWStructuredBufferViewHandle handle, con
 
 void ResourceViewRegistry::DestroyHandle(TextureViewHandle handle) noexcept
 {
-    DestroyHandle(m_textureHandleManager, handle, TEXTURE_BINDING);
+    DestroyHandle(m_textureHandleManager, m_textureHandleManagerMutex, handle, TEXTURE_BINDING);
 }
 
 void ResourceViewRegistry::DestroyHandle(RWTextureViewHandle handle) noexcept
 {
-    DestroyHandle(m_rwTextureHandleManager, handle, RW_TEXTURE_BINDING);
+    DestroyHandle(m_rwTextureHandleManager, m_rwTextureHandleManagerMutex, handle, RW_TEXTURE_BINDING);
 }
 
 void ResourceViewRegistry::DestroyHandle(TypedBufferViewHandle handle) noexcept
 {
-    DestroyHandle(m_typedBufferHandleManager, handle, TYPED_BUFFER_BINDING);
+    DestroyHandle(m_typedBufferHandleManager, m_typedBufferHandleManagerMutex, handle, TYPED_BUFFER_BINDING);
 }
 
 void ResourceViewRegistry::DestroyHandle(RWTypedBufferViewHandle handle) noexcept
 {
-    DestroyHandle(m_rwTypedBufferHandleManager, handle, RW_TYPED_BUFFER_BINDING);
+    DestroyHandle(m_rwTypedBufferHandleManager, m_rwTypedBufferHandleManagerMutex, handle, RW_TYPED_BUFFER_BINDING);
 }
 
 void ResourceViewRegistry::DestroyHandle(ByteBufferViewHandle handle) noexcept
 {
-    DestroyHandle(m_byteBufferHandleManager, handle, BYTE_BUFFER_BINDING);
+    DestroyHandle(m_byteBufferHandleManager, m_byteBufferHandleManagerMutex, handle, BYTE_BUFFER_BINDING);
 }
 
 void ResourceViewRegistry::DestroyHandle(RWByteBufferViewHandle handle) noexcept
 {
-    DestroyHandle(m_rwByteBufferHandleManager, handle, RW_BYTE_BUFFER_BINDING);
+    DestroyHandle(m_rwByteBufferHandleManager, m_rwByteBufferHandleManagerMutex, handle, RW_BYTE_BUFFER_BINDING);
 }
 
 void ResourceViewRegistry::DestroyHandle(StructuredBufferViewHandle handle) noexcept
@@ -164,6 +164,11 @@ void ResourceViewRegistry::FlushChanges() noexcept
 void ResourceViewRegistry::SwapSets() noexcept
 {
     m_textureHandleManager.FreeTransientHandles();
+    m_rwTextureHandleManager.FreeTransientHandles();
+    m_typedBufferHandleManager.FreeTransientHandles();
+    m_rwTypedBufferHandleManager.FreeTransientHandles();
+    m_byteBufferHandleManager.FreeTransientHandles();
+    m_rwByteBufferHandleManager.FreeTransientHandles();
     m_frame++;
 }
 
@@ -259,8 +264,18 @@ void ResourceViewRegistry::UpdateHandle(uint32_t handle, uint32_t binding, Descr
     AddUpdate(update, false);
 }
 
-void ResourceViewRegistry::DestroyHandle(HandleManager& manager, uint32_t handle, uint32_t binding)
+void ResourceViewRegistry::DestroyHandle(HandleManager& manager, SpinLock& managerMutex, uint32_t handle, uint32_t binding)
 {
+    if(!handle)
+    {
+	return;
+    }
+
+    {
+	SpinLockHolder lockHolder(managerMutex);
+	manager.Free(handle);
+    }
+
     for(size_t frame = 0; frame < 2; frame++)
     {
 	SpinLockHolder lockHolder(m_pendingUpdatesMutex[frame]);
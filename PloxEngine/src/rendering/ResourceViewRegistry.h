@@ -68,7 +68,7 @@ private:
     void AddUpdate(DescriptorSetUpdate& update, bool transient);
     uint32_t CreateHandle(HandleManager& manager, SpinLock& managerMutex, uint32_t binding, bool transient, DescriptorType descriptorType, ImageView* imageView, BufferView* bufferView, const DescriptorBufferInfo* bufferInfo);
     void UpdateHandle(uint32_t handle, uint32_t binding, DescriptorType descriptorType, ImageView* imageView, BufferView* bufferView, const DescriptorBufferInfo* bufferInfo);
-    void DestroyHandle(HandleManager& manager, uint32_t handle, uint32_t binding);
+    void DestroyHandle(HandleManager& manager, SpinLock& managerMutex, uint32_t handle, uint32_t binding);
 
 private:
     GraphicsAdapter* m_adapter		       = nullptr;
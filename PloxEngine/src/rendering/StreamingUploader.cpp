@@ -0,0 +1,279 @@
+//
+// Created by Ploxie on 2023-07-02.
+//
+#include "StreamingUploader.h"
+#include "core/Assert.h"
+#include "core/Profiler.h"
+#include "GraphicsAdapter.h"
+#include "rendering/rendergraph/RenderGraph.h"
+#include "rendering/types/CommandPool.h"
+#include "rendering/types/Queue.h"
+#include "rendering/types/Semaphore.h"
+#include "utility/Utilities.h"
+#include <cstring>
+
+StreamingUploader::StreamingUploader(GraphicsAdapter* adapter, Semaphore* semaphore, uint64_t* semaphoreValue, uint64_t stagingSize) noexcept
+    : m_adapter(adapter), m_queue(adapter->GetTransferQueue()), m_semaphore(semaphore), m_semaphoreValue(semaphoreValue), m_stagingSize(Util::AlignUp(stagingSize, STAGING_ALIGNMENT))
+{
+    BufferCreateInfo createInfo = {};
+    {
+	createInfo.Size	      = m_stagingSize;
+	createInfo.UsageFlags = BufferUsageFlags::TRANSFER_SRC_BIT;
+    }
+    m_adapter->CreateBuffer(createInfo, MemoryPropertyFlags::HOST_VISIBLE_BIT | MemoryPropertyFlags::HOST_COHERENT_BIT, {}, false, &m_stagingBuffer);
+    m_adapter->SetDebugObjectName(ObjectType::BUFFER, m_stagingBuffer, "Streaming Upload Staging Buffer");
+
+    // stays mapped for the lifetime of the uploader
+    m_stagingBuffer->Map((void**) &m_stagingData);
+}
+
+StreamingUploader::~StreamingUploader() noexcept
+{
+    // the adapter defers the destruction until the pending uploads are done, destroying a pool frees its commands
+    for(auto& submission: m_submissions)
+    {
+	if(submission.CommandPool)
+	{
+	    m_adapter->DestroyCommandPool(submission.CommandPool);
+	}
+    }
+
+    m_stagingBuffer->Unmap();
+    m_adapter->DestroyBuffer(m_stagingBuffer);
+}
+
+bool StreamingUploader::UploadBuffer(Buffer* buffer, uint64_t offset, uint64_t size, const void* data, ResourceStateData* resourceStateData) noexcept
+{
+    ASSERT(size != 0 && offset + size <= buffer->GetDescription().Size);
+
+    const uint64_t stagingOffset = AllocateStaging(size);
+    if(stagingOffset == UINT64_MAX)
+    {
+	++m_statistics.RejectedUploadCount;
+	return false;
+    }
+
+    memcpy(m_stagingData + stagingOffset, data, size);
+
+    PendingBufferCopy copy = {};
+    {
+	copy.Buffer    = buffer;
+	copy.Region    = { stagingOffset, offset, size };
+	copy.StateData = resourceStateData;
+    }
+    m_pendingBufferCopies.push_back(copy);
+
+    m_statistics.UploadedBytes += size;
+    return true;
+}
+
+bool StreamingUploader::UploadImage(Image* image, uint32_t regionCount, const BufferImageCopy* regions, uint64_t size, const void* data, ResourceStateData* resourceStateData) noexcept
+{
+    ASSERT(size != 0 && regionCount != 0);
+
+    const uint64_t stagingOffset = AllocateStaging(size);
+    if(stagingOffset == UINT64_MAX)
+    {
+	++m_statistics.RejectedUploadCount;
+	return false;
+    }
+
+    memcpy(m_stagingData + stagingOffset, data, size);
+
+    PendingImageCopy copy = {};
+    {
+	copy.Image	  = image;
+	copy.RegionOffset = static_cast<uint32_t>(m_pendingImageRegions.size());
+	copy.RegionCount  = regionCount;
+	copy.StateData	  = resourceStateData;
+    }
+    m_pendingImageCopies.push_back(copy);
+
+    for(uint32_t i = 0; i < regionCount; ++i)
+    {
+	ASSERT(regions[i].BufferOffset < size);
+	m_pendingImageRegions.push_back(regions[i]);
+	m_pendingImageRegions.back().BufferOffset += stagingOffset;
+    }
+
+    m_statistics.UploadedBytes += size;
+    return true;
+}
+
+void StreamingUploader::Flush() noexcept
+{
+    if(m_pendingBufferCopies.empty() && m_pendingImageCopies.empty())
+    {
+	return;
+    }
+
+    PROFILE_FUNCTION();
+
+    Retire();
+
+    // every submission is still in flight, the oldest one is the first to be done
+    if(m_submissionCount == MAX_PENDING_SUBMISSIONS)
+    {
+	m_semaphore->Wait(m_submissions[m_firstSubmission].SemaphoreValue);
+	Retire();
+    }
+
+    auto& submission = m_submissions[(m_firstSubmission + m_submissionCount) % MAX_PENDING_SUBMISSIONS];
+    if(!submission.CommandPool)
+    {
+	m_adapter->CreateCommandPool(m_queue, &submission.CommandPool);
+	submission.CommandPool->Allocate(1, &submission.Command);
+    }
+    else
+    {
+	submission.CommandPool->Reset();
+    }
+
+    Command* command = submission.Command;
+    command->Begin();
+
+    // the previous contents of the images are discarded, so they are transitioned without a queue ownership transfer
+    m_imageBarriers.clear();
+    for(const auto& copy: m_pendingImageCopies)
+    {
+	for(uint32_t i = 0; i < copy.RegionCount; ++i)
+	{
+	    const auto& region = m_pendingImageRegions[copy.RegionOffset + i];
+
+	    Barrier barrier = {};
+	    {
+		barrier.m_image			= copy.Image;
+		barrier.m_stagesBefore		= PipelineStageFlags::TOP_OF_PIPE_BIT;
+		barrier.m_stagesAfter		= PipelineStageFlags::TRANSFER_BIT;
+		barrier.m_stateBefore		= ResourceState::UNDEFINED;
+		barrier.m_stateAfter		= ResourceState::WRITE_TRANSFER;
+		barrier.m_srcQueue		= m_queue;
+		barrier.m_dstQueue		= m_queue;
+		barrier.m_imageSubresourceRange = { region.MipLevel, 1, region.BaseArrayLayer, region.LayerCount };
+	    }
+	    m_imageBarriers.push_back(barrier);
+	}
+    }
+    if(!m_imageBarriers.empty())
+    {
+	command->Barrier(static_cast<uint32_t>(m_imageBarriers.size()), m_imageBarriers.data());
+    }
+
+    for(const auto& copy: m_pendingBufferCopies)
+    {
+	command->CopyBuffer(m_stagingBuffer, copy.Buffer, 1, &copy.Region);
+    }
+    for(const auto& copy: m_pendingImageCopies)
+    {
+	command->CopyBufferToImage(m_stagingBuffer, copy.Image, copy.RegionCount, m_pendingImageRegions.data() + copy.RegionOffset);
+    }
+
+    command->End();
+
+    // no waits, the copies overlap whatever the other queues are doing
+    const uint64_t signalValue = ++(*m_semaphoreValue);
+    {
+	SubmitInfo submitInfo {};
+	submitInfo.CommandCount		= 1;
+	submitInfo.Commands		= &command;
+	submitInfo.SignalSemaphoreCount = 1;
+	submitInfo.SignalSemaphores	= &m_semaphore;
+	submitInfo.SignalValues		= &signalValue;
+
+	m_queue->Submit(1, &submitInfo);
+    }
+
+    submission.SemaphoreValue = signalValue;
+    submission.StagingEnd     = m_stagingHead;
+    ++m_submissionCount;
+    ++m_statistics.SubmissionCount;
+
+    // the render graph waits for the copies and transfers the ownership when the destinations are imported with these states
+    const ResourceStateAndStage transferState = { ResourceState::WRITE_TRANSFER, PipelineStageFlags::TRANSFER_BIT };
+    for(const auto& copy: m_pendingBufferCopies)
+    {
+	if(copy.StateData)
+	{
+	    copy.StateData->StateAndStage = transferState;
+	    copy.StateData->Queue	  = m_queue;
+	}
+    }
+    for(const auto& copy: m_pendingImageCopies)
+    {
+	if(!copy.StateData)
+	{
+	    continue;
+	}
+
+	const uint32_t levels = copy.Image->GetDescription().Levels;
+	for(uint32_t i = 0; i < copy.RegionCount; ++i)
+	{
+	    const auto& region = m_pendingImageRegions[copy.RegionOffset + i];
+	    for(uint32_t layer = region.BaseArrayLayer; layer < region.BaseArrayLayer + region.LayerCount; ++layer)
+	    {
+		auto& stateData		= copy.StateData[layer * levels + region.MipLevel];
+		stateData.StateAndStage = transferState;
+		stateData.Queue		= m_queue;
+	    }
+	}
+    }
+
+    m_pendingBufferCopies.clear();
+    m_pendingImageCopies.clear();
+    m_pendingImageRegions.clear();
+}
+
+void StreamingUploader::WaitIdle() noexcept
+{
+    if(m_submissionCount != 0)
+    {
+	const auto& lastSubmission = m_submissions[(m_firstSubmission + m_submissionCount - 1) % MAX_PENDING_SUBMISSIONS];
+	m_semaphore->Wait(lastSubmission.SemaphoreValue);
+    }
+    Retire();
+}
+
+const StreamingUploaderStatistics& StreamingUploader::GetStatistics() const noexcept
+{
+    return m_statistics;
+}
+
+uint64_t StreamingUploader::AllocateStaging(uint64_t size) noexcept
+{
+    const uint64_t alignedSize = Util::AlignUp(size, STAGING_ALIGNMENT);
+    if(alignedSize > m_stagingSize)
+    {
+	return UINT64_MAX;
+    }
+
+    // allocations never wrap around, the rest of the ring is skipped instead
+    uint64_t begin	  = m_stagingHead;
+    const uint64_t offset = begin % m_stagingSize;
+    if(offset + alignedSize > m_stagingSize)
+    {
+	begin += m_stagingSize - offset;
+    }
+
+    if(begin + alignedSize - m_stagingTail > m_stagingSize)
+    {
+	Retire();
+	if(begin + alignedSize - m_stagingTail > m_stagingSize)
+	{
+	    return UINT64_MAX;
+	}
+    }
+
+    m_stagingHead = begin + alignedSize;
+    return begin % m_stagingSize;
+}
+
+void StreamingUploader::Retire() noexcept
+{
+    const uint64_t completedValue = m_semaphore->GetCompletedValue();
+    while(m_submissionCount != 0 && m_submissions[m_firstSubmission].SemaphoreValue <= completedValue)
+    {
+	m_stagingTail	  = m_submissions[m_firstSubmission].StagingEnd;
+	m_firstSubmission = (m_firstSubmission + 1) % MAX_PENDING_SUBMISSIONS;
+	--m_submissionCount;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+//
+// Created by Ploxie on 2023-07-02.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/Barrier.h"
+#include "rendering/types/Buffer.h"
+#include "rendering/types/Image.h"
+#include <cstdint>
+
+class GraphicsAdapter;
+class Semaphore;
+class Queue;
+class CommandPool;
+class Command;
+struct ResourceStateData;
+
+struct StreamingUploaderStatistics
+{
+    uint64_t UploadedBytes;
+    uint64_t SubmissionCount;
+    // uploads that did not fit into the staging ring and have to be retried by the caller
+    uint64_t RejectedUploadCount;
+};
+
+// copies data into device local buffers and images on the transfer queue.
+// the data goes through a persistently mapped staging ring, which is reclaimed once the transfer semaphore passed the value of the submission that used it.
+// the semaphore is shared with the render graph, so importing the destination with the resource state data written by Flush
+// makes the graph wait for the copy and hand the resource over to the queue using it.
+class StreamingUploader
+{
+public:
+    static constexpr uint64_t DEFAULT_STAGING_SIZE = 1024 * 1024 * 16;
+
+public:
+    explicit StreamingUploader(GraphicsAdapter* adapter, Semaphore* semaphore, uint64_t* semaphoreValue, uint64_t stagingSize = DEFAULT_STAGING_SIZE) noexcept;
+    ~StreamingUploader() noexcept;
+
+    StreamingUploader(const StreamingUploader&)		    = delete;
+    StreamingUploader(const StreamingUploader&&)	    = delete;
+    StreamingUploader& operator=(const StreamingUploader&)  = delete;
+    StreamingUploader& operator=(const StreamingUploader&&) = delete;
+
+    // the destination must not be in use on the gpu until the upload was submitted.
+    // returns false if the staging ring is full, the upload should be retried after a later Flush
+    bool UploadBuffer(Buffer* buffer, uint64_t offset, uint64_t size, const void* data, ResourceStateData* resourceStateData) noexcept;
+    // the BufferOffset of the regions is relative to data. previous contents of the touched subresources are discarded,
+    // resourceStateData has one entry per subresource, indexed by layer * levels + level
+    bool UploadImage(Image* image, uint32_t regionCount, const BufferImageCopy* regions, uint64_t size, const void* data, ResourceStateData* resourceStateData) noexcept;
+
+    // records and submits the queued copies, has to happen before the render graph using the destinations is executed
+    void Flush() noexcept;
+    // blocks until everything submitted so far has completed on the gpu
+    void WaitIdle() noexcept;
+
+    const StreamingUploaderStatistics& GetStatistics() const noexcept;
+
+private:
+    static constexpr uint64_t STAGING_ALIGNMENT	      = 16;
+    static constexpr uint32_t MAX_PENDING_SUBMISSIONS = 8;
+
+    struct PendingBufferCopy
+    {
+	Buffer* Buffer;
+	BufferCopy Region;
+	ResourceStateData* StateData;
+    };
+
+    struct PendingImageCopy
+    {
+	Image* Image;
+	uint32_t RegionOffset;
+	uint32_t RegionCount;
+	ResourceStateData* StateData;
+    };
+
+    struct Submission
+    {
+	CommandPool* CommandPool = nullptr;
+	Command* Command	 = nullptr;
+	uint64_t SemaphoreValue	 = 0;
+	// position of the staging ring head once the submission was recorded
+	uint64_t StagingEnd = 0;
+    };
+
+    // returns the offset into the staging buffer or UINT64_MAX if there is not enough space
+    uint64_t AllocateStaging(uint64_t size) noexcept;
+    void Retire() noexcept;
+
+private:
+    GraphicsAdapter* m_adapter;
+    Queue* m_queue;
+    Semaphore* m_semaphore;
+    uint64_t* m_semaphoreValue;
+
+    Buffer* m_stagingBuffer = nullptr;
+    uint8_t* m_stagingData  = nullptr;
+    uint64_t m_stagingSize  = 0;
+    // ever increasing, the ring offset is the position modulo the staging size
+    uint64_t m_stagingHead = 0;
+    uint64_t m_stagingTail = 0;
+
+    eastl::vector<PendingBufferCopy> m_pendingBufferCopies;
+    eastl::vector<PendingImageCopy> m_pendingImageCopies;
+    eastl::vector<BufferImageCopy> m_pendingImageRegions;
+    eastl::vector<Barrier> m_imageBarriers;
+
+    Submission m_submissions[MAX_PENDING_SUBMISSIONS];
+    uint32_t m_firstSubmission = 0;
+    uint32_t m_submissionCount = 0;
+
+    StreamingUploaderStatistics m_statistics = {};
+};
\ No newline at end of file
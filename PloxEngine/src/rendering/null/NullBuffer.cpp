@@ -0,0 +1,85 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullBuffer.h"
+#include "core/Assert.h"
+#include <cstdlib>
+
+NullBuffer::NullBuffer(const BufferCreateInfo& createInfo)
+    : m_description(createInfo)
+{
+}
+
+NullBuffer::~NullBuffer()
+{
+    free(m_data);
+}
+
+void* NullBuffer::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const BufferCreateInfo& NullBuffer::GetDescription() const
+{
+    return m_description;
+}
+
+void NullBuffer::Map(void** data)
+{
+    if(!m_data)
+    {
+	m_data = calloc(1, m_description.Size);
+	ASSERT(m_data);
+    }
+    *data = m_data;
+}
+
+void NullBuffer::Unmap()
+{
+}
+
+void NullBuffer::Invalidate(uint32_t /*count*/, const MemoryRange* /*ranges*/)
+{
+}
+
+void NullBuffer::Flush(uint32_t /*count*/, const MemoryRange* /*ranges*/)
+{
+}
+
+void NullBuffer::BindMemory(MemoryHeap* memoryHeap, uint64_t offset)
+{
+    ASSERT(!m_memoryHeap);
+    m_memoryHeap   = memoryHeap;
+    m_memoryOffset = offset;
+}
+
+MemoryHeap* NullBuffer::GetMemoryHeap() const
+{
+    return m_memoryHeap;
+}
+
+uint64_t NullBuffer::GetMemoryOffset() const
+{
+    return m_memoryOffset;
+}
+
+NullBufferView::NullBufferView(const BufferViewCreateInfo& createInfo)
+    : m_description(createInfo)
+{
+}
+
+void* NullBufferView::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const Buffer* NullBufferView::GetBuffer() const
+{
+    return m_description.Buffer;
+}
+
+const BufferViewCreateInfo& NullBufferView::GetDescription() const
+{
+    return m_description;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "rendering/types/Buffer.h"
+#include "rendering/types/BufferView.h"
+
+class MemoryHeap;
+
+class NullBuffer : public Buffer
+{
+public:
+    explicit NullBuffer(const BufferCreateInfo& createInfo);
+    ~NullBuffer() override;
+
+    NullBuffer(NullBuffer&)		      = delete;
+    NullBuffer(NullBuffer&&)		      = delete;
+    NullBuffer& operator=(const NullBuffer&)  = delete;
+    NullBuffer& operator=(const NullBuffer&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const BufferCreateInfo& GetDescription() const override;
+    // the memory is allocated on the first Map and stays until the buffer is destroyed
+    void Map(void** data) override;
+    void Unmap() override;
+    void Invalidate(uint32_t count, const MemoryRange* ranges) override;
+    void Flush(uint32_t count, const MemoryRange* ranges) override;
+
+    void BindMemory(MemoryHeap* memoryHeap, uint64_t offset);
+    // nullptr if the buffer has its own memory
+    MemoryHeap* GetMemoryHeap() const;
+    uint64_t GetMemoryOffset() const;
+
+private:
+    BufferCreateInfo m_description;
+    void* m_data	     = nullptr;
+    MemoryHeap* m_memoryHeap = nullptr;
+    uint64_t m_memoryOffset  = 0;
+};
+
+class NullBufferView : public BufferView
+{
+public:
+    explicit NullBufferView(const BufferViewCreateInfo& createInfo);
+
+    NullBufferView(NullBufferView&)		      = delete;
+    NullBufferView(NullBufferView&&)		      = delete;
+    NullBufferView& operator=(const NullBufferView&)  = delete;
+    NullBufferView& operator=(const NullBufferView&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const Buffer* GetBuffer() const override;
+    const BufferViewCreateInfo& GetDescription() const override;
+
+private:
+    BufferViewCreateInfo m_description;
+};
\ No newline at end of file
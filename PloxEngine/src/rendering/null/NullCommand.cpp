@@ -0,0 +1,354 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullCommand.h"
+#include "core/Assert.h"
+#include "NullLoweredBarriers.h"
+#include "utility/Utilities.h"
+#include <cstring>
+
+void* NullCommand::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+void NullCommand::Begin()
+{
+    ASSERT(!m_recording);
+    m_records.clear();
+    m_data.clear();
+    m_recording = true;
+}
+
+void NullCommand::End()
+{
+    ASSERT(m_recording);
+    m_recording = false;
+}
+
+void NullCommand::BindPipeline(const GraphicsPipeline* pipeline)
+{
+    Record(NullCommandType::BIND_GRAPHICS_PIPELINE, pipeline);
+}
+
+void NullCommand::BindPipeline(const ComputePipeline* pipeline)
+{
+    Record(NullCommandType::BIND_COMPUTE_PIPELINE, pipeline);
+}
+
+void NullCommand::SetViewports(uint32_t firstViewport, uint32_t viewportCount, const Viewport* viewports)
+{
+    auto& record	= Record(NullCommandType::SET_VIEWPORTS);
+    record.Arguments[0] = firstViewport;
+    record.Arguments[1] = viewportCount;
+    RecordData(viewports, sizeof(Viewport) * viewportCount);
+}
+
+void NullCommand::SetScissors(uint32_t firstScissor, uint32_t scissorCount, const Rect* scissors)
+{
+    auto& record	= Record(NullCommandType::SET_SCISSORS);
+    record.Arguments[0] = firstScissor;
+    record.Arguments[1] = scissorCount;
+    RecordData(scissors, sizeof(Rect) * scissorCount);
+}
+
+void NullCommand::SetLineWidth(float lineWidth)
+{
+    Record(NullCommandType::SET_LINE_WIDTH);
+    RecordData(&lineWidth, sizeof(lineWidth));
+}
+
+void NullCommand::SetDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor)
+{
+    const float values[] = { depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor };
+
+    Record(NullCommandType::SET_DEPTH_BIAS);
+    RecordData(values, sizeof(values));
+}
+
+void NullCommand::SetBlendConstants(const float blendConstants[4])
+{
+    Record(NullCommandType::SET_BLEND_CONSTANTS);
+    RecordData(blendConstants, sizeof(float) * 4);
+}
+
+void NullCommand::SetDepthBounds(float minDepthBounds, float maxDepthBounds)
+{
+    const float values[] = { minDepthBounds, maxDepthBounds };
+
+    Record(NullCommandType::SET_DEPTH_BOUNDS);
+    RecordData(values, sizeof(values));
+}
+
+void NullCommand::SetStencilCompareMask(StencilFaceFlags faceMask, uint32_t compareMask)
+{
+    auto& record	= Record(NullCommandType::SET_STENCIL_COMPARE_MASK);
+    record.Arguments[0] = static_cast<uint64_t>(faceMask);
+    record.Arguments[1] = compareMask;
+}
+
+void NullCommand::SetStencilWriteMask(StencilFaceFlags faceMask, uint32_t writeMask)
+{
+    auto& record	= Record(NullCommandType::SET_STENCIL_WRITE_MASK);
+    record.Arguments[0] = static_cast<uint64_t>(faceMask);
+    record.Arguments[1] = writeMask;
+}
+
+void NullCommand::SetStencilReference(StencilFaceFlags faceMask, uint32_t reference)
+{
+    auto& record	= Record(NullCommandType::SET_STENCIL_REFERENCE);
+    record.Arguments[0] = static_cast<uint64_t>(faceMask);
+    record.Arguments[1] = reference;
+}
+
+void NullCommand::BindDescriptorSets(const GraphicsPipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)
+{
+    auto& record	= Record(NullCommandType::BIND_GRAPHICS_DESCRIPTOR_SETS, pipeline);
+    record.Arguments[0] = firstSet;
+    record.Arguments[1] = count;
+    record.Arguments[2] = offsetCount;
+    RecordData(sets, sizeof(DescriptorSet*) * count);
+    RecordData(offsets, sizeof(uint32_t) * offsetCount);
+}
+
+void NullCommand::BindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)
+{
+    auto& record	= Record(NullCommandType::BIND_COMPUTE_DESCRIPTOR_SETS, pipeline);
+    record.Arguments[0] = firstSet;
+    record.Arguments[1] = count;
+    record.Arguments[2] = offsetCount;
+    RecordData(sets, sizeof(DescriptorSet*) * count);
+    RecordData(offsets, sizeof(uint32_t) * offsetCount);
+}
+
+void NullCommand::BindIndexBuffer(const Buffer* buffer, uint64_t offset, IndexType indexType)
+{
+    auto& record	= Record(NullCommandType::BIND_INDEX_BUFFER, buffer);
+    record.Arguments[0] = offset;
+    record.Arguments[1] = static_cast<uint64_t>(indexType);
+}
+
+void NullCommand::BindVertexBuffers(uint32_t firstBinding, uint32_t count, const Buffer* const* buffers, uint64_t* offsets)
+{
+    auto& record	= Record(NullCommandType::BIND_VERTEX_BUFFERS);
+    record.Arguments[0] = firstBinding;
+    record.Arguments[1] = count;
+    RecordData(buffers, sizeof(Buffer*) * count);
+    RecordData(offsets, sizeof(uint64_t) * count);
+}
+
+void NullCommand::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    auto& record	= Record(NullCommandType::DRAW);
+    record.Arguments[0] = vertexCount;
+    record.Arguments[1] = instanceCount;
+    record.Arguments[2] = firstVertex;
+    record.Arguments[3] = firstInstance;
+}
+
+void NullCommand::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    auto& record	= Record(NullCommandType::DRAW_INDEXED);
+    record.Arguments[0] = indexCount;
+    record.Arguments[1] = instanceCount;
+    record.Arguments[2] = firstIndex;
+    record.Arguments[3] = static_cast<uint64_t>(static_cast<int64_t>(vertexOffset));
+    record.Arguments[4] = firstInstance;
+}
+
+void NullCommand::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    auto& record	= Record(NullCommandType::DISPATCH);
+    record.Arguments[0] = groupCountX;
+    record.Arguments[1] = groupCountY;
+    record.Arguments[2] = groupCountZ;
+}
+
+void NullCommand::DispatchIndirect(const Buffer* buffer, uint64_t offset)
+{
+    auto& record	= Record(NullCommandType::DISPATCH_INDIRECT, buffer);
+    record.Arguments[0] = offset;
+}
+
+void NullCommand::CopyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions)
+{
+    auto& record	= Record(NullCommandType::COPY_BUFFER, srcBuffer, dstBuffer);
+    record.Arguments[0] = regionCount;
+    RecordData(regions, sizeof(BufferCopy) * regionCount);
+}
+
+void NullCommand::CopyImage(const Image* srcImage, const Image* dstImage, uint32_t regionCount, const ImageCopy* regions)
+{
+    auto& record	= Record(NullCommandType::COPY_IMAGE, srcImage, dstImage);
+    record.Arguments[0] = regionCount;
+    RecordData(regions, sizeof(ImageCopy) * regionCount);
+}
+
+void NullCommand::CopyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions)
+{
+    auto& record	= Record(NullCommandType::COPY_BUFFER_TO_IMAGE, srcBuffer, dstImage);
+    record.Arguments[0] = regionCount;
+    RecordData(regions, sizeof(BufferImageCopy) * regionCount);
+}
+
+void NullCommand::UpdateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data)
+{
+    ASSERT(dataSize % 4 == 0 && dataSize <= 65536);
+
+    auto& record	= Record(NullCommandType::UPDATE_BUFFER, dstBuffer);
+    record.Arguments[0] = dstOffset;
+    record.Arguments[1] = dataSize;
+    RecordData(data, dataSize);
+}
+
+void NullCommand::ClearColorImage(const Image* image, const ClearColorValue* color, uint32_t rangeCount, const ImageSubresourceRange* ranges)
+{
+    auto& record	= Record(NullCommandType::CLEAR_COLOR_IMAGE, image);
+    record.Arguments[0] = rangeCount;
+    RecordData(color, sizeof(ClearColorValue));
+    RecordData(ranges, sizeof(ImageSubresourceRange) * rangeCount);
+}
+
+void NullCommand::ClearDepthStencilImage(const Image* image, const ClearDepthStencilValue* depthStencil, uint32_t rangeCount, const ImageSubresourceRange* ranges)
+{
+    auto& record	= Record(NullCommandType::CLEAR_DEPTH_STENCIL_IMAGE, image);
+    record.Arguments[0] = rangeCount;
+    RecordData(depthStencil, sizeof(ClearDepthStencilValue));
+    RecordData(ranges, sizeof(ImageSubresourceRange) * rangeCount);
+}
+
+void NullCommand::Barrier(uint32_t count, const class Barrier* barriers)
+{
+    auto& record	= Record(NullCommandType::BARRIER);
+    record.Arguments[0] = count;
+    RecordData(barriers, sizeof(class Barrier) * count);
+}
+
+void NullCommand::Barrier(const LoweredBarriers* loweredBarriers, uint32_t group)
+{
+    const auto* loweredBarriersNull = dynamic_cast<const NullLoweredBarriers*>(loweredBarriers);
+    ASSERT(loweredBarriersNull);
+
+    Barrier(loweredBarriersNull->GetBarrierCount(group), loweredBarriersNull->GetBarriers(group));
+}
+
+void NullCommand::BeginQuery(const QueryPool* queryPool, uint32_t query)
+{
+    auto& record	= Record(NullCommandType::BEGIN_QUERY, queryPool);
+    record.Arguments[0] = query;
+}
+
+void NullCommand::EndQuery(const QueryPool* queryPool, uint32_t query)
+{
+    auto& record	= Record(NullCommandType::END_QUERY, queryPool);
+    record.Arguments[0] = query;
+}
+
+void NullCommand::ResetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+    auto& record	= Record(NullCommandType::RESET_QUERY_POOL, queryPool);
+    record.Arguments[0] = firstQuery;
+    record.Arguments[1] = queryCount;
+}
+
+void NullCommand::WriteTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query)
+{
+    auto& record	= Record(NullCommandType::WRITE_TIMESTAMP, queryPool);
+    record.Arguments[0] = static_cast<uint64_t>(pipelineStage);
+    record.Arguments[1] = query;
+}
+
+void NullCommand::CopyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset)
+{
+    auto& record	= Record(NullCommandType::COPY_QUERY_POOL_RESULTS, queryPool, dstBuffer);
+    record.Arguments[0] = firstQuery;
+    record.Arguments[1] = queryCount;
+    record.Arguments[2] = dstOffset;
+}
+
+void NullCommand::PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    auto& record	= Record(NullCommandType::GRAPHICS_PUSH_CONSTANTS, pipeline);
+    record.Arguments[0] = static_cast<uint64_t>(stageFlags);
+    record.Arguments[1] = offset;
+    record.Arguments[2] = size;
+    RecordData(values, size);
+}
+
+void NullCommand::PushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    auto& record	= Record(NullCommandType::COMPUTE_PUSH_CONSTANTS, pipeline);
+    record.Arguments[0] = static_cast<uint64_t>(stageFlags);
+    record.Arguments[1] = offset;
+    record.Arguments[2] = size;
+    RecordData(values, size);
+}
+
+void NullCommand::BeginRenderPass(uint32_t colorAttachmentCount, ColorAttachmentDescription* colorAttachments, DepthStencilAttachmentDescription* depthStencilAttachment, const Rect& renderArea, bool rwTextureBufferAccess)
+{
+    auto& record	= Record(NullCommandType::BEGIN_RENDER_PASS);
+    record.Arguments[0] = colorAttachmentCount;
+    record.Arguments[1] = depthStencilAttachment != nullptr;
+    record.Arguments[2] = rwTextureBufferAccess;
+    RecordData(colorAttachments, sizeof(ColorAttachmentDescription) * colorAttachmentCount);
+    RecordData(depthStencilAttachment, depthStencilAttachment ? sizeof(DepthStencilAttachmentDescription) : 0);
+    RecordData(&renderArea, sizeof(Rect));
+}
+
+void NullCommand::EndRenderPass()
+{
+    Record(NullCommandType::END_RENDER_PASS);
+}
+
+const eastl::vector<NullCommandRecord>& NullCommand::GetRecords() const
+{
+    return m_records;
+}
+
+const void* NullCommand::GetData(const NullCommandRecord& record) const
+{
+    return record.DataSize != 0 ? m_data.data() + record.DataOffset : nullptr;
+}
+
+bool NullCommand::IsRecording() const
+{
+    return m_recording;
+}
+
+void NullCommand::Reset()
+{
+    m_recording = false;
+}
+
+NullCommandRecord& NullCommand::Record(NullCommandType type, const void* object0, const void* object1)
+{
+    ASSERT(m_recording);
+
+    // the data of every record starts aligned for any of the structs copied into it
+    m_data.resize(Util::AlignUp(m_data.size(), alignof(uint64_t)));
+
+    NullCommandRecord record = {};
+    {
+	record.Type	  = type;
+	record.Objects[0] = object0;
+	record.Objects[1] = object1;
+	record.DataOffset = static_cast<uint32_t>(m_data.size());
+    }
+    m_records.push_back(record);
+
+    return m_records.back();
+}
+
+void NullCommand::RecordData(const void* data, size_t size)
+{
+    if(size == 0)
+    {
+	return;
+    }
+
+    const size_t offset = m_data.size();
+    m_data.resize(offset + size);
+    memcpy(m_data.data() + offset, data, size);
+
+    m_records.back().DataSize += static_cast<uint32_t>(size);
+}
\ No newline at end of file
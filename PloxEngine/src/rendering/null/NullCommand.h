@@ -0,0 +1,123 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/Command.h"
+
+enum class NullCommandType
+{
+    BIND_GRAPHICS_PIPELINE,
+    BIND_COMPUTE_PIPELINE,
+    SET_VIEWPORTS,
+    SET_SCISSORS,
+    SET_LINE_WIDTH,
+    SET_DEPTH_BIAS,
+    SET_BLEND_CONSTANTS,
+    SET_DEPTH_BOUNDS,
+    SET_STENCIL_COMPARE_MASK,
+    SET_STENCIL_WRITE_MASK,
+    SET_STENCIL_REFERENCE,
+    BIND_GRAPHICS_DESCRIPTOR_SETS,
+    BIND_COMPUTE_DESCRIPTOR_SETS,
+    BIND_INDEX_BUFFER,
+    BIND_VERTEX_BUFFERS,
+    DRAW,
+    DRAW_INDEXED,
+    DISPATCH,
+    DISPATCH_INDIRECT,
+    COPY_BUFFER,
+    COPY_IMAGE,
+    COPY_BUFFER_TO_IMAGE,
+    UPDATE_BUFFER,
+    CLEAR_COLOR_IMAGE,
+    CLEAR_DEPTH_STENCIL_IMAGE,
+    BARRIER,
+    BEGIN_QUERY,
+    END_QUERY,
+    RESET_QUERY_POOL,
+    WRITE_TIMESTAMP,
+    COPY_QUERY_POOL_RESULTS,
+    GRAPHICS_PUSH_CONSTANTS,
+    COMPUTE_PUSH_CONSTANTS,
+    BEGIN_RENDER_PASS,
+    END_RENDER_PASS,
+};
+
+// one recorded call. Objects are the pipeline, buffer, image or query pool it works on, the source before the destination.
+// Arguments are its integer arguments in the order they are passed, everything else (arrays, floats, structs) is copied to
+// GetData(record) in the order it is passed
+struct NullCommandRecord
+{
+    NullCommandType Type;
+    const void* Objects[2];
+    uint64_t Arguments[5];
+    uint32_t DataOffset;
+    uint32_t DataSize;
+};
+
+// records the calls into an inspectable stream, nothing is executed
+class NullCommand : public Command
+{
+public:
+    explicit NullCommand() = default;
+
+    void* GetNativeHandle() const override;
+    void Begin() override;
+    void End() override;
+    void BindPipeline(const GraphicsPipeline* pipeline) override;
+    void BindPipeline(const ComputePipeline* pipeline) override;
+    void SetViewports(uint32_t firstViewport, uint32_t viewportCount, const Viewport* viewports) override;
+    void SetScissors(uint32_t firstScissor, uint32_t scissorCount, const Rect* scissors) override;
+    void SetLineWidth(float lineWidth) override;
+    void SetDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) override;
+    void SetBlendConstants(const float blendConstants[4]) override;
+    void SetDepthBounds(float minDepthBounds, float maxDepthBounds) override;
+    void SetStencilCompareMask(StencilFaceFlags faceMask, uint32_t compareMask) override;
+    void SetStencilWriteMask(StencilFaceFlags faceMask, uint32_t writeMask) override;
+    void SetStencilReference(StencilFaceFlags faceMask, uint32_t reference) override;
+    void BindDescriptorSets(const GraphicsPipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets) override;
+    void BindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets) override;
+    void BindIndexBuffer(const Buffer* buffer, uint64_t offset, IndexType indexType) override;
+    void BindVertexBuffers(uint32_t firstBinding, uint32_t count, const Buffer* const* buffers, uint64_t* offsets) override;
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+    void DispatchIndirect(const Buffer* buffer, uint64_t offset) override;
+    void CopyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions) override;
+    void CopyImage(const Image* srcImage, const Image* dstImage, uint32_t regionCount, const ImageCopy* regions) override;
+    void CopyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions) override;
+    void UpdateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data) override;
+    void ClearColorImage(const Image* image, const ClearColorValue* color, uint32_t rangeCount, const ImageSubresourceRange* ranges) override;
+    void ClearDepthStencilImage(const Image* image, const ClearDepthStencilValue* depthStencil, uint32_t rangeCount, const ImageSubresourceRange* ranges) override;
+    void Barrier(uint32_t count, const class Barrier* barriers) override;
+    // recorded as the barriers it was lowered from
+    void Barrier(const LoweredBarriers* loweredBarriers, uint32_t group) override;
+    void BeginQuery(const QueryPool* queryPool, uint32_t query) override;
+    void EndQuery(const QueryPool* queryPool, uint32_t query) override;
+    void ResetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount) override;
+    void WriteTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query) override;
+    void CopyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset) override;
+    void PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values) override;
+    void PushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values) override;
+    void BeginRenderPass(uint32_t colorAttachmentCount, ColorAttachmentDescription* colorAttachments, DepthStencilAttachmentDescription* depthStencilAttachment, const Rect& renderArea, bool rwTextureBufferAccess) override;
+    void EndRenderPass() override;
+
+    // the stream is cleared by Begin and complete once End was called
+    const eastl::vector<NullCommandRecord>& GetRecords() const;
+    const void* GetData(const NullCommandRecord& record) const;
+    bool IsRecording() const;
+    // called when the pool is reset, the stream is kept until the next Begin
+    void Reset();
+
+private:
+    NullCommandRecord& Record(NullCommandType type, const void* object0 = nullptr, const void* object1 = nullptr);
+    // appends to the data of the last record
+    void RecordData(const void* data, size_t size);
+
+private:
+    eastl::vector<NullCommandRecord> m_records;
+    eastl::vector<uint8_t> m_data;
+    bool m_recording = false;
+};
\ No newline at end of file
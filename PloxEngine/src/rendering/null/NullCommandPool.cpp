@@ -0,0 +1,68 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullCommandPool.h"
+#include "core/Assert.h"
+#include "EASTL/algorithm.h"
+
+NullCommandPool::NullCommandPool(const NullQueue& queue)
+    : m_queue(queue), m_commandMemoryPool(sizeof(NullCommand), 32, "NullCommand Pool Allocator")
+{
+}
+
+NullCommandPool::~NullCommandPool()
+{
+    for(auto* command: m_liveCommands)
+    {
+	ALLOC_DELETE(&m_commandMemoryPool, command);
+    }
+
+    m_liveCommands.clear();
+}
+
+void* NullCommandPool::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+void NullCommandPool::Allocate(uint32_t count, Command** commands)
+{
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	auto* command = ALLOC_NEW(&m_commandMemoryPool, NullCommand)();
+	commands[i]   = command;
+
+	m_liveCommands.push_back(command);
+    }
+}
+
+void NullCommandPool::Free(uint32_t count, Command** commands)
+{
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	auto* command = dynamic_cast<NullCommand*>(commands[i]);
+	ASSERT(command);
+
+	auto* it = eastl::find(m_liveCommands.begin(), m_liveCommands.end(), command);
+	if(it != m_liveCommands.end())
+	{
+	    eastl::swap(m_liveCommands.back(), *it);
+	    m_liveCommands.erase(m_liveCommands.end() - 1);
+	}
+
+	ALLOC_DELETE(&m_commandMemoryPool, command);
+    }
+}
+
+void NullCommandPool::Reset()
+{
+    for(auto* command: m_liveCommands)
+    {
+	command->Reset();
+    }
+}
+
+const NullQueue& NullCommandPool::GetQueue() const
+{
+    return m_queue;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "EASTL/fixed_vector.h"
+#include "NullCommand.h"
+#include "rendering/types/CommandPool.h"
+#include "utility/memory/PoolAllocator.h"
+
+class NullQueue;
+
+class NullCommandPool : public CommandPool
+{
+public:
+    explicit NullCommandPool(const NullQueue& queue);
+    NullCommandPool(NullCommandPool&)			= delete;
+    NullCommandPool(NullCommandPool&&)			= delete;
+    NullCommandPool& operator=(const NullCommandPool&)	= delete;
+    NullCommandPool& operator=(const NullCommandPool&&) = delete;
+    ~NullCommandPool() override;
+
+    void* GetNativeHandle() const override;
+    void Allocate(uint32_t count, Command** commands) override;
+    void Free(uint32_t count, Command** commands) override;
+    void Reset() override;
+
+    const NullQueue& GetQueue() const;
+
+private:
+    const NullQueue& m_queue;
+    DynamicPoolAllocator m_commandMemoryPool;
+    eastl::fixed_vector<NullCommand*, 32> m_liveCommands;
+};
\ No newline at end of file
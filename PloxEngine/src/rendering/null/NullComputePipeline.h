@@ -0,0 +1,26 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "rendering/types/ComputePipeline.h"
+
+// no shader is loaded, the pipeline only keeps the descriptor set layouts it was created with
+class NullComputePipeline : public ComputePipeline
+{
+public:
+    explicit NullComputePipeline(const ComputePipelineCreateInfo& createInfo);
+
+    NullComputePipeline(NullComputePipeline&)			= delete;
+    NullComputePipeline(NullComputePipeline&&)			= delete;
+    NullComputePipeline& operator=(const NullComputePipeline&)	= delete;
+    NullComputePipeline& operator=(const NullComputePipeline&&) = delete;
+
+    void* GetNativeHandle() const override;
+    uint32_t GetDescriptorSetLayoutCount() const override;
+    const DescriptorSetLayout* GetDescriptorSetLayout(uint32_t index) const override;
+
+private:
+    uint32_t m_descriptorSetLayoutCount;
+    const DescriptorSetLayout* m_descriptorSetLayouts[4];
+};
\ No newline at end of file
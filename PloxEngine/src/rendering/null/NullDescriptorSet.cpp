@@ -0,0 +1,80 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullDescriptorSet.h"
+#include "core/Assert.h"
+#include "utility/memory/DefaultAllocator.h"
+#include <new>
+
+NullDescriptorSetLayout::NullDescriptorSetLayout(uint32_t bindingCount, const DescriptorSetLayoutBinding* bindings)
+    : m_bindings(bindings, bindings + bindingCount)
+{
+}
+
+void* NullDescriptorSetLayout::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const eastl::vector<DescriptorSetLayoutBinding>& NullDescriptorSetLayout::GetBindings() const
+{
+    return m_bindings;
+}
+
+NullDescriptorSet::NullDescriptorSet(const NullDescriptorSetLayout* layout)
+    : m_layout(layout)
+{
+}
+
+void* NullDescriptorSet::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+void NullDescriptorSet::Update(uint32_t count, const DescriptorSetUpdate* /*updates*/)
+{
+    m_updateCount += count;
+}
+
+const NullDescriptorSetLayout* NullDescriptorSet::GetLayout() const
+{
+    return m_layout;
+}
+
+uint64_t NullDescriptorSet::GetUpdateCount() const
+{
+    return m_updateCount;
+}
+
+NullDescriptorSetPool::NullDescriptorSetPool(uint32_t maxSets, const NullDescriptorSetLayout* layout)
+    : m_layout(layout), m_poolSize(maxSets), m_currentOffset(), m_descriptorSetMemory()
+{
+    m_descriptorSetMemory = static_cast<char*>(DefaultAllocator::Get()->allocate(sizeof(NullDescriptorSet) * m_poolSize, alignof(NullDescriptorSet), 0));
+}
+
+NullDescriptorSetPool::~NullDescriptorSetPool()
+{
+    DefaultAllocator::Get()->deallocate(m_descriptorSetMemory, sizeof(NullDescriptorSet) * m_poolSize);
+    m_descriptorSetMemory = nullptr;
+}
+
+void* NullDescriptorSetPool::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+void NullDescriptorSetPool::AllocateDescriptorSets(uint32_t count, DescriptorSet** sets)
+{
+    ASSERT_MSG(m_currentOffset + count <= m_poolSize, "Tried to allocate more descriptor sets from descriptor set pool than available!");
+
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	sets[i] = new(m_descriptorSetMemory + sizeof(NullDescriptorSet) * m_currentOffset) NullDescriptorSet(m_layout);
+	m_currentOffset++;
+    }
+}
+
+void NullDescriptorSetPool::Reset()
+{
+    m_currentOffset = 0;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/DescriptorSet.h"
+#include "rendering/types/GraphicsPipeline.h"
+
+class NullDescriptorSetLayout : public DescriptorSetLayout
+{
+public:
+    explicit NullDescriptorSetLayout(uint32_t bindingCount, const DescriptorSetLayoutBinding* bindings);
+
+    NullDescriptorSetLayout(NullDescriptorSetLayout&)			= delete;
+    NullDescriptorSetLayout(NullDescriptorSetLayout&&)			= delete;
+    NullDescriptorSetLayout& operator=(const NullDescriptorSetLayout&)	= delete;
+    NullDescriptorSetLayout& operator=(const NullDescriptorSetLayout&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const eastl::vector<DescriptorSetLayoutBinding>& GetBindings() const;
+
+private:
+    eastl::vector<DescriptorSetLayoutBinding> m_bindings;
+};
+
+class NullDescriptorSet : public DescriptorSet
+{
+public:
+    explicit NullDescriptorSet(const NullDescriptorSetLayout* layout);
+    void* GetNativeHandle() const override;
+    // only counts the updates, the descriptors are never read
+    void Update(uint32_t count, const DescriptorSetUpdate* updates) override;
+    const NullDescriptorSetLayout* GetLayout() const;
+    uint64_t GetUpdateCount() const;
+
+private:
+    const NullDescriptorSetLayout* m_layout;
+    uint64_t m_updateCount = 0;
+};
+
+class NullDescriptorSetPool : public DescriptorSetPool
+{
+public:
+    explicit NullDescriptorSetPool(uint32_t maxSets, const NullDescriptorSetLayout* layout);
+    ~NullDescriptorSetPool() override;
+
+    NullDescriptorSetPool(NullDescriptorSetPool&)		    = delete;
+    NullDescriptorSetPool(NullDescriptorSetPool&&)		    = delete;
+    NullDescriptorSetPool& operator=(const NullDescriptorSetPool&)  = delete;
+    NullDescriptorSetPool& operator=(const NullDescriptorSetPool&&) = delete;
+
+    void* GetNativeHandle() const override;
+    void AllocateDescriptorSets(uint32_t count, DescriptorSet** sets) override;
+    void Reset() override;
+
+private:
+    const NullDescriptorSetLayout* m_layout;
+    uint32_t m_poolSize;
+    uint32_t m_currentOffset;
+    char* m_descriptorSetMemory;
+};
\ No newline at end of file
@@ -0,0 +1,13 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullEvent.h"
+
+void* NullEvent::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+void NullEvent::Reset()
+{
+}
\ No newline at end of file
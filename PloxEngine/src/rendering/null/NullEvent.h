@@ -0,0 +1,21 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "rendering/types/Event.h"
+
+// the queue executes in order, so waiting on an event never blocks and there is nothing to track
+class NullEvent : public Event
+{
+public:
+    explicit NullEvent() = default;
+
+    NullEvent(NullEvent&)		    = delete;
+    NullEvent(NullEvent&&)		    = delete;
+    NullEvent& operator=(const NullEvent&)  = delete;
+    NullEvent& operator=(const NullEvent&&) = delete;
+
+    void* GetNativeHandle() const override;
+    void Reset() override;
+};
\ No newline at end of file
@@ -0,0 +1,474 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullGraphicsAdapter.h"
+#include "core/Assert.h"
+#include "core/Clock.h"
+#include "core/Logger.h"
+#include "EASTL/algorithm.h"
+#include "NullBuffer.h"
+#include "NullCommandPool.h"
+#include "NullComputePipeline.h"
+#include "NullDescriptorSet.h"
+#include "NullEvent.h"
+#include "NullGraphicsPipeline.h"
+#include "NullImage.h"
+#include "NullLoweredBarriers.h"
+#include "NullMemoryHeap.h"
+#include "NullQueryPool.h"
+#include "NullSemaphore.h"
+#include "NullSwapchain.h"
+#include "utility/Utilities.h"
+
+// bytes per texel, block compressed formats are rounded up to one byte per texel
+static uint64_t GetTexelSize(Format format)
+{
+    const auto value = static_cast<uint32_t>(format);
+
+    if(value == 0)
+    {
+	return 0;
+    }
+    if(value == 1 || (value >= 9 && value <= 15) || value == 127)
+    {
+	return 1;
+    }
+    if((value >= 2 && value <= 8) || (value >= 16 && value <= 22) || (value >= 70 && value <= 76) || value == 124)
+    {
+	return 2;
+    }
+    if(value >= 23 && value <= 36)
+    {
+	return 3;
+    }
+    if((value >= 37 && value <= 69) || (value >= 77 && value <= 83) || (value >= 98 && value <= 100) || (value >= 122 && value <= 129))
+    {
+	return 4;
+    }
+    if(value >= 84 && value <= 90)
+    {
+	return 6;
+    }
+    if((value >= 91 && value <= 97) || (value >= 101 && value <= 103) || (value >= 110 && value <= 112) || value == 130)
+    {
+	return 8;
+    }
+    if(value >= 104 && value <= 106)
+    {
+	return 12;
+    }
+    if((value >= 107 && value <= 109) || (value >= 113 && value <= 115))
+    {
+	return 16;
+    }
+    if(value >= 116 && value <= 118)
+    {
+	return 24;
+    }
+    if(value >= 119 && value <= 121)
+    {
+	return 32;
+    }
+    return 1;
+}
+
+NullGraphicsAdapter::NullGraphicsAdapter(uint64_t simulatedLatency)
+    : m_graphicsQueue(QueueType::GRAPHICS),
+      m_computeQueue(QueueType::COMPUTE),
+      m_transferQueue(QueueType::TRANSFER),
+      m_graphicsPipelineMemoryPool(sizeof(NullGraphicsPipeline), 64, "NullGraphicsPipeline Pool Allocator"),
+      m_computePipelineMemoryPool(sizeof(NullComputePipeline), 64, "NullComputePipeline Pool Allocator"),
+      m_commandPoolMemoryPool(sizeof(NullCommandPool), 32, "NullCommandPool Pool Allocator"),
+      m_imageMemoryPool(sizeof(NullImage), 1024, "NullImage Pool Allocator"),
+      m_bufferMemoryPool(sizeof(NullBuffer), 1024, "NullBuffer Pool Allocator"),
+      m_imageViewMemoryPool(sizeof(NullImageView), 1024, "NullImageView Pool Allocator"),
+      m_bufferViewMemoryPool(sizeof(NullBufferView), 64, "NullBufferView Pool Allocator"),
+      m_semaphoreMemoryPool(sizeof(NullSemaphore), 16, "NullSemaphore Pool Allocator"),
+      m_queryPoolMemoryPool(sizeof(NullQueryPool), 16, "NullQueryPool Pool Allocator"),
+      m_eventMemoryPool(sizeof(NullEvent), 64, "NullEvent Pool Allocator"),
+      m_memoryHeapMemoryPool(sizeof(NullMemoryHeap), 16, "NullMemoryHeap Pool Allocator"),
+      m_descriptorSetPoolMemoryPool(sizeof(NullDescriptorSetPool), 16, "NullDescriptorSetPool Pool Allocator"),
+      m_descriptorSetLayoutMemoryPool(sizeof(NullDescriptorSetLayout), 16, "NullDescriptorSetLayout Pool Allocator"),
+      m_loweredBarriersMemoryPool(sizeof(NullLoweredBarriers), 16, "NullLoweredBarriers Pool Allocator")
+{
+    SetSimulatedLatency(simulatedLatency);
+
+    LOG_CORE_INFO("Null Graphics Adapter Created (simulated latency {0} ns)", simulatedLatency);
+}
+
+NullGraphicsAdapter::~NullGraphicsAdapter()
+{
+    delete m_swapchain;
+}
+
+void NullGraphicsAdapter::CreateGraphicsPipeline(uint32_t count, const GraphicsPipelineCreateInfo* createInfo, GraphicsPipeline** pipelines)
+{
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	pipelines[i] = ALLOC_NEW(&m_graphicsPipelineMemoryPool, NullGraphicsPipeline)(createInfo[i]);
+    }
+}
+
+void NullGraphicsAdapter::CreateComputePipeline(uint32_t count, const ComputePipelineCreateInfo* createInfo, ComputePipeline** pipelines)
+{
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	pipelines[i] = ALLOC_NEW(&m_computePipelineMemoryPool, NullComputePipeline)(createInfo[i]);
+    }
+}
+
+void NullGraphicsAdapter::CreateCommandPool(const Queue* queue, CommandPool** commandPool)
+{
+    const auto* queueNull = dynamic_cast<const NullQueue*>(queue);
+    ASSERT(queueNull);
+    *commandPool = ALLOC_NEW(&m_commandPoolMemoryPool, NullCommandPool)(*queueNull);
+}
+
+void NullGraphicsAdapter::CreateSwapchain(const Queue* presentQueue, unsigned int width, unsigned int height, Window* /*window*/, PresentMode presentMode, Swapchain** swapchain)
+{
+    ASSERT(!m_swapchain);
+    ASSERT(width && height);
+
+    Queue* queue = nullptr;
+
+    queue = presentQueue == &m_graphicsQueue ? &m_graphicsQueue : queue;
+    queue = presentQueue == &m_computeQueue ? &m_computeQueue : queue;
+    ASSERT(queue);
+
+    *swapchain = m_swapchain = new NullSwapchain(queue, width, height, presentMode);
+}
+
+void NullGraphicsAdapter::CreateSemaphore(uint64_t initialValue, Semaphore** semaphore)
+{
+    *semaphore = ALLOC_NEW(&m_semaphoreMemoryPool, NullSemaphore)(initialValue);
+}
+
+void NullGraphicsAdapter::CreateImage(const ImageCreateInfo& imageCreateInfo, MemoryPropertyFlags /*requiredMemoryPropertyFlags*/, MemoryPropertyFlags /*preferredMemoryPropertyFlags*/, bool /*dedicated*/, Image** image)
+{
+    *image = ALLOC_NEW(&m_imageMemoryPool, NullImage)(imageCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateUnboundImage(const ImageCreateInfo& imageCreateInfo, Image** image)
+{
+    *image = ALLOC_NEW(&m_imageMemoryPool, NullImage)(imageCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateImageView(const ImageViewCreateInfo* imageViewCreateInfo, ImageView** imageView)
+{
+    *imageView = ALLOC_NEW(&m_imageViewMemoryPool, NullImageView)(*imageViewCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateImageView(Image* image, ImageView** imageView)
+{
+    const auto& imageDesc = image->GetDescription();
+
+    ImageViewCreateInfo imageViewCreateInfo = {};
+    {
+	imageViewCreateInfo.Image	   = image;
+	imageViewCreateInfo.ViewType	   = static_cast<ImageViewType>(imageDesc.ImageType);
+	imageViewCreateInfo.Format	   = imageDesc.Format;
+	imageViewCreateInfo.Components	   = {};
+	imageViewCreateInfo.BaseMipLevel   = 0;
+	imageViewCreateInfo.LevelCount	   = imageDesc.Levels;
+	imageViewCreateInfo.BaseArrayLayer = 0;
+	imageViewCreateInfo.LayerCount	   = imageDesc.Layers;
+    }
+
+    // array view, 3d images dont support arrays
+    if(imageViewCreateInfo.LayerCount > 1)
+    {
+	ASSERT(imageViewCreateInfo.ViewType != ImageViewType::_3D);
+	imageViewCreateInfo.ViewType = imageViewCreateInfo.ViewType == ImageViewType::_1D ? ImageViewType::_1D_ARRAY : ImageViewType::_2D_ARRAY;
+    }
+
+    CreateImageView(&imageViewCreateInfo, imageView);
+}
+
+void NullGraphicsAdapter::CreateBuffer(const BufferCreateInfo& bufferCreateInfo, MemoryPropertyFlags /*requiredMemoryPropertyFlags*/, MemoryPropertyFlags /*preferredMemoryPropertyFlags*/, bool /*dedicated*/, Buffer** buffer)
+{
+    *buffer = ALLOC_NEW(&m_bufferMemoryPool, NullBuffer)(bufferCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateUnboundBuffer(const BufferCreateInfo& bufferCreateInfo, Buffer** buffer)
+{
+    *buffer = ALLOC_NEW(&m_bufferMemoryPool, NullBuffer)(bufferCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateBufferView(const BufferViewCreateInfo* bufferViewCreateInfo, BufferView** bufferView)
+{
+    *bufferView = ALLOC_NEW(&m_bufferViewMemoryPool, NullBufferView)(*bufferViewCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateDescriptorSetPool(uint32_t maxSets, const DescriptorSetLayout* descriptorSetLayout, DescriptorSetPool** descriptorSetPool)
+{
+    const auto* layoutNull = dynamic_cast<const NullDescriptorSetLayout*>(descriptorSetLayout);
+    ASSERT(layoutNull);
+
+    *descriptorSetPool = ALLOC_NEW(&m_descriptorSetPoolMemoryPool, NullDescriptorSetPool)(maxSets, layoutNull);
+}
+
+void NullGraphicsAdapter::CreateDescriptorSetLayout(uint32_t bindingCount, const DescriptorSetLayoutBinding* bindings, DescriptorSetLayout** descriptorSetLayout)
+{
+    *descriptorSetLayout = ALLOC_NEW(&m_descriptorSetLayoutMemoryPool, NullDescriptorSetLayout)(bindingCount, bindings);
+}
+
+void NullGraphicsAdapter::CreateQueryPool(const QueryPoolCreateInfo& queryPoolCreateInfo, QueryPool** queryPool)
+{
+    *queryPool = ALLOC_NEW(&m_queryPoolMemoryPool, NullQueryPool)(queryPoolCreateInfo);
+}
+
+void NullGraphicsAdapter::CreateEvent(Event** event)
+{
+    *event = ALLOC_NEW(&m_eventMemoryPool, NullEvent)();
+}
+
+void NullGraphicsAdapter::CreateMemoryHeap(const MemoryHeapCreateInfo& memoryHeapCreateInfo, MemoryHeap** memoryHeap)
+{
+    *memoryHeap = ALLOC_NEW(&m_memoryHeapMemoryPool, NullMemoryHeap)(memoryHeapCreateInfo);
+}
+
+void NullGraphicsAdapter::GetMemoryRequirements(const Image* image, MemoryRequirements* memoryRequirements)
+{
+    const auto& desc = image->GetDescription();
+
+    uint64_t size = 0;
+    for(uint32_t level = 0; level < desc.Levels; ++level)
+    {
+	const uint64_t width  = eastl::max(desc.Width >> level, 1u);
+	const uint64_t height = eastl::max(desc.Height >> level, 1u);
+	const uint64_t depth  = eastl::max(desc.Depth >> level, 1u);
+	size += width * height * depth;
+    }
+    size *= desc.Layers * static_cast<uint64_t>(desc.Samples) * GetTexelSize(desc.Format);
+
+    memoryRequirements->Size	       = Util::AlignUp(eastl::max(size, uint64_t(1)), IMAGE_ALIGNMENT);
+    memoryRequirements->Alignment      = IMAGE_ALIGNMENT;
+    memoryRequirements->MemoryTypeBits = 1;
+}
+
+void NullGraphicsAdapter::GetMemoryRequirements(const Buffer* buffer, MemoryRequirements* memoryRequirements)
+{
+    memoryRequirements->Size	       = Util::AlignUp(buffer->GetDescription().Size, BUFFER_ALIGNMENT);
+    memoryRequirements->Alignment      = BUFFER_ALIGNMENT;
+    memoryRequirements->MemoryTypeBits = 1;
+}
+
+void NullGraphicsAdapter::BindMemory(Image* image, MemoryHeap* memoryHeap, uint64_t offset)
+{
+    auto* imageNull = dynamic_cast<NullImage*>(image);
+    ASSERT(imageNull);
+    ASSERT(offset % IMAGE_ALIGNMENT == 0 && offset < memoryHeap->GetDescription().Size);
+
+    imageNull->BindMemory(memoryHeap, offset);
+}
+
+void NullGraphicsAdapter::BindMemory(Buffer* buffer, MemoryHeap* memoryHeap, uint64_t offset)
+{
+    auto* bufferNull = dynamic_cast<NullBuffer*>(buffer);
+    ASSERT(bufferNull);
+    ASSERT(offset % BUFFER_ALIGNMENT == 0 && offset + buffer->GetDescription().Size <= memoryHeap->GetDescription().Size);
+
+    bufferNull->BindMemory(memoryHeap, offset);
+}
+
+void NullGraphicsAdapter::CreateLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets, LoweredBarriers** loweredBarriers)
+{
+    *loweredBarriers = ALLOC_NEW(&m_loweredBarriersMemoryPool, NullLoweredBarriers)(count, barriers, groupCount, groupOffsets);
+}
+
+void NullGraphicsAdapter::DestroyGraphicsPipelineImmediate(GraphicsPipeline* pipeline)
+{
+    if(pipeline)
+    {
+	auto* pipelineNull = dynamic_cast<NullGraphicsPipeline*>(pipeline);
+	ASSERT(pipelineNull);
+
+	ALLOC_DELETE(&m_graphicsPipelineMemoryPool, pipelineNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyComputePipelineImmediate(ComputePipeline* pipeline)
+{
+    if(pipeline)
+    {
+	auto* pipelineNull = dynamic_cast<NullComputePipeline*>(pipeline);
+	ASSERT(pipelineNull);
+
+	ALLOC_DELETE(&m_computePipelineMemoryPool, pipelineNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyCommandPoolImmediate(CommandPool* commandPool)
+{
+    if(commandPool)
+    {
+	auto* pool = dynamic_cast<NullCommandPool*>(commandPool);
+	ASSERT(pool);
+
+	ALLOC_DELETE(&m_commandPoolMemoryPool, pool);
+    }
+}
+
+void NullGraphicsAdapter::DestroySemaphoreImmediate(Semaphore* semaphore)
+{
+    if(semaphore)
+    {
+	auto* semaphoreNull = dynamic_cast<NullSemaphore*>(semaphore);
+	ASSERT(semaphoreNull);
+
+	ALLOC_DELETE(&m_semaphoreMemoryPool, semaphoreNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyImageImmediate(Image* image)
+{
+    if(image)
+    {
+	auto* imageNull = dynamic_cast<NullImage*>(image);
+	ASSERT(imageNull);
+
+	ALLOC_DELETE(&m_imageMemoryPool, imageNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyImageViewImmediate(ImageView* imageView)
+{
+    if(imageView)
+    {
+	auto* viewNull = dynamic_cast<NullImageView*>(imageView);
+	ASSERT(viewNull);
+
+	ALLOC_DELETE(&m_imageViewMemoryPool, viewNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyBufferImmediate(Buffer* buffer)
+{
+    if(buffer)
+    {
+	auto* bufferNull = dynamic_cast<NullBuffer*>(buffer);
+	ASSERT(bufferNull);
+
+	ALLOC_DELETE(&m_bufferMemoryPool, bufferNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyBufferViewImmediate(BufferView* bufferView)
+{
+    if(bufferView)
+    {
+	auto* viewNull = dynamic_cast<NullBufferView*>(bufferView);
+	ASSERT(viewNull);
+
+	ALLOC_DELETE(&m_bufferViewMemoryPool, viewNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyDescriptorSetPoolImmediate(DescriptorSetPool* descriptorSetPool)
+{
+    if(descriptorSetPool)
+    {
+	auto* pool = dynamic_cast<NullDescriptorSetPool*>(descriptorSetPool);
+	ASSERT(pool);
+
+	ALLOC_DELETE(&m_descriptorSetPoolMemoryPool, pool);
+    }
+}
+
+void NullGraphicsAdapter::DestroyDescriptorSetLayoutImmediate(DescriptorSetLayout* descriptorSetLayout)
+{
+    if(descriptorSetLayout)
+    {
+	auto* layout = dynamic_cast<NullDescriptorSetLayout*>(descriptorSetLayout);
+	ASSERT(layout);
+
+	ALLOC_DELETE(&m_descriptorSetLayoutMemoryPool, layout);
+    }
+}
+
+void NullGraphicsAdapter::DestroyQueryPoolImmediate(QueryPool* queryPool)
+{
+    if(queryPool)
+    {
+	auto* poolNull = dynamic_cast<NullQueryPool*>(queryPool);
+	ASSERT(poolNull);
+
+	ALLOC_DELETE(&m_queryPoolMemoryPool, poolNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyEventImmediate(Event* event)
+{
+    if(event)
+    {
+	auto* eventNull = dynamic_cast<NullEvent*>(event);
+	ASSERT(eventNull);
+
+	ALLOC_DELETE(&m_eventMemoryPool, eventNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyMemoryHeapImmediate(MemoryHeap* memoryHeap)
+{
+    if(memoryHeap)
+    {
+	auto* heapNull = dynamic_cast<NullMemoryHeap*>(memoryHeap);
+	ASSERT(heapNull);
+
+	ALLOC_DELETE(&m_memoryHeapMemoryPool, heapNull);
+    }
+}
+
+void NullGraphicsAdapter::DestroyLoweredBarriers(LoweredBarriers* loweredBarriers)
+{
+    if(loweredBarriers)
+    {
+	auto* loweredBarriersNull = dynamic_cast<NullLoweredBarriers*>(loweredBarriers);
+	ASSERT(loweredBarriersNull);
+
+	ALLOC_DELETE(&m_loweredBarriersMemoryPool, loweredBarriersNull);
+    }
+}
+
+bool NullGraphicsAdapter::ActivateFullscreen(Window* /*window*/)
+{
+    return false;
+}
+
+Queue* NullGraphicsAdapter::GetGraphicsQueue()
+{
+    return &m_graphicsQueue;
+}
+
+Queue* NullGraphicsAdapter::GetComputeQueue()
+{
+    return &m_computeQueue;
+}
+
+Queue* NullGraphicsAdapter::GetTransferQueue()
+{
+    return &m_transferQueue;
+}
+
+bool NullGraphicsAdapter::IsPipelineStatisticsQuerySupported() const
+{
+    return true;
+}
+
+bool NullGraphicsAdapter::GetCalibratedTimestamp(uint64_t* gpuTimestamp, uint64_t* cpuTimestamp)
+{
+    // the queues write Clock times as timestamps
+    *gpuTimestamp = *cpuTimestamp = Clock::Now();
+    return true;
+}
+
+void NullGraphicsAdapter::SetDebugObjectName(ObjectType /*type*/, void* /*object*/, const char* /*name*/)
+{
+}
+
+void NullGraphicsAdapter::SetSimulatedLatency(uint64_t simulatedLatency)
+{
+    m_graphicsQueue.SetSimulatedLatency(simulatedLatency);
+    m_computeQueue.SetSimulatedLatency(simulatedLatency);
+    m_transferQueue.SetSimulatedLatency(simulatedLatency);
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "NullQueue.h"
+#include "rendering/GraphicsAdapter.h"
+#include "utility/memory/PoolAllocator.h"
+
+class NullSwapchain;
+class Window;
+
+#undef CreateSemaphore
+#undef CreateEvent
+
+// a device without a gpu. resources only exist as bookkeeping, commands are recorded into inspectable streams and
+// submissions complete immediately or after a simulated latency, so everything above the adapter runs without a gpu or a window
+class NullGraphicsAdapter : public GraphicsAdapter
+{
+public:
+    // the latency of every submission in nanoseconds
+    explicit NullGraphicsAdapter(uint64_t simulatedLatency = 0);
+    ~NullGraphicsAdapter() override;
+
+    void CreateGraphicsPipeline(uint32_t count, const GraphicsPipelineCreateInfo* createInfo, GraphicsPipeline** pipelines) override;
+    void CreateComputePipeline(uint32_t count, const ComputePipelineCreateInfo* createInfo, ComputePipeline** pipelines) override;
+    void CreateCommandPool(const Queue* queue, CommandPool** commandPool) override;
+    void CreateSwapchain(const Queue* presentQueue, unsigned int width, unsigned int height, Window* window, PresentMode presentMode, Swapchain** swapchain) override;
+    void CreateSemaphore(uint64_t initialValue, Semaphore** semaphore) override;
+    void CreateImage(const ImageCreateInfo& imageCreateInfo, MemoryPropertyFlags requiredMemoryPropertyFlags, MemoryPropertyFlags preferredMemoryPropertyFlags, bool dedicated, Image** image) override;
+    void CreateImageView(const ImageViewCreateInfo* imageViewCreateInfo, ImageView** imageView) override;
+    void CreateImageView(Image* image, ImageView** imageView) override;
+    void CreateBuffer(const BufferCreateInfo& bufferCreateInfo, MemoryPropertyFlags requiredMemoryPropertyFlags, MemoryPropertyFlags preferredMemoryPropertyFlags, bool dedicated, Buffer** buffer) override;
+    void CreateBufferView(const BufferViewCreateInfo* bufferViewCreateInfo, BufferView** bufferView) override;
+    void CreateDescriptorSetPool(uint32_t maxSets, const DescriptorSetLayout* descriptorSetLayout, DescriptorSetPool** descriptorSetPool) override;
+    void CreateDescriptorSetLayout(uint32_t bindingCount, const DescriptorSetLayoutBinding* bindings, DescriptorSetLayout** descriptorSetLayout) override;
+    void CreateQueryPool(const QueryPoolCreateInfo& queryPoolCreateInfo, QueryPool** queryPool) override;
+    void CreateEvent(Event** event) override;
+    void CreateMemoryHeap(const MemoryHeapCreateInfo& memoryHeapCreateInfo, MemoryHeap** memoryHeap) override;
+    void CreateUnboundImage(const ImageCreateInfo& imageCreateInfo, Image** image) override;
+    void CreateUnboundBuffer(const BufferCreateInfo& bufferCreateInfo, Buffer** buffer) override;
+    void GetMemoryRequirements(const Image* image, MemoryRequirements* memoryRequirements) override;
+    void GetMemoryRequirements(const Buffer* buffer, MemoryRequirements* memoryRequirements) override;
+    void BindMemory(Image* image, MemoryHeap* memoryHeap, uint64_t offset) override;
+    void BindMemory(Buffer* buffer, MemoryHeap* memoryHeap, uint64_t offset) override;
+    void CreateLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets, LoweredBarriers** loweredBarriers) override;
+
+    void DestroyLoweredBarriers(LoweredBarriers* loweredBarriers) override;
+
+    bool ActivateFullscreen(Window* window) override;
+
+    Queue* GetGraphicsQueue() override;
+    Queue* GetComputeQueue() override;
+    Queue* GetTransferQueue() override;
+
+    bool IsPipelineStatisticsQuerySupported() const override;
+    bool GetCalibratedTimestamp(uint64_t* gpuTimestamp, uint64_t* cpuTimestamp) override;
+
+    void SetDebugObjectName(ObjectType type, void* object, const char* name) override;
+
+    void SetSimulatedLatency(uint64_t simulatedLatency);
+
+protected:
+    void DestroyGraphicsPipelineImmediate(GraphicsPipeline* pipeline) override;
+    void DestroyComputePipelineImmediate(ComputePipeline* pipeline) override;
+    void DestroyCommandPoolImmediate(CommandPool* commandPool) override;
+    void DestroySemaphoreImmediate(Semaphore* semaphore) override;
+    void DestroyImageImmediate(Image* image) override;
+    void DestroyImageViewImmediate(ImageView* imageView) override;
+    void DestroyBufferImmediate(Buffer* buffer) override;
+    void DestroyBufferViewImmediate(BufferView* bufferView) override;
+    void DestroyDescriptorSetPoolImmediate(DescriptorSetPool* descriptorSetPool) override;
+    void DestroyDescriptorSetLayoutImmediate(DescriptorSetLayout* descriptorSetLayout) override;
+    void DestroyQueryPoolImmediate(QueryPool* queryPool) override;
+    void DestroyEventImmediate(Event* event) override;
+    void DestroyMemoryHeapImmediate(MemoryHeap* memoryHeap) override;
+
+private:
+    static constexpr uint64_t IMAGE_ALIGNMENT  = 64 * 1024;
+    static constexpr uint64_t BUFFER_ALIGNMENT = 256;
+
+    NullQueue m_graphicsQueue;
+    NullQueue m_computeQueue;
+    NullQueue m_transferQueue;
+    NullSwapchain* m_swapchain = nullptr;
+    DynamicPoolAllocator m_graphicsPipelineMemoryPool;
+    DynamicPoolAllocator m_computePipelineMemoryPool;
+    DynamicPoolAllocator m_commandPoolMemoryPool;
+    DynamicPoolAllocator m_imageMemoryPool;
+    DynamicPoolAllocator m_bufferMemoryPool;
+    DynamicPoolAllocator m_imageViewMemoryPool;
+    DynamicPoolAllocator m_bufferViewMemoryPool;
+    DynamicPoolAllocator m_semaphoreMemoryPool;
+    DynamicPoolAllocator m_queryPoolMemoryPool;
+    DynamicPoolAllocator m_eventMemoryPool;
+    DynamicPoolAllocator m_memoryHeapMemoryPool;
+    DynamicPoolAllocator m_descriptorSetPoolMemoryPool;
+    DynamicPoolAllocator m_descriptorSetLayoutMemoryPool;
+    DynamicPoolAllocator m_loweredBarriersMemoryPool;
+};
\ No newline at end of file
@@ -0,0 +1,33 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullGraphicsPipeline.h"
+#include "core/Assert.h"
+#include "EASTL/iterator.h"
+
+NullGraphicsPipeline::NullGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo)
+    : m_descriptorSetLayoutCount(createInfo.LayoutCreateInfo.DescriptorSetLayoutCount), m_descriptorSetLayouts()
+{
+    ASSERT(m_descriptorSetLayoutCount <= eastl::size(m_descriptorSetLayouts));
+
+    for(uint32_t i = 0; i < m_descriptorSetLayoutCount; ++i)
+    {
+	m_descriptorSetLayouts[i] = createInfo.LayoutCreateInfo.DescriptorSetLayoutDeclarations[i].Layout;
+    }
+}
+
+void* NullGraphicsPipeline::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+uint32_t NullGraphicsPipeline::GetDescriptorSetLayoutCount() const
+{
+    return m_descriptorSetLayoutCount;
+}
+
+const DescriptorSetLayout* NullGraphicsPipeline::GetDescriptorSetLayout(uint32_t index) const
+{
+    ASSERT(index < m_descriptorSetLayoutCount);
+    return m_descriptorSetLayouts[index];
+}
\ No newline at end of file
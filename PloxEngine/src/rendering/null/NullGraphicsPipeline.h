@@ -0,0 +1,26 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "rendering/types/GraphicsPipeline.h"
+
+// no shaders are loaded, the pipeline only keeps the descriptor set layouts it was created with
+class NullGraphicsPipeline : public GraphicsPipeline
+{
+public:
+    explicit NullGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo);
+
+    NullGraphicsPipeline(NullGraphicsPipeline&)			  = delete;
+    NullGraphicsPipeline(NullGraphicsPipeline&&)		  = delete;
+    NullGraphicsPipeline& operator=(const NullGraphicsPipeline&)  = delete;
+    NullGraphicsPipeline& operator=(const NullGraphicsPipeline&&) = delete;
+
+    void* GetNativeHandle() const override;
+    uint32_t GetDescriptorSetLayoutCount() const override;
+    const DescriptorSetLayout* GetDescriptorSetLayout(uint32_t index) const override;
+
+private:
+    uint32_t m_descriptorSetLayoutCount;
+    const DescriptorSetLayout* m_descriptorSetLayouts[4];
+};
\ No newline at end of file
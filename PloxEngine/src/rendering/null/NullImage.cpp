@@ -0,0 +1,57 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullImage.h"
+#include "core/Assert.h"
+
+NullImage::NullImage(const ImageCreateInfo& createInfo)
+    : m_description(createInfo)
+{
+}
+
+void* NullImage::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const ImageCreateInfo& NullImage::GetDescription() const
+{
+    return m_description;
+}
+
+void NullImage::BindMemory(MemoryHeap* memoryHeap, uint64_t offset)
+{
+    ASSERT(!m_memoryHeap);
+    m_memoryHeap   = memoryHeap;
+    m_memoryOffset = offset;
+}
+
+MemoryHeap* NullImage::GetMemoryHeap() const
+{
+    return m_memoryHeap;
+}
+
+uint64_t NullImage::GetMemoryOffset() const
+{
+    return m_memoryOffset;
+}
+
+NullImageView::NullImageView(const ImageViewCreateInfo& createInfo)
+    : m_description(createInfo)
+{
+}
+
+void* NullImageView::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const Image* NullImageView::GetImage() const
+{
+    return m_description.Image;
+}
+
+const ImageViewCreateInfo& NullImageView::GetDescription() const
+{
+    return m_description;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "rendering/types/Image.h"
+#include "rendering/types/ImageView.h"
+
+class MemoryHeap;
+
+class NullImage : public Image
+{
+public:
+    explicit NullImage(const ImageCreateInfo& createInfo);
+
+    NullImage(NullImage&)		    = delete;
+    NullImage(NullImage&&)		    = delete;
+    NullImage& operator=(const NullImage&)  = delete;
+    NullImage& operator=(const NullImage&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const ImageCreateInfo& GetDescription() const override;
+
+    void BindMemory(MemoryHeap* memoryHeap, uint64_t offset);
+    // nullptr if the image has its own memory
+    MemoryHeap* GetMemoryHeap() const;
+    uint64_t GetMemoryOffset() const;
+
+private:
+    ImageCreateInfo m_description;
+    MemoryHeap* m_memoryHeap = nullptr;
+    uint64_t m_memoryOffset  = 0;
+};
+
+class NullImageView : public ImageView
+{
+public:
+    explicit NullImageView(const ImageViewCreateInfo& createInfo);
+
+    NullImageView(NullImageView&)		    = delete;
+    NullImageView(NullImageView&&)		    = delete;
+    NullImageView& operator=(const NullImageView&)  = delete;
+    NullImageView& operator=(const NullImageView&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const Image* GetImage() const override;
+    const ImageViewCreateInfo& GetDescription() const override;
+
+private:
+    ImageViewCreateInfo m_description;
+};
\ No newline at end of file
@@ -0,0 +1,28 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+#include "NullLoweredBarriers.h"
+#include "core/Assert.h"
+
+NullLoweredBarriers::NullLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets)
+    : m_barriers(barriers, barriers + count), m_groupOffsets(groupOffsets, groupOffsets + groupCount + 1)
+{
+    ASSERT(m_groupOffsets.back() <= count);
+}
+
+void NullLoweredBarriers::Update(const Barrier* barriers)
+{
+    m_barriers.assign(barriers, barriers + m_barriers.size());
+}
+
+uint32_t NullLoweredBarriers::GetBarrierCount(uint32_t group) const
+{
+    ASSERT(group + 1 < m_groupOffsets.size());
+    return m_groupOffsets[group + 1] - m_groupOffsets[group];
+}
+
+const Barrier* NullLoweredBarriers::GetBarriers(uint32_t group) const
+{
+    ASSERT(group + 1 < m_groupOffsets.size());
+    return m_barriers.data() + m_groupOffsets[group];
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/LoweredBarriers.h"
+
+// there is no native form, the barriers are kept as they are and recorded like any other barrier call
+class NullLoweredBarriers : public LoweredBarriers
+{
+public:
+    explicit NullLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets);
+
+    NullLoweredBarriers(NullLoweredBarriers&)			= delete;
+    NullLoweredBarriers(NullLoweredBarriers&&)			= delete;
+    NullLoweredBarriers& operator=(const NullLoweredBarriers&)	= delete;
+    NullLoweredBarriers& operator=(const NullLoweredBarriers&&) = delete;
+
+    void Update(const Barrier* barriers) override;
+
+    uint32_t GetBarrierCount(uint32_t group) const;
+    const Barrier* GetBarriers(uint32_t group) const;
+
+private:
+    eastl::vector<Barrier> m_barriers;
+    eastl::vector<uint32_t> m_groupOffsets;
+};
\ No newline at end of file
@@ -0,0 +1,19 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullMemoryHeap.h"
+
+NullMemoryHeap::NullMemoryHeap(const MemoryHeapCreateInfo& createInfo)
+    : m_description(createInfo)
+{
+}
+
+void* NullMemoryHeap::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const MemoryHeapCreateInfo& NullMemoryHeap::GetDescription() const
+{
+    return m_description;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "rendering/types/MemoryHeap.h"
+
+// no memory is allocated, the heap only exists to have resources bound to it
+class NullMemoryHeap : public MemoryHeap
+{
+public:
+    explicit NullMemoryHeap(const MemoryHeapCreateInfo& createInfo);
+
+    NullMemoryHeap(NullMemoryHeap&)		      = delete;
+    NullMemoryHeap(NullMemoryHeap&&)		      = delete;
+    NullMemoryHeap& operator=(const NullMemoryHeap&)  = delete;
+    NullMemoryHeap& operator=(const NullMemoryHeap&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const MemoryHeapCreateInfo& GetDescription() const override;
+
+private:
+    MemoryHeapCreateInfo m_description;
+};
\ No newline at end of file
@@ -0,0 +1,77 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullQueryPool.h"
+#include "core/Assert.h"
+#include "core/Clock.h"
+#include <cstring>
+
+NullQueryPool::NullQueryPool(const QueryPoolCreateInfo& createInfo)
+    : m_description(createInfo), m_valueCount(1)
+{
+    ASSERT(createInfo.QueryCount > 0);
+
+    if(createInfo.QueryType == QueryType::PIPELINE_STATISTICS)
+    {
+	m_valueCount = 0;
+	for(uint32_t bits = static_cast<uint32_t>(createInfo.PipelineStatistics); bits != 0; bits &= bits - 1)
+	{
+	    ++m_valueCount;
+	}
+    }
+
+    m_values.resize(createInfo.QueryCount * m_valueCount, 0);
+    m_availableTimes.resize(createInfo.QueryCount, UINT64_MAX);
+}
+
+void* NullQueryPool::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+const QueryPoolCreateInfo& NullQueryPool::GetDescription() const
+{
+    return m_description;
+}
+
+bool NullQueryPool::GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t dataSize, void* data, uint64_t stride) const
+{
+    ASSERT(firstQuery + queryCount <= m_description.QueryCount);
+    ASSERT(stride >= m_valueCount * sizeof(uint64_t) && dataSize >= (queryCount - 1) * stride + m_valueCount * sizeof(uint64_t));
+
+    const uint64_t now = Clock::Now();
+    for(uint32_t i = firstQuery; i < firstQuery + queryCount; ++i)
+    {
+	if(m_availableTimes[i] > now)
+	{
+	    return false;
+	}
+    }
+
+    for(uint32_t i = 0; i < queryCount; ++i)
+    {
+	memcpy(static_cast<uint8_t*>(data) + i * stride, m_values.data() + (firstQuery + i) * m_valueCount, m_valueCount * sizeof(uint64_t));
+    }
+    return true;
+}
+
+void NullQueryPool::Reset(uint32_t firstQuery, uint32_t queryCount) const
+{
+    ASSERT(firstQuery + queryCount <= m_description.QueryCount);
+
+    for(uint32_t i = firstQuery; i < firstQuery + queryCount; ++i)
+    {
+	m_availableTimes[i] = UINT64_MAX;
+    }
+}
+
+void NullQueryPool::WriteResult(uint32_t query, uint64_t value, uint64_t availableTime) const
+{
+    ASSERT(query < m_description.QueryCount);
+
+    for(uint32_t i = 0; i < m_valueCount; ++i)
+    {
+	m_values[query * m_valueCount + i] = value;
+    }
+    m_availableTimes[query] = availableTime;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/QueryPool.h"
+
+// results are written by the queue when the submission using the pool is executed and become available once it completes
+class NullQueryPool : public QueryPool
+{
+public:
+    explicit NullQueryPool(const QueryPoolCreateInfo& createInfo);
+
+    NullQueryPool(NullQueryPool&)		    = delete;
+    NullQueryPool(NullQueryPool&&)		    = delete;
+    NullQueryPool& operator=(const NullQueryPool&)  = delete;
+    NullQueryPool& operator=(const NullQueryPool&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const QueryPoolCreateInfo& GetDescription() const override;
+    bool GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t dataSize, void* data, uint64_t stride) const override;
+
+    void Reset(uint32_t firstQuery, uint32_t queryCount) const;
+    // every value of the query, pipeline statistics have one per enabled statistic
+    void WriteResult(uint32_t query, uint64_t value, uint64_t availableTime) const;
+
+private:
+    QueryPoolCreateInfo m_description;
+    uint32_t m_valueCount;
+    mutable eastl::vector<uint64_t> m_values;
+    // UINT64_MAX while the query has no result
+    mutable eastl::vector<uint64_t> m_availableTimes;
+};
\ No newline at end of file
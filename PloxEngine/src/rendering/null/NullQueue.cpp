@@ -0,0 +1,244 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullQueue.h"
+#include "core/Assert.h"
+#include "core/Clock.h"
+#include "EASTL/algorithm.h"
+#include "NullCommand.h"
+#include "NullQueryPool.h"
+#include "NullSemaphore.h"
+
+NullQueue::NullQueue(QueueType queueType)
+    : m_queueType(queueType)
+{
+}
+
+void* NullQueue::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+QueueType NullQueue::GetQueueType() const
+{
+    return m_queueType;
+}
+
+unsigned int NullQueue::GetTimestampValidBits() const
+{
+    return 64;
+}
+
+float NullQueue::GetTimestampPeriod() const
+{
+    // timestamps are Clock times
+    return 1.0f;
+}
+
+bool NullQueue::CanPresent() const
+{
+    return m_queueType != QueueType::TRANSFER;
+}
+
+void NullQueue::Submit(uint32_t count, const SubmitInfo* submitInfo)
+{
+    ++m_statistics.SubmitCallCount;
+
+    const uint64_t submitTime = Clock::Now();
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	Submit(submitInfo[i], submitTime, false);
+    }
+}
+
+void NullQueue::Present(const Semaphore* waitSemaphore, uint64_t waitValue, const Semaphore* signalSemaphore, uint64_t signalValue)
+{
+    SubmitInfo info	      = {};
+    info.WaitSemaphoreCount   = 1;
+    info.WaitSemaphores	      = &waitSemaphore;
+    info.WaitValues	      = &waitValue;
+    info.SignalSemaphoreCount = 1;
+    info.SignalSemaphores     = &signalSemaphore;
+    info.SignalValues	      = &signalValue;
+
+    Submit(info, Clock::Now(), true);
+}
+
+void NullQueue::SetSimulatedLatency(uint64_t latency)
+{
+    m_simulatedLatency = latency;
+}
+
+uint64_t NullQueue::GetCompletionTime() const
+{
+    return m_completionTime;
+}
+
+uint32_t NullQueue::GetPendingSubmissionCount() const
+{
+    return static_cast<uint32_t>(m_pendingSubmissions.size());
+}
+
+const NullQueueStatistics& NullQueue::GetStatistics() const
+{
+    return m_statistics;
+}
+
+void NullQueue::Resume()
+{
+    // a signal scheduled by a pending submission can resume another queue, which can resume this one again
+    if(m_scheduling)
+    {
+	m_resumeRequested = true;
+	return;
+    }
+
+    m_scheduling = true;
+    do
+    {
+	m_resumeRequested = false;
+	SchedulePending();
+    } while(m_resumeRequested);
+    m_scheduling = false;
+}
+
+uint64_t NullQueue::GetStartTime(uint32_t waitCount, const Semaphore* const* waitSemaphores, const uint64_t* waitValues, uint64_t submitTime)
+{
+    uint64_t startTime = eastl::max(submitTime, m_completionTime);
+    for(uint32_t i = 0; i < waitCount; ++i)
+    {
+	const auto* semaphore = dynamic_cast<const NullSemaphore*>(waitSemaphores[i]);
+	ASSERT(semaphore);
+
+	const uint64_t waitTime = semaphore->GetCompletionTime(waitValues[i]);
+	if(waitTime == UINT64_MAX)
+	{
+	    semaphore->AddBlockedQueue(this);
+	    return UINT64_MAX;
+	}
+	startTime = eastl::max(startTime, waitTime);
+    }
+    return startTime;
+}
+
+void NullQueue::Schedule(uint32_t commandCount, const Command* const* commands, uint32_t signalCount, const Semaphore* const* signalSemaphores, const uint64_t* signalValues, uint64_t startTime)
+{
+    m_completionTime = startTime + m_simulatedLatency;
+
+    for(uint32_t i = 0; i < commandCount; ++i)
+    {
+	const auto* command = dynamic_cast<const NullCommand*>(commands[i]);
+	ASSERT(command && !command->IsRecording());
+
+	Execute(*command, m_completionTime);
+    }
+
+    for(uint32_t i = 0; i < signalCount; ++i)
+    {
+	const auto* semaphore = dynamic_cast<const NullSemaphore*>(signalSemaphores[i]);
+	ASSERT(semaphore);
+
+	semaphore->ScheduleSignal(signalValues[i], m_completionTime);
+    }
+}
+
+void NullQueue::Submit(const SubmitInfo& info, uint64_t submitTime, bool present)
+{
+    if(!present)
+    {
+	++m_statistics.SubmissionCount;
+	m_statistics.CommandCount += info.CommandCount;
+	m_statistics.WaitCount += info.WaitSemaphoreCount;
+	m_statistics.SignalCount += info.SignalSemaphoreCount;
+    }
+
+    // everything submitted after a pending submission waits behind it
+    if(m_pendingSubmissions.empty())
+    {
+	const uint64_t startTime = GetStartTime(info.WaitSemaphoreCount, info.WaitSemaphores, info.WaitValues, submitTime);
+	if(startTime != UINT64_MAX)
+	{
+	    Schedule(info.CommandCount, info.Commands, info.SignalSemaphoreCount, info.SignalSemaphores, info.SignalValues, startTime);
+	    return;
+	}
+    }
+
+    // the arrays of the submit info only live until Submit returns
+    PendingSubmission submission = {};
+    submission.WaitSemaphores.assign(info.WaitSemaphores, info.WaitSemaphores + info.WaitSemaphoreCount);
+    submission.WaitValues.assign(info.WaitValues, info.WaitValues + info.WaitSemaphoreCount);
+    submission.Commands.assign(info.Commands, info.Commands + info.CommandCount);
+    submission.SignalSemaphores.assign(info.SignalSemaphores, info.SignalSemaphores + info.SignalSemaphoreCount);
+    submission.SignalValues.assign(info.SignalValues, info.SignalValues + info.SignalSemaphoreCount);
+    submission.SubmitTime = submitTime;
+    m_pendingSubmissions.push_back(eastl::move(submission));
+
+    ++m_statistics.BlockedSubmissionCount;
+}
+
+void NullQueue::SchedulePending()
+{
+    size_t scheduledCount = 0;
+    for(; scheduledCount < m_pendingSubmissions.size(); ++scheduledCount)
+    {
+	const auto& submission	 = m_pendingSubmissions[scheduledCount];
+	const uint64_t startTime = GetStartTime(static_cast<uint32_t>(submission.WaitSemaphores.size()), submission.WaitSemaphores.data(), submission.WaitValues.data(), submission.SubmitTime);
+	if(startTime == UINT64_MAX)
+	{
+	    break;
+	}
+
+	Schedule(static_cast<uint32_t>(submission.Commands.size()), submission.Commands.data(), static_cast<uint32_t>(submission.SignalSemaphores.size()), submission.SignalSemaphores.data(), submission.SignalValues.data(), startTime);
+    }
+
+    m_pendingSubmissions.erase(m_pendingSubmissions.begin(), m_pendingSubmissions.begin() + scheduledCount);
+}
+
+void NullQueue::Execute(const NullCommand& command, uint64_t completionTime)
+{
+    const auto& records = command.GetRecords();
+    m_statistics.RecordCount += records.size();
+
+    for(const auto& record: records)
+    {
+	switch(record.Type)
+	{
+	    case NullCommandType::DRAW:
+	    case NullCommandType::DRAW_INDEXED:
+		++m_statistics.DrawCount;
+		break;
+	    case NullCommandType::DISPATCH:
+	    case NullCommandType::DISPATCH_INDIRECT:
+		++m_statistics.DispatchCount;
+		break;
+	    case NullCommandType::COPY_BUFFER:
+	    case NullCommandType::COPY_IMAGE:
+	    case NullCommandType::COPY_BUFFER_TO_IMAGE:
+	    case NullCommandType::UPDATE_BUFFER:
+		++m_statistics.CopyCount;
+		break;
+	    case NullCommandType::BARRIER:
+		m_statistics.BarrierCount += record.Arguments[0];
+		break;
+	    case NullCommandType::RESET_QUERY_POOL:
+		GetQueryPool(record)->Reset(static_cast<uint32_t>(record.Arguments[0]), static_cast<uint32_t>(record.Arguments[1]));
+		break;
+	    case NullCommandType::WRITE_TIMESTAMP:
+		GetQueryPool(record)->WriteResult(static_cast<uint32_t>(record.Arguments[1]), completionTime, completionTime);
+		break;
+	    case NullCommandType::END_QUERY:
+		// nothing is rasterized or shaded, so occlusion and pipeline statistics queries count nothing
+		GetQueryPool(record)->WriteResult(static_cast<uint32_t>(record.Arguments[0]), 0, completionTime);
+		break;
+	    default:
+		break;
+	}
+    }
+}
+
+const NullQueryPool* NullQueue::GetQueryPool(const NullCommandRecord& record)
+{
+    const auto* queryPool = dynamic_cast<const NullQueryPool*>(static_cast<const QueryPool*>(record.Objects[0]));
+    ASSERT(queryPool);
+    return queryPool;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/Queue.h"
+
+class NullCommand;
+class NullQueryPool;
+struct NullCommandRecord;
+
+struct NullQueueStatistics
+{
+    // calls to Submit and the submit infos handed to them
+    uint64_t SubmitCallCount;
+    uint64_t SubmissionCount;
+    uint64_t CommandCount;
+    uint64_t WaitCount;
+    uint64_t SignalCount;
+    // summed over the recorded streams of the submitted commands
+    uint64_t RecordCount;
+    uint64_t DrawCount;
+    uint64_t DispatchCount;
+    uint64_t CopyCount;
+    uint64_t BarrierCount;
+    // submissions kept pending as they or an earlier one waited on a value nothing had been submitted for yet, a gpu would have stalled on them
+    uint64_t BlockedSubmissionCount;
+};
+
+// submissions execute in order. every one starts once the queue is idle and its waits are satisfied and takes the simulated latency,
+// its signals and queries complete when it is done. a submission waiting on a value nothing has been submitted for yet stays pending,
+// together with everything submitted after it, until that signal is submitted or the value is signaled from the host.
+// like a native queue, submitting and signaling from the host have to be externally synchronized
+class NullQueue : public Queue
+{
+public:
+    explicit NullQueue(QueueType queueType);
+
+    void* GetNativeHandle() const override;
+    QueueType GetQueueType() const override;
+    unsigned int GetTimestampValidBits() const override;
+    float GetTimestampPeriod() const override;
+    bool CanPresent() const override;
+    void Submit(uint32_t count, const SubmitInfo* submitInfo) override;
+
+    // a queue operation without commands, it is not counted as a submission
+    void Present(const Semaphore* waitSemaphore, uint64_t waitValue, const Semaphore* signalSemaphore, uint64_t signalValue);
+
+    // in nanoseconds, 0 completes every submission immediately
+    void SetSimulatedLatency(uint64_t latency);
+    // Clock time the last scheduled submission completes at, pending submissions are not included
+    uint64_t GetCompletionTime() const;
+    uint32_t GetPendingSubmissionCount() const;
+    const NullQueueStatistics& GetStatistics() const;
+
+    // called by the semaphores once a value a pending submission waits on may have been scheduled
+    void Resume();
+
+private:
+    struct PendingSubmission
+    {
+	eastl::vector<const Semaphore*> WaitSemaphores;
+	eastl::vector<uint64_t> WaitValues;
+	eastl::vector<const Command*> Commands;
+	eastl::vector<const Semaphore*> SignalSemaphores;
+	eastl::vector<uint64_t> SignalValues;
+	uint64_t SubmitTime;
+    };
+
+    // UINT64_MAX if one of the waits has not been submitted yet, the queue then waits for its signal to be submitted
+    uint64_t GetStartTime(uint32_t waitCount, const Semaphore* const* waitSemaphores, const uint64_t* waitValues, uint64_t submitTime);
+    void Schedule(uint32_t commandCount, const Command* const* commands, uint32_t signalCount, const Semaphore* const* signalSemaphores, const uint64_t* signalValues, uint64_t startTime);
+    void Submit(const SubmitInfo& info, uint64_t submitTime, bool present);
+    void SchedulePending();
+    void Execute(const NullCommand& command, uint64_t completionTime);
+    static const NullQueryPool* GetQueryPool(const NullCommandRecord& record);
+
+private:
+    QueueType m_queueType;
+    uint64_t m_simulatedLatency	     = 0;
+    uint64_t m_completionTime	     = 0;
+    NullQueueStatistics m_statistics = {};
+    // in submission order, only the first one can be blocked on a wait
+    eastl::vector<PendingSubmission> m_pendingSubmissions;
+    bool m_scheduling	   = false;
+    bool m_resumeRequested = false;
+};
\ No newline at end of file
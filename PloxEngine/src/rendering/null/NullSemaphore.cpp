@@ -0,0 +1,127 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullSemaphore.h"
+#include "core/Assert.h"
+#include "core/Clock.h"
+#include "EASTL/algorithm.h"
+#include "NullQueue.h"
+#include <thread>
+
+NullSemaphore::NullSemaphore(uint64_t initialValue)
+    : m_completedValue(initialValue)
+{
+}
+
+void* NullSemaphore::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+uint64_t NullSemaphore::GetCompletedValue() const
+{
+    SpinLockHolder holder(m_lock);
+    Retire();
+    return m_completedValue;
+}
+
+void NullSemaphore::Wait(uint64_t waitValue) const
+{
+    // the value may also be signaled from the host by another thread, so this spins instead of sleeping until a completion time
+    while(GetCompletedValue() < waitValue)
+    {
+	std::this_thread::yield();
+    }
+}
+
+void NullSemaphore::Signal(uint64_t signalValue) const
+{
+    {
+	SpinLockHolder holder(m_lock);
+	Retire();
+	ASSERT(signalValue > m_completedValue);
+	m_completedValue = signalValue;
+    }
+    ResumeBlockedQueues();
+}
+
+void NullSemaphore::ScheduleSignal(uint64_t signalValue, uint64_t completionTime) const
+{
+    {
+	SpinLockHolder holder(m_lock);
+	Retire();
+
+	// a later signal can not complete before an earlier one
+	if(!m_pendingSignals.empty())
+	{
+	    ASSERT(signalValue > m_pendingSignals.back().Value);
+	    completionTime = eastl::max(completionTime, m_pendingSignals.back().CompletionTime);
+	}
+	ASSERT(signalValue > m_completedValue);
+
+	m_pendingSignals.push_back({ signalValue, completionTime });
+	Retire();
+    }
+    ResumeBlockedQueues();
+}
+
+uint64_t NullSemaphore::GetCompletionTime(uint64_t waitValue) const
+{
+    SpinLockHolder holder(m_lock);
+    Retire();
+
+    if(m_completedValue >= waitValue)
+    {
+	return 0;
+    }
+    for(const auto& signal: m_pendingSignals)
+    {
+	if(signal.Value >= waitValue)
+	{
+	    return signal.CompletionTime;
+	}
+    }
+    return UINT64_MAX;
+}
+
+void NullSemaphore::AddBlockedQueue(NullQueue* queue) const
+{
+    SpinLockHolder holder(m_lock);
+    if(eastl::find(m_blockedQueues.begin(), m_blockedQueues.end(), queue) == m_blockedQueues.end())
+    {
+	m_blockedQueues.push_back(queue);
+    }
+}
+
+void NullSemaphore::Retire() const
+{
+    if(m_pendingSignals.empty())
+    {
+	return;
+    }
+
+    const uint64_t now = Clock::Now();
+
+    size_t retiredCount = 0;
+    while(retiredCount < m_pendingSignals.size() && m_pendingSignals[retiredCount].CompletionTime <= now)
+    {
+	m_completedValue = eastl::max(m_completedValue, m_pendingSignals[retiredCount].Value);
+	++retiredCount;
+    }
+    m_pendingSignals.erase(m_pendingSignals.begin(), m_pendingSignals.begin() + retiredCount);
+}
+
+void NullSemaphore::ResumeBlockedQueues() const
+{
+    eastl::vector<NullQueue*> blockedQueues;
+    {
+	SpinLockHolder holder(m_lock);
+	blockedQueues.swap(m_blockedQueues);
+    }
+
+    // a queue still waiting on a later value adds itself again
+    for(auto* queue: blockedQueues)
+    {
+	queue->Resume();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/Semaphore.h"
+#include "utility/SpinLock.h"
+
+class NullQueue;
+
+// timeline semaphore whose signals from queue submissions complete at a simulated point in time
+class NullSemaphore : public Semaphore
+{
+public:
+    explicit NullSemaphore(uint64_t initialValue);
+
+    NullSemaphore(NullSemaphore&)		    = delete;
+    NullSemaphore(NullSemaphore&&)		    = delete;
+    NullSemaphore& operator=(const NullSemaphore&)  = delete;
+    NullSemaphore& operator=(const NullSemaphore&&) = delete;
+
+    void* GetNativeHandle() const override;
+    uint64_t GetCompletedValue() const override;
+    void Wait(uint64_t waitValue) const override;
+    void Signal(uint64_t signalValue) const override;
+
+    // the value is reached once Clock::Now() passed completionTime, const like Signal as queues only see const semaphores
+    void ScheduleSignal(uint64_t signalValue, uint64_t completionTime) const;
+    // Clock time the value is reached at, 0 if it already was and UINT64_MAX if nothing signaling it has been submitted yet
+    uint64_t GetCompletionTime(uint64_t waitValue) const;
+    // the queue is resumed by the next signal, scheduled or from the host
+    void AddBlockedQueue(NullQueue* queue) const;
+
+private:
+    struct PendingSignal
+    {
+	uint64_t Value;
+	uint64_t CompletionTime;
+    };
+
+    // moves the signals that are due into the completed value, the lock has to be held
+    void Retire() const;
+    // called without the lock held, as the resumed queues query and signal semaphores themselves
+    void ResumeBlockedQueues() const;
+
+private:
+    mutable SpinLock m_lock;
+    mutable uint64_t m_completedValue;
+    // ordered by value and completion time
+    mutable eastl::vector<PendingSignal> m_pendingSignals;
+    mutable eastl::vector<NullQueue*> m_blockedQueues;
+};
\ No newline at end of file
@@ -0,0 +1,110 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+#include "NullSwapchain.h"
+#include "core/Assert.h"
+#include "NullQueue.h"
+
+NullSwapchain::NullSwapchain(Queue* presentQueue, uint32_t width, uint32_t height, PresentMode presentMode)
+    : m_presentMode(presentMode), m_presentQueue(presentQueue)
+{
+    Create(width, height);
+}
+
+NullSwapchain::~NullSwapchain()
+{
+    Destroy();
+}
+
+void NullSwapchain::Resize(uint32_t width, uint32_t height, Window* /*window*/, PresentMode presentMode)
+{
+    Destroy();
+    m_presentMode = presentMode;
+    Create(width, height);
+}
+
+void NullSwapchain::Present(Semaphore* waitSemaphore, uint64_t semaphoreWaitValue, Semaphore* signalSemaphore, uint64_t semaphoreSignalValue)
+{
+    auto* presentQueue = dynamic_cast<NullQueue*>(m_presentQueue);
+    ASSERT(presentQueue);
+
+    // presenting is ordered with the submissions of the present queue, so it waits behind any of them that are pending
+    presentQueue->Present(waitSemaphore, semaphoreWaitValue, signalSemaphore, semaphoreSignalValue);
+
+    m_currentImageIndex = (m_currentImageIndex + 1) % IMAGE_COUNT;
+    ++m_presentCount;
+}
+
+uint32_t NullSwapchain::GetCurrentImageIndex()
+{
+    return m_currentImageIndex;
+}
+
+void* NullSwapchain::GetNativeHandle() const
+{
+    return (void*) this;
+}
+
+Extent2D NullSwapchain::GetExtent() const
+{
+    return m_extent;
+}
+
+Extent2D NullSwapchain::GetRecreationExtent() const
+{
+    return m_extent;
+}
+
+Format NullSwapchain::GetImageFormat() const
+{
+    return IMAGE_FORMAT;
+}
+
+Image* NullSwapchain::GetImage(uint32_t index) const
+{
+    ASSERT(index < IMAGE_COUNT);
+    return m_images[index];
+}
+
+Queue* NullSwapchain::GetPresentQueue() const
+{
+    return m_presentQueue;
+}
+
+PresentMode NullSwapchain::GetPresentMode() const
+{
+    return m_presentMode;
+}
+
+uint64_t NullSwapchain::GetPresentCount() const
+{
+    return m_presentCount;
+}
+
+void NullSwapchain::Create(uint32_t width, uint32_t height)
+{
+    m_extent = { width, height };
+
+    ImageCreateInfo createInfo = {};
+    {
+	createInfo.Width      = width;
+	createInfo.Height     = height;
+	createInfo.Format     = IMAGE_FORMAT;
+	createInfo.UsageFlags = ImageUsageFlags::COLOR_ATTACHMENT_BIT | ImageUsageFlags::TRANSFER_DST_BIT;
+    }
+
+    for(auto& image: m_images)
+    {
+	image = new NullImage(createInfo);
+    }
+    m_currentImageIndex = 0;
+}
+
+void NullSwapchain::Destroy()
+{
+    for(auto& image: m_images)
+    {
+	delete image;
+	image = nullptr;
+    }
+}
\ No newline at end of file
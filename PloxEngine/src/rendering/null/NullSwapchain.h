@@ -0,0 +1,52 @@
+//
+// Created by Ploxie on 2023-07-03.
+//
+
+#pragma once
+#include "NullImage.h"
+#include "rendering/types/Swapchain.h"
+
+class Window;
+
+// presents nowhere, the images are only cycled through. a present completes as soon as the work it waits on has
+class NullSwapchain : public Swapchain
+{
+public:
+    explicit NullSwapchain(Queue* presentQueue, uint32_t width, uint32_t height, PresentMode presentMode);
+    ~NullSwapchain() override;
+
+    NullSwapchain(NullSwapchain&)		    = delete;
+    NullSwapchain(NullSwapchain&&)		    = delete;
+    NullSwapchain& operator=(const NullSwapchain&)  = delete;
+    NullSwapchain& operator=(const NullSwapchain&&) = delete;
+
+    void Resize(uint32_t width, uint32_t height, Window* window, PresentMode presentMode) override;
+    void Present(Semaphore* waitSemaphore, uint64_t semaphoreWaitValue, Semaphore* signalSemaphore, uint64_t semaphoreSignalValue) override;
+
+    uint32_t GetCurrentImageIndex() override;
+    void* GetNativeHandle() const override;
+    Extent2D GetExtent() const override;
+    Extent2D GetRecreationExtent() const override;
+    Format GetImageFormat() const override;
+    Image* GetImage(uint32_t index) const override;
+    Queue* GetPresentQueue() const override;
+    PresentMode GetPresentMode() const override;
+
+    uint64_t GetPresentCount() const;
+
+private:
+    void Create(uint32_t width, uint32_t height);
+    void Destroy();
+
+private:
+    static constexpr uint32_t IMAGE_COUNT = 3;
+    static constexpr Format IMAGE_FORMAT  = Format::B8G8R8A8_UNORM;
+
+    Extent2D m_extent	      = {};
+    PresentMode m_presentMode = PresentMode::IMMEDIATE;
+    Queue* m_presentQueue     = nullptr;
+
+    NullImage* m_images[IMAGE_COUNT] = {};
+    uint32_t m_currentImageIndex     = 0;
+    uint64_t m_presentCount	     = 0;
+};
\ No newline at end of file
@@ -7,12 +7,84 @@
 #include "rendering/rendergraph/Registry.h"
 #include "rendering/rendergraph/RenderGraph.h"
 #include "rendering/RenderUtilities.h"
+#include "rendering/StreamingUploader.h"
 #include "rendering/types/Command.h"
 #include "rendering/types/GraphicsPipeline.h"
 #include <glm/gtc/quaternion.hpp>
 
-CubePass::CubePass(GraphicsAdapter* adapter, DescriptorSetLayout* offsetBufferSetLayout)
-    : m_adapter(adapter)
+static const uint32_t s_indices[] = {
+    0, 1, 3, 1, 2, 3,
+    4, 5, 7, 5, 6, 7,
+    8, 9, 11, 9, 10, 11,
+    12, 13, 15, 13, 14, 15,
+    16, 17, 19, 17, 18, 19,
+    20, 21, 23, 21, 22, 23
+};
+
+static const glm::vec3 s_positions[48] = {
+    { -0.5f, -0.5f, 0.5f }, // Front
+    { 0.5f, -0.5f, 0.5f },
+    { 0.5f, 0.5f, 0.5f },
+    { -0.5f, 0.5f, 0.5f },
+
+    { 0.5f, -0.5f, -0.5f }, // Back
+    { -0.5f, -0.5f, -0.5f },
+    { -0.5f, 0.5f, -0.5f },
+    { 0.5f, 0.5f, -0.5f },
+
+    { -0.5f, -0.5f, -0.5f }, // Up
+    { 0.5f, -0.5f, -0.5f },
+    { 0.5f, -0.5f, 0.5f },
+    { -0.5f, -0.5f, 0.5f },
+
+    { -0.5f, 0.5f, 0.5f }, // Down
+    { 0.5f, 0.5f, 0.5f },
+    { 0.5f, 0.5f, -0.5f },
+    { -0.5f, 0.5f, -0.5f },
+
+    { -0.5f, 0.5f, 0.5f }, // Left
+    { -0.5f, 0.5f, -0.5f },
+    { -0.5f, -0.5f, -0.5f },
+    { -0.5f, -0.5f, 0.5f },
+
+    { 0.5f, 0.5f, -0.5f }, // Right
+    { 0.5f, 0.5f, 0.5f },
+    { 0.5f, -0.5f, 0.5f },
+    { 0.5f, -0.5f, -0.5f },
+
+    { 0, 0, 1 }, // Front
+    { 0, 0, 1 },
+    { 0, 0, 1 },
+    { 0, 0, 1 },
+
+    { 0, 0, -1 }, // Back
+    { 0, 0, -1 },
+    { 0, 0, -1 },
+    { 0, 0, -1 },
+
+    { 0, -1, 0 }, // Down
+    { 0, -1, 0 },
+    { 0, -1, 0 },
+    { 0, -1, 0 },
+
+    { 0, 1, 0 }, // Up
+    { 0, 1, 0 },
+    { 0, 1, 0 },
+    { 0, 1, 0 },
+
+    { -1, 0, 0 }, // Left
+    { -1, 0, 0 },
+    { -1, 0, 0 },
+    { -1, 0, 0 },
+
+    { 1, 0, 0 }, // Right
+    { 1, 0, 0 },
+    { 1, 0, 0 },
+    { 1, 0, 0 },
+};
+
+CubePass::CubePass(GraphicsAdapter* adapter, StreamingUploader* uploader, DescriptorSetLayout* offsetBufferSetLayout)
+    : m_adapter(adapter), m_uploader(uploader)
 {
     PipelineColorBlendAttachmentState blendState = {};
     {
@@ -55,96 +127,22 @@ CubePass::CubePass(GraphicsAdapter* adapter, DescriptorSetLayout* offsetBufferSe
 
     m_adapter->CreateGraphicsPipeline(1, &pipelineCreateInfo, &m_pipeline);
 
-    uint32_t indices[] = {
-	0, 1, 3, 1, 2, 3,
-	4, 5, 7, 5, 6, 7,
-	8, 9, 11, 9, 10, 11,
-	12, 13, 15, 13, 14, 15,
-	16, 17, 19, 17, 18, 19,
-	20, 21, 23, 21, 22, 23
-    };
-
     BufferCreateInfo indexBufferCreateInfo = {};
     {
-	indexBufferCreateInfo.Size	 = eastl::size(indices) * sizeof(uint32_t);
+	indexBufferCreateInfo.Size	 = sizeof(s_indices);
 	indexBufferCreateInfo.UsageFlags = BufferUsageFlags::INDEX_BUFFER_BIT | BufferUsageFlags::TRANSFER_DST_BIT;
     }
-    m_adapter->CreateBuffer(indexBufferCreateInfo, MemoryPropertyFlags::HOST_VISIBLE_BIT | MemoryPropertyFlags::HOST_COHERENT_BIT, MemoryPropertyFlags::DEVICE_LOCAL_BIT, false, &m_indexBuffer);
+    m_adapter->CreateBuffer(indexBufferCreateInfo, MemoryPropertyFlags::DEVICE_LOCAL_BIT, {}, false, &m_indexBuffer);
     m_adapter->SetDebugObjectName(ObjectType::BUFFER, m_indexBuffer, "Index Buffer");
 
-    uint32_t* indicesPtr;
-    m_indexBuffer->Map((void**) &indicesPtr);
-    memcpy(indicesPtr, indices, indexBufferCreateInfo.Size);
-
     BufferCreateInfo vertexBufferCreateInfo = {};
     {
-	vertexBufferCreateInfo.Size	  = 6 * sizeof(float) * 24;
+	vertexBufferCreateInfo.Size	  = sizeof(s_positions);
 	vertexBufferCreateInfo.UsageFlags = BufferUsageFlags::VERTEX_BUFFER_BIT | BufferUsageFlags::TRANSFER_DST_BIT;
     }
-    m_adapter->CreateBuffer(vertexBufferCreateInfo, MemoryPropertyFlags::HOST_COHERENT_BIT, MemoryPropertyFlags::DEVICE_LOCAL_BIT, false, &m_vertexBuffer);
+    m_adapter->CreateBuffer(vertexBufferCreateInfo, MemoryPropertyFlags::DEVICE_LOCAL_BIT, {}, false, &m_vertexBuffer);
     m_adapter->SetDebugObjectName(ObjectType::BUFFER, m_vertexBuffer, "Vertex Buffer");
 
-    glm::vec3 positions[48] = {
-	{ -0.5f, -0.5f, 0.5f }, // Front
-	{ 0.5f, -0.5f, 0.5f },
-	{ 0.5f, 0.5f, 0.5f },
-	{ -0.5f, 0.5f, 0.5f },
-
-	{ 0.5f, -0.5f, -0.5f }, // Back
-	{ -0.5f, -0.5f, -0.5f },
-	{ -0.5f, 0.5f, -0.5f },
-	{ 0.5f, 0.5f, -0.5f },
-
-	{ -0.5f, -0.5f, -0.5f }, // Up
-	{ 0.5f, -0.5f, -0.5f },
-	{ 0.5f, -0.5f, 0.5f },
-	{ -0.5f, -0.5f, 0.5f },
-
-	{ -0.5f, 0.5f, 0.5f }, // Down
-	{ 0.5f, 0.5f, 0.5f },
-	{ 0.5f, 0.5f, -0.5f },
-	{ -0.5f, 0.5f, -0.5f },
-
-	{ -0.5f, 0.5f, 0.5f }, // Left
-	{ -0.5f, 0.5f, -0.5f },
-	{ -0.5f, -0.5f, -0.5f },
-	{ -0.5f, -0.5f, 0.5f },
-
-	{ 0.5f, 0.5f, -0.5f }, // Right
-	{ 0.5f, 0.5f, 0.5f },
-	{ 0.5f, -0.5f, 0.5f },
-	{ 0.5f, -0.5f, -0.5f },
-
-	{ 0, 0, 1 }, // Front
-	{ 0, 0, 1 },
-	{ 0, 0, 1 },
-	{ 0, 0, 1 },
-
-	{ 0, 0, -1 }, // Back
-	{ 0, 0, -1 },
-	{ 0, 0, -1 },
-	{ 0, 0, -1 },
-
-	{ 0, -1, 0 }, // Down
-	{ 0, -1, 0 },
-	{ 0, -1, 0 },
-	{ 0, -1, 0 },
-
-	{ 0, 1, 0 }, // Up
-	{ 0, 1, 0 },
-	{ 0, 1, 0 },
-	{ 0, 1, 0 },
-
-	{ -1, 0, 0 }, // Left
-	{ -1, 0, 0 },
-	{ -1, 0, 0 },
-	{ -1, 0, 0 },
-
-	{ 1, 0, 0 }, // Right
-	{ 1, 0, 0 },
-	{ 1, 0, 0 },
-	{ 1, 0, 0 },
-    };
 
     float vertices[] = {
 	// Vertices
@@ -214,27 +212,65 @@ CubePass::CubePass(GraphicsAdapter* adapter, DescriptorSetLayout* offsetBufferSe
 	0.0f,
     };
 
-    float* verticesPtr;
-    m_vertexBuffer->Map((void**) &verticesPtr);
-    size_t size = 24 * sizeof(float) * 6;
-
-    memcpy(verticesPtr, positions, size);
-    //memcpy(verticesPtr + size, normals, size);
+    UploadGeometry();
 }
 
 CubePass::~CubePass()
 {
-    //m_adapter->DestroyGraphicsPipeline(m_pipeline);
+    m_adapter->DestroyGraphicsPipeline(m_pipeline);
+    m_adapter->DestroyBuffer(m_indexBuffer);
+    m_adapter->DestroyBuffer(m_vertexBuffer);
+}
+
+bool CubePass::UploadGeometry()
+{
+    if(!m_indicesUploaded)
+    {
+	m_indicesUploaded = m_uploader->UploadBuffer(m_indexBuffer, 0, sizeof(s_indices), s_indices, m_indexBufferState);
+    }
+    if(!m_verticesUploaded)
+    {
+	m_verticesUploaded = m_uploader->UploadBuffer(m_vertexBuffer, 0, sizeof(s_positions), s_positions, m_vertexBufferState);
+    }
+    return m_indicesUploaded && m_verticesUploaded;
 }
 
 void CubePass::Record(RenderGraph* renderGraph, const CubePass::Data& data)
 {
     m_rotation += 0.0005f;
 
+    // an upload rejected by a full staging ring is retried every frame, until then the attachments are only cleared
+    const bool geometryUploaded = UploadGeometry();
+    if(!geometryUploaded)
+    {
+	ResourceUsageDescription usageDescs[] = {
+	    { data.ColorAttachment, { ResourceState::WRITE_COLOR_ATTACHMENT } },
+	    { data.DepthAttachment, { ResourceState::WRITE_DEPTH_STENCIL } },
+	};
+
+	renderGraph->AddPass("Cube", QueueType::GRAPHICS, eastl::size(usageDescs), usageDescs, [=](Command* command, const Registry& registry)
+	{
+	    ColorAttachmentDescription attachmentDesc { registry.GetImageView(data.ColorAttachment), AttachmentLoadOp::CLEAR, registry.GetStoreOp(data.ColorAttachment), { 0.01f, 0.02f, 0.02f, 1.0f } };
+	    DepthStencilAttachmentDescription depthBufferDesc { registry.GetImageView(data.DepthAttachment), AttachmentLoadOp::CLEAR, registry.GetStoreOp(data.DepthAttachment), AttachmentLoadOp::DONT_CARE, AttachmentStoreOp::DONT_CARE };
+	    Rect renderRect { { 0, 0 }, { data.FrameWidth, data.FrameHeight } };
+
+	    command->BeginRenderPass(1, &attachmentDesc, &depthBufferDesc, renderRect, false);
+	    command->EndRenderPass();
+	});
+	return;
+    }
+
+    ResourceHandle indexBufferHandle	     = renderGraph->ImportBuffer(m_indexBuffer, "Index Buffer", m_indexBufferState);
+    ResourceViewHandle indexBufferViewHandle = renderGraph->CreateBufferView(BufferViewDescription::CreateDefault("Index Buffer", indexBufferHandle, renderGraph));
+
+    ResourceHandle vertexBufferHandle	      = renderGraph->ImportBuffer(m_vertexBuffer, "Vertex Buffer", m_vertexBufferState);
+    ResourceViewHandle vertexBufferViewHandle = renderGraph->CreateBufferView(BufferViewDescription::CreateDefault("Vertex Buffer", vertexBufferHandle, renderGraph));
+
     ResourceUsageDescription usageDescs[] = {
 	{ data.ColorAttachment, { ResourceState::WRITE_COLOR_ATTACHMENT } },
 	{ data.DepthAttachment, { ResourceState::WRITE_DEPTH_STENCIL } },
-
+	{ indexBufferViewHandle, { ResourceState::READ_INDEX_BUFFER } },
+	{ vertexBufferViewHandle, { ResourceState::READ_VERTEX_BUFFER } },
     };
 
     renderGraph->AddPass("Cube", QueueType::GRAPHICS, eastl::size(usageDescs), usageDescs, [=](Command* command, const Registry& registry)
@@ -267,8 +303,9 @@ void CubePass::Record(RenderGraph* renderGraph, const CubePass::Data& data)
 
 	//uint32_t allocOffset = (uint32_t) data.m_bufferAllocator->uploadStruct(DescriptorType::OFFSET_CONSTANT_BUFFER, consts);
 
-	ColorAttachmentDescription attachmentDesc { registry.GetImageView(data.ColorAttachment), AttachmentLoadOp::CLEAR, AttachmentStoreOp::STORE, { 0.01f, 0.02f, 0.02f, 1.0f } };
-	DepthStencilAttachmentDescription depthBufferDesc { registry.GetImageView(data.DepthAttachment), AttachmentLoadOp::CLEAR, AttachmentStoreOp::STORE, AttachmentLoadOp::DONT_CARE, AttachmentStoreOp::DONT_CARE };
+	// both are cleared, only the store ops come from the graph
+	ColorAttachmentDescription attachmentDesc { registry.GetImageView(data.ColorAttachment), AttachmentLoadOp::CLEAR, registry.GetStoreOp(data.ColorAttachment), { 0.01f, 0.02f, 0.02f, 1.0f } };
+	DepthStencilAttachmentDescription depthBufferDesc { registry.GetImageView(data.DepthAttachment), AttachmentLoadOp::CLEAR, registry.GetStoreOp(data.DepthAttachment), AttachmentLoadOp::DONT_CARE, AttachmentStoreOp::DONT_CARE };
 	Rect renderRect { { 0, 0 }, { data.FrameWidth, data.FrameHeight } };
 
 	command->BeginRenderPass(1, &attachmentDesc, &depthBufferDesc, renderRect, false);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "rendering/rendergraph/RenderGraph.h"
 #include "rendering/rendergraph/ViewHandles.h"
 #include "rendering/renderview/RenderViewData.h"
 
@@ -13,6 +14,7 @@ class GraphicsPipeline;
 class DescriptorSetLayout;
 class DescriptorSet;
 class Buffer;
+class StreamingUploader;
 
 class CubePass
 {
@@ -30,17 +32,27 @@ public:
     };
 
 public:
-    explicit CubePass(GraphicsAdapter* adapter, DescriptorSetLayout* offsetBufferSetLayout);
+    explicit CubePass(GraphicsAdapter* adapter, StreamingUploader* uploader, DescriptorSetLayout* offsetBufferSetLayout);
     ~CubePass();
 
     void Record(RenderGraph* renderGraph, const Data& data);
 
+private:
+    // returns true once both buffers were handed to the uploader
+    bool UploadGeometry();
+
 private:
     GraphicsAdapter* m_adapter;
+    StreamingUploader* m_uploader;
     GraphicsPipeline* m_pipeline;
 
     Buffer* m_indexBuffer;
     Buffer* m_vertexBuffer;
+    // written by the uploader, the first frame waits for the copies on the transfer queue
+    ResourceStateData m_indexBufferState[1]  = {};
+    ResourceStateData m_vertexBufferState[1] = {};
+    bool m_indicesUploaded		     = false;
+    bool m_verticesUploaded		     = false;
     uint16_t m_indices[36];
 
     float m_rotation = 0.0f;
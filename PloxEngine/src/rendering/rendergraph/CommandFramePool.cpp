@@ -2,55 +2,93 @@
 // Created by Ploxie on 2023-05-23.
 //
 #include "CommandFramePool.h"
+#include "core/Assert.h"
 #include "rendering/GraphicsAdapter.h"
 #include "rendering/types/CommandPool.h"
+#include "rendering/types/Event.h"
 
 CommandFramePool::~CommandFramePool() noexcept
 {
     Reset();
-    for(size_t i = 0; i < 3; i++)
+    for(auto& threadPools: m_threadPools)
     {
-	if(m_commandPools[i])
+	for(size_t i = 0; i < 3; i++)
 	{
-	    m_adapter->DestroyCommandPool(m_commandPools[i]);
+	    if(threadPools.CommandPools[i])
+	    {
+		m_adapter->DestroyCommandPool(threadPools.CommandPools[i]);
+	    }
 	}
     }
+    for(auto* event: m_events)
+    {
+	m_adapter->DestroyEvent(event);
+    }
 }
 
-void CommandFramePool::Initialize(GraphicsAdapter* adapter, uint32_t allocationChunkSize) noexcept
+void CommandFramePool::Initialize(GraphicsAdapter* adapter, uint32_t threadCount, uint32_t allocationChunkSize) noexcept
 {
     m_adapter		  = adapter;
     m_allocationChunkSize = allocationChunkSize;
+    m_threadPools.resize(eastl::max<uint32_t>(threadCount, 1));
 }
 
-Command* CommandFramePool::Acquire(Queue* queue) noexcept
+Command* CommandFramePool::Acquire(Queue* queue, uint32_t threadIndex) noexcept
 {
+    ASSERT(threadIndex < m_threadPools.size());
+
     const uint32_t poolIndex = queue == m_adapter->GetGraphicsQueue() ? 0 : queue == m_adapter->GetComputeQueue() ? 1 :
 														    2;
 
-    if(!m_commandPools[poolIndex])
+    auto& threadPools = m_threadPools[threadIndex];
+
+    if(!threadPools.CommandPools[poolIndex])
     {
-	m_adapter->CreateCommandPool(queue, &m_commandPools[poolIndex]);
+	// the adapter's object pools are not thread safe
+	SpinLockHolder lockHolder(m_createPoolLock);
+	m_adapter->CreateCommandPool(queue, &threadPools.CommandPools[poolIndex]);
     }
 
-    const size_t currentPoolSize = m_commands[poolIndex].size();
-    if(m_nextFreeCommand[poolIndex] == currentPoolSize)
+    auto& commands		 = threadPools.Commands[poolIndex];
+    const size_t currentPoolSize = commands.size();
+    if(threadPools.NextFreeCommand[poolIndex] == currentPoolSize)
     {
-	m_commands[poolIndex].resize(currentPoolSize + m_allocationChunkSize);
-	m_commandPools[poolIndex]->Allocate(m_allocationChunkSize, m_commands[poolIndex].data() + currentPoolSize);
+	commands.resize(currentPoolSize + m_allocationChunkSize);
+	threadPools.CommandPools[poolIndex]->Allocate(m_allocationChunkSize, commands.data() + currentPoolSize);
     }
 
-    return m_commands[poolIndex][m_nextFreeCommand[poolIndex]++];
+    return commands[threadPools.NextFreeCommand[poolIndex]++];
+}
+
+Event* CommandFramePool::AcquireEvent() noexcept
+{
+    if(m_nextFreeEvent == m_events.size())
+    {
+	m_events.push_back(nullptr);
+	m_adapter->CreateEvent(&m_events.back());
+    }
+
+    return m_events[m_nextFreeEvent++];
 }
 
 void CommandFramePool::Reset() noexcept
 {
-    for(size_t i = 0; i < 3; i++)
+    for(auto& threadPools: m_threadPools)
     {
-	if(m_commandPools[i])
+	for(size_t i = 0; i < 3; i++)
 	{
-	    m_commandPools[i]->Reset();
+	    if(threadPools.CommandPools[i])
+	    {
+		threadPools.CommandPools[i]->Reset();
+	    }
+	    threadPools.NextFreeCommand[i] = 0;
 	}
-	m_nextFreeCommand[i] = 0;
     }
+
+    // the frame is done on the gpu, so the events can be reset from the host
+    for(uint32_t i = 0; i < m_nextFreeEvent; ++i)
+    {
+	m_events[i]->Reset();
+    }
+    m_nextFreeEvent = 0;
 }
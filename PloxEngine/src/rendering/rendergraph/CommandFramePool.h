@@ -4,12 +4,14 @@
 
 #pragma once
 #include "EASTL/vector.h"
+#include "utility/SpinLock.h"
 #include <cstdint>
 
 class GraphicsAdapter;
 class Command;
 class Queue;
 class CommandPool;
+class Event;
 
 class CommandFramePool
 {
@@ -22,16 +24,27 @@ public:
     CommandFramePool& operator=(const CommandFramePool&)  = delete;
     CommandFramePool& operator=(const CommandFramePool&&) = delete;
 
-    void Initialize(GraphicsAdapter* adapter, uint32_t allocationChunkSize = 64) noexcept;
+    void Initialize(GraphicsAdapter* adapter, uint32_t threadCount = 1, uint32_t allocationChunkSize = 64) noexcept;
 
-    Command* Acquire(Queue* queue) noexcept;
+    // threadIndex selects the per-thread command pools, so different threads may acquire concurrently
+    Command* Acquire(Queue* queue, uint32_t threadIndex = 0) noexcept;
+    // events are not per thread, they are acquired while the graph is compiled
+    Event* AcquireEvent() noexcept;
 
     void Reset() noexcept;
 
 private:
-    GraphicsAdapter* m_adapter		  = nullptr;
-    uint32_t m_allocationChunkSize	  = 64;
-    CommandPool* m_commandPools[3]	  = {};
-    eastl::vector<Command*> m_commands[3] = {};
-    uint32_t m_nextFreeCommand[3]	  = {};
+    struct alignas(64) ThreadCommandPools
+    {
+	CommandPool* CommandPools[3]	    = {};
+	eastl::vector<Command*> Commands[3] = {};
+	uint32_t NextFreeCommand[3]	    = {};
+    };
+
+    GraphicsAdapter* m_adapter	   = nullptr;
+    uint32_t m_allocationChunkSize = 64;
+    eastl::vector<ThreadCommandPools> m_threadPools;
+    eastl::vector<Event*> m_events;
+    uint32_t m_nextFreeEvent = 0;
+    SpinLock m_createPoolLock;
 };
\ No newline at end of file
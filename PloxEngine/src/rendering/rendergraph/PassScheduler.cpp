@@ -0,0 +1,134 @@
+//
+// Created by Ploxie on 2023-06-24.
+//
+#include "PassScheduler.h"
+#include "core/Assert.h"
+#include "EASTL/algorithm.h"
+#include "EASTL/sort.h"
+
+void PassScheduler::Reset(size_t passCount) noexcept
+{
+    m_nodes.clear();
+    m_nodes.resize(passCount);
+    m_dependencies.clear();
+    m_ready.clear();
+}
+
+void PassScheduler::SetPass(uint16_t passIndex, uint32_t queueIndex, bool culled) noexcept
+{
+    m_nodes[passIndex].QueueIndex = queueIndex;
+    m_nodes[passIndex].Culled	  = culled;
+}
+
+void PassScheduler::AddDependency(uint16_t producer, uint16_t consumer) noexcept
+{
+    // a pass can use several views of the same subresource
+    if(producer == consumer)
+    {
+	return;
+    }
+
+    ASSERT(producer < consumer);
+    m_dependencies.push_back({ producer, consumer });
+}
+
+void PassScheduler::Schedule(uint16_t* order) noexcept
+{
+    const size_t passCount = m_nodes.size();
+
+    // every subresource adds its own dependencies, so most of them are duplicates.
+    // sorted by producer the consumers of a node are a range of the dependencies
+    eastl::sort(m_dependencies.begin(), m_dependencies.end());
+    m_dependencies.erase(eastl::unique(m_dependencies.begin(), m_dependencies.end()), m_dependencies.end());
+
+    const uint32_t dependencyCount = static_cast<uint32_t>(m_dependencies.size());
+    for(uint32_t i = 0; i < dependencyCount; ++i)
+    {
+	auto& producer = m_nodes[m_dependencies[i].first];
+	if(producer.ConsumerCount == 0)
+	{
+	    producer.ConsumerOffset = i;
+	}
+	++producer.ConsumerCount;
+	++m_nodes[m_dependencies[i].second].DependencyCount;
+    }
+
+    for(size_t i = 0; i < passCount; ++i)
+    {
+	if(m_nodes[i].DependencyCount == 0)
+	{
+	    m_ready.push_back(static_cast<uint16_t>(i));
+	}
+    }
+
+    uint32_t prevQueue = UINT32_MAX;
+    for(uint32_t position = 0; position < passCount; ++position)
+    {
+	// dependencies always point forward in declaration order, so there is no cycle and something is always ready
+	ASSERT(!m_ready.empty());
+
+	size_t best = 0;
+	for(size_t i = 1; i < m_ready.size(); ++i)
+	{
+	    if(IsPreferred(m_ready[i], m_ready[best], m_nodes[m_ready[i]], m_nodes[m_ready[best]], prevQueue))
+	    {
+		best = i;
+	    }
+	}
+
+	const uint16_t passIndex = m_ready[best];
+	m_ready.erase(m_ready.begin() + best);
+	order[position] = passIndex;
+
+	const auto& node = m_nodes[passIndex];
+	if(!node.Culled)
+	{
+	    prevQueue = node.QueueIndex;
+	}
+
+	for(uint32_t i = 0; i < node.ConsumerCount; ++i)
+	{
+	    const uint16_t consumerIndex = m_dependencies[node.ConsumerOffset + i].second;
+	    auto& consumer		 = m_nodes[consumerIndex];
+	    consumer.LatestProducer	 = eastl::max(consumer.LatestProducer, position + 1);
+	    if(--consumer.DependencyCount == 0)
+	    {
+		m_ready.push_back(consumerIndex);
+	    }
+	}
+    }
+}
+
+bool PassScheduler::IsPreferred(uint16_t left, uint16_t right, const Node& leftNode, const Node& rightNode, uint32_t prevQueue) noexcept
+{
+    // culled passes cost nothing
+    if(leftNode.Culled != rightNode.Culled)
+    {
+	return leftNode.Culled;
+    }
+
+    // staying on the same queue keeps the current batch going
+    const bool leftSameQueue  = leftNode.QueueIndex == prevQueue;
+    const bool rightSameQueue = rightNode.QueueIndex == prevQueue;
+    if(leftSameQueue != rightSameQueue)
+    {
+	return leftSameQueue;
+    }
+
+    // async work is submitted first so it can overlap with the graphics work that does not depend on it
+    const bool leftAsync  = leftNode.QueueIndex != 0;
+    const bool rightAsync = rightNode.QueueIndex != 0;
+    if(leftAsync != rightAsync)
+    {
+	return leftAsync;
+    }
+
+    // the longer ago the producers ran, the more room there is for split barriers and semaphore waits
+    if(leftNode.LatestProducer != rightNode.LatestProducer)
+    {
+	return leftNode.LatestProducer < rightNode.LatestProducer;
+    }
+
+    // declaration order
+    return left < right;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+//
+// Created by Ploxie on 2023-06-24.
+//
+
+#pragma once
+#include "EASTL/utility.h"
+#include "EASTL/vector.h"
+#include <cstdint>
+
+// orders passes topologically so fewer queue switches are needed and dependent passes end up further apart.
+// it only works on indices, so it runs without a gpu and the same input always results in the same order
+class PassScheduler
+{
+public:
+    void Reset(size_t passCount) noexcept;
+    // queueIndex 0 is the graphics queue, everything else is async work.
+    // culled passes record nothing and are placed where they do not break up other work
+    void SetPass(uint16_t passIndex, uint32_t queueIndex, bool culled) noexcept;
+    // the consumer has to run after the producer
+    void AddDependency(uint16_t producer, uint16_t consumer) noexcept;
+    // order receives the original indices of all passes in execution order
+    void Schedule(uint16_t* order) noexcept;
+
+private:
+    struct Node
+    {
+	uint32_t QueueIndex;
+	uint32_t DependencyCount;
+	uint32_t ConsumerOffset;
+	uint32_t ConsumerCount;
+	// position of the last scheduled producer + 1, 0 if there is none
+	uint32_t LatestProducer;
+	bool Culled;
+    };
+
+    static bool IsPreferred(uint16_t left, uint16_t right, const Node& leftNode, const Node& rightNode, uint32_t prevQueue) noexcept;
+
+private:
+    eastl::vector<Node> m_nodes;
+    eastl::vector<eastl::pair<uint16_t, uint16_t>> m_dependencies;
+    eastl::vector<uint16_t> m_ready;
+};
\ No newline at end of file
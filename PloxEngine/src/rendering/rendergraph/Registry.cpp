@@ -6,8 +6,8 @@
 #include "core/Assert.h"
 #include "RenderGraph.h"
 
-Registry::Registry(RenderGraph* renderGraph) noexcept
-    : m_graph(renderGraph)
+Registry::Registry(RenderGraph* renderGraph, uint32_t passIndex) noexcept
+    : m_graph(renderGraph), m_passIndex(passIndex)
 {
 }
 
@@ -91,3 +91,66 @@ void Registry::Unmap(ResourceViewHandle handle) const noexcept
     ASSERT(resDesc.HostVisible && !resDesc.External);
     frameResources.Resources[resIdx].Buffer->Unmap();
 }
+
+AttachmentLoadOp Registry::GetLoadOp(ResourceViewHandle handle) const noexcept
+{
+    const auto& passData = m_graph->m_passData[m_passIndex];
+
+    // the contents are only discarded if no subresource of the view needs them
+    bool used = false;
+    for(uint32_t i = passData.UsageOffset; i < passData.UsageOffset + passData.UsageCount; ++i)
+    {
+	if(IsViewSubresource(handle, m_graph->m_usageSubresources[i]))
+	{
+	    used = true;
+	    if(m_graph->m_usageLoadOps[i] == AttachmentLoadOp::LOAD)
+	    {
+		return AttachmentLoadOp::LOAD;
+	    }
+	}
+    }
+    ASSERT(used);
+
+    return AttachmentLoadOp::DONT_CARE;
+}
+
+AttachmentStoreOp Registry::GetStoreOp(ResourceViewHandle handle) const noexcept
+{
+    const auto& passData = m_graph->m_passData[m_passIndex];
+
+    bool used = false;
+    for(uint32_t i = passData.UsageOffset; i < passData.UsageOffset + passData.UsageCount; ++i)
+    {
+	if(IsViewSubresource(handle, m_graph->m_usageSubresources[i]))
+	{
+	    used = true;
+	    if(m_graph->m_usageStoreOps[i] == AttachmentStoreOp::STORE)
+	    {
+		return AttachmentStoreOp::STORE;
+	    }
+	}
+    }
+    ASSERT(used);
+
+    return AttachmentStoreOp::DONT_CARE;
+}
+
+bool Registry::IsViewSubresource(ResourceViewHandle handle, uint32_t subresourceIdx) const noexcept
+{
+    const auto& viewDesc = m_graph->m_viewDescriptions[(size_t) handle - 1];
+    const auto& resDesc	 = m_graph->m_resourceDescriptions[(size_t) viewDesc.ResourceHandle - 1];
+
+    if(subresourceIdx < resDesc.SubresourceUsageInfoOffset || subresourceIdx >= resDesc.SubresourceUsageInfoOffset + resDesc.SubresourceCount)
+    {
+	return false;
+    }
+    if(!resDesc.Image)
+    {
+	return true;
+    }
+
+    const uint32_t level = (subresourceIdx - resDesc.SubresourceUsageInfoOffset) % resDesc.Levels;
+    const uint32_t layer = (subresourceIdx - resDesc.SubresourceUsageInfoOffset) / resDesc.Levels;
+    const auto& range	 = viewDesc.SubresourceRange;
+    return level >= range.BaseMipLevel && level < range.BaseMipLevel + range.LevelCount && layer >= range.BaseArrayLayer && layer < range.BaseArrayLayer + range.LayerCount;
+}
@@ -3,6 +3,7 @@
 //
 
 #pragma once
+#include "rendering/types/Command.h"
 #include "rendering/types/DescriptorSet.h"
 #include "ViewHandles.h"
 
@@ -12,7 +13,7 @@ class Image;
 class Registry
 {
 public:
-    explicit Registry(RenderGraph* renderGraph) noexcept;
+    explicit Registry(RenderGraph* renderGraph, uint32_t passIndex) noexcept;
 
     uint32_t GetBindlessHandle(ResourceViewHandle handle, DescriptorType type) const noexcept;
 
@@ -25,6 +26,15 @@ public:
     void Map(ResourceViewHandle handle, void** data) const noexcept;
     void Unmap(ResourceViewHandle handle) const noexcept;
 
+    // inferred from the usages of the view's subresources before and after the current pass.
+    // DONT_CARE if the previous contents are undefined or nothing reads the attachment afterwards
+    AttachmentLoadOp GetLoadOp(ResourceViewHandle handle) const noexcept;
+    AttachmentStoreOp GetStoreOp(ResourceViewHandle handle) const noexcept;
+
+private:
+    bool IsViewSubresource(ResourceViewHandle handle, uint32_t subresourceIdx) const noexcept;
+
 private:
     RenderGraph* m_graph;
+    uint32_t m_passIndex;
 };
\ No newline at end of file
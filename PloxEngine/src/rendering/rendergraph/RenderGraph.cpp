@@ -2,6 +2,11 @@
 // Created by Ploxie on 2023-05-23.
 //
 #include "RenderGraph.h"
+#include "core/Clock.h"
+#include "core/Logger.h"
+#include "core/Profiler.h"
+#include "EASTL/algorithm.h"
+#include "EASTL/sort.h"
 #include "Registry.h"
 #include "rendering/GraphicsAdapter.h"
 #include "rendering/RenderUtilities.h"
@@ -9,9 +14,33 @@
 #include "rendering/types/BufferView.h"
 #include "rendering/types/Command.h"
 #include "rendering/types/ImageView.h"
-
-RenderGraph::RenderGraph(GraphicsAdapter* adapter, Semaphore** semaphores, uint64_t* semaphoreValues, ResourceViewRegistry* resourceViewRegistry) noexcept
-    : m_adapter(adapter), m_resourceViewRegistry(resourceViewRegistry)
+#include "rendering/types/LoweredBarriers.h"
+#include "utility/memory/LinearAllocator.h"
+#include "utility/ThreadPool.h"
+#include "utility/Utilities.h"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+// a generated barrier with the indices coalescing sorts by. the objects are recreated and the events acquired from a pool,
+// so ordering by their pointers would give a different barrier order from frame to frame
+struct CoalescedBarrier
+{
+    Barrier Barrier;
+    uint32_t ResourceIndex;
+    uint32_t EventKey;
+    uint32_t SrcQueueIndex;
+    uint32_t DstQueueIndex;
+};
+
+static bool IsWriteState(ResourceState state);
+static bool IsSameBarrierState(const CoalescedBarrier& left, const CoalescedBarrier& right);
+static bool IsLessBarrierState(const CoalescedBarrier& left, const CoalescedBarrier& right);
+static uint32_t CoalesceBarriers(CoalescedBarrier* barriers, uint32_t count);
+static PipelineStageFlags GetFirstAccessStagesBefore(PipelineStageFlags aliasingStages);
+
+RenderGraph::RenderGraph(GraphicsAdapter* adapter, Semaphore** semaphores, uint64_t* semaphoreValues, ResourceViewRegistry* resourceViewRegistry, ThreadPool* threadPool) noexcept
+    : m_adapter(adapter), m_resourceViewRegistry(resourceViewRegistry), m_threadPool(threadPool)
 {
     m_queues[0] = m_adapter->GetGraphicsQueue();
     m_queues[1] = m_adapter->GetComputeQueue();
@@ -19,14 +48,18 @@ RenderGraph::RenderGraph(GraphicsAdapter* adapter, Semaphore** semaphores, uint6
 
     for(size_t i = 0; i < 3; i++)
     {
-	m_semaphores[i]	     = semaphores[i];
-	m_semaphoreValues[i] = semaphoreValues + i;
+	m_semaphores[i]		 = semaphores[i];
+	m_semaphoreValues[i]	 = semaphoreValues + i;
+	m_timestampsSupported[i] = m_queues[i]->GetTimestampValidBits() != 0;
     }
 
     for(size_t i = 0; i < FRAME_COUNT; i++)
     {
-	m_frameResources[i].CommandFramePool.Initialize(m_adapter);
+	m_frameResources[i].CommandFramePool.Initialize(m_adapter, m_threadPool->GetThreadCount());
+	m_frameResources[i].ResourcePool.Initialize(m_adapter, MAX_UNUSED_POOLED_RESOURCE_FRAMES);
     }
+
+    m_frameArena = new LinearAllocator(m_frameArenaSize, "Render Graph Frame Arena");
 }
 
 RenderGraph::~RenderGraph() noexcept
@@ -35,6 +68,61 @@ RenderGraph::~RenderGraph() noexcept
     {
 	NextFrame();
     }
+
+    for(auto& compilation: m_compilationCache)
+    {
+	m_adapter->DestroyLoweredBarriers(compilation.second.Lowered);
+    }
+    m_compilationCache.clear();
+
+    for(auto& frameResources: m_frameResources)
+    {
+	m_adapter->DestroyQueryPool(frameResources.TimestampQueryPool);
+	m_adapter->DestroyQueryPool(frameResources.StatisticsQueryPool);
+
+	for(auto& cachedView: frameResources.ViewCache)
+	{
+	    DestroyResourceView(cachedView.second.View);
+	}
+	frameResources.ViewCache.clear();
+
+	// pooled resources may still be bound to the heaps
+	frameResources.ResourcePool.Clear();
+	for(auto* heap: frameResources.TransientHeaps)
+	{
+	    m_adapter->DestroyMemoryHeap(heap);
+	}
+    }
+
+    delete m_frameArena;
+}
+
+template<typename T>
+T* RenderGraph::AllocateFrameArray(size_t count) noexcept
+{
+    T* result = m_frameArena->AllocateArray<T>(count);
+    if(!result)
+    {
+	// the arena grows in the next frame, until then the memory comes from the heap
+	result = static_cast<T*>(malloc(count * sizeof(T)));
+	m_frameArenaOverflowAllocations.push_back(result);
+	m_frameArenaOverflowSize += count * sizeof(T) + alignof(T);
+    }
+    return result;
+}
+
+void* RenderGraph::AllocateFrameMemory(size_t size, size_t alignment) noexcept
+{
+    void* result = m_frameArena->allocate(size, alignment, 0);
+    if(!result)
+    {
+	// malloc is aligned for every fundamental type, over aligned closures are not supported
+	ASSERT(alignment <= alignof(std::max_align_t));
+	result = malloc(size);
+	m_frameArenaOverflowAllocations.push_back(result);
+	m_frameArenaOverflowSize += size + alignment;
+    }
+    return result;
 }
 
 ResourceViewHandle RenderGraph::CreateImageView(const ImageViewDescription& viewDesc) noexcept
@@ -106,7 +194,7 @@ ResourceHandle RenderGraph::CreateImage(const ImageDescription& imageDesc) noexc
 	desc.Format			= imageDesc.Format;
 	desc.OptimizedClearValue	= imageDesc.OptimizedClearValue;
 	desc.SubresourceCount		= desc.Layers * desc.Levels;
-	desc.SubresourceUsageInfoOffset = static_cast<uint32_t>(m_subresourceUsages.size());
+	desc.SubresourceUsageInfoOffset = m_subresourceCount;
 	desc.Concurrent			= false;
 	desc.Image			= true;
     }
@@ -114,10 +202,7 @@ ResourceHandle RenderGraph::CreateImage(const ImageDescription& imageDesc) noexc
     ASSERT(desc.Width && desc.Height && desc.Layers && desc.Levels);
 
     m_resourceDescriptions.push_back(desc);
-    for(size_t i = 0; i < desc.SubresourceCount; ++i)
-    {
-	m_subresourceUsages.push_back({});
-    }
+    m_subresourceCount += desc.SubresourceCount;
 
     return ResourceHandle(m_resourceDescriptions.size());
 }
@@ -131,7 +216,7 @@ ResourceHandle RenderGraph::CreateBuffer(const BufferDescription& bufferDesc) no
 	desc.Offset			= 0;
 	desc.Size			= bufferDesc.Size;
 	desc.SubresourceCount		= 1;
-	desc.SubresourceUsageInfoOffset = static_cast<uint32_t>(m_subresourceUsages.size());
+	desc.SubresourceUsageInfoOffset = m_subresourceCount;
 	desc.Concurrent			= true;
 	desc.HostVisible		= bufferDesc.HostVisible;
     }
@@ -139,7 +224,7 @@ ResourceHandle RenderGraph::CreateBuffer(const BufferDescription& bufferDesc) no
     ASSERT(desc.Size);
 
     m_resourceDescriptions.push_back(desc);
-    m_subresourceUsages.push_back({});
+    m_subresourceCount += desc.SubresourceCount;
 
     return ResourceHandle(m_resourceDescriptions.size());
 }
@@ -162,7 +247,7 @@ ResourceHandle RenderGraph::ImportImage(Image* image, const char* name, Resource
 	desc.Format			= imageDesc.Format;
 	desc.OptimizedClearValue	= imageDesc.OptimizedClearValue;
 	desc.SubresourceCount		= desc.Layers * desc.Levels;
-	desc.SubresourceUsageInfoOffset = static_cast<uint32_t>(m_subresourceUsages.size());
+	desc.SubresourceUsageInfoOffset = m_subresourceCount;
 	desc.ExternalStateData		= resourceStateData;
 	desc.Concurrent			= false;
 	desc.External			= true;
@@ -172,10 +257,7 @@ ResourceHandle RenderGraph::ImportImage(Image* image, const char* name, Resource
     ASSERT(desc.Width && desc.Height && desc.Layers && desc.Levels);
 
     m_resourceDescriptions.push_back(desc);
-    for(size_t i = 0; i < desc.SubresourceCount; ++i)
-    {
-	m_subresourceUsages.push_back({});
-    }
+    m_subresourceCount += desc.SubresourceCount;
 
     auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
     frameResources.Resources.resize(m_resourceDescriptions.size());
@@ -198,7 +280,7 @@ ResourceHandle RenderGraph::ImportBuffer(Buffer* buffer, const char* name, Resou
 	resDesc.Offset			   = 0; // TODO
 	resDesc.Size			   = bufferDesc.Size;
 	resDesc.SubresourceCount	   = 1;
-	resDesc.SubresourceUsageInfoOffset = static_cast<uint32_t>(m_subresourceUsages.size());
+	resDesc.SubresourceUsageInfoOffset = m_subresourceCount;
 	resDesc.ExternalStateData	   = resourceStateData;
 	resDesc.Concurrent		   = true;
 	resDesc.External		   = true;
@@ -207,7 +289,7 @@ ResourceHandle RenderGraph::ImportBuffer(Buffer* buffer, const char* name, Resou
     ASSERT(resDesc.Size);
 
     m_resourceDescriptions.push_back(resDesc);
-    m_subresourceUsages.push_back({});
+    m_subresourceCount += resDesc.SubresourceCount;
 
     auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
     frameResources.Resources.resize(m_resourceDescriptions.size());
@@ -219,48 +301,50 @@ ResourceHandle RenderGraph::ImportBuffer(Buffer* buffer, const char* name, Resou
     return ResourceHandle(m_resourceDescriptions.size());
 }
 
+void RenderGraph::MarkOutput(ResourceHandle resource) noexcept
+{
+    ASSERT(resource != 0 && size_t(resource) <= m_resourceDescriptions.size());
+    m_resourceDescriptions[resource - 1].Output = true;
+}
+
 void RenderGraph::NextFrame() noexcept
 {
+    PROFILE_FUNCTION();
+
     ++m_frame;
 
     // reset old frame resources
     {
 	auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
 
-	// wait on semaphores for queue completion
+	// this is what limits the frames in flight. the slot's command pools, events and queries are reset below and its pooled
+	// resources are handed out again, objects destroyed through the adapter do not depend on it as their destruction is deferred
 	for(size_t i = 0; i < 3; ++i)
 	{
 	    m_semaphores[i]->Wait(frameResources.FinalWaitValues[i]);
 	}
 
-	// destroy internal resources
+	// the frame is done on the gpu so its queries can be read back without stalling
+	ResolvePassTimings();
+
+	// hand internal resources back to the pool so the next frame in this slot can reuse them
 	for(auto& res: frameResources.Resources)
 	{
-	    if(res.External)
+	    if(res.External || (!res.Image && !res.Buffer))
 	    {
 		continue;
 	    }
-	    if(res.Image)
-	    {
-		m_adapter->DestroyImage(res.Image);
-	    }
-	    else if(res.Buffer)
-	    {
-		m_adapter->DestroyBuffer(res.Buffer);
-	    }
+	    frameResources.ResourcePool.Release(res, m_frame);
 	}
 	frameResources.Resources.clear();
+	frameResources.ResourcePool.Evict(m_frame);
 
-	// destroy views
+	// destroy views of external resources, the others stay in the view cache
 	for(auto& view: frameResources.ResourceViews)
 	{
-	    if(view.ImageView)
-	    {
-		m_adapter->DestroyImageView(view.ImageView);
-	    }
-	    else if(view.BufferView)
+	    if(!view.Cached)
 	    {
-		m_adapter->DestroyBufferView(view.BufferView);
+		DestroyResourceView(view);
 	    }
 	}
 	frameResources.ResourceViews.clear();
@@ -273,15 +357,77 @@ void RenderGraph::NextFrame() noexcept
     m_resourceDescriptions.clear();
     m_viewDescriptions.clear();
     m_culledResources.clear();
-    m_subresourceUsages.clear();
+    m_passResourceAccesses.clear();
+    // the closures live in the frame arena, which is reset below
+    for(const auto& passData: m_passData)
+    {
+	if(passData.Closure.Destroy)
+	{
+	    passData.Closure.Destroy(passData.Closure.Data);
+	}
+    }
     m_passData.clear();
     m_recordBatches.clear();
-    m_externalReleaseBarriers[0].clear();
-    m_externalReleaseBarriers[1].clear();
-    m_externalReleaseBarriers[2].clear();
+    m_recordChunks.clear();
+    m_recordedCommands.clear();
+    m_transientResources.clear();
+    m_aliasingBarrierStages.clear();
+    m_splitBarrierEvents.clear();
+    m_resourceUsageInfos.clear();
+    m_compilationKey.clear();
+    m_passHash	  = 0;
+    m_compilation = nullptr;
+
+    // the flat arrays keep their capacity, so a graph of the same size allocates nothing
+    m_usageSubresources.clear();
+    m_usageInitialStates.clear();
+    m_usageFinalStates.clear();
+    m_usageLoadOps.clear();
+    m_usageStoreOps.clear();
+    m_subresourceCount	      = 0;
+    m_subresourceUsageOffsets = nullptr;
+    m_subresourceUsageIndices = nullptr;
+    m_subresourceUsagePasses  = nullptr;
+    m_barriers		      = nullptr;
+    m_barrierCount	      = 0;
+    for(size_t i = 0; i < 3; ++i)
+    {
+	m_externalReleaseBarrierOffsets[i] = 0;
+	m_externalReleaseBarrierCounts[i]  = 0;
+    }
+    DestroyLoweredBarriers();
+
+    // the last frame did not fit into the arena, make it large enough for the next one
+    for(void* allocation: m_frameArenaOverflowAllocations)
+    {
+	free(allocation);
+    }
+    m_frameArenaOverflowAllocations.clear();
+    if(m_frameArenaOverflowSize != 0)
+    {
+	m_frameArenaSize = eastl::max(m_frameArenaSize * 2, m_frameArenaSize + m_frameArenaOverflowSize);
+	delete m_frameArena;
+	m_frameArena		 = new LinearAllocator(m_frameArenaSize, "Render Graph Frame Arena");
+	m_frameArenaOverflowSize = 0;
+    }
+    m_frameArena->Reset();
+
+    // compilations of graphs that have not been built for a while
+    for(auto it = m_compilationCache.begin(); it != m_compilationCache.end();)
+    {
+	if(it->second.LastUsedFrame + MAX_UNUSED_COMPILATION_FRAMES < m_frame)
+	{
+	    m_adapter->DestroyLoweredBarriers(it->second.Lowered);
+	    it = m_compilationCache.erase(it);
+	}
+	else
+	{
+	    ++it;
+	}
+    }
 }
 
-void RenderGraph::AddPass(const char* name, QueueType queueType, size_t usageCount, const ResourceUsageDescription* usageDescs, const RenderGraph::RecordFunc& recordFunc) noexcept
+void RenderGraph::AddPassClosure(const char* name, QueueType queueType, size_t usageCount, const ResourceUsageDescription* usageDescs, const PassClosure& closure) noexcept
 {
 #ifdef _DEBUG
     for(uint32_t i = 0; i < usageCount; ++i)
@@ -294,579 +440,2568 @@ void RenderGraph::AddPass(const char* name, QueueType queueType, size_t usageCou
 #endif // _DEBUG
 
     PassData passData {};
-    passData.RecordFunc = recordFunc;
-    passData.Name	= name;
-    passData.Queue	= m_queues[static_cast<size_t>(queueType)];
+    passData.Closure	 = closure;
+    passData.Name	 = name;
+    passData.Queue	 = m_queues[static_cast<size_t>(queueType)];
+    passData.UsageOffset = static_cast<uint32_t>(m_usageSubresources.size());
 
     const uint16_t passIndex = static_cast<uint16_t>(m_passData.size());
     m_passData.push_back(passData);
 
+    // the name and the record function do not change what the graph compiles to
+    const size_t keyOffset = m_compilationKey.size();
+    m_compilationKey.resize(keyOffset + 2 + usageCount * 5);
+    uint32_t* key = m_compilationKey.data() + keyOffset;
+    *key++	  = static_cast<uint32_t>(queueType);
+    *key++	  = static_cast<uint32_t>(usageCount);
+    Util::HashCombine(m_passHash, static_cast<uint32_t>(queueType));
+    Util::HashCombine(m_passHash, usageCount);
+
     for(size_t i = 0; i < usageCount; ++i)
     {
 	const auto& usage = usageDescs[i];
 	ASSERT(usage.ViewHandle != 0);
-	const auto& viewDesc = m_viewDescriptions[usage.ViewHandle - 1];
-	const SubresourceUsage resUsage { passIndex, usage.StateAndStage, usage.FinalStateAndStage.ResourceState == ResourceState::UNDEFINED ? usage.StateAndStage : usage.FinalStateAndStage };
+	const auto& viewDesc			 = m_viewDescriptions[usage.ViewHandle - 1];
+	const ResourceStateAndStage initialState = usage.StateAndStage;
+	const ResourceStateAndStage finalState	 = usage.FinalStateAndStage.ResourceState == ResourceState::UNDEFINED ? usage.StateAndStage : usage.FinalStateAndStage;
+
+	*key++ = static_cast<uint32_t>(usage.ViewHandle);
+	*key++ = static_cast<uint32_t>(initialState.ResourceState);
+	*key++ = static_cast<uint32_t>(initialState.StageMask);
+	*key++ = static_cast<uint32_t>(finalState.ResourceState);
+	*key++ = static_cast<uint32_t>(finalState.StageMask);
+	Util::HashCombine(m_passHash, static_cast<uint32_t>(usage.ViewHandle));
+	Util::HashCombine(m_passHash, static_cast<uint32_t>(initialState.ResourceState));
+	Util::HashCombine(m_passHash, static_cast<uint32_t>(initialState.StageMask));
+	Util::HashCombine(m_passHash, static_cast<uint32_t>(finalState.ResourceState));
+	Util::HashCombine(m_passHash, static_cast<uint32_t>(finalState.StageMask));
 
 	const size_t resIndex = (size_t) viewDesc.ResourceHandle - 1;
 	const auto& resDesc   = m_resourceDescriptions[resIndex];
 
-	if(resDesc.Image)
-	{
-	    const uint32_t baseLayer  = viewDesc.SubresourceRange.BaseArrayLayer;
-	    const uint32_t layerCount = viewDesc.SubresourceRange.LayerCount;
-	    const uint32_t baseLevel  = viewDesc.SubresourceRange.BaseMipLevel;
-	    const uint32_t levelCount = viewDesc.SubresourceRange.LevelCount;
+	const bool write = IsWriteState(initialState.ResourceState | finalState.ResourceState);
+	m_passResourceAccesses.push_back({ passIndex, static_cast<uint32_t>(resIndex), write });
 
-	    for(uint32_t layer = 0; layer < layerCount; ++layer)
+	const uint32_t baseLayer  = resDesc.Image ? viewDesc.SubresourceRange.BaseArrayLayer : 0;
+	const uint32_t layerCount = resDesc.Image ? viewDesc.SubresourceRange.LayerCount : 1;
+	const uint32_t baseLevel  = resDesc.Image ? viewDesc.SubresourceRange.BaseMipLevel : 0;
+	const uint32_t levelCount = resDesc.Image ? viewDesc.SubresourceRange.LevelCount : 1;
+
+	for(uint32_t layer = 0; layer < layerCount; ++layer)
+	{
+	    for(uint32_t level = 0; level < levelCount; ++level)
 	    {
-		for(uint32_t level = 0; level < levelCount; ++level)
-		{
-		    const uint32_t index = (layer + baseLayer) * resDesc.Levels + (level + baseLevel) + resDesc.SubresourceUsageInfoOffset;
-		    m_subresourceUsages[index].push_back(resUsage);
-		}
+		const uint32_t index = (layer + baseLayer) * resDesc.Levels + (level + baseLevel) + resDesc.SubresourceUsageInfoOffset;
+		m_usageSubresources.push_back(index);
+		m_usageInitialStates.push_back(initialState);
+		m_usageFinalStates.push_back(finalState);
 	    }
 	}
-	else
-	{
-	    m_subresourceUsages[resDesc.SubresourceUsageInfoOffset].push_back(resUsage);
-	}
     }
+
+    m_passData.back().UsageCount = static_cast<uint32_t>(m_usageSubresources.size()) - m_passData.back().UsageOffset;
 }
 
 void RenderGraph::Execute() noexcept
 {
+    PROFILE_FUNCTION();
+
+    // an unchanged graph compiles to the same barriers and batches, only the objects they refer to change
+    const uint64_t compileBegin = Clock::Now();
+    const size_t compilationKey = BuildCompilationKey();
+    if(m_compilationCacheEnabled)
+    {
+	auto it = m_compilationCache.find(compilationKey);
+	if(it != m_compilationCache.end() && it->second.Key == m_compilationKey)
+	{
+	    it->second.LastUsedFrame = m_frame;
+	    m_compilation	     = &it->second;
+	}
+    }
+
+    if(m_compilation)
+    {
+	ApplyCompilation();
+    }
+    else
+    {
+	CullPasses();
+	SortSubresourceUsages();
+	SchedulePasses();
+	PartitionResources();
+	AnalyzeResources();
+	InferAttachmentOps();
+    }
+    uint64_t compileTime = Clock::Now() - compileBegin;
+
     CreateResources();
-    CreateSynchronization();
+
+    const uint64_t synchronizationBegin = Clock::Now();
+    uint64_t synchronizationTime	= 0;
+    if(m_compilation)
+    {
+	PatchSynchronization();
+    }
+    else
+    {
+	CreateSynchronization();
+	LowerBarriers();
+	synchronizationTime = Clock::Now() - synchronizationBegin;
+	if(m_compilationCacheEnabled)
+	{
+	    StoreCompilation(compilationKey);
+	}
+    }
+    compileTime += Clock::Now() - synchronizationBegin;
+    const bool cacheHit = m_compilation != nullptr;
+
+    RenderGraphStatistics statistics   = {};
+    statistics.PassCount	       = static_cast<uint32_t>(m_passData.size());
+    statistics.ResourceCount	       = static_cast<uint32_t>(m_resourceDescriptions.size());
+    statistics.BatchCount	       = static_cast<uint32_t>(m_recordBatches.size());
+    statistics.UnreducedBatchCount     = m_unreducedBatchCount;
+    statistics.UnreducedWaitCount      = m_unreducedWaitCount;
+    statistics.UncoalescedBarrierCount = m_uncoalescedBarrierCount;
+    statistics.BarrierCount	       = m_barrierCount;
+    statistics.SubresourceUsageCount   = static_cast<uint32_t>(m_usageSubresources.size());
+    statistics.SynchronizationTime     = synchronizationTime;
+    statistics.CompilationCacheHit     = cacheHit;
+    statistics.CompilationCacheHits    = m_statistics.CompilationCacheHits + (cacheHit ? 1 : 0);
+    statistics.CompilationCacheMisses  = m_statistics.CompilationCacheMisses + (cacheHit ? 0 : 1);
+    statistics.HitCompileTime	       = m_statistics.HitCompileTime + (cacheHit ? compileTime : 0);
+    statistics.MissCompileTime	       = m_statistics.MissCompileTime + (cacheHit ? 0 : compileTime);
+    for(const auto& passData: m_passData)
+    {
+	statistics.CulledPassCount += passData.Culled ? 1 : 0;
+    }
+    for(size_t i = 0; i < m_culledResources.size(); ++i)
+    {
+	statistics.CulledResourceCount += m_culledResources[i] ? 1 : 0;
+    }
+    for(const auto& batch: m_recordBatches)
+    {
+	for(size_t i = 0; i < 3; ++i)
+	{
+	    statistics.WaitCount += batch.WaitDstStageMasks[i] != 0 ? 1 : 0;
+	}
+    }
+    if(statistics.CulledPassCount != m_statistics.CulledPassCount || statistics.CulledResourceCount != m_statistics.CulledResourceCount || statistics.BatchCount != m_statistics.BatchCount || statistics.BarrierCount != m_statistics.BarrierCount)
+    {
+	LOG_CORE_INFO("Render graph: culled {0} of {1} passes and {2} of {3} resources, {4} batch(es), {5} barriers coalesced into {6}", statistics.CulledPassCount, statistics.PassCount, statistics.CulledResourceCount, statistics.ResourceCount, statistics.BatchCount, statistics.UncoalescedBarrierCount, statistics.BarrierCount);
+	LOG_CORE_INFO("Render graph: {0} semaphore wait(s) reduced to {1}, {2} batch(es) merged into {3}", statistics.UnreducedWaitCount, statistics.WaitCount, statistics.UnreducedBatchCount, statistics.BatchCount);
+    }
+    m_statistics = statistics;
+
     m_resourceViewRegistry->FlushChanges();
     RecordAndSubmit();
 }
 
-void RenderGraph::CreateResources() noexcept
+void RenderGraph::SetPipelineStatisticsEnabled(bool enabled) noexcept
 {
-    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
-    frameResources.Resources.resize(m_resourceDescriptions.size());
-    m_culledResources.resize(m_resourceDescriptions.size());
-    frameResources.ResourceViews.resize(m_viewDescriptions.size());
+    m_pipelineStatisticsEnabled = enabled && m_adapter->IsPipelineStatisticsQuerySupported();
+}
 
-    // create resources
-    const size_t resourceCount = m_resourceDescriptions.size();
-    for(size_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
-    {
-	const auto& resDesc = m_resourceDescriptions[resourceIdx];
+const eastl::vector<PassTiming>& RenderGraph::GetPassTimings() const noexcept
+{
+    return m_passTimings;
+}
 
-	if(resDesc.External)
-	{
-	    continue;
-	}
+void RenderGraph::SetMemoryAliasingEnabled(bool enabled) noexcept
+{
+    m_memoryAliasingEnabled = enabled;
+}
 
-	// check if resource is used at all and also find usage flags
-	bool isReferenced   = false;
-	uint32_t usageFlags = resDesc.UsageFlags;
+const TransientMemoryStatistics& RenderGraph::GetTransientMemoryStatistics() const noexcept
+{
+    return m_transientMemoryStatistics;
+}
 
-	const size_t subresourceCount = resDesc.SubresourceCount;
-	for(size_t subresourceIdx = 0; subresourceIdx < subresourceCount; ++subresourceIdx)
-	{
-	    const size_t subresourceUsageIdx = subresourceIdx + resDesc.SubresourceUsageInfoOffset;
+TransientResourcePoolStatistics RenderGraph::GetResourcePoolStatistics() const noexcept
+{
+    TransientResourcePoolStatistics statistics = {};
+    for(const auto& frameResources: m_frameResources)
+    {
+	const auto& poolStatistics = frameResources.ResourcePool.GetStatistics();
+	statistics.Hits += poolStatistics.Hits;
+	statistics.Misses += poolStatistics.Misses;
+	statistics.Evictions += poolStatistics.Evictions;
+	statistics.PooledCount += poolStatistics.PooledCount;
+    }
+    return statistics;
+}
+
+void RenderGraph::SetPassCullingEnabled(bool enabled) noexcept
+{
+    m_passCullingEnabled = enabled;
+}
 
-	    // check if subresource is used at all
-	    isReferenced = isReferenced || !m_subresourceUsages[subresourceUsageIdx].empty();
+void RenderGraph::SetPassSchedulingEnabled(bool enabled) noexcept
+{
+    m_passSchedulingEnabled = enabled;
+}
 
-	    // get usage flags
-	    for(const auto& usage: m_subresourceUsages[subresourceUsageIdx])
+void RenderGraph::SetCompilationCacheEnabled(bool enabled) noexcept
+{
+    m_compilationCacheEnabled = enabled;
+    if(!enabled)
+    {
+	// the lowered barriers of this frame may belong to a cached compilation and are still needed until it is recorded
+	for(auto& compilation: m_compilationCache)
+	{
+	    if(compilation.second.Lowered != m_loweredBarriers)
 	    {
-		usageFlags |= RenderUtilities::GetUsageFlags(usage.InitialResourceState.ResourceState, resDesc.Image);
-		usageFlags |= RenderUtilities::GetUsageFlags(usage.FinalResourceState.ResourceState, resDesc.Image);
+		m_adapter->DestroyLoweredBarriers(compilation.second.Lowered);
 	    }
 	}
+	m_loweredBarriersCached = false;
+	m_compilationCache.clear();
+    }
+}
+
+void RenderGraph::SetDeferredRecordingEnabled(bool enabled) noexcept
+{
+    m_deferredRecordingEnabled = enabled;
+}
+
+const RenderGraphStatistics& RenderGraph::GetStatistics() const noexcept
+{
+    return m_statistics;
+}
+
+void RenderGraph::CullPasses() noexcept
+{
+    PROFILE_FUNCTION();
+
+    if(!m_passCullingEnabled)
+    {
+	return;
+    }
+
+    // resources whose contents leave the graph are the roots everything else is culled from
+    const size_t resourceCount = m_resourceDescriptions.size();
+    eastl::bitvector<> requiredResources(resourceCount);
+    for(size_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+    {
+	const auto& resDesc	       = m_resourceDescriptions[resourceIdx];
+	requiredResources[resourceIdx] = resDesc.External || resDesc.Output || resDesc.HostVisible;
+    }
 
-	// resource has no references -> no need to create an actual resource
-	if(!isReferenced)
+    // walk the passes backwards, a pass is needed if it writes a required resource.
+    // everything a needed pass accesses becomes required, writes included because attachments may be loaded or blended
+    size_t accessEnd = m_passResourceAccesses.size();
+    for(size_t passIdx = m_passData.size(); passIdx-- > 0;)
+    {
+	size_t accessBegin = accessEnd;
+	while(accessBegin > 0 && m_passResourceAccesses[accessBegin - 1].PassHandle == passIdx)
 	{
-	    m_culledResources[resourceIdx] = true;
-	    continue;
+	    --accessBegin;
 	}
 
-	// is resource image or buffer?
-	if(resDesc.Image)
+	// a pass without resources has side effects the graph knows nothing about
+	bool needed = accessBegin == accessEnd;
+	for(size_t i = accessBegin; i < accessEnd && !needed; ++i)
 	{
-	    // create image
-	    ImageCreateInfo imageCreateInfo {};
-	    imageCreateInfo.Width		= resDesc.Width;
-	    imageCreateInfo.Height		= resDesc.Height;
-	    imageCreateInfo.Depth		= resDesc.Depth;
-	    imageCreateInfo.Levels		= resDesc.Levels;
-	    imageCreateInfo.Layers		= resDesc.Layers;
-	    imageCreateInfo.Samples		= resDesc.Samples;
-	    imageCreateInfo.ImageType		= resDesc.ImageType;
-	    imageCreateInfo.Format		= resDesc.Format;
-	    imageCreateInfo.CreateFlags		= resDesc.ImageFlags;
-	    imageCreateInfo.UsageFlags		= static_cast<ImageUsageFlags>(usageFlags);
-	    imageCreateInfo.OptimizedClearValue = resDesc.OptimizedClearValue;
+	    needed = m_passResourceAccesses[i].Write && requiredResources[m_passResourceAccesses[i].ResourceIndex];
+	}
 
-	    m_adapter->CreateImage(imageCreateInfo, MemoryPropertyFlags::DEVICE_LOCAL_BIT, {}, false, &frameResources.Resources[resourceIdx].Image);
-	    m_adapter->SetDebugObjectName(ObjectType::IMAGE, frameResources.Resources[resourceIdx].Image, resDesc.Name);
+	if(needed)
+	{
+	    for(size_t i = accessBegin; i < accessEnd; ++i)
+	    {
+		requiredResources[m_passResourceAccesses[i].ResourceIndex] = true;
+	    }
 	}
 	else
 	{
-	    // create buffer
-	    BufferCreateInfo bufferCreateInfo {};
-	    bufferCreateInfo.Size	 = resDesc.Size;
-	    bufferCreateInfo.CreateFlags = {};
-	    bufferCreateInfo.UsageFlags	 = static_cast<BufferUsageFlags>(usageFlags);
+	    m_passData[passIdx].Culled = true;
+	}
 
-	    auto requiredFlags	= resDesc.HostVisible ? (MemoryPropertyFlags::HOST_VISIBLE_BIT | MemoryPropertyFlags::HOST_COHERENT_BIT) : MemoryPropertyFlags::DEVICE_LOCAL_BIT;
-	    auto preferredFlags = resDesc.HostVisible ? MemoryPropertyFlags::DEVICE_LOCAL_BIT : MemoryPropertyFlags {};
+	accessEnd = accessBegin;
+    }
+}
 
-	    m_adapter->CreateBuffer(bufferCreateInfo, requiredFlags, preferredFlags, false, &frameResources.Resources[resourceIdx].Buffer);
-	    m_adapter->SetDebugObjectName(ObjectType::BUFFER, frameResources.Resources[resourceIdx].Buffer, resDesc.Name);
+void RenderGraph::SortSubresourceUsages() noexcept
+{
+    PROFILE_FUNCTION();
+
+    // counting sort by subresource. walking the passes in execution order keeps the usages of every subresource in that order.
+    // without their usages culled passes get no barriers, and resources only they used are culled as well
+    m_subresourceUsageOffsets = AllocateFrameArray<uint32_t>(m_subresourceCount + 1);
+    memset(m_subresourceUsageOffsets, 0, (m_subresourceCount + 1) * sizeof(uint32_t));
+
+    uint32_t usageCount = 0;
+    for(const auto& passData: m_passData)
+    {
+	if(passData.Culled)
+	{
+	    continue;
+	}
+	for(uint32_t i = passData.UsageOffset; i < passData.UsageOffset + passData.UsageCount; ++i)
+	{
+	    ++m_subresourceUsageOffsets[m_usageSubresources[i] + 1];
 	}
+	usageCount += passData.UsageCount;
     }
-
-    // create views
-    const size_t viewCount = m_viewDescriptions.size();
-    for(uint32_t viewIndex = 0; viewIndex < m_viewDescriptions.size(); ++viewIndex)
+    for(uint32_t i = 0; i < m_subresourceCount; ++i)
     {
-	const auto& viewDesc = m_viewDescriptions[viewIndex];
+	m_subresourceUsageOffsets[i + 1] += m_subresourceUsageOffsets[i];
+    }
 
-	if(m_culledResources[viewDesc.ResourceHandle - 1])
+    uint32_t* cursors = AllocateFrameArray<uint32_t>(m_subresourceCount);
+    memcpy(cursors, m_subresourceUsageOffsets, m_subresourceCount * sizeof(uint32_t));
+
+    m_subresourceUsageIndices = AllocateFrameArray<uint32_t>(usageCount);
+    m_subresourceUsagePasses  = AllocateFrameArray<uint16_t>(usageCount);
+    for(size_t passIdx = 0; passIdx < m_passData.size(); ++passIdx)
+    {
+	const auto& passData = m_passData[passIdx];
+	if(passData.Culled)
 	{
 	    continue;
 	}
+	for(uint32_t i = passData.UsageOffset; i < passData.UsageOffset + passData.UsageCount; ++i)
+	{
+	    const uint32_t position		= cursors[m_usageSubresources[i]]++;
+	    m_subresourceUsageIndices[position] = i;
+	    m_subresourceUsagePasses[position]	= static_cast<uint16_t>(passIdx);
+	}
+    }
+}
 
-	auto& viewData = frameResources.ResourceViews[viewIndex];
-	viewData       = {};
+void RenderGraph::SchedulePasses() noexcept
+{
+    PROFILE_FUNCTION();
 
-	if(viewDesc.Image)
-	{
-	    ImageViewCreateInfo viewCreateInfo {};
-	    {
-		viewCreateInfo.Image	      = frameResources.Resources[viewDesc.ResourceHandle - 1].Image;
-		viewCreateInfo.ViewType	      = viewDesc.ViewType;
-		viewCreateInfo.Format	      = viewDesc.Format;
-		viewCreateInfo.Components     = viewDesc.Components;
-		viewCreateInfo.BaseMipLevel   = viewDesc.SubresourceRange.BaseMipLevel;
-		viewCreateInfo.LevelCount     = viewDesc.SubresourceRange.LevelCount;
-		viewCreateInfo.BaseArrayLayer = viewDesc.SubresourceRange.BaseArrayLayer;
-		viewCreateInfo.LayerCount     = viewDesc.SubresourceRange.LayerCount;
-	    }
+    m_passOrder.clear();
 
-	    m_adapter->CreateImageView(&viewCreateInfo, &viewData.ImageView);
-	    m_adapter->SetDebugObjectName(ObjectType::IMAGE_VIEW, viewData.ImageView, viewDesc.Name);
+    const size_t passCount = m_passData.size();
+    if(!m_passSchedulingEnabled || passCount < 2)
+    {
+	return;
+    }
 
-	    const auto usageFlags = viewCreateInfo.Image->GetDescription().UsageFlags;
+    m_passScheduler.Reset(passCount);
+    for(size_t i = 0; i < passCount; ++i)
+    {
+	const auto& passData = m_passData[i];
+	m_passScheduler.SetPass(static_cast<uint16_t>(i), static_cast<uint32_t>(passData.Queue->GetQueueType()), passData.Culled);
+    }
 
-	    if((usageFlags & ImageUsageFlags::TEXTURE_BIT) != 0)
+    // a write has to stay behind every earlier access of the subresource, a read only behind the last write.
+    // a custom final state counts as a write because the order of the transitions matters
+    for(uint32_t subresourceIdx = 0; subresourceIdx < m_subresourceCount; ++subresourceIdx)
+    {
+	const uint32_t usageBegin = m_subresourceUsageOffsets[subresourceIdx];
+	const uint32_t usageEnd	  = m_subresourceUsageOffsets[subresourceIdx + 1];
+
+	uint16_t lastWrite = UINT16_MAX;
+	uint32_t readBegin = usageBegin;
+	for(uint32_t i = usageBegin; i < usageEnd; ++i)
+	{
+	    const uint16_t passHandle	     = m_subresourceUsagePasses[i];
+	    const ResourceState initialState = m_usageInitialStates[m_subresourceUsageIndices[i]].ResourceState;
+	    const ResourceState finalState   = m_usageFinalStates[m_subresourceUsageIndices[i]].ResourceState;
+	    const bool write		     = IsWriteState(initialState | finalState) || initialState != finalState;
+
+	    if(lastWrite != UINT16_MAX)
 	    {
-		viewData.TextureHandle = m_resourceViewRegistry->CreateTextureViewHandle(viewData.ImageView, true);
+		m_passScheduler.AddDependency(lastWrite, passHandle);
 	    }
-	    if((usageFlags & ImageUsageFlags::RW_TEXTURE_BIT) != 0)
+	    if(write)
 	    {
-		viewData.RWTextureHandle = m_resourceViewRegistry->CreateRWTextureViewHandle(viewData.ImageView, true);
+		for(uint32_t j = readBegin; j < i; ++j)
+		{
+		    m_passScheduler.AddDependency(m_subresourceUsagePasses[j], passHandle);
+		}
+		lastWrite = passHandle;
+		readBegin = i + 1;
 	    }
 	}
-	else if(viewDesc.Format != Format::UNDEFINED)
-	{
-	    BufferViewCreateInfo viewCreateInfo = {};
-	    {
-		viewCreateInfo.Buffer = frameResources.Resources[viewDesc.ResourceHandle - 1].Buffer;
-		viewCreateInfo.Format = viewDesc.Format;
-		viewCreateInfo.Offset = viewDesc.Offset;
-		viewCreateInfo.Range  = viewDesc.Range;
-	    }
+    }
 
-	    m_adapter->CreateBufferView(&viewCreateInfo, &viewData.BufferView);
-	    m_adapter->SetDebugObjectName(ObjectType::BUFFER_VIEW, viewData.BufferView, viewDesc.Name);
+    // passes without resources have side effects the graph knows nothing about, they keep their place relative to all other passes
+    eastl::bitvector<> hasResources(passCount);
+    for(const auto& access: m_passResourceAccesses)
+    {
+	hasResources[access.PassHandle] = true;
+    }
+    uint16_t lastFixedPass = UINT16_MAX;
+    for(uint16_t i = 0; i < passCount; ++i)
+    {
+	if(m_passData[i].Culled)
+	{
+	    continue;
 	}
 
-	if(!viewDesc.Image)
+	if(!hasResources[i])
 	{
-	    auto buffer			    = frameResources.Resources[viewDesc.ResourceHandle - 1].Buffer;
-	    const auto usageFlags	    = buffer->GetDescription().UsageFlags;
+	    for(uint16_t j = lastFixedPass == UINT16_MAX ? 0 : lastFixedPass; j < i; ++j)
+	    {
+		if(!m_passData[j].Culled)
+		{
+		    m_passScheduler.AddDependency(j, i);
+		}
+	    }
+	    lastFixedPass = i;
+	}
+	else if(lastFixedPass != UINT16_MAX)
+	{
+	    m_passScheduler.AddDependency(lastFixedPass, i);
+	}
+    }
+
+    m_passOrder.resize(passCount);
+    m_passScheduler.Schedule(m_passOrder.data());
+
+    bool reordered = false;
+    m_passRemap.resize(passCount);
+    for(size_t i = 0; i < passCount; ++i)
+    {
+	m_passRemap[m_passOrder[i]] = static_cast<uint16_t>(i);
+	reordered		    = reordered || m_passOrder[i] != i;
+    }
+
+    if(!reordered)
+    {
+	return;
+    }
+
+    eastl::vector<PassData> passData;
+    passData.reserve(passCount);
+    for(size_t i = 0; i < passCount; ++i)
+    {
+	passData.push_back(eastl::move(m_passData[m_passOrder[i]]));
+    }
+    m_passData.swap(passData);
+
+    // usages have to be in execution order again
+    SortSubresourceUsages();
+    for(auto& access: m_passResourceAccesses)
+    {
+	access.PassHandle = m_passRemap[access.PassHandle];
+    }
+    eastl::stable_sort(m_passResourceAccesses.begin(), m_passResourceAccesses.end(), [](const PassResourceAccess& left, const PassResourceAccess& right)
+    {
+	return left.PassHandle < right.PassHandle;
+    });
+}
+
+void RenderGraph::PartitionResources() noexcept
+{
+    PROFILE_FUNCTION();
+
+    // cut the resources into chunks of roughly equal usage counts. a chunk only touches its own resources and
+    // usages, so chunks can be compiled on different threads and merged in order
+    const uint32_t resourceCount  = static_cast<uint32_t>(m_resourceDescriptions.size());
+    const uint32_t usageCount	  = m_subresourceUsageOffsets[m_subresourceCount];
+    const uint32_t threadCount	  = m_threadPool->GetThreadCount();
+    const uint32_t usagesPerChunk = eastl::max<uint32_t>(MIN_USAGES_PER_COMPILE_CHUNK, (usageCount + threadCount * 2 - 1) / (threadCount * 2));
+
+    m_resourceChunkOffsets.clear();
+    m_resourceChunkOffsets.push_back(0);
+
+    uint32_t chunkUsageBegin = 0;
+    for(uint32_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+    {
+	const auto& resDesc	= m_resourceDescriptions[resourceIdx];
+	const uint32_t usageEnd = m_subresourceUsageOffsets[resDesc.SubresourceUsageInfoOffset + resDesc.SubresourceCount];
+	if(usageEnd - chunkUsageBegin >= usagesPerChunk)
+	{
+	    m_resourceChunkOffsets.push_back(resourceIdx + 1);
+	    chunkUsageBegin = usageEnd;
+	}
+    }
+    if(m_resourceChunkOffsets.back() != resourceCount)
+    {
+	m_resourceChunkOffsets.push_back(resourceCount);
+    }
+}
+
+void RenderGraph::AnalyzeResources() noexcept
+{
+    PROFILE_FUNCTION();
+
+    const size_t resourceCount = m_resourceDescriptions.size();
+    m_culledResources.resize(resourceCount);
+    m_resourceUsageInfos.resize(resourceCount);
+
+    const uint32_t chunkCount = static_cast<uint32_t>(m_resourceChunkOffsets.size()) - 1;
+    m_threadPool->ParallelFor(chunkCount, [&](uint32_t chunkIndex, uint32_t)
+    {
+	PROFILE_ZONE("AnalyzeChunk");
+
+	for(uint32_t resourceIdx = m_resourceChunkOffsets[chunkIndex]; resourceIdx < m_resourceChunkOffsets[chunkIndex + 1]; ++resourceIdx)
+	{
+	    const auto& resDesc = m_resourceDescriptions[resourceIdx];
+
+	    // lifetime of the resource, used to find resources that can share memory
+	    auto& usageInfo	  = m_resourceUsageInfos[resourceIdx];
+	    usageInfo		  = {};
+	    usageInfo.UsageFlags  = resDesc.UsageFlags;
+	    usageInfo.FirstPass	  = UINT16_MAX;
+	    usageInfo.SingleQueue = true;
+
+	    if(resDesc.External)
+	    {
+		continue;
+	    }
+
+	    // find usage flags, a resource without usages keeps its invalid first pass
+	    Queue* queue = nullptr;
+
+	    const size_t subresourceCount = resDesc.SubresourceCount;
+	    for(size_t subresourceIdx = 0; subresourceIdx < subresourceCount; ++subresourceIdx)
+	    {
+		const size_t subresourceUsageIdx = subresourceIdx + resDesc.SubresourceUsageInfoOffset;
+		const uint32_t usageBegin	 = m_subresourceUsageOffsets[subresourceUsageIdx];
+		const uint32_t usageEnd		 = m_subresourceUsageOffsets[subresourceUsageIdx + 1];
+
+		for(uint32_t i = usageBegin; i < usageEnd; ++i)
+		{
+		    const uint16_t passHandle = m_subresourceUsagePasses[i];
+		    const auto& initialState  = m_usageInitialStates[m_subresourceUsageIndices[i]];
+		    const auto& finalState    = m_usageFinalStates[m_subresourceUsageIndices[i]];
+
+		    usageInfo.UsageFlags |= RenderUtilities::GetUsageFlags(initialState.ResourceState, resDesc.Image);
+		    usageInfo.UsageFlags |= RenderUtilities::GetUsageFlags(finalState.ResourceState, resDesc.Image);
+
+		    usageInfo.FirstPass = eastl::min(usageInfo.FirstPass, passHandle);
+		    usageInfo.LastPass	= eastl::max(usageInfo.LastPass, passHandle);
+		    usageInfo.StageMask |= initialState.StageMask | finalState.StageMask;
+
+		    Queue* passQueue	  = m_passData[passHandle].Queue;
+		    usageInfo.SingleQueue = usageInfo.SingleQueue && (queue == nullptr || queue == passQueue);
+		    queue		  = passQueue;
+		}
+	    }
+
+	    if(queue)
+	    {
+		usageInfo.QueueIndex = static_cast<uint16_t>(queue->GetQueueType());
+	    }
+	}
+    });
+
+    // resource has no references -> no need to create an actual resource.
+    // the bits share words, so they are written here instead of on the workers
+    for(size_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+    {
+	m_culledResources[resourceIdx] = !m_resourceDescriptions[resourceIdx].External && m_resourceUsageInfos[resourceIdx].FirstPass == UINT16_MAX;
+    }
+}
+
+void RenderGraph::InferAttachmentOps() noexcept
+{
+    PROFILE_FUNCTION();
+
+    // usages of culled passes are never recorded and keep the conservative ops
+    m_usageLoadOps.assign(m_usageSubresources.size(), AttachmentLoadOp::LOAD);
+    m_usageStoreOps.assign(m_usageSubresources.size(), AttachmentStoreOp::STORE);
+
+    const uint32_t chunkCount = static_cast<uint32_t>(m_resourceChunkOffsets.size()) - 1;
+    m_threadPool->ParallelFor(chunkCount, [&](uint32_t chunkIndex, uint32_t)
+    {
+	PROFILE_ZONE("InferAttachmentOpsChunk");
+
+	for(uint32_t resourceIdx = m_resourceChunkOffsets[chunkIndex]; resourceIdx < m_resourceChunkOffsets[chunkIndex + 1]; ++resourceIdx)
+	{
+	    const auto& resDesc = m_resourceDescriptions[resourceIdx];
+	    if(!resDesc.Image)
+	    {
+		continue;
+	    }
+
+	    // contents outlive the graph if they were imported or marked as an output
+	    const bool keepContents = resDesc.External || resDesc.Output;
+
+	    for(uint32_t subresourceIdx = 0; subresourceIdx < resDesc.SubresourceCount; ++subresourceIdx)
+	    {
+		const uint32_t subresourceUsageIdx = subresourceIdx + resDesc.SubresourceUsageInfoOffset;
+		const uint32_t usageBegin	   = m_subresourceUsageOffsets[subresourceUsageIdx];
+		const uint32_t usageEnd		   = m_subresourceUsageOffsets[subresourceUsageIdx + 1];
+		if(usageBegin == usageEnd)
+		{
+		    continue;
+		}
+
+		// a transient resource starts out undefined, an imported one only if it was left undefined or its state is unknown
+		const auto* extInfo    = resDesc.ExternalStateData ? &resDesc.ExternalStateData[subresourceIdx] : nullptr;
+		const bool initialized = extInfo && extInfo->StateAndStage.ResourceState != ResourceState::UNDEFINED;
+
+		m_usageLoadOps[m_subresourceUsageIndices[usageBegin]]	 = initialized ? AttachmentLoadOp::LOAD : AttachmentLoadOp::DONT_CARE;
+		m_usageStoreOps[m_subresourceUsageIndices[usageEnd - 1]] = keepContents ? AttachmentStoreOp::STORE : AttachmentStoreOp::DONT_CARE;
+	    }
+	}
+    });
+}
+
+void RenderGraph::CreateResources() noexcept
+{
+    PROFILE_FUNCTION();
+
+    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
+    frameResources.Resources.resize(m_resourceDescriptions.size());
+    m_aliasingBarrierStages.resize(m_resourceDescriptions.size());
+    frameResources.ResourceViews.resize(m_viewDescriptions.size());
+
+    // create resources
+    const size_t resourceCount = m_resourceDescriptions.size();
+    for(size_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+    {
+	const auto& resDesc = m_resourceDescriptions[resourceIdx];
+
+	if(resDesc.External || m_culledResources[resourceIdx])
+	{
+	    continue;
+	}
+
+	const auto& usageInfo	  = m_resourceUsageInfos[resourceIdx];
+	const uint32_t usageFlags = usageInfo.UsageFlags;
+
+	// host visible resources are mapped by the passes and multi queue resources would need cross queue synchronization for the memory hand-off
+	const bool aliasable = m_memoryAliasingEnabled && usageInfo.SingleQueue && !resDesc.HostVisible;
+
+	TransientResource transientResource {};
+	transientResource.ResourceIndex = static_cast<uint32_t>(resourceIdx);
+	transientResource.FirstPass	= usageInfo.FirstPass;
+	transientResource.LastPass	= usageInfo.LastPass;
+	transientResource.QueueIndex	= usageInfo.QueueIndex;
+	transientResource.StageMask	= usageInfo.StageMask;
+
+	// is resource image or buffer?
+	if(resDesc.Image)
+	{
+	    // create image
+	    ImageCreateInfo imageCreateInfo {};
+	    imageCreateInfo.Width		= resDesc.Width;
+	    imageCreateInfo.Height		= resDesc.Height;
+	    imageCreateInfo.Depth		= resDesc.Depth;
+	    imageCreateInfo.Levels		= resDesc.Levels;
+	    imageCreateInfo.Layers		= resDesc.Layers;
+	    imageCreateInfo.Samples		= resDesc.Samples;
+	    imageCreateInfo.ImageType		= resDesc.ImageType;
+	    imageCreateInfo.Format		= resDesc.Format;
+	    imageCreateInfo.CreateFlags		= resDesc.ImageFlags;
+	    imageCreateInfo.UsageFlags		= static_cast<ImageUsageFlags>(usageFlags);
+	    imageCreateInfo.OptimizedClearValue = resDesc.OptimizedClearValue;
+
+	    frameResources.ResourcePool.AcquireImage(imageCreateInfo, aliasable, resDesc.Name, &frameResources.Resources[resourceIdx]);
+	    if(aliasable)
+	    {
+		m_adapter->GetMemoryRequirements(frameResources.Resources[resourceIdx].Image, &transientResource.MemoryRequirements);
+		m_transientResources.push_back(transientResource);
+	    }
+	}
+	else
+	{
+	    // create buffer
+	    BufferCreateInfo bufferCreateInfo {};
+	    bufferCreateInfo.Size	 = resDesc.Size;
+	    bufferCreateInfo.CreateFlags = {};
+	    bufferCreateInfo.UsageFlags	 = static_cast<BufferUsageFlags>(usageFlags);
+
+	    auto requiredFlags	= resDesc.HostVisible ? (MemoryPropertyFlags::HOST_VISIBLE_BIT | MemoryPropertyFlags::HOST_COHERENT_BIT) : MemoryPropertyFlags::DEVICE_LOCAL_BIT;
+	    auto preferredFlags = resDesc.HostVisible ? MemoryPropertyFlags::DEVICE_LOCAL_BIT : MemoryPropertyFlags {};
+
+	    frameResources.ResourcePool.AcquireBuffer(bufferCreateInfo, requiredFlags, preferredFlags, aliasable, resDesc.Name, &frameResources.Resources[resourceIdx]);
+	    if(aliasable)
+	    {
+		m_adapter->GetMemoryRequirements(frameResources.Resources[resourceIdx].Buffer, &transientResource.MemoryRequirements);
+		m_transientResources.push_back(transientResource);
+	    }
+	}
+    }
+
+    // place the unbound resources into shared memory
+    AllocateTransientMemory();
+
+    // create views
+    const size_t viewCount = m_viewDescriptions.size();
+    for(uint32_t viewIndex = 0; viewIndex < m_viewDescriptions.size(); ++viewIndex)
+    {
+	const auto& viewDesc = m_viewDescriptions[viewIndex];
+
+	if(m_culledResources[viewDesc.ResourceHandle - 1])
+	{
+	    continue;
+	}
+
+	auto& viewData = frameResources.ResourceViews[viewIndex];
+	viewData       = {};
+
+	// views of pooled resources live as long as the resource is used, so an unchanged graph creates no views and handles.
+	// external resources can change or be destroyed between frames and only get transient views
+	const auto& res	     = frameResources.Resources[viewDesc.ResourceHandle - 1];
+	const bool cacheable = !res.External;
+	const size_t viewKey = cacheable ? HashViewDescription(viewDesc, res.Id) : 0;
+	if(cacheable)
+	{
+	    bool found = false;
+	    auto range = frameResources.ViewCache.equal_range(viewKey);
+	    for(auto it = range.first; it != range.second; ++it)
+	    {
+		if(it->second.ResourceId == res.Id && IsSameView(it->second.Description, viewDesc))
+		{
+		    it->second.LastUsedFrame = m_frame;
+		    viewData		     = it->second.View;
+		    found		     = true;
+		    break;
+		}
+	    }
+	    if(found)
+	    {
+		continue;
+	    }
+	}
+
+	if(viewDesc.Image)
+	{
+	    ImageViewCreateInfo viewCreateInfo {};
+	    {
+		viewCreateInfo.Image	      = frameResources.Resources[viewDesc.ResourceHandle - 1].Image;
+		viewCreateInfo.ViewType	      = viewDesc.ViewType;
+		viewCreateInfo.Format	      = viewDesc.Format;
+		viewCreateInfo.Components     = viewDesc.Components;
+		viewCreateInfo.BaseMipLevel   = viewDesc.SubresourceRange.BaseMipLevel;
+		viewCreateInfo.LevelCount     = viewDesc.SubresourceRange.LevelCount;
+		viewCreateInfo.BaseArrayLayer = viewDesc.SubresourceRange.BaseArrayLayer;
+		viewCreateInfo.LayerCount     = viewDesc.SubresourceRange.LayerCount;
+	    }
+
+	    m_adapter->CreateImageView(&viewCreateInfo, &viewData.ImageView);
+	    m_adapter->SetDebugObjectName(ObjectType::IMAGE_VIEW, viewData.ImageView, viewDesc.Name);
+
+	    const auto usageFlags = viewCreateInfo.Image->GetDescription().UsageFlags;
+
+	    if((usageFlags & ImageUsageFlags::TEXTURE_BIT) != 0)
+	    {
+		viewData.TextureHandle = m_resourceViewRegistry->CreateTextureViewHandle(viewData.ImageView, !cacheable);
+	    }
+	    if((usageFlags & ImageUsageFlags::RW_TEXTURE_BIT) != 0)
+	    {
+		viewData.RWTextureHandle = m_resourceViewRegistry->CreateRWTextureViewHandle(viewData.ImageView, !cacheable);
+	    }
+	}
+	else if(viewDesc.Format != Format::UNDEFINED)
+	{
+	    BufferViewCreateInfo viewCreateInfo = {};
+	    {
+		viewCreateInfo.Buffer = frameResources.Resources[viewDesc.ResourceHandle - 1].Buffer;
+		viewCreateInfo.Format = viewDesc.Format;
+		viewCreateInfo.Offset = viewDesc.Offset;
+		viewCreateInfo.Range  = viewDesc.Range;
+	    }
+
+	    m_adapter->CreateBufferView(&viewCreateInfo, &viewData.BufferView);
+	    m_adapter->SetDebugObjectName(ObjectType::BUFFER_VIEW, viewData.BufferView, viewDesc.Name);
+	}
+
+	if(!viewDesc.Image)
+	{
+	    auto buffer			    = frameResources.Resources[viewDesc.ResourceHandle - 1].Buffer;
+	    const auto usageFlags	    = buffer->GetDescription().UsageFlags;
 	    const auto& resDesc		    = m_resourceDescriptions[viewDesc.ResourceHandle - 1];
 	    DescriptorBufferInfo bufferInfo = { buffer, resDesc.Offset + viewDesc.Offset, viewDesc.Range, viewDesc.StructureByteStride };
 
 	    if((usageFlags & BufferUsageFlags::TYPED_BUFFER_BIT) != 0 && viewData.BufferView)
 	    {
-		viewData.TypedBufferHandle = m_resourceViewRegistry->CreateTypedBufferViewHandle(viewData.BufferView, true);
+		viewData.TypedBufferHandle = m_resourceViewRegistry->CreateTypedBufferViewHandle(viewData.BufferView, !cacheable);
 	    }
 	    if((usageFlags & BufferUsageFlags::RW_TYPED_BUFFER_BIT) != 0 && viewData.BufferView)
 	    {
-		viewData.RWTypedBufferHandle = m_resourceViewRegistry->CreateRWTypedBufferViewHandle(viewData.BufferView, true);
+		viewData.RWTypedBufferHandle = m_resourceViewRegistry->CreateRWTypedBufferViewHandle(viewData.BufferView, !cacheable);
 	    }
 	    if((usageFlags & BufferUsageFlags::BYTE_BUFFER_BIT) != 0)
 	    {
-		viewData.ByteBufferHandle = m_resourceViewRegistry->CreateByteBufferViewHandle(bufferInfo, true);
+		viewData.ByteBufferHandle = m_resourceViewRegistry->CreateByteBufferViewHandle(bufferInfo, !cacheable);
 	    }
 	    if((usageFlags & BufferUsageFlags::RW_BYTE_BUFFER_BIT) != 0)
 	    {
-		viewData.RWByteBufferHandle = m_resourceViewRegistry->CreateRWByteBufferViewHandle(bufferInfo, true);
+		viewData.RWByteBufferHandle = m_resourceViewRegistry->CreateRWByteBufferViewHandle(bufferInfo, !cacheable);
 	    }
 	    if(viewDesc.StructureByteStride != 0 && (usageFlags & BufferUsageFlags::STRUCTURED_BUFFER_BIT) != 0)
 	    {
-		viewData.StructuredBufferHandle = m_resourceViewRegistry->CreateStructuredBufferViewHandle(bufferInfo, true);
+		viewData.StructuredBufferHandle = m_resourceViewRegistry->CreateStructuredBufferViewHandle(bufferInfo, !cacheable);
 	    }
 	    if(viewDesc.StructureByteStride != 0 && (usageFlags & BufferUsageFlags::RW_STRUCTURED_BUFFER_BIT) != 0)
 	    {
-		viewData.RWStructuredBufferHandle = m_resourceViewRegistry->CreateRWStructuredBufferViewHandle(bufferInfo, true);
+		viewData.RWStructuredBufferHandle = m_resourceViewRegistry->CreateRWStructuredBufferViewHandle(bufferInfo, !cacheable);
 	    }
 	}
+
+	if(cacheable)
+	{
+	    viewData.Cached = true;
+
+	    CachedResourceView cachedView = {};
+	    cachedView.View		  = viewData;
+	    cachedView.Description	  = viewDesc;
+	    cachedView.ResourceId	  = res.Id;
+	    cachedView.LastUsedFrame	  = m_frame;
+	    frameResources.ViewCache.insert(eastl::make_pair(viewKey, cachedView));
+	}
+    }
+
+    // views that were not used this frame may belong to resources the pool already destroyed
+    for(auto it = frameResources.ViewCache.begin(); it != frameResources.ViewCache.end();)
+    {
+	if(it->second.LastUsedFrame != m_frame)
+	{
+	    DestroyResourceView(it->second.View);
+	    it = frameResources.ViewCache.erase(it);
+	}
+	else
+	{
+	    ++it;
+	}
     }
 }
 
-void RenderGraph::CreateSynchronization() noexcept
+void RenderGraph::DestroyResourceView(const ResourceView& view) noexcept
 {
-    struct SemaphoreDependencyInfo
+    if(view.ImageView)
     {
-	PipelineStageFlags m_waitDstStageMasks[3] = {};
-	uint64_t m_waitValues[3]		  = {};
-    };
+	m_adapter->DestroyImageView(view.ImageView);
+    }
+    else if(view.BufferView)
+    {
+	m_adapter->DestroyBufferView(view.BufferView);
+    }
 
-    struct UsageInfo
+    // transient handles are freed by the registry itself
+    if(view.Cached)
     {
-	uint16_t m_passHandle;
-	Queue* m_queue;
-	ResourceStateAndStage m_stateAndStage;
-    };
+	m_resourceViewRegistry->DestroyHandle(view.TextureHandle);
+	m_resourceViewRegistry->DestroyHandle(view.RWTextureHandle);
+	m_resourceViewRegistry->DestroyHandle(view.TypedBufferHandle);
+	m_resourceViewRegistry->DestroyHandle(view.RWTypedBufferHandle);
+	m_resourceViewRegistry->DestroyHandle(view.ByteBufferHandle);
+	m_resourceViewRegistry->DestroyHandle(view.RWByteBufferHandle);
+	m_resourceViewRegistry->DestroyHandle(view.StructuredBufferHandle);
+	m_resourceViewRegistry->DestroyHandle(view.RWStructuredBufferHandle);
+    }
+}
+
+size_t RenderGraph::HashViewDescription(const ResourceViewDescription& viewDesc, uint64_t resourceId) noexcept
+{
+    size_t hash = 0;
+    Util::HashCombine(hash, resourceId);
+    Util::HashCombine(hash, static_cast<uint32_t>(viewDesc.ViewType));
+    Util::HashCombine(hash, static_cast<uint32_t>(viewDesc.Format));
+    Util::HashCombine(hash, viewDesc.SubresourceRange.BaseMipLevel);
+    Util::HashCombine(hash, viewDesc.SubresourceRange.LevelCount);
+    Util::HashCombine(hash, viewDesc.SubresourceRange.BaseArrayLayer);
+    Util::HashCombine(hash, viewDesc.SubresourceRange.LayerCount);
+    Util::HashCombine(hash, viewDesc.Offset);
+    Util::HashCombine(hash, viewDesc.Range);
+    Util::HashCombine(hash, viewDesc.StructureByteStride);
+    return hash;
+}
+
+bool RenderGraph::IsSameView(const ResourceViewDescription& left, const ResourceViewDescription& right) noexcept
+{
+    return left.Image == right.Image &&
+	   left.ViewType == right.ViewType &&
+	   left.Format == right.Format &&
+	   left.Components.m_r == right.Components.m_r &&
+	   left.Components.m_g == right.Components.m_g &&
+	   left.Components.m_b == right.Components.m_b &&
+	   left.Components.m_a == right.Components.m_a &&
+	   left.SubresourceRange.BaseMipLevel == right.SubresourceRange.BaseMipLevel &&
+	   left.SubresourceRange.LevelCount == right.SubresourceRange.LevelCount &&
+	   left.SubresourceRange.BaseArrayLayer == right.SubresourceRange.BaseArrayLayer &&
+	   left.SubresourceRange.LayerCount == right.SubresourceRange.LayerCount &&
+	   left.Offset == right.Offset &&
+	   left.Range == right.Range &&
+	   left.StructureByteStride == right.StructureByteStride;
+}
+
+void RenderGraph::AllocateTransientMemory() noexcept
+{
+    PROFILE_FUNCTION();
+
+    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
+
+    // resources can only share a heap when they are used on the same queue and have the same memory type requirements.
+    // images and buffers are never mixed so bufferImageGranularity does not have to be taken into account
+    eastl::sort(m_transientResources.begin(), m_transientResources.end(), [this](const TransientResource& lhs, const TransientResource& rhs)
+    {
+	const bool lhsImage = m_resourceDescriptions[lhs.ResourceIndex].Image;
+	const bool rhsImage = m_resourceDescriptions[rhs.ResourceIndex].Image;
+	if(lhs.QueueIndex != rhs.QueueIndex)
+	{
+	    return lhs.QueueIndex < rhs.QueueIndex;
+	}
+	if(lhsImage != rhsImage)
+	{
+	    return lhsImage;
+	}
+	if(lhs.MemoryRequirements.MemoryTypeBits != rhs.MemoryRequirements.MemoryTypeBits)
+	{
+	    return lhs.MemoryRequirements.MemoryTypeBits < rhs.MemoryRequirements.MemoryTypeBits;
+	}
+	// placing the largest resources first keeps the heaps small
+	return lhs.MemoryRequirements.Size > rhs.MemoryRequirements.Size;
+    });
+
+    TransientMemoryStatistics statistics = {};
+
+    size_t heapCount   = 0;
+    const size_t count = m_transientResources.size();
+    for(size_t groupBegin = 0; groupBegin < count;)
+    {
+	const auto& first  = m_transientResources[groupBegin];
+	const bool isImage = m_resourceDescriptions[first.ResourceIndex].Image;
+
+	size_t groupEnd = groupBegin + 1;
+	while(groupEnd < count && m_transientResources[groupEnd].QueueIndex == first.QueueIndex && m_resourceDescriptions[m_transientResources[groupEnd].ResourceIndex].Image == isImage && m_transientResources[groupEnd].MemoryRequirements.MemoryTypeBits == first.MemoryRequirements.MemoryTypeBits)
+	{
+	    ++groupEnd;
+	}
+
+	// place each resource at the lowest offset that does not overlap any resource alive at the same time
+	uint64_t heapSize = 0;
+	for(size_t i = groupBegin; i < groupEnd; ++i)
+	{
+	    auto& resource	     = m_transientResources[i];
+	    const uint64_t size	     = resource.MemoryRequirements.Size;
+	    const uint64_t alignment = resource.MemoryRequirements.Alignment;
+
+	    uint64_t offset = 0;
+	    bool moved	    = true;
+	    while(moved)
+	    {
+		moved = false;
+		for(size_t j = groupBegin; j < i; ++j)
+		{
+		    const auto& placed	     = m_transientResources[j];
+		    const bool aliveTogether = placed.FirstPass <= resource.LastPass && resource.FirstPass <= placed.LastPass;
+		    const bool overlapping   = placed.Offset < offset + size && offset < placed.Offset + placed.MemoryRequirements.Size;
+		    if(aliveTogether && overlapping)
+		    {
+			offset = Util::AlignUp(placed.Offset + placed.MemoryRequirements.Size, alignment);
+			moved  = true;
+		    }
+		}
+	    }
+
+	    resource.Offset = offset;
+	    heapSize	    = eastl::max(heapSize, offset + size);
+
+	    statistics.UnaliasedSize += size;
+	    ++statistics.AliasedResourceCount;
+	}
+
+	// reuse the heap of this frame slot if it still fits, the gpu is done with it at this point
+	if(heapCount < frameResources.TransientHeaps.size())
+	{
+	    auto*& heap		 = frameResources.TransientHeaps[heapCount];
+	    const auto& heapDesc = heap->GetDescription();
+	    if(heapDesc.MemoryTypeBits != first.MemoryRequirements.MemoryTypeBits || heapDesc.Size < heapSize)
+	    {
+		DestroyTransientHeap(heap);
+		heap = nullptr;
+	    }
+	}
+	else
+	{
+	    frameResources.TransientHeaps.push_back(nullptr);
+	}
+
+	auto*& heap = frameResources.TransientHeaps[heapCount];
+	if(!heap)
+	{
+	    MemoryHeapCreateInfo heapCreateInfo = {};
+	    heapCreateInfo.Size			= heapSize;
+	    heapCreateInfo.MemoryTypeBits	= first.MemoryRequirements.MemoryTypeBits;
+	    heapCreateInfo.RequiredFlags	= MemoryPropertyFlags::DEVICE_LOCAL_BIT;
+
+	    m_adapter->CreateMemoryHeap(heapCreateInfo, &heap);
+	}
+
+	for(size_t i = groupBegin; i < groupEnd; ++i)
+	{
+	    const auto& resource = m_transientResources[i];
+	    auto& res		 = frameResources.Resources[resource.ResourceIndex];
+
+	    // recycled resources keep their memory if they ended up at the same place
+	    if(res.Bound && (res.Heap != heap || res.HeapOffset != resource.Offset))
+	    {
+		frameResources.ResourcePool.Recreate(&res, m_resourceDescriptions[resource.ResourceIndex].Name);
+	    }
+	    if(!res.Bound)
+	    {
+		if(res.Image)
+		{
+		    m_adapter->BindMemory(res.Image, heap, resource.Offset);
+		}
+		else
+		{
+		    m_adapter->BindMemory(res.Buffer, heap, resource.Offset);
+		}
+		res.Heap       = heap;
+		res.HeapOffset = resource.Offset;
+		res.Bound      = true;
+	    }
+
+	    // every resource that lived in this memory before has to be done with it
+	    PipelineStageFlags aliasingStages = {};
+	    for(size_t j = groupBegin; j < groupEnd; ++j)
+	    {
+		const auto& other      = m_transientResources[j];
+		const bool overlapping = other.Offset < resource.Offset + resource.MemoryRequirements.Size && resource.Offset < other.Offset + other.MemoryRequirements.Size;
+		if(j != i && overlapping && other.LastPass < resource.FirstPass)
+		{
+		    aliasingStages |= other.StageMask;
+		}
+	    }
+	    m_aliasingBarrierStages[resource.ResourceIndex] = aliasingStages;
+	}
+
+	statistics.AliasedSize += heapSize;
+	++statistics.HeapCount;
+	++heapCount;
+
+	groupBegin = groupEnd;
+    }
+
+    // heaps that are no longer needed
+    for(size_t i = heapCount; i < frameResources.TransientHeaps.size(); ++i)
+    {
+	DestroyTransientHeap(frameResources.TransientHeaps[i]);
+    }
+    frameResources.TransientHeaps.resize(heapCount);
+
+    if(statistics.UnaliasedSize != m_transientMemoryStatistics.UnaliasedSize || statistics.AliasedSize != m_transientMemoryStatistics.AliasedSize)
+    {
+	LOG_CORE_INFO("Transient memory: {0} resources in {1} heap(s), {2} KiB without aliasing, {3} KiB with aliasing", statistics.AliasedResourceCount, statistics.HeapCount, statistics.UnaliasedSize / 1024, statistics.AliasedSize / 1024);
+    }
+    m_transientMemoryStatistics = statistics;
+}
+
+void RenderGraph::DestroyTransientHeap(MemoryHeap* heap) noexcept
+{
+    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
+
+    // resources acquired this frame that are still bound to the heap have to be recreated when they get placed
+    for(auto& res: frameResources.Resources)
+    {
+	if(res.Unbound && res.Heap == heap)
+	{
+	    res.Heap = nullptr;
+	}
+    }
+    frameResources.ResourcePool.EvictMemoryHeap(heap);
+
+    m_adapter->DestroyMemoryHeap(heap);
+}
+
+void RenderGraph::CreateSynchronization() noexcept
+{
+    PROFILE_FUNCTION();
+
+    struct SemaphoreDependencyInfo
+    {
+	PipelineStageFlags m_waitDstStageMasks[3] = {};
+	// values of semaphores signaled before the graph, the passes waited on get their values with the batches
+	uint64_t m_waitValues[3]     = {};
+	int32_t m_waitPassHandles[3] = { -1, -1, -1 };
+    };
+
+    struct UsageInfo
+    {
+	uint16_t m_passHandle;
+	Queue* m_queue;
+	ResourceStateAndStage m_stateAndStage;
+    };
+
+    auto& frameResources     = m_frameResources[m_frame % FRAME_COUNT];
+    const uint32_t passCount = static_cast<uint32_t>(m_passData.size());
+
+    struct SemaphoreDependencyUpdate
+    {
+	uint16_t m_passHandle;
+	uint16_t m_queueIdx;
+	// pass on the other queue, UINT16_MAX if the resource comes from outside the graph
+	uint16_t m_waitPassHandle;
+	PipelineStageFlags m_waitDstStageMask;
+	uint64_t m_waitValue;
+    };
+
+    auto* semaphoreDependencies = AllocateFrameArray<SemaphoreDependencyInfo>(passCount);
+    bool* signalingPasses	= AllocateFrameArray<bool>(passCount);
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	semaphoreDependencies[i] = {};
+	signalingPasses[i]	 = false;
+    }
+
+    // barriers are generated per subresource and sorted into slots afterwards. slot 2 * pass holds the before barriers of a pass,
+    // 2 * pass + 1 its after barriers and the last three the release barriers for external resources of every queue.
+    // a usage adds at most a barrier, the begin of a split barrier and a release barrier, so every chunk of resources
+    // gets three times its usage range of the arrays and a usage range of semaphore dependency updates
+    const uint32_t slotCount			 = passCount * 2 + 3;
+    const uint32_t usageCount			 = m_subresourceUsageOffsets[m_subresourceCount];
+    const uint32_t chunkCount			 = static_cast<uint32_t>(m_resourceChunkOffsets.size()) - 1;
+    Barrier* generatedBarriers			 = AllocateFrameArray<Barrier>(usageCount * 3);
+    uint32_t* generatedBarrierSlots		 = AllocateFrameArray<uint32_t>(usageCount * 3);
+    uint32_t* generatedBarrierEventKeys		 = AllocateFrameArray<uint32_t>(usageCount * 3);
+    uint32_t* generatedBarrierResources		 = AllocateFrameArray<uint32_t>(usageCount * 3);
+    SemaphoreDependencyUpdate* dependencyUpdates = AllocateFrameArray<SemaphoreDependencyUpdate>(usageCount);
+    uint32_t* chunkBarrierCounts		 = AllocateFrameArray<uint32_t>(chunkCount);
+    uint32_t* chunkDependencyUpdateCounts	 = AllocateFrameArray<uint32_t>(chunkCount);
+
+    const auto getChunkUsageOffset = [&](uint32_t chunkIndex)
+    {
+	const uint32_t resourceIdx = m_resourceChunkOffsets[chunkIndex];
+	return resourceIdx < m_resourceDescriptions.size() ? m_subresourceUsageOffsets[m_resourceDescriptions[resourceIdx].SubresourceUsageInfoOffset] : usageCount;
+    };
+
+    // resources are independent of each other, only the events and the semaphore dependencies are shared between them.
+    // both are resolved when merging the chunks in order, which gives the same result as going through the resources in order
+    m_threadPool->ParallelFor(chunkCount, [&](uint32_t chunkIndex, uint32_t)
+    {
+	PROFILE_ZONE("SynchronizeChunk");
+
+	const uint32_t chunkUsageOffset			  = getChunkUsageOffset(chunkIndex);
+	Barrier* chunkBarriers				  = generatedBarriers + chunkUsageOffset * 3;
+	uint32_t* chunkBarrierSlots			  = generatedBarrierSlots + chunkUsageOffset * 3;
+	uint32_t* chunkBarrierEventKeys			  = generatedBarrierEventKeys + chunkUsageOffset * 3;
+	uint32_t* chunkBarrierResources			  = generatedBarrierResources + chunkUsageOffset * 3;
+	SemaphoreDependencyUpdate* chunkDependencyUpdates = dependencyUpdates + chunkUsageOffset;
+	uint32_t barrierCount				  = 0;
+	uint32_t dependencyUpdateCount			  = 0;
+
+	const auto addBarrier = [&](uint32_t slot, const Barrier& barrier, uint32_t eventKey, uint32_t resourceIdx)
+	{
+	    chunkBarriers[barrierCount]		= barrier;
+	    chunkBarrierSlots[barrierCount]	= slot;
+	    chunkBarrierEventKeys[barrierCount] = eventKey;
+	    chunkBarrierResources[barrierCount] = resourceIdx;
+	    ++barrierCount;
+	};
+
+	// for each resource...
+	for(uint32_t resourceIdx = m_resourceChunkOffsets[chunkIndex]; resourceIdx < m_resourceChunkOffsets[chunkIndex + 1]; ++resourceIdx)
+	{
+	    // skip culled resources
+	    if(m_culledResources[resourceIdx])
+	    {
+		continue;
+	    }
+
+	    const auto& resDesc = m_resourceDescriptions[resourceIdx];
+
+	    // for each subresource...
+	    const size_t subresourceCount = resDesc.SubresourceCount;
+	    for(size_t subresourceIdx = 0; subresourceIdx < subresourceCount; ++subresourceIdx)
+	    {
+		const size_t subresourceUsageIdx = subresourceIdx + resDesc.SubresourceUsageInfoOffset;
+		const uint32_t usageBegin	 = m_subresourceUsageOffsets[subresourceUsageIdx];
+		const uint32_t usageEnd		 = m_subresourceUsageOffsets[subresourceUsageIdx + 1];
+
+		// check if subresource is used at all
+		if(usageBegin == usageEnd)
+		{
+		    continue;
+		}
+
+		UsageInfo prevUsageInfo {};
+		prevUsageInfo.m_queue = m_passData[m_subresourceUsagePasses[usageBegin]].Queue;
+
+		// if the resource is external, change prevUsageInfo accordingly and update external info values
+		if(resDesc.External)
+		{
+		    const auto& extInfo		  = resDesc.ExternalStateData;
+		    prevUsageInfo.m_queue	  = extInfo && extInfo[subresourceIdx].Queue ? extInfo[subresourceIdx].Queue : prevUsageInfo.m_queue;
+		    prevUsageInfo.m_stateAndStage = extInfo ? extInfo[subresourceIdx].StateAndStage : prevUsageInfo.m_stateAndStage;
+		    prevUsageInfo.m_passHandle	  = prevUsageInfo.m_queue == m_queues[0] ? 0 : prevUsageInfo.m_queue == m_queues[1] ? 1 :
+																      2;
+
+		    // update external info values
+		    if(extInfo)
+		    {
+			extInfo[subresourceIdx].Queue	      = m_passData[m_subresourceUsagePasses[usageEnd - 1]].Queue;
+			extInfo[subresourceIdx].StateAndStage = m_usageFinalStates[m_subresourceUsageIndices[usageEnd - 1]];
+		    }
+		}
+
+		// for each usage...
+		const size_t usageCount = usageEnd - usageBegin;
+		for(size_t usageIdx = 0; usageIdx < usageCount;)
+		{
+		    const uint16_t passHandle = m_subresourceUsagePasses[usageBegin + usageIdx];
+		    const auto& initialState  = m_usageInitialStates[m_subresourceUsageIndices[usageBegin + usageIdx]];
+		    const auto& finalState    = m_usageFinalStates[m_subresourceUsageIndices[usageBegin + usageIdx]];
+		    auto& passData	      = m_passData[passHandle];
+
+		    UsageInfo curUsageInfo { passHandle, passData.Queue, initialState };
+
+		    // look ahead and try to combine READ_* states
+		    size_t nextUsageIdx			     = usageIdx + 1;
+		    ResourceState combinableImageReadStates  = ResourceState::READ_RESOURCE | ResourceState::READ_DEPTH_STENCIL;
+		    ResourceState combinableBufferReadStates = ResourceState::READ_RESOURCE | ResourceState::READ_CONSTANT_BUFFER | ResourceState::READ_VERTEX_BUFFER | ResourceState::READ_INDEX_BUFFER | ResourceState::READ_INDIRECT_BUFFER | ResourceState::READ_TRANSFER;
+
+		    const bool hasNoCustomFinalState = curUsageInfo.m_stateAndStage.ResourceState == finalState.ResourceState &&
+						       curUsageInfo.m_stateAndStage.StageMask == finalState.StageMask;
+
+		    // is the current state even READ combinable? custom final state breaks this too
+
+		    if(hasNoCustomFinalState &&
+		       ((resDesc.Image && (curUsageInfo.m_stateAndStage.ResourceState & combinableImageReadStates) != 0) ||
+			(!resDesc.Image && (curUsageInfo.m_stateAndStage.ResourceState & combinableBufferReadStates) != 0)))
+		    {
+			for(; nextUsageIdx < usageCount; ++nextUsageIdx)
+			{
+			    const uint16_t nextPassHandle = m_subresourceUsagePasses[usageBegin + nextUsageIdx];
+			    const auto& nextInitialState  = m_usageInitialStates[m_subresourceUsageIndices[usageBegin + nextUsageIdx]];
+			    const auto& nextFinalState	  = m_usageFinalStates[m_subresourceUsageIndices[usageBegin + nextUsageIdx]];
+			    auto& nextPassData		  = m_passData[nextPassHandle];
+			    UsageInfo nextUsageInfo { nextPassHandle, nextPassData.Queue, nextInitialState };
+
+			    const bool sameQueue = nextPassData.Queue == passData.Queue;
+
+			    const bool noCustomFinalState = nextUsageInfo.m_stateAndStage.ResourceState == nextFinalState.ResourceState &&
+							    nextUsageInfo.m_stateAndStage.StageMask == nextFinalState.StageMask;
+
+			    const bool combinable = (resDesc.Image && (nextUsageInfo.m_stateAndStage.ResourceState & combinableImageReadStates) != 0) ||
+						    (!resDesc.Image && (nextUsageInfo.m_stateAndStage.ResourceState & combinableBufferReadStates) != 0);
+
+			    if(!sameQueue || !combinable || !noCustomFinalState)
+			    {
+				break;
+			    }
+
+			    curUsageInfo.m_stateAndStage.StageMask |= nextUsageInfo.m_stateAndStage.StageMask;
+			    curUsageInfo.m_stateAndStage.ResourceState |= nextUsageInfo.m_stateAndStage.ResourceState;
+			}
+		    }
+
+		    Barrier barrier {};
+		    barrier.m_image		    = resDesc.Image ? frameResources.Resources[resourceIdx].Image : nullptr;
+		    barrier.m_buffer		    = !resDesc.Image ? frameResources.Resources[resourceIdx].Buffer : nullptr;
+		    barrier.m_stagesBefore	    = prevUsageInfo.m_stateAndStage.StageMask;
+		    barrier.m_stagesAfter	    = curUsageInfo.m_stateAndStage.StageMask;
+		    barrier.m_stateBefore	    = prevUsageInfo.m_stateAndStage.ResourceState;
+		    barrier.m_stateAfter	    = curUsageInfo.m_stateAndStage.ResourceState;
+		    barrier.m_srcQueue		    = prevUsageInfo.m_queue;
+		    barrier.m_dstQueue		    = curUsageInfo.m_queue;
+		    barrier.m_imageSubresourceRange = { static_cast<uint32_t>(subresourceIdx) % resDesc.Levels, 1, static_cast<uint32_t>(subresourceIdx) / resDesc.Levels, 1 };
+		    if(barrier.m_srcQueue != barrier.m_dstQueue && !resDesc.Concurrent)
+		    {
+			barrier.m_flags |= BarrierFlags::QUEUE_OWNERSHIP_AQUIRE;
+		    }
+		    if(usageIdx == 0)
+		    {
+			barrier.m_flags |= BarrierFlags::FIRST_ACCESS_IN_SUBMISSION;
+		    }
+		    // the memory was used by another resource earlier in the frame
+		    if(usageIdx == 0 && m_aliasingBarrierStages[resourceIdx] != 0)
+		    {
+			barrier.m_flags |= BarrierFlags::ALIASING;
+		    }
+		    // a transient resource has no previous usage, PatchSynchronization applies the same rule to cached compilations
+		    if(usageIdx == 0 && !resDesc.External)
+		    {
+			barrier.m_stagesBefore = GetFirstAccessStagesBefore(m_aliasingBarrierStages[resourceIdx]);
+		    }
+
+		    // split barriers
+		    uint32_t eventKey = 0;
+		    if(usageIdx > 0 && prevUsageInfo.m_queue == curUsageInfo.m_queue)
+		    {
+			// multiple previous usages may have been merged, so we need to insert the begin-split-barrier at the end of the merged batch.
+			// events only work within a queue, so the begin goes before the next pass that is recorded on the same queue
+			auto actualPrevPassHandle = m_subresourceUsagePasses[usageBegin + usageIdx - 1];
+			uint16_t beginPassHandle  = static_cast<uint16_t>(actualPrevPassHandle + 1);
+			while(beginPassHandle < curUsageInfo.m_passHandle && (m_passData[beginPassHandle].Culled || m_passData[beginPassHandle].Queue != curUsageInfo.m_queue))
+			{
+			    ++beginPassHandle;
+			}
+			if(beginPassHandle < curUsageInfo.m_passHandle)
+			{
+			    // all barriers split between the same two passes share an event, it is acquired when merging the chunks
+			    eventKey = (static_cast<uint32_t>(beginPassHandle) << 16u) | curUsageInfo.m_passHandle;
+
+			    auto flags = barrier.m_flags;
+			    barrier.m_flags |= BarrierFlags::BARRIER_BEGIN;
+			    addBarrier(beginPassHandle * 2u, barrier, eventKey, resourceIdx);
+
+			    barrier.m_flags = flags;
+			    barrier.m_flags |= BarrierFlags::BARRIER_END;
+			}
+		    }
+
+		    addBarrier(curUsageInfo.m_passHandle * 2u, barrier, eventKey, resourceIdx);
+
+		    const size_t prevQueueIdx = prevUsageInfo.m_queue == m_queues[0] ? 0 : prevUsageInfo.m_queue == m_queues[1] ? 1 :
+																  2;
+
+		    // the resource comes from another queue -> wait on the semaphore of that queue.
+		    // the previous usage may be a merged batch of reads, the last of them has to finish first
+		    if(prevUsageInfo.m_queue != curUsageInfo.m_queue)
+		    {
+			const uint16_t lastPrevPassHandle = usageIdx == 0 ? UINT16_MAX : m_subresourceUsagePasses[usageBegin + usageIdx - 1];
+
+			auto& dependencyUpdate		    = chunkDependencyUpdates[dependencyUpdateCount++];
+			dependencyUpdate.m_passHandle	    = curUsageInfo.m_passHandle;
+			dependencyUpdate.m_queueIdx	    = static_cast<uint16_t>(prevQueueIdx);
+			dependencyUpdate.m_waitDstStageMask = curUsageInfo.m_stateAndStage.StageMask;
+			dependencyUpdate.m_waitPassHandle   = lastPrevPassHandle;
+			// external resources wait on the previous frame or on the submission releasing them this frame
+			dependencyUpdate.m_waitValue = usageIdx == 0 ? *m_semaphoreValues[prevQueueIdx] : 0;
+
+			// we just acquired ownership of the resource -> add a release barrier on the previous queue
+			if((barrier.m_flags & BarrierFlags::QUEUE_OWNERSHIP_AQUIRE) != 0)
+			{
+			    barrier.m_flags ^= BarrierFlags::QUEUE_OWNERSHIP_AQUIRE;
+			    barrier.m_flags |= BarrierFlags::QUEUE_OWNERSHIP_RELEASE;
+
+			    // external dependency
+			    if(usageIdx == 0)
+			    {
+				addBarrier(passCount * 2u + prevUsageInfo.m_passHandle, barrier, 0, resourceIdx);
+				dependencyUpdate.m_waitValue = *m_semaphoreValues[prevQueueIdx] + 1;
+			    }
+			    else
+			    {
+				addBarrier(lastPrevPassHandle * 2u + 1u, barrier, 0, resourceIdx);
+			    }
+			}
+		    }
+
+		    // update prevUsageInfo
+		    prevUsageInfo = curUsageInfo;
+		    if(!hasNoCustomFinalState)
+		    {
+			prevUsageInfo.m_stateAndStage = finalState;
+		    }
+
+		    usageIdx = nextUsageIdx;
+		}
+	    }
+	}
+
+	chunkBarrierCounts[chunkIndex]		= barrierCount;
+	chunkDependencyUpdateCounts[chunkIndex] = dependencyUpdateCount;
+    });
+
+    // merge the chunks in order. acquire the events of split barriers, apply the semaphore dependencies and count the barriers of every slot
+    uint32_t* slotOffsets = AllocateFrameArray<uint32_t>(slotCount + 1);
+    uint32_t* slotCursors = AllocateFrameArray<uint32_t>(slotCount);
+    memset(slotOffsets, 0, (slotCount + 1) * sizeof(uint32_t));
+
+    uint32_t generatedBarrierCount = 0;
+    for(uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+	const uint32_t chunkUsageOffset = getChunkUsageOffset(chunkIndex);
+	for(uint32_t i = chunkUsageOffset * 3; i < chunkUsageOffset * 3 + chunkBarrierCounts[chunkIndex]; ++i)
+	{
+	    if(generatedBarrierEventKeys[i] != 0)
+	    {
+		auto& event = m_splitBarrierEvents[generatedBarrierEventKeys[i]];
+		if(!event)
+		{
+		    event = frameResources.CommandFramePool.AcquireEvent();
+		}
+		generatedBarriers[i].m_event = event;
+	    }
+	    ++slotOffsets[generatedBarrierSlots[i] + 1];
+	}
+	for(uint32_t i = chunkUsageOffset; i < chunkUsageOffset + chunkDependencyUpdateCounts[chunkIndex]; ++i)
+	{
+	    const auto& dependencyUpdate = dependencyUpdates[i];
+	    auto& semaphoreDependency	 = semaphoreDependencies[dependencyUpdate.m_passHandle];
+	    semaphoreDependency.m_waitDstStageMasks[dependencyUpdate.m_queueIdx] |= dependencyUpdate.m_waitDstStageMask;
+	    if(dependencyUpdate.m_waitPassHandle == UINT16_MAX)
+	    {
+		semaphoreDependency.m_waitValues[dependencyUpdate.m_queueIdx] = eastl::max(semaphoreDependency.m_waitValues[dependencyUpdate.m_queueIdx], dependencyUpdate.m_waitValue);
+	    }
+	    else
+	    {
+		auto& waitPassHandle = semaphoreDependency.m_waitPassHandles[dependencyUpdate.m_queueIdx];
+		waitPassHandle	     = eastl::max<int32_t>(waitPassHandle, dependencyUpdate.m_waitPassHandle);
+
+		// the pass waited on has to end its batch so that its value gets signaled
+		signalingPasses[dependencyUpdate.m_waitPassHandle] = true;
+	    }
+	}
+	generatedBarrierCount += chunkBarrierCounts[chunkIndex];
+    }
+
+    // sort the barriers into their slots, a slot keeps the order its barriers were generated in
+    for(uint32_t i = 0; i < slotCount; ++i)
+    {
+	slotOffsets[i + 1] += slotOffsets[i];
+    }
+    memcpy(slotCursors, slotOffsets, slotCount * sizeof(uint32_t));
+
+    const auto getQueueIndex = [&](const Queue* queue)
+    {
+	return queue == m_queues[0] ? 0u : queue == m_queues[1] ? 1u :
+								  2u;
+    };
+
+    auto* slotBarriers = AllocateFrameArray<CoalescedBarrier>(generatedBarrierCount);
+    for(uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+	const uint32_t chunkUsageOffset = getChunkUsageOffset(chunkIndex);
+	for(uint32_t i = chunkUsageOffset * 3; i < chunkUsageOffset * 3 + chunkBarrierCounts[chunkIndex]; ++i)
+	{
+	    auto& slotBarrier	      = slotBarriers[slotCursors[generatedBarrierSlots[i]]++];
+	    slotBarrier.Barrier	      = generatedBarriers[i];
+	    slotBarrier.ResourceIndex = generatedBarrierResources[i];
+	    slotBarrier.EventKey      = generatedBarrierEventKeys[i];
+	    slotBarrier.SrcQueueIndex = getQueueIndex(generatedBarriers[i].m_srcQueue);
+	    slotBarrier.DstQueueIndex = getQueueIndex(generatedBarriers[i].m_dstQueue);
+	}
+    }
+
+    // merge the per subresource barriers of every call into as few ranges as possible and close the gaps this leaves
+    m_barriers		      = AllocateFrameArray<Barrier>(generatedBarrierCount);
+    m_uncoalescedBarrierCount = generatedBarrierCount;
+    m_barrierCount	      = 0;
+    for(uint32_t slot = 0; slot < slotCount; ++slot)
+    {
+	const uint32_t offset = slotOffsets[slot];
+	const uint32_t count  = CoalesceBarriers(slotBarriers + offset, slotOffsets[slot + 1] - offset);
+	for(uint32_t i = 0; i < count; ++i)
+	{
+	    m_barriers[m_barrierCount + i] = slotBarriers[offset + i].Barrier;
+	}
+
+	if(slot >= passCount * 2)
+	{
+	    m_externalReleaseBarrierOffsets[slot - passCount * 2] = m_barrierCount;
+	    m_externalReleaseBarrierCounts[slot - passCount * 2]  = count;
+	}
+	else if(slot % 2 == 0)
+	{
+	    m_passData[slot / 2].BarrierOffset	    = m_barrierCount;
+	    m_passData[slot / 2].BeforeBarrierCount = count;
+	}
+	else
+	{
+	    m_passData[slot / 2].AfterBarrierCount = count;
+	}
+	m_barrierCount += count;
+    }
+
+    // what the batching below would produce from the waits as generated
+    m_unreducedWaitCount  = 0;
+    m_unreducedBatchCount = 0;
+    {
+	Queue* prevQueue   = nullptr;
+	bool startNewBatch = true;
+	for(uint32_t i = 0; i < passCount; ++i)
+	{
+	    const auto& semaphoreDependency = semaphoreDependencies[i];
+	    Queue* curQueue		    = m_passData[i].Culled && prevQueue ? prevQueue : m_passData[i].Queue;
+	    bool waits			    = false;
+	    for(size_t j = 0; j < 3; ++j)
+	    {
+		waits = waits || semaphoreDependency.m_waitDstStageMasks[j] != 0;
+		m_unreducedWaitCount += semaphoreDependency.m_waitDstStageMasks[j] != 0 ? 1 : 0;
+	    }
+	    m_unreducedBatchCount += startNewBatch || prevQueue != curQueue || waits ? 1 : 0;
+	    startNewBatch = signalingPasses[i];
+	    prevQueue	  = curQueue;
+	}
+    }
+
+    // drop the waits implied by earlier ones. a wait orders the given stages of its batch and of everything submitted after it on the same queue
+    // after the batch signaling the value, and through it after everything that batch waited on in turn. the latest pass of every semaphore
+    // known to be complete is tracked per queue and remembered at the end of every pass, semaphore values from before the graph are below
+    // the values of all passes of the frame, so a known pass implies them as well
+    struct KnownWait
+    {
+	int32_t m_passHandle		 = -1;
+	PipelineStageFlags m_passStages	 = {};
+	uint64_t m_value		 = 0;
+	PipelineStageFlags m_valueStages = {};
+    };
+
+    const auto addKnownPass = [](KnownWait& known, int32_t passHandle, PipelineStageFlags stages)
+    {
+	if(passHandle == known.m_passHandle)
+	{
+	    known.m_passStages |= stages;
+	}
+	else if(passHandle > known.m_passHandle)
+	{
+	    known.m_passHandle = passHandle;
+	    known.m_passStages = stages;
+	}
+    };
+    const auto addKnownValue = [](KnownWait& known, uint64_t value, PipelineStageFlags stages)
+    {
+	if(value == known.m_value)
+	{
+	    known.m_valueStages |= stages;
+	}
+	else if(value > known.m_value)
+	{
+	    known.m_value	= value;
+	    known.m_valueStages = stages;
+	}
+    };
+    const auto isImplied = [](const KnownWait& known, int32_t waitPassHandle, uint64_t waitValue, PipelineStageFlags stages)
+    {
+	if(known.m_passHandle >= 0 && known.m_passHandle >= waitPassHandle && (known.m_passStages & stages) == stages)
+	{
+	    return true;
+	}
+	return waitPassHandle < 0 && known.m_valueStages != 0 && known.m_value >= waitValue && (known.m_valueStages & stages) == stages;
+    };
+
+    KnownWait queueKnownWaits[3][3] = {};
+    KnownWait* passKnownWaits	    = AllocateFrameArray<KnownWait>(passCount * 3);
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	auto& semaphoreDependency = semaphoreDependencies[i];
+	const size_t queueIdx	  = m_passData[i].Queue == m_queues[0] ? 0 : m_passData[i].Queue == m_queues[1] ? 1 :
+														   2;
+	KnownWait* knownWaits	  = queueKnownWaits[queueIdx];
+
+	// what every wait of the pass implies on its own, a wait must not be dropped because of itself
+	KnownWait impliedWaits[3][3] = {};
+	for(size_t j = 0; j < 3; ++j)
+	{
+	    const PipelineStageFlags stages = semaphoreDependency.m_waitDstStageMasks[j];
+	    const int32_t waitPassHandle    = semaphoreDependency.m_waitPassHandles[j];
+	    if(stages == 0 || waitPassHandle < 0)
+	    {
+		continue;
+	    }
+
+	    addKnownPass(impliedWaits[j][j], waitPassHandle, stages);
+	    for(size_t k = 0; k < 3; ++k)
+	    {
+		const auto& passKnownWait = passKnownWaits[waitPassHandle * 3 + k];
+		addKnownPass(impliedWaits[j][k], passKnownWait.m_passHandle, passKnownWait.m_passHandle >= 0 ? stages : PipelineStageFlags {});
+		addKnownValue(impliedWaits[j][k], passKnownWait.m_value, passKnownWait.m_valueStages != 0 ? stages : PipelineStageFlags {});
+	    }
+	}
+
+	for(size_t j = 0; j < 3; ++j)
+	{
+	    const PipelineStageFlags stages = semaphoreDependency.m_waitDstStageMasks[j];
+	    const int32_t waitPassHandle    = semaphoreDependency.m_waitPassHandles[j];
+	    const uint64_t waitValue	    = semaphoreDependency.m_waitValues[j];
+	    if(stages == 0)
+	    {
+		continue;
+	    }
+
+	    bool implied = isImplied(knownWaits[j], waitPassHandle, waitValue, stages);
+	    for(size_t k = 0; k < 3 && !implied; ++k)
+	    {
+		implied = k != j && isImplied(impliedWaits[k][j], waitPassHandle, waitValue, stages);
+	    }
+
+	    if(implied)
+	    {
+		semaphoreDependency.m_waitDstStageMasks[j] = {};
+		semaphoreDependency.m_waitValues[j]	   = 0;
+		semaphoreDependency.m_waitPassHandles[j]   = -1;
+	    }
+	    else if(waitPassHandle < 0)
+	    {
+		addKnownValue(knownWaits[j], waitValue, stages);
+	    }
+	}
+
+	// the implications stay valid for dropped waits, they are implied by something that implies them too
+	for(size_t j = 0; j < 3; ++j)
+	{
+	    for(size_t k = 0; k < 3; ++k)
+	    {
+		addKnownPass(knownWaits[k], impliedWaits[j][k].m_passHandle, impliedWaits[j][k].m_passStages);
+		addKnownValue(knownWaits[k], impliedWaits[j][k].m_value, impliedWaits[j][k].m_valueStages);
+	    }
+	}
+	memcpy(passKnownWaits + i * 3, knownWaits, sizeof(KnownWait) * 3);
+    }
+
+    // only the passes that are still waited on have to end their batch
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	signalingPasses[i] = false;
+    }
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	for(size_t j = 0; j < 3; ++j)
+	{
+	    if(semaphoreDependencies[i].m_waitPassHandles[j] >= 0)
+	    {
+		signalingPasses[semaphoreDependencies[i].m_waitPassHandles[j]] = true;
+	    }
+	}
+    }
+
+    // create batches. every batch signals the next value of the semaphore of its queue, after the submission
+    // releasing external resources on that queue if there is one
+    uint64_t nextSignalValues[3];
+    for(size_t i = 0; i < 3; ++i)
+    {
+	nextSignalValues[i] = *m_semaphoreValues[i] + (m_externalReleaseBarrierCounts[i] != 0 ? 2 : 1);
+    }
+
+    Queue* prevQueue   = nullptr;
+    bool startNewBatch = true;
+    for(size_t i = 0; i < m_passData.size(); ++i)
+    {
+	const auto passHandle		= i;
+	const auto& semaphoreDependency = semaphoreDependencies[passHandle];
+	// culled passes record nothing, so they join the current batch instead of breaking it up
+	Queue* curQueue	      = m_passData[passHandle].Culled && prevQueue ? prevQueue : m_passData[passHandle].Queue;
+	const size_t queueIdx = curQueue == m_queues[0] ? 0 : curQueue == m_queues[1] ? 1 :
+										2;
+
+	// if the previous pass needs to signal, startNewBatch is already true
+	// if the queue type changed, we need to start a new batch
+	// if this pass needs to wait, we also need a need batch
+	startNewBatch = startNewBatch || prevQueue != curQueue || semaphoreDependency.m_waitDstStageMasks[0] != 0 || semaphoreDependency.m_waitDstStageMasks[1] != 0 || semaphoreDependency.m_waitDstStageMasks[2] != 0;
+	if(startNewBatch)
+	{
+	    startNewBatch = false;
+	    m_recordBatches.push_back({});
+	    auto& batch		  = m_recordBatches.back();
+	    batch.Queue		  = curQueue;
+	    batch.PassIndexOffset = static_cast<uint16_t>(i);
+	    batch.SignalValue	  = nextSignalValues[queueIdx]++;
+	    for(size_t j = 0; j < 3; ++j)
+	    {
+		// the passes waited on are earlier in the frame, so their batches already have their values
+		const int32_t waitPassHandle = semaphoreDependency.m_waitPassHandles[j];
+		batch.WaitDstStageMasks[j]   = semaphoreDependency.m_waitDstStageMasks[j];
+		batch.WaitValues[j]	     = semaphoreDependency.m_waitValues[j];
+		if(waitPassHandle >= 0)
+		{
+		    batch.WaitValues[j] = eastl::max<uint64_t>(batch.WaitValues[j], *m_semaphoreValues[j] + m_passData[waitPassHandle].SignalValue);
+		}
+	    }
+	}
+
+	// some other passes needs to wait on this one or this is the last pass -> end batch after this pass
+	if(signalingPasses[passHandle] || i == m_passData.size() - 1)
+	{
+	    startNewBatch = true;
+	}
+
+	// remember what the batch of the pass signals, relative to the value the frame started with
+	auto& batch			   = m_recordBatches.back();
+	m_passData[passHandle].SignalValue = static_cast<uint32_t>(batch.SignalValue - *m_semaphoreValues[queueIdx]);
+
+	prevQueue = curQueue;
+	++batch.PassIndexCount;
+    }
+}
+
+size_t RenderGraph::BuildCompilationKey() noexcept
+{
+    PROFILE_FUNCTION();
+
+    const size_t passKeySize = m_compilationKey.size();
+    m_compilationKey.push_back(static_cast<uint32_t>(m_passData.size()));
+    m_compilationKey.push_back(m_passCullingEnabled);
+    m_compilationKey.push_back(m_passSchedulingEnabled);
+
+    // sizes and formats only matter for creating the resources, which happens every frame anyway, so a resized graph is still a hit
+    m_compilationKey.push_back(static_cast<uint32_t>(m_resourceDescriptions.size()));
+    for(const auto& resDesc: m_resourceDescriptions)
+    {
+	m_compilationKey.push_back(resDesc.UsageFlags);
+	m_compilationKey.push_back(resDesc.Levels);
+	m_compilationKey.push_back(resDesc.SubresourceCount);
+	m_compilationKey.push_back(resDesc.Concurrent);
+	m_compilationKey.push_back(resDesc.External);
+	m_compilationKey.push_back(resDesc.Output);
+	m_compilationKey.push_back(resDesc.Image);
+	m_compilationKey.push_back(resDesc.HostVisible);
+	m_compilationKey.push_back(resDesc.ExternalStateData != nullptr);
+
+	// the state an imported resource was left in decides the first barriers
+	if(resDesc.ExternalStateData)
+	{
+	    for(uint32_t i = 0; i < resDesc.SubresourceCount; ++i)
+	    {
+		const auto& extInfo = resDesc.ExternalStateData[i];
+		m_compilationKey.push_back(static_cast<uint32_t>(extInfo.StateAndStage.ResourceState));
+		m_compilationKey.push_back(static_cast<uint32_t>(extInfo.StateAndStage.StageMask));
+		m_compilationKey.push_back(extInfo.Queue ? static_cast<uint32_t>(extInfo.Queue->GetQueueType()) : UINT32_MAX);
+	    }
+	}
+    }
+
+    m_compilationKey.push_back(static_cast<uint32_t>(m_viewDescriptions.size()));
+    for(const auto& viewDesc: m_viewDescriptions)
+    {
+	m_compilationKey.push_back(static_cast<uint32_t>(viewDesc.ResourceHandle));
+	m_compilationKey.push_back(viewDesc.SubresourceRange.BaseMipLevel);
+	m_compilationKey.push_back(viewDesc.SubresourceRange.LevelCount);
+	m_compilationKey.push_back(viewDesc.SubresourceRange.BaseArrayLayer);
+	m_compilationKey.push_back(viewDesc.SubresourceRange.LayerCount);
+    }
+
+    // the passes were hashed as they were added
+    size_t hash = m_passHash;
+    for(size_t i = passKeySize; i < m_compilationKey.size(); ++i)
+    {
+	Util::HashCombine(hash, m_compilationKey[i]);
+    }
+    return hash;
+}
+
+void RenderGraph::StoreCompilation(size_t key) noexcept
+{
+    PROFILE_FUNCTION();
+
+    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
+
+    // barriers refer to resources and events by index, so the objects of later frames can be patched in
+    eastl::hash_map<const void*, uint32_t> resourceIndices;
+    for(uint32_t i = 0; i < frameResources.Resources.size(); ++i)
+    {
+	const auto& res = frameResources.Resources[i];
+	if(res.Image || res.Buffer)
+	{
+	    resourceIndices[res.Image ? static_cast<const void*>(res.Image) : static_cast<const void*>(res.Buffer)] = i;
+	}
+    }
+    eastl::hash_map<const Event*, uint32_t> eventIndices;
+    uint32_t eventCount = 0;
+    for(const auto& event: m_splitBarrierEvents)
+    {
+	eventIndices[event.second] = eventCount++;
+    }
+
+    Compilation compilation		= {};
+    compilation.Key			= m_compilationKey;
+    compilation.ResourceUsageInfos	= m_resourceUsageInfos;
+    compilation.UsageLoadOps		= m_usageLoadOps;
+    compilation.UsageStoreOps		= m_usageStoreOps;
+    compilation.CulledResources		= m_culledResources;
+    compilation.EventCount		= eventCount;
+    compilation.UncoalescedBarrierCount = m_uncoalescedBarrierCount;
+    compilation.UnreducedBatchCount	= m_unreducedBatchCount;
+    compilation.UnreducedWaitCount	= m_unreducedWaitCount;
+    compilation.LastUsedFrame		= m_frame;
+    compilation.Lowered			= m_loweredBarriers;
+
+    // the flat barrier array keeps its layout, only the objects are replaced by indices
+    compilation.Barriers.resize(m_barrierCount);
+    for(uint32_t i = 0; i < m_barrierCount; ++i)
+    {
+	const auto& barrier = m_barriers[i];
+	auto it		    = resourceIndices.find(barrier.m_image ? static_cast<const void*>(barrier.m_image) : static_cast<const void*>(barrier.m_buffer));
+	ASSERT(it != resourceIndices.end());
+
+	auto& compiledBarrier	      = compilation.Barriers[i];
+	compiledBarrier.Barrier	      = barrier;
+	compiledBarrier.ResourceIndex = it->second;
+	compiledBarrier.EventIndex    = barrier.m_event ? eventIndices[barrier.m_event] : UINT32_MAX;
+    }
+
+    compilation.Passes.resize(m_passData.size());
+    for(size_t i = 0; i < m_passData.size(); ++i)
+    {
+	const auto& passData = m_passData[i];
+	auto& compiledPass   = compilation.Passes[i];
+
+	compiledPass.PassIndex		= m_passOrder.empty() ? static_cast<uint16_t>(i) : m_passOrder[i];
+	compiledPass.Culled		= passData.Culled;
+	compiledPass.BarrierOffset	= passData.BarrierOffset;
+	compiledPass.BeforeBarrierCount = passData.BeforeBarrierCount;
+	compiledPass.AfterBarrierCount	= passData.AfterBarrierCount;
+    }
+    for(size_t i = 0; i < 3; ++i)
+    {
+	compilation.ExternalReleaseBarrierOffsets[i] = m_externalReleaseBarrierOffsets[i];
+	compilation.ExternalReleaseBarrierCounts[i]  = m_externalReleaseBarrierCounts[i];
+    }
+
+    // the next frame starts from different semaphore values. a wait on the value the frame started with is 0 relative to it,
+    // so the stage masks tell which waits exist
+    compilation.Batches = m_recordBatches;
+    for(auto& batch: compilation.Batches)
+    {
+	for(size_t i = 0; i < 3; ++i)
+	{
+	    batch.WaitValues[i] -= batch.WaitDstStageMasks[i] != 0 ? *m_semaphoreValues[i] : 0;
+	}
+	const size_t queueIdx = batch.Queue == m_queues[0] ? 0 : batch.Queue == m_queues[1] ? 1 : 2;
+	batch.SignalValue -= *m_semaphoreValues[queueIdx];
+    }
+
+    // state the imported resources are left in, CreateSynchronization already wrote it to the external state data
+    for(size_t resourceIdx = 0; resourceIdx < m_resourceDescriptions.size(); ++resourceIdx)
+    {
+	const auto& resDesc = m_resourceDescriptions[resourceIdx];
+	if(!resDesc.ExternalStateData || m_culledResources[resourceIdx])
+	{
+	    continue;
+	}
+
+	for(uint32_t subresourceIdx = 0; subresourceIdx < resDesc.SubresourceCount; ++subresourceIdx)
+	{
+	    const uint32_t subresourceUsageIdx = subresourceIdx + resDesc.SubresourceUsageInfoOffset;
+	    if(m_subresourceUsageOffsets[subresourceUsageIdx] == m_subresourceUsageOffsets[subresourceUsageIdx + 1])
+	    {
+		continue;
+	    }
+
+	    const auto& extInfo = resDesc.ExternalStateData[subresourceIdx];
+
+	    CompiledExternalState externalState = {};
+	    externalState.ResourceIndex		= static_cast<uint32_t>(resourceIdx);
+	    externalState.SubresourceIndex	= subresourceIdx;
+	    externalState.QueueIndex		= extInfo.Queue == m_queues[0] ? 0 : extInfo.Queue == m_queues[1] ? 1 : 2;
+	    externalState.StateAndStage		= extInfo.StateAndStage;
+	    compilation.ExternalStates.push_back(externalState);
+	}
+    }
+
+    // a compilation of a different graph with the same hash is replaced
+    auto it = m_compilationCache.find(key);
+    if(it != m_compilationCache.end())
+    {
+	m_adapter->DestroyLoweredBarriers(it->second.Lowered);
+    }
+    m_compilationCache[key] = eastl::move(compilation);
+    m_loweredBarriersCached = true;
+}
+
+void RenderGraph::ApplyCompilation() noexcept
+{
+    PROFILE_FUNCTION();
+
+    const auto& compilation = *m_compilation;
+
+    // passes in the order they were scheduled in, the usages are not looked at again
+    eastl::vector<PassData> passData;
+    passData.reserve(m_passData.size());
+    for(const auto& compiledPass: compilation.Passes)
+    {
+	passData.push_back(eastl::move(m_passData[compiledPass.PassIndex]));
+	passData.back().Culled = compiledPass.Culled;
+    }
+    m_passData.swap(passData);
+
+    m_culledResources	 = compilation.CulledResources;
+    m_resourceUsageInfos = compilation.ResourceUsageInfos;
+    m_usageLoadOps	 = compilation.UsageLoadOps;
+    m_usageStoreOps	 = compilation.UsageStoreOps;
+}
+
+void RenderGraph::PatchSynchronization() noexcept
+{
+    PROFILE_FUNCTION();
+
+    const auto& compilation = *m_compilation;
+    auto& frameResources    = m_frameResources[m_frame % FRAME_COUNT];
+
+    m_compilationEvents.resize(compilation.EventCount);
+    for(auto& event: m_compilationEvents)
+    {
+	event = frameResources.CommandFramePool.AcquireEvent();
+    }
+
+    m_barrierCount = static_cast<uint32_t>(compilation.Barriers.size());
+    m_barriers	   = AllocateFrameArray<Barrier>(m_barrierCount);
+    for(uint32_t i = 0; i < m_barrierCount; ++i)
+    {
+	const auto& compiledBarrier = compilation.Barriers[i];
+	const auto& resDesc	    = m_resourceDescriptions[compiledBarrier.ResourceIndex];
+	const auto& res		    = frameResources.Resources[compiledBarrier.ResourceIndex];
+
+	auto& barrier	 = m_barriers[i];
+	barrier		 = compiledBarrier.Barrier;
+	barrier.m_image	 = resDesc.Image ? res.Image : nullptr;
+	barrier.m_buffer = !resDesc.Image ? res.Buffer : nullptr;
+	barrier.m_event	 = compiledBarrier.EventIndex != UINT32_MAX ? m_compilationEvents[compiledBarrier.EventIndex] : nullptr;
+
+	// where a transient resource was placed in memory can change from frame to frame
+	if(!resDesc.External && (barrier.m_flags & BarrierFlags::FIRST_ACCESS_IN_SUBMISSION) != 0)
+	{
+	    const PipelineStageFlags aliasingStages = m_aliasingBarrierStages[compiledBarrier.ResourceIndex];
+	    barrier.m_flags			    = aliasingStages != 0 ? barrier.m_flags | BarrierFlags::ALIASING : barrier.m_flags & ~BarrierFlags::ALIASING;
+	    barrier.m_stagesBefore		    = GetFirstAccessStagesBefore(aliasingStages);
+	}
+    }
+
+    for(size_t i = 0; i < m_passData.size(); ++i)
+    {
+	const auto& compiledPass	 = compilation.Passes[i];
+	m_passData[i].BarrierOffset	 = compiledPass.BarrierOffset;
+	m_passData[i].BeforeBarrierCount = compiledPass.BeforeBarrierCount;
+	m_passData[i].AfterBarrierCount	 = compiledPass.AfterBarrierCount;
+    }
+    for(size_t i = 0; i < 3; ++i)
+    {
+	m_externalReleaseBarrierOffsets[i] = compilation.ExternalReleaseBarrierOffsets[i];
+	m_externalReleaseBarrierCounts[i]  = compilation.ExternalReleaseBarrierCounts[i];
+    }
+
+    m_recordBatches = compilation.Batches;
+    for(auto& batch: m_recordBatches)
+    {
+	for(size_t i = 0; i < 3; ++i)
+	{
+	    batch.WaitValues[i] += batch.WaitDstStageMasks[i] != 0 ? *m_semaphoreValues[i] : 0;
+	}
+	const size_t queueIdx = batch.Queue == m_queues[0] ? 0 : batch.Queue == m_queues[1] ? 1 : 2;
+	batch.SignalValue += *m_semaphoreValues[queueIdx];
+    }
+
+    for(const auto& externalState: compilation.ExternalStates)
+    {
+	auto& extInfo	      = m_resourceDescriptions[externalState.ResourceIndex].ExternalStateData[externalState.SubresourceIndex];
+	extInfo.Queue	      = m_queues[externalState.QueueIndex];
+	extInfo.StateAndStage = externalState.StateAndStage;
+    }
+
+    m_uncoalescedBarrierCount = compilation.UncoalescedBarrierCount;
+    m_unreducedBatchCount     = compilation.UnreducedBatchCount;
+    m_unreducedWaitCount      = compilation.UnreducedWaitCount;
+
+    // only the objects and the stages of aliased resources changed, the rest of the native barriers is reused
+    m_loweredBarriers	    = compilation.Lowered;
+    m_loweredBarriersCached = true;
+    m_loweredBarriers->Update(m_barriers);
+}
+
+void RenderGraph::LowerBarriers() noexcept
+{
+    PROFILE_FUNCTION();
+
+    const uint32_t passCount  = static_cast<uint32_t>(m_passData.size());
+    const uint32_t groupCount = passCount * 2 + 3;
+    uint32_t* groupOffsets    = AllocateFrameArray<uint32_t>(groupCount + 1);
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	groupOffsets[i * 2]	= m_passData[i].BarrierOffset;
+	groupOffsets[i * 2 + 1] = m_passData[i].BarrierOffset + m_passData[i].BeforeBarrierCount;
+    }
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+	groupOffsets[passCount * 2 + i] = m_externalReleaseBarrierOffsets[i];
+    }
+    groupOffsets[groupCount] = m_barrierCount;
+
+    m_adapter->CreateLoweredBarriers(m_barrierCount, m_barriers, groupCount, groupOffsets, &m_loweredBarriers);
+    m_loweredBarriersCached = false;
+}
+
+void RenderGraph::DestroyLoweredBarriers() noexcept
+{
+    if(!m_loweredBarriersCached)
+    {
+	m_adapter->DestroyLoweredBarriers(m_loweredBarriers);
+    }
+    m_loweredBarriers	    = nullptr;
+    m_loweredBarriersCached = false;
+}
+
+void RenderGraph::RecordAndSubmit() noexcept
+{
+    PROFILE_FUNCTION();
+
+    auto& frameResources	      = m_frameResources[m_frame % FRAME_COUNT];
+    frameResources.FinalWaitValues[0] = *m_semaphoreValues[0];
+    frameResources.FinalWaitValues[1] = *m_semaphoreValues[1];
+    frameResources.FinalWaitValues[2] = *m_semaphoreValues[2];
+
+    CreateQueryPools();
+
+    // the submissions of a queue are collected and handed over together, the release barriers first and the batches in order after them.
+    // they are only handed over early when a batch of another queue waits on one of them, so no wait is ever submitted before its signal.
+    // queues may share the same native queue, where waiting on a later submission would never finish
+    struct SubmitSemaphores
+    {
+	Semaphore* WaitSemaphores[3];
+	PipelineStageFlags WaitDstStageMasks[3];
+	uint64_t WaitValues[3];
+	uint64_t SignalValue;
+	Command* ReleaseCommand;
+    };
+
+    const uint32_t maxSubmitCount      = static_cast<uint32_t>(m_recordBatches.size()) + 1;
+    SubmitInfo* submitInfos	       = AllocateFrameArray<SubmitInfo>(maxSubmitCount * 3);
+    SubmitSemaphores* submitSemaphores = AllocateFrameArray<SubmitSemaphores>(maxSubmitCount * 3);
+    uint32_t submitCounts[3]	       = {};
+    uint32_t flushedSubmitCounts[3]    = {};
+    uint64_t flushedSignalValues[3]    = { *m_semaphoreValues[0], *m_semaphoreValues[1], *m_semaphoreValues[2] };
+
+    const auto flushSubmissions = [&](size_t queueIdx)
+    {
+	if(flushedSubmitCounts[queueIdx] != submitCounts[queueIdx])
+	{
+	    m_queues[queueIdx]->Submit(submitCounts[queueIdx] - flushedSubmitCounts[queueIdx], submitInfos + queueIdx * maxSubmitCount + flushedSubmitCounts[queueIdx]);
+	    flushedSubmitCounts[queueIdx] = submitCounts[queueIdx];
+	    flushedSignalValues[queueIdx] = frameResources.FinalWaitValues[queueIdx];
+	    ++m_statistics.SubmitCount;
+	}
+    };
+
+    // issue release queue ownership transfer barriers for external resources on the wrong queue
+    for(size_t i = 0; i < 3; ++i)
+    {
+	const char* releasePassNames[] {
+	    "release barriers for external resources (graphics queue)",
+	    "release barriers for external resources (compute queue)",
+	    "release barriers for external resources (transfer queue)",
+	};
+
+	if(m_externalReleaseBarrierCounts[i] != 0)
+	{
+	    Command* cmdList = frameResources.CommandFramePool.Acquire(m_queues[i]);
+
+	    cmdList->Begin();
+
+	    //cmdList->InsertDebugLabel(releasePassNames[i]); // TODO
+	    cmdList->Barrier(m_loweredBarriers, static_cast<uint32_t>(m_passData.size() * 2 + i));
+
+	    cmdList->End();
 
-    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
+	    // add to the submission of the queue
+	    {
+		const uint32_t submitIdx = static_cast<uint32_t>(i) * maxSubmitCount + submitCounts[i]++;
 
-    eastl::vector<SemaphoreDependencyInfo> semaphoreDependencies(m_passData.size());
+		auto& semaphores		= submitSemaphores[submitIdx];
+		semaphores.WaitSemaphores[0]	= m_semaphores[i];
+		semaphores.WaitDstStageMasks[0] = PipelineStageFlags::TOP_OF_PIPE_BIT;
+		semaphores.WaitValues[0]	= *m_semaphoreValues[i];
+		semaphores.SignalValue		= *m_semaphoreValues[i] + 1;
+		semaphores.ReleaseCommand	= cmdList;
 
-    // for each resource...
-    const size_t resourceCount = m_resourceDescriptions.size();
-    for(size_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+		SubmitInfo& submitInfo		= submitInfos[submitIdx];
+		submitInfo			= {};
+		submitInfo.WaitSemaphoreCount	= 1;
+		submitInfo.WaitSemaphores	= semaphores.WaitSemaphores;
+		submitInfo.WaitValues		= semaphores.WaitValues;
+		submitInfo.WaitDstStageMask	= semaphores.WaitDstStageMasks;
+		submitInfo.CommandCount		= 1;
+		submitInfo.Commands		= &semaphores.ReleaseCommand;
+		submitInfo.SignalSemaphoreCount = 1;
+		submitInfo.SignalSemaphores	= &m_semaphores[i];
+		submitInfo.SignalValues		= &semaphores.SignalValue;
+
+		frameResources.FinalWaitValues[i] = eastl::max<uint64_t>(frameResources.FinalWaitValues[i], semaphores.SignalValue);
+	    }
+	}
+    }
+
+    // split batches into chunks of passes that can be recorded independently
+    const uint32_t threadCount	  = m_threadPool->GetThreadCount();
+    const uint32_t passesPerChunk = eastl::max<uint32_t>(MIN_PASSES_PER_RECORD_CHUNK, static_cast<uint32_t>((m_passData.size() + threadCount * 2 - 1) / (threadCount * 2)));
+
+    m_recordChunks.clear();
+    for(auto& batch: m_recordBatches)
     {
-	// skip culled resources
-	if(m_culledResources[resourceIdx])
+	batch.CommandOffset = static_cast<uint32_t>(m_recordChunks.size());
+	for(uint32_t i = 0; i < batch.PassIndexCount; i += passesPerChunk)
 	{
-	    continue;
+	    RecordChunk chunk {};
+	    chunk.Queue		  = batch.Queue;
+	    chunk.PassIndexOffset = static_cast<uint16_t>(batch.PassIndexOffset + i);
+	    chunk.PassIndexCount  = static_cast<uint16_t>(eastl::min<uint32_t>(passesPerChunk, batch.PassIndexCount - i));
+	    m_recordChunks.push_back(chunk);
 	}
+	batch.CommandCount = static_cast<uint32_t>(m_recordChunks.size()) - batch.CommandOffset;
+    }
 
-	const auto& resDesc = m_resourceDescriptions[resourceIdx];
+    // records the passes of a chunk, either straight into a command list or into a command stream
+    const auto recordChunk = [&](Command* cmdList, uint32_t chunkIndex)
+    {
+	const auto& chunk = m_recordChunks[chunkIndex];
+
+	// every chunk resets the queries of its own passes, so no reset has to be ordered across queues or command lists
+	const size_t queueIdx	  = static_cast<size_t>(chunk.Queue->GetQueueType());
+	const bool timestamps	  = m_timestampsSupported[queueIdx];
+	const bool statistics	  = frameResources.PassTimings[chunk.PassIndexOffset].HasStatistics;
+	QueryPool* timestampPool  = frameResources.TimestampQueryPool;
+	QueryPool* statisticsPool = frameResources.StatisticsQueryPool;
+	if(timestamps)
+	{
+	    cmdList->ResetQueryPool(timestampPool, chunk.PassIndexOffset * 2u, chunk.PassIndexCount * 2u);
+	}
+	if(statistics)
+	{
+	    cmdList->ResetQueryPool(statisticsPool, chunk.PassIndexOffset, chunk.PassIndexCount);
+	}
 
-	// for each subresource...
-	const size_t subresourceCount = resDesc.SubresourceCount;
-	for(size_t subresourceIdx = 0; subresourceIdx < subresourceCount; ++subresourceIdx)
+	// record passes
+	for(size_t i = 0; i < chunk.PassIndexCount; ++i)
 	{
-	    const size_t subresourceUsageIdx = subresourceIdx + resDesc.SubresourceUsageInfoOffset;
+	    const uint32_t passIndex = static_cast<uint32_t>(i + chunk.PassIndexOffset);
+	    const auto& passData     = m_passData[passIndex];
+	    PROFILE_ZONE(passData.Name);
 
-	    // check if subresource is used at all
-	    if(m_subresourceUsages[subresourceUsageIdx].empty())
+	    //ScopedLabel debugLabel(cmdList, passData.m_name);
+
+	    if(timestamps)
 	    {
-		continue;
+		cmdList->WriteTimestamp(PipelineStageFlags::TOP_OF_PIPE_BIT, timestampPool, passIndex * 2);
 	    }
 
-	    UsageInfo prevUsageInfo {};
-	    prevUsageInfo.m_queue = m_passData[m_subresourceUsages[subresourceUsageIdx][0].PassHandle].Queue;
+	    // before-barriers
+	    if(passData.BeforeBarrierCount != 0)
+	    {
+		cmdList->Barrier(m_loweredBarriers, passIndex * 2);
+	    }
 
-	    // if the resource is external, change prevUsageInfo accordingly and update external info values
-	    if(resDesc.External)
+	    // record commands
+	    if(statistics)
 	    {
-		const auto& extInfo	      = resDesc.ExternalStateData;
-		prevUsageInfo.m_queue	      = extInfo && extInfo[subresourceIdx].Queue ? extInfo[subresourceIdx].Queue : prevUsageInfo.m_queue;
-		prevUsageInfo.m_stateAndStage = extInfo ? extInfo[subresourceIdx].StateAndStage : prevUsageInfo.m_stateAndStage;
-		prevUsageInfo.m_passHandle    = prevUsageInfo.m_queue == m_queues[0] ? 0 : prevUsageInfo.m_queue == m_queues[1] ? 1 :
-																  2;
+		cmdList->BeginQuery(statisticsPool, passIndex);
+	    }
+	    if(!passData.Culled)
+	    {
+		const Registry registry(this, passIndex);
+		passData.Closure.Invoke(passData.Closure.Data, cmdList, registry);
+	    }
+	    if(statistics)
+	    {
+		cmdList->EndQuery(statisticsPool, passIndex);
+	    }
 
-		// update external info values
-		if(extInfo)
-		{
-		    const auto& lastUsage		  = m_subresourceUsages[subresourceUsageIdx].back();
-		    extInfo[subresourceIdx].Queue	  = m_passData[lastUsage.PassHandle].Queue;
-		    extInfo[subresourceIdx].StateAndStage = lastUsage.FinalResourceState;
-		}
+	    // after-barriers
+	    if(passData.AfterBarrierCount != 0)
+	    {
+		cmdList->Barrier(m_loweredBarriers, passIndex * 2 + 1);
 	    }
 
-	    // for each usage...
-	    const size_t usageCount = m_subresourceUsages[subresourceUsageIdx].size();
-	    for(size_t usageIdx = 0; usageIdx < usageCount;)
+	    if(timestamps)
 	    {
-		const auto& subresUsage = m_subresourceUsages[subresourceUsageIdx][usageIdx];
-		auto& passData		= m_passData[subresUsage.PassHandle];
+		cmdList->WriteTimestamp(PipelineStageFlags::BOTTOM_OF_PIPE_BIT, timestampPool, passIndex * 2 + 1);
+	    }
+	}
+    };
 
-		UsageInfo curUsageInfo { subresUsage.PassHandle, passData.Queue, subresUsage.InitialResourceState };
+    m_recordedCommands.resize(m_recordChunks.size());
 
-		// look ahead and try to combine READ_* states
-		size_t nextUsageIdx			 = usageIdx + 1;
-		ResourceState combinableImageReadStates	 = ResourceState::READ_RESOURCE | ResourceState::READ_DEPTH_STENCIL;
-		ResourceState combinableBufferReadStates = ResourceState::READ_RESOURCE | ResourceState::READ_CONSTANT_BUFFER | ResourceState::READ_VERTEX_BUFFER | ResourceState::READ_INDEX_BUFFER | ResourceState::READ_INDIRECT_BUFFER | ResourceState::READ_TRANSFER;
+    const uint64_t recordBegin = Clock::Now();
+    if(m_deferredRecordingEnabled)
+    {
+	// the passes only append to command streams, the backend work happens when the streams are translated
+	m_commandStreams.resize(m_recordChunks.size());
+	m_threadPool->ParallelFor(static_cast<uint32_t>(m_recordChunks.size()), [&](uint32_t chunkIndex, uint32_t)
+	{
+	    PROFILE_ZONE("RecordChunk");
 
-		const bool hasNoCustomFinalState = curUsageInfo.m_stateAndStage.ResourceState == subresUsage.FinalResourceState.ResourceState &&
-						   curUsageInfo.m_stateAndStage.StageMask == subresUsage.FinalResourceState.StageMask;
+	    auto& stream = m_commandStreams[chunkIndex];
+	    stream.Begin();
+	    recordChunk(&stream, chunkIndex);
+	    stream.End();
+	});
 
-		// is the current state even READ combinable? custom final state breaks this too
+	const uint64_t translateBegin = Clock::Now();
+	m_statistics.RecordTime	      = translateBegin - recordBegin;
 
-		if(hasNoCustomFinalState &&
-		   (resDesc.Image && (curUsageInfo.m_stateAndStage.ResourceState & combinableImageReadStates) != 0 ||
-		    !resDesc.Image && (curUsageInfo.m_stateAndStage.ResourceState & combinableBufferReadStates) != 0))
-		{
-		    for(; nextUsageIdx < usageCount; ++nextUsageIdx)
-		    {
-			const auto& nextSubresUsage = m_subresourceUsages[subresourceUsageIdx][nextUsageIdx];
-			auto& nextPassData	    = m_passData[nextSubresUsage.PassHandle];
-			UsageInfo nextUsageInfo { nextSubresUsage.PassHandle, nextPassData.Queue, nextSubresUsage.InitialResourceState };
+	// translate the streams on worker threads, every chunk gets its own primary command list
+	m_threadPool->ParallelFor(static_cast<uint32_t>(m_recordChunks.size()), [&](uint32_t chunkIndex, uint32_t threadIndex)
+	{
+	    PROFILE_ZONE("TranslateChunk");
 
-			const bool sameQueue = nextPassData.Queue == passData.Queue;
+	    Command* cmdList = frameResources.CommandFramePool.Acquire(m_recordChunks[chunkIndex].Queue, threadIndex);
+	    cmdList->Begin();
+	    m_commandStreams[chunkIndex].Replay(cmdList);
+	    cmdList->End();
 
-			const bool noCustomFinalState = nextUsageInfo.m_stateAndStage.ResourceState == nextSubresUsage.FinalResourceState.ResourceState &&
-							nextUsageInfo.m_stateAndStage.StageMask == nextSubresUsage.FinalResourceState.StageMask;
+	    m_recordedCommands[chunkIndex] = cmdList;
+	});
 
-			const bool combinable = (resDesc.Image && (nextUsageInfo.m_stateAndStage.ResourceState & combinableImageReadStates) != 0 ||
-						 !resDesc.Image && (nextUsageInfo.m_stateAndStage.ResourceState & combinableBufferReadStates) != 0);
+	m_statistics.TranslateTime = Clock::Now() - translateBegin;
+	for(size_t i = 0; i < m_recordChunks.size(); ++i)
+	{
+	    m_statistics.CommandStreamSize += m_commandStreams[i].GetSize();
+	}
+    }
+    else
+    {
+	// record chunks on worker threads, every chunk gets its own primary command list
+	m_threadPool->ParallelFor(static_cast<uint32_t>(m_recordChunks.size()), [&](uint32_t chunkIndex, uint32_t threadIndex)
+	{
+	    PROFILE_ZONE("RecordChunk");
 
-			if(!sameQueue || !combinable || !noCustomFinalState)
-			{
-			    break;
-			}
+	    Command* cmdList = frameResources.CommandFramePool.Acquire(m_recordChunks[chunkIndex].Queue, threadIndex);
+	    cmdList->Begin();
+	    recordChunk(cmdList, chunkIndex);
+	    cmdList->End();
 
-			curUsageInfo.m_stateAndStage.StageMask |= nextUsageInfo.m_stateAndStage.StageMask;
-			curUsageInfo.m_stateAndStage.ResourceState |= nextUsageInfo.m_stateAndStage.ResourceState;
-		    }
-		}
+	    m_recordedCommands[chunkIndex] = cmdList;
+	});
 
-		Barrier barrier {};
-		barrier.m_image			= resDesc.Image ? frameResources.Resources[resourceIdx].Image : nullptr;
-		barrier.m_buffer		= !resDesc.Image ? frameResources.Resources[resourceIdx].Buffer : nullptr;
-		barrier.m_stagesBefore		= prevUsageInfo.m_stateAndStage.StageMask;
-		barrier.m_stagesAfter		= curUsageInfo.m_stateAndStage.StageMask;
-		barrier.m_stateBefore		= prevUsageInfo.m_stateAndStage.ResourceState;
-		barrier.m_stateAfter		= curUsageInfo.m_stateAndStage.ResourceState;
-		barrier.m_srcQueue		= prevUsageInfo.m_queue;
-		barrier.m_dstQueue		= curUsageInfo.m_queue;
-		barrier.m_imageSubresourceRange = { static_cast<uint32_t>(subresourceIdx) % resDesc.Levels, 1, static_cast<uint32_t>(subresourceIdx) / resDesc.Levels, 1 };
-		if(barrier.m_srcQueue != barrier.m_dstQueue && !resDesc.Concurrent)
-		{
-		    barrier.m_flags |= BarrierFlags::QUEUE_OWNERSHIP_AQUIRE;
-		}
-		if(usageIdx == 0)
-		{
-		    barrier.m_flags |= BarrierFlags::FIRST_ACCESS_IN_SUBMISSION;
-		}
+	m_statistics.RecordTime = Clock::Now() - recordBegin;
+    }
 
-		// split barriers
-		if(usageIdx > 0 && prevUsageInfo.m_queue == curUsageInfo.m_queue)
-		{
-		    // multiple previous usages may have been merged, so we need to insert the begin-split-barrier at the end of the merged batch
-		    auto actualPrevPassHandle = m_subresourceUsages[subresourceUsageIdx][usageIdx - 1].PassHandle;
-		    if((actualPrevPassHandle + 1) < curUsageInfo.m_passHandle)
-		    {
-			auto flags = barrier.m_flags;
-			barrier.m_flags |= BarrierFlags::BARRIER_BEGIN;
-			m_passData[actualPrevPassHandle + 1].BeforeBarriers.push_back(barrier);
+    // collect the batches in order so submission stays deterministic regardless of which thread recorded what
+    for(const auto& batch: m_recordBatches)
+    {
+	const size_t queueIdx = batch.Queue == m_queues[0] ? 0 : batch.Queue == m_queues[1] ? 1 :
+											      2;
+	const uint32_t submitIdx = static_cast<uint32_t>(queueIdx) * maxSubmitCount + submitCounts[queueIdx]++;
 
-			barrier.m_flags = flags;
-			barrier.m_flags |= BarrierFlags::BARRIER_END;
-		    }
+	auto& semaphores   = submitSemaphores[submitIdx];
+	uint32_t waitCount = 0;
+	for(size_t i = 0; i < 3; ++i)
+	{
+	    if(batch.WaitDstStageMasks[i] != 0)
+	    {
+		if(batch.WaitValues[i] > flushedSignalValues[i])
+		{
+		    flushSubmissions(i);
 		}
 
-		passData.BeforeBarriers.push_back(barrier);
-
-		const size_t prevQueueIdx = prevUsageInfo.m_queue == m_queues[0] ? 0 : prevUsageInfo.m_queue == m_queues[1] ? 1 :
-															      2;
+		semaphores.WaitSemaphores[waitCount]	= m_semaphores[i];
+		semaphores.WaitDstStageMasks[waitCount] = batch.WaitDstStageMasks[i];
+		semaphores.WaitValues[waitCount]	= batch.WaitValues[i];
+		++waitCount;
+	    }
+	}
 
-		// we just acquired ownership of the resource -> add a release barrier on the previous queue
-		if((barrier.m_flags & BarrierFlags::QUEUE_OWNERSHIP_AQUIRE) != 0)
-		{
-		    barrier.m_flags ^= BarrierFlags::QUEUE_OWNERSHIP_AQUIRE;
-		    barrier.m_flags |= BarrierFlags::QUEUE_OWNERSHIP_RELEASE;
+	SubmitInfo& submitInfo = submitInfos[submitIdx];
+	submitInfo	       = {};
+	{
+	    submitInfo.WaitSemaphoreCount   = waitCount;
+	    submitInfo.WaitSemaphores	    = waitCount > 0 ? semaphores.WaitSemaphores : nullptr;
+	    submitInfo.WaitValues	    = semaphores.WaitValues;
+	    submitInfo.WaitDstStageMask	    = semaphores.WaitDstStageMasks;
+	    submitInfo.CommandCount	    = batch.CommandCount;
+	    submitInfo.Commands		    = m_recordedCommands.data() + batch.CommandOffset;
+	    submitInfo.SignalSemaphoreCount = 1;
+	    submitInfo.SignalSemaphores	    = &m_semaphores[queueIdx];
+	    submitInfo.SignalValues	    = &batch.SignalValue;
+	}
 
-		    semaphoreDependencies[curUsageInfo.m_passHandle].m_waitDstStageMasks[prevQueueIdx] |= curUsageInfo.m_stateAndStage.StageMask;
-		    auto& waitValue = semaphoreDependencies[curUsageInfo.m_passHandle].m_waitValues[prevQueueIdx];
+	frameResources.FinalWaitValues[queueIdx] = MAX(frameResources.FinalWaitValues[queueIdx], batch.SignalValue);
+    }
 
-		    // external dependency
-		    if(usageIdx == 0)
-		    {
-			m_externalReleaseBarriers[prevUsageInfo.m_passHandle].push_back(barrier);
-			waitValue = eastl::max<uint64_t>(*m_semaphoreValues[prevQueueIdx] + 1, waitValue);
-		    }
-		    else
-		    {
-			auto& prevPassRecordInfo = m_passData[prevUsageInfo.m_passHandle];
-			prevPassRecordInfo.AfterBarriers.push_back(barrier);
-			waitValue = eastl::max<uint64_t>(*m_semaphoreValues[prevQueueIdx] + 1 + prevPassRecordInfo.SignalValue, waitValue);
-		    }
-		}
+    for(size_t i = 0; i < 3; ++i)
+    {
+	flushSubmissions(i);
+    }
 
-		// update prevUsageInfo
-		prevUsageInfo = curUsageInfo;
-		if(!hasNoCustomFinalState)
-		{
-		    prevUsageInfo.m_stateAndStage = subresUsage.FinalResourceState;
-		}
+    // update global semaphore values
+    *m_semaphoreValues[0] = frameResources.FinalWaitValues[0];
+    *m_semaphoreValues[1] = frameResources.FinalWaitValues[1];
+    *m_semaphoreValues[2] = frameResources.FinalWaitValues[2];
+}
 
-		usageIdx = nextUsageIdx;
-	    }
-	}
-    }
+void RenderGraph::CreateQueryPools() noexcept
+{
+    auto& frameResources     = m_frameResources[m_frame % FRAME_COUNT];
+    const uint32_t passCount = static_cast<uint32_t>(m_passData.size());
 
-    // create batches
-    Queue* prevQueue   = nullptr;
-    bool startNewBatch = true;
-    for(size_t i = 0; i < m_passData.size(); ++i)
+    // pools only grow, this frame slot has been waited on in NextFrame so they are not in use
+    if(!frameResources.TimestampQueryPool || frameResources.TimestampQueryPool->GetDescription().QueryCount < passCount * 2)
     {
-	const auto passHandle		= i;
-	const auto& semaphoreDependency = semaphoreDependencies[passHandle];
-	Queue* curQueue			= m_passData[passHandle].Queue;
+	m_adapter->DestroyQueryPool(frameResources.TimestampQueryPool);
 
-	// if the previous pass needs to signal, startNewBatch is already true
-	// if the queue type changed, we need to start a new batch
-	// if this pass needs to wait, we also need a need batch
-	startNewBatch = startNewBatch || prevQueue != curQueue || semaphoreDependency.m_waitDstStageMasks[0] != 0 || semaphoreDependency.m_waitDstStageMasks[1] != 0 || semaphoreDependency.m_waitDstStageMasks[2] != 0;
-	if(startNewBatch)
+	QueryPoolCreateInfo createInfo = {};
 	{
-	    startNewBatch = false;
-	    m_recordBatches.push_back({});
-	    auto& batch		  = m_recordBatches.back();
-	    batch.Queue		  = curQueue;
-	    batch.PassIndexOffset = static_cast<uint16_t>(i);
-	    for(size_t j = 0; j < 3; ++j)
-	    {
-		batch.WaitDstStageMasks[j] = semaphoreDependency.m_waitDstStageMasks[j];
-		batch.WaitValues[j]	   = semaphoreDependency.m_waitValues[j];
-	    }
+	    createInfo.QueryType  = QueryType::TIMESTAMP;
+	    createInfo.QueryCount = eastl::max(MIN_QUERY_POOL_PASS_COUNT, passCount) * 2;
 	}
+	m_adapter->CreateQueryPool(createInfo, &frameResources.TimestampQueryPool);
+    }
 
-	// some other passes needs to wait on this one or this is the last pass -> end batch after this pass
-	if(!m_passData[passHandle].AfterBarriers.empty() || i == m_passData.size() - 1)
+    if(m_pipelineStatisticsEnabled && (!frameResources.StatisticsQueryPool || frameResources.StatisticsQueryPool->GetDescription().QueryCount < passCount))
+    {
+	m_adapter->DestroyQueryPool(frameResources.StatisticsQueryPool);
+
+	QueryPoolCreateInfo createInfo = {};
 	{
-	    startNewBatch = true;
+	    createInfo.QueryType	  = QueryType::PIPELINE_STATISTICS;
+	    createInfo.QueryCount	  = eastl::max(MIN_QUERY_POOL_PASS_COUNT, passCount);
+	    createInfo.PipelineStatistics = PIPELINE_STATISTICS;
 	}
+	m_adapter->CreateQueryPool(createInfo, &frameResources.StatisticsQueryPool);
+    }
 
-	// update signal value to current last pass in batch
-	auto& batch	      = m_recordBatches.back();
-	const size_t queueIdx = curQueue == m_queues[0] ? 0 : curQueue == m_queues[1] ? 1 :
-											2;
-	batch.SignalValue     = MAX(*m_semaphoreValues[queueIdx] + 1 + m_passData[passHandle].SignalValue, batch.SignalValue);
+    // remember what was recorded, the pass data is gone by the time the results are read back
+    frameResources.PassTimings.resize(passCount);
+    for(uint32_t i = 0; i < passCount; ++i)
+    {
+	const auto& passData = m_passData[i];
+	auto& timing	     = frameResources.PassTimings[i];
+	timing		     = {};
+	timing.Name	     = passData.Name;
+	timing.QueueType     = passData.Queue->GetQueueType();
+	// statistics on graphics passes only, the graphics statistics are not valid on compute or transfer queues
+	timing.HasStatistics = m_pipelineStatisticsEnabled && passData.Queue == m_queues[0];
+    }
 
-	prevQueue = curQueue;
-	++batch.PassIndexCount;
+    frameResources.Calibrated = m_adapter->GetCalibratedTimestamp(&frameResources.CalibrationGPUTimestamp, &frameResources.CalibrationCPUTimestamp);
+    if(!frameResources.Calibrated)
+    {
+	frameResources.CalibrationCPUTimestamp = Clock::Now();
     }
 }
 
-void RenderGraph::RecordAndSubmit() noexcept
+void RenderGraph::ResolvePassTimings() noexcept
 {
-    auto& frameResources	      = m_frameResources[m_frame % FRAME_COUNT];
-    frameResources.FinalWaitValues[0] = *m_semaphoreValues[0];
-    frameResources.FinalWaitValues[1] = *m_semaphoreValues[1];
-    frameResources.FinalWaitValues[2] = *m_semaphoreValues[2];
-
-    // issue release queue ownership transfer barriers for external resources on the wrong queue
-    for(size_t i = 0; i < 3; ++i)
+    auto& frameResources = m_frameResources[m_frame % FRAME_COUNT];
+    if(frameResources.PassTimings.empty())
     {
-	const char* releasePassNames[] {
-	    "release barriers for external resources (graphics queue)",
-	    "release barriers for external resources (compute queue)",
-	    "release barriers for external resources (transfer queue)",
-	};
+	return;
+    }
+
+    PROFILE_FUNCTION();
 
-	if(!m_externalReleaseBarriers[i].empty())
+    auto& timings	     = frameResources.PassTimings;
+    const uint32_t passCount = static_cast<uint32_t>(timings.size());
+    bool complete	     = true;
+
+    // read back timestamps in runs of passes on queues that support them
+    m_queryResults.resize(passCount * 2);
+    for(uint32_t first = 0; first < passCount;)
+    {
+	const QueueType queueType = timings[first].QueueType;
+	if(!m_timestampsSupported[static_cast<size_t>(queueType)])
 	{
-	    Command* cmdList = frameResources.CommandFramePool.Acquire(m_queues[i]);
+	    ++first;
+	    continue;
+	}
 
-	    cmdList->Begin();
+	uint32_t count = 1;
+	while(first + count < passCount && m_timestampsSupported[static_cast<size_t>(timings[first + count].QueueType)])
+	{
+	    ++count;
+	}
 
-	    //cmdList->InsertDebugLabel(releasePassNames[i]); // TODO
-	    cmdList->Barrier(static_cast<uint32_t>(m_externalReleaseBarriers[i].size()), m_externalReleaseBarriers[i].data());
+	complete &= frameResources.TimestampQueryPool->GetResults(first * 2, count * 2, count * 2 * sizeof(uint64_t), m_queryResults.data() + first * 2, sizeof(uint64_t));
+	first += count;
+    }
 
-	    cmdList->End();
+    uint64_t calibrationGPUTimestamp = frameResources.CalibrationGPUTimestamp;
+    uint64_t calibrationCPUTimestamp = frameResources.CalibrationCPUTimestamp;
+    bool calibrated		     = frameResources.Calibrated;
 
-	    // submit to queue
-	    {
-		uint64_t waitValue    = *m_semaphoreValues[i];
-		uint64_t signalValue  = waitValue + 1;
-		auto waitDstStageMask = PipelineStageFlags::TOP_OF_PIPE_BIT;
+#ifdef PROFILER_ENABLED
+    const char* trackNames[] {
+	"GPU Graphics Queue",
+	"GPU Compute Queue",
+	"GPU Transfer Queue",
+    };
+#endif // PROFILER_ENABLED
 
-		SubmitInfo submitInfo {};
-		submitInfo.WaitSemaphoreCount	= 1;
-		submitInfo.WaitSemaphores	= &m_semaphores[i];
-		submitInfo.WaitValues		= &waitValue;
-		submitInfo.WaitDstStageMask	= &waitDstStageMask;
-		submitInfo.CommandCount		= 1;
-		submitInfo.Commands		= &cmdList;
-		submitInfo.SignalSemaphoreCount = 1;
-		submitInfo.SignalSemaphores	= &m_semaphores[i];
-		submitInfo.SignalValues		= &signalValue;
+    for(uint32_t i = 0; i < passCount && complete; ++i)
+    {
+	auto& timing		 = timings[i];
+	const size_t queueIdx	 = static_cast<size_t>(timing.QueueType);
+	const Queue* queue	 = m_queues[queueIdx];
+	const uint32_t validBits = queue->GetTimestampValidBits();
+	if(validBits == 0)
+	{
+	    continue;
+	}
 
-		m_queues[i]->Submit(1, &submitInfo);
-		frameResources.FinalWaitValues[i] = eastl::max<uint64_t>(frameResources.FinalWaitValues[i], signalValue);
-	    }
+	// without calibration the first timestamp of the frame is anchored to the time the frame was submitted
+	if(!calibrated)
+	{
+	    calibrationGPUTimestamp = m_queryResults[i * 2];
+	    calibrated		    = true;
 	}
+
+	// sign extend the wrapped difference so timestamps slightly before the calibration point stay correct
+	const uint32_t shift = 64 - validBits;
+	const auto toClock   = [&](uint64_t timestamp)
+	{
+	    const int64_t delta = static_cast<int64_t>((timestamp - calibrationGPUTimestamp) << shift) >> shift;
+	    return calibrationCPUTimestamp + static_cast<int64_t>(static_cast<double>(delta) * queue->GetTimestampPeriod());
+	};
+
+	timing.Begin = toClock(m_queryResults[i * 2]);
+	timing.End   = toClock(m_queryResults[i * 2 + 1]);
+
+#ifdef PROFILER_ENABLED
+	Profiler::RecordZone(trackNames[queueIdx], timing.Name, timing.Begin, timing.End);
+#endif // PROFILER_ENABLED
     }
 
-    for(const auto& batch: m_recordBatches)
+    // pipeline statistics of consecutive graphics passes
+    for(uint32_t first = 0; first < passCount && complete;)
     {
-	// allocate command list
-	Command* cmdList = frameResources.CommandFramePool.Acquire(batch.Queue);
+	if(!timings[first].HasStatistics)
+	{
+	    ++first;
+	    continue;
+	}
 
-	cmdList->Begin();
+	uint32_t count = 1;
+	while(first + count < passCount && timings[first + count].HasStatistics)
+	{
+	    ++count;
+	}
 
-	// record passes
-	for(size_t i = 0; i < batch.PassIndexCount; ++i)
+	constexpr uint64_t stride = sizeof(PassPipelineStatistics);
+	m_queryResults.resize(count * stride / sizeof(uint64_t));
+	complete &= frameResources.StatisticsQueryPool->GetResults(first, count, count * stride, m_queryResults.data(), stride);
+	for(uint32_t i = 0; i < count && complete; ++i)
 	{
-	    const auto& passData = m_passData[i + batch.PassIndexOffset];
+	    memcpy(&timings[first + i].Statistics, m_queryResults.data() + i * stride / sizeof(uint64_t), stride);
+	}
+	first += count;
+    }
 
-	    //ScopedLabel debugLabel(cmdList, passData.m_name);
+    // results that are not available are dropped rather than waited on
+    if(complete)
+    {
+	m_passTimings = timings;
+    }
+    timings.clear();
+}
 
-	    // before-barriers
-	    if(!passData.BeforeBarriers.empty())
-	    {
-		cmdList->Barrier(static_cast<uint32_t>(passData.BeforeBarriers.size()), passData.BeforeBarriers.data());
-	    }
+static bool IsWriteState(ResourceState state)
+{
+    const ResourceState writeStates = ResourceState::WRITE_DEPTH_STENCIL | ResourceState::WRITE_COLOR_ATTACHMENT | ResourceState::WRITE_TRANSFER | ResourceState::CLEAR_RESOURCE | ResourceState::RW_RESOURCE | ResourceState::RW_RESOURCE_WRITE_ONLY | ResourceState::PRESENT;
+    return (state & writeStates) != 0;
+}
 
-	    // record commands
-	    passData.RecordFunc(cmdList, Registry(this));
+static bool IsSameBarrierState(const CoalescedBarrier& left, const CoalescedBarrier& right)
+{
+    return left.ResourceIndex == right.ResourceIndex &&
+	   left.Barrier.m_stagesBefore == right.Barrier.m_stagesBefore &&
+	   left.Barrier.m_stagesAfter == right.Barrier.m_stagesAfter &&
+	   left.Barrier.m_stateBefore == right.Barrier.m_stateBefore &&
+	   left.Barrier.m_stateAfter == right.Barrier.m_stateAfter &&
+	   left.SrcQueueIndex == right.SrcQueueIndex &&
+	   left.DstQueueIndex == right.DstQueueIndex &&
+	   left.Barrier.m_flags == right.Barrier.m_flags &&
+	   left.EventKey == right.EventKey;
+}
 
-	    // after-barriers
-	    if(!passData.AfterBarriers.empty())
-	    {
-		cmdList->Barrier(static_cast<uint32_t>(passData.AfterBarriers.size()), passData.AfterBarriers.data());
-	    }
-	}
+// any strict order works, it only has to put barriers with the same state next to each other
+static bool IsLessBarrierState(const CoalescedBarrier& left, const CoalescedBarrier& right)
+{
+    if(left.ResourceIndex != right.ResourceIndex)
+    {
+	return left.ResourceIndex < right.ResourceIndex;
+    }
+    if(left.Barrier.m_stagesBefore != right.Barrier.m_stagesBefore)
+    {
+	return left.Barrier.m_stagesBefore < right.Barrier.m_stagesBefore;
+    }
+    if(left.Barrier.m_stagesAfter != right.Barrier.m_stagesAfter)
+    {
+	return left.Barrier.m_stagesAfter < right.Barrier.m_stagesAfter;
+    }
+    if(left.Barrier.m_stateBefore != right.Barrier.m_stateBefore)
+    {
+	return left.Barrier.m_stateBefore < right.Barrier.m_stateBefore;
+    }
+    if(left.Barrier.m_stateAfter != right.Barrier.m_stateAfter)
+    {
+	return left.Barrier.m_stateAfter < right.Barrier.m_stateAfter;
+    }
+    if(left.SrcQueueIndex != right.SrcQueueIndex)
+    {
+	return left.SrcQueueIndex < right.SrcQueueIndex;
+    }
+    if(left.DstQueueIndex != right.DstQueueIndex)
+    {
+	return left.DstQueueIndex < right.DstQueueIndex;
+    }
+    if(left.Barrier.m_flags != right.Barrier.m_flags)
+    {
+	return left.Barrier.m_flags < right.Barrier.m_flags;
+    }
+    return left.EventKey < right.EventKey;
+}
 
-	cmdList->End();
+// image barriers with the same state are merged into runs of mip levels first, then runs of layers with the same mip range.
+// a resource transitioned as a whole ends up as a single barrier
+static uint32_t CoalesceBarriers(CoalescedBarrier* barriers, uint32_t count)
+{
+    if(count < 2)
+    {
+	return count;
+    }
 
-	// submit to queue
+    const auto merge = [&](bool layers)
+    {
+	uint32_t mergedCount = 0;
+	for(uint32_t i = 0; i < count; ++i)
 	{
-	    Semaphore* waitSemaphores[3]	    = {};
-	    PipelineStageFlags waitDstStageMasks[3] = {};
-	    uint64_t waitValues[3]		    = {};
-	    uint32_t waitCount			    = 0;
-	    for(size_t i = 0; i < 3; ++i)
+	    const auto& barrier = barriers[i];
+	    if(mergedCount > 0 && barrier.Barrier.m_image && IsSameBarrierState(barriers[mergedCount - 1], barrier))
 	    {
-		if(batch.WaitDstStageMasks[i] != 0)
+		auto& prevRange	  = barriers[mergedCount - 1].Barrier.m_imageSubresourceRange;
+		const auto& range = barrier.Barrier.m_imageSubresourceRange;
+		if(!layers && prevRange.BaseArrayLayer == range.BaseArrayLayer && prevRange.LayerCount == range.LayerCount && prevRange.BaseMipLevel + prevRange.LevelCount == range.BaseMipLevel)
+		{
+		    prevRange.LevelCount += range.LevelCount;
+		    continue;
+		}
+		if(layers && prevRange.BaseMipLevel == range.BaseMipLevel && prevRange.LevelCount == range.LevelCount && prevRange.BaseArrayLayer + prevRange.LayerCount == range.BaseArrayLayer)
 		{
-		    waitSemaphores[waitCount]	 = m_semaphores[i];
-		    waitDstStageMasks[waitCount] = batch.WaitDstStageMasks[i];
-		    waitValues[waitCount]	 = batch.WaitValues[i];
-		    ++waitCount;
+		    prevRange.LayerCount += range.LayerCount;
+		    continue;
 		}
 	    }
+	    barriers[mergedCount++] = barrier;
+	}
+	count = mergedCount;
+    };
 
-	    const size_t queueIdx = batch.Queue == m_queues[0] ? 0 : batch.Queue == m_queues[1] ? 1 :
-												  2;
-
-	    SubmitInfo submitInfo = {};
+    // a slot keeps the order its barriers were generated in, which is the order of the resources. sorting the barriers of every resource
+    // on its own gives the same order as sorting the whole slot
+    const auto sortResources = [&](auto compare)
+    {
+	for(uint32_t begin = 0; begin < count;)
+	{
+	    uint32_t end = begin + 1;
+	    while(end < count && barriers[end].ResourceIndex == barriers[begin].ResourceIndex)
 	    {
-		submitInfo.WaitSemaphoreCount	= waitCount;
-		submitInfo.WaitSemaphores	= waitCount > 0 ? waitSemaphores : nullptr;
-		submitInfo.WaitValues		= waitValues;
-		submitInfo.WaitDstStageMask	= waitDstStageMasks;
-		submitInfo.CommandCount		= 1;
-		submitInfo.Commands		= &cmdList;
-		submitInfo.SignalSemaphoreCount = 1;
-		submitInfo.SignalSemaphores	= &m_semaphores[queueIdx];
-		submitInfo.SignalValues		= &batch.SignalValue;
+		++end;
+	    }
+	    if(end - begin > 1)
+	    {
+		eastl::sort(barriers + begin, barriers + end, compare);
 	    }
+	    begin = end;
+	}
+    };
 
-	    batch.Queue->Submit(1, &submitInfo);
+    sortResources([](const CoalescedBarrier& left, const CoalescedBarrier& right)
+    {
+	if(!IsSameBarrierState(left, right))
+	{
+	    return IsLessBarrierState(left, right);
+	}
+	if(left.Barrier.m_imageSubresourceRange.BaseArrayLayer != right.Barrier.m_imageSubresourceRange.BaseArrayLayer)
+	{
+	    return left.Barrier.m_imageSubresourceRange.BaseArrayLayer < right.Barrier.m_imageSubresourceRange.BaseArrayLayer;
+	}
+	return left.Barrier.m_imageSubresourceRange.BaseMipLevel < right.Barrier.m_imageSubresourceRange.BaseMipLevel;
+    });
+    merge(false);
 
-	    frameResources.FinalWaitValues[queueIdx] = MAX(frameResources.FinalWaitValues[queueIdx], batch.SignalValue);
+    sortResources([](const CoalescedBarrier& left, const CoalescedBarrier& right)
+    {
+	if(!IsSameBarrierState(left, right))
+	{
+	    return IsLessBarrierState(left, right);
 	}
-    }
+	if(left.Barrier.m_imageSubresourceRange.BaseMipLevel != right.Barrier.m_imageSubresourceRange.BaseMipLevel)
+	{
+	    return left.Barrier.m_imageSubresourceRange.BaseMipLevel < right.Barrier.m_imageSubresourceRange.BaseMipLevel;
+	}
+	if(left.Barrier.m_imageSubresourceRange.LevelCount != right.Barrier.m_imageSubresourceRange.LevelCount)
+	{
+	    return left.Barrier.m_imageSubresourceRange.LevelCount < right.Barrier.m_imageSubresourceRange.LevelCount;
+	}
+	return left.Barrier.m_imageSubresourceRange.BaseArrayLayer < right.Barrier.m_imageSubresourceRange.BaseArrayLayer;
+    });
+    merge(true);
 
-    // update global semaphore values
-    *m_semaphoreValues[0] = frameResources.FinalWaitValues[0];
-    *m_semaphoreValues[1] = frameResources.FinalWaitValues[1];
-    *m_semaphoreValues[2] = frameResources.FinalWaitValues[2];
+    return count;
 }
+
+static PipelineStageFlags GetFirstAccessStagesBefore(PipelineStageFlags aliasingStages)
+{
+    // without aliasing there is nothing to wait for
+    return aliasingStages != 0 ? aliasingStages : PipelineStageFlags::TOP_OF_PIPE_BIT;
+}
\ No newline at end of file
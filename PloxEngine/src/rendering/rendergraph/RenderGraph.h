@@ -6,17 +6,30 @@
 #include "CommandFramePool.h"
 #include "descriptions/ImageDescription.h"
 #include "EASTL/bitvector.h"
-#include "EASTL/internal/function.h"
+#include "EASTL/hash_map.h"
+#include "EASTL/type_traits.h"
+#include "EASTL/utility.h"
 #include "EASTL/vector.h"
+#include "PassScheduler.h"
+#include "rendering/CommandStream.h"
 #include "rendering/rendergraph/descriptions/BufferDescription.h"
+#include "rendering/types/Command.h"
+#include "rendering/types/MemoryHeap.h"
+#include "rendering/types/QueryPool.h"
 #include "rendering/types/Queue.h"
+#include "TransientResourcePool.h"
 #include "ViewHandles.h"
 #include <cstdint>
+#include <new>
 
 class GraphicsAdapter;
 class Semaphore;
 class ResourceViewRegistry;
 class BufferView;
+class ThreadPool;
+class Event;
+class LinearAllocator;
+class LoweredBarriers;
 
 struct ResourceStateAndStage
 {
@@ -37,6 +50,75 @@ struct ResourceUsageDescription
     ResourceStateAndStage FinalStateAndStage;
 };
 
+// layout matches the order the statistics are written by the query pool
+struct PassPipelineStatistics
+{
+    uint64_t InputAssemblyVertices;
+    uint64_t InputAssemblyPrimitives;
+    uint64_t VertexShaderInvocations;
+    uint64_t ClippingInvocations;
+    uint64_t ClippingPrimitives;
+    uint64_t PixelShaderInvocations;
+    uint64_t ComputeShaderInvocations;
+};
+
+struct PassTiming
+{
+    const char* Name;
+    QueueType QueueType;
+    // in the Clock domain
+    uint64_t Begin;
+    uint64_t End;
+    PassPipelineStatistics Statistics;
+    bool HasStatistics;
+};
+
+struct TransientMemoryStatistics
+{
+    // memory the transient resources would need without aliasing
+    uint64_t UnaliasedSize;
+    // memory actually allocated for the transient resources
+    uint64_t AliasedSize;
+    uint32_t AliasedResourceCount;
+    uint32_t HeapCount;
+};
+
+struct RenderGraphStatistics
+{
+    uint32_t PassCount;
+    // passes whose outputs are never consumed, they are neither recorded nor synchronized
+    uint32_t CulledPassCount;
+    uint32_t ResourceCount;
+    uint32_t CulledResourceCount;
+    // every batch is a submission, queue switches and semaphore waits start new ones.
+    // the waits of all batches, and both counts with the waits as generated, before dropping those implied by earlier waits
+    uint32_t BatchCount;
+    uint32_t WaitCount;
+    uint32_t UnreducedBatchCount;
+    uint32_t UnreducedWaitCount;
+    // one barrier per subresource as generated, and what is left after merging them into ranges
+    uint32_t UncoalescedBarrierCount;
+    uint32_t BarrierCount;
+    uint32_t SubresourceUsageCount;
+    // cpu time of generating the barriers and batches this frame in nanoseconds, 0 if they came from the compilation cache
+    uint64_t SynchronizationTime;
+    // whether this frame reused a cached compilation of an identical graph
+    bool CompilationCacheHit;
+    // since the graph was created, compile times exclude resource and view creation and are in nanoseconds
+    uint64_t CompilationCacheHits;
+    uint64_t CompilationCacheMisses;
+    uint64_t HitCompileTime;
+    uint64_t MissCompileTime;
+    // cpu time of recording the passes and of translating their command streams to the backend in nanoseconds,
+    // with deferred recording disabled the passes record into the backend directly and there is no translation
+    uint64_t RecordTime;
+    uint64_t TranslateTime;
+    // bytes of command streams recorded this frame
+    uint64_t CommandStreamSize;
+    // calls to Queue::Submit this frame, the batches of a queue are submitted together until another queue waits on them
+    uint32_t SubmitCount;
+};
+
 class RenderGraph
 {
     friend class Registry;
@@ -44,10 +126,7 @@ class RenderGraph
     friend struct BufferViewDescription;
 
 public:
-    using RecordFunc = eastl::function<void(Command* command, const Registry& registry)>;
-
-public:
-    explicit RenderGraph(GraphicsAdapter* adapter, Semaphore** semaphores, uint64_t* semaphoreValues, ResourceViewRegistry* resourceViewRegistry) noexcept;
+    explicit RenderGraph(GraphicsAdapter* adapter, Semaphore** semaphores, uint64_t* semaphoreValues, ResourceViewRegistry* resourceViewRegistry, ThreadPool* threadPool) noexcept;
     ~RenderGraph() noexcept;
 
     RenderGraph(const RenderGraph&)		= delete;
@@ -61,15 +140,69 @@ public:
     ResourceHandle CreateBuffer(const BufferDescription& bufferDesc) noexcept;
     ResourceHandle ImportImage(Image* image, const char* name, ResourceStateData* resourceStateData = nullptr) noexcept;
     ResourceHandle ImportBuffer(Buffer* buffer, const char* name, ResourceStateData* resourceStateData = nullptr) noexcept;
+    // the contents of the resource are needed after the graph ran, passes writing it are never culled.
+    // imported resources are outputs already
+    void MarkOutput(ResourceHandle resource) noexcept;
 
     void NextFrame() noexcept;
-    void AddPass(const char* name, QueueType queueType, size_t usageCount, const ResourceUsageDescription* usageDesc, const RecordFunc& recordFunc) noexcept;
+    // recordFunc is called as recordFunc(Command*, const Registry&). it is moved into the frame arena and destroyed in the next frame.
+    // the batches are recorded in parallel on the thread pool, so record functions of different passes may run at the same time on worker threads.
+    // they have to be thread safe and must not modify state shared with other passes or the thread calling Execute
+    template<typename RecordFunc>
+    void AddPass(const char* name, QueueType queueType, size_t usageCount, const ResourceUsageDescription* usageDesc, RecordFunc&& recordFunc) noexcept;
     void Execute() noexcept;
 
+    void SetPipelineStatisticsEnabled(bool enabled) noexcept;
+    // gpu timings of the most recently completed frame
+    const eastl::vector<PassTiming>& GetPassTimings() const noexcept;
+    void SetMemoryAliasingEnabled(bool enabled) noexcept;
+    const TransientMemoryStatistics& GetTransientMemoryStatistics() const noexcept;
+    // summed over all frames in flight
+    TransientResourcePoolStatistics GetResourcePoolStatistics() const noexcept;
+    void SetPassCullingEnabled(bool enabled) noexcept;
+    // reorders the passes within their dependencies instead of executing them in the order they were added
+    void SetPassSchedulingEnabled(bool enabled) noexcept;
+    // reuses the barriers and batches of an earlier frame with the same passes, resources and usages
+    void SetCompilationCacheEnabled(bool enabled) noexcept;
+    // passes record into backend agnostic command streams that are translated to command lists afterwards
+    void SetDeferredRecordingEnabled(bool enabled) noexcept;
+    const RenderGraphStatistics& GetStatistics() const noexcept;
+
 private:
+    void CullPasses() noexcept;
+    void SortSubresourceUsages() noexcept;
+    void SchedulePasses() noexcept;
+    void PartitionResources() noexcept;
+    void AnalyzeResources() noexcept;
+    void InferAttachmentOps() noexcept;
     void CreateResources() noexcept;
+    void AllocateTransientMemory() noexcept;
+    void DestroyTransientHeap(MemoryHeap* heap) noexcept;
     void CreateSynchronization() noexcept;
+    // completes the compilation key with everything but the passes and returns its hash
+    size_t BuildCompilationKey() noexcept;
+    void StoreCompilation(size_t key) noexcept;
+    void ApplyCompilation() noexcept;
+    void PatchSynchronization() noexcept;
+    void LowerBarriers() noexcept;
+    void DestroyLoweredBarriers() noexcept;
     void RecordAndSubmit() noexcept;
+    void CreateQueryPools() noexcept;
+    void ResolvePassTimings() noexcept;
+    template<typename T>
+    T* AllocateFrameArray(size_t count) noexcept;
+    void* AllocateFrameMemory(size_t size, size_t alignment) noexcept;
+
+private:
+    // a record function placed in the frame arena, Destroy is nullptr if it is trivially destructible
+    struct PassClosure
+    {
+	void* Data;
+	void (*Invoke)(void* data, Command* command, const Registry& registry);
+	void (*Destroy)(void* data);
+    };
+
+    void AddPassClosure(const char* name, QueueType queueType, size_t usageCount, const ResourceUsageDescription* usageDesc, const PassClosure& closure) noexcept;
 
 private:
     struct ResourceDescription
@@ -93,6 +226,7 @@ private:
 	ResourceStateData* ExternalStateData = nullptr;
 	bool Concurrent			     = false;
 	bool External			     = false;
+	bool Output			     = false;
 	bool Image			     = false;
 	bool HostVisible;
     };
@@ -111,10 +245,8 @@ private:
 	bool Image;
     };
 
-    struct Resource
+    struct Resource : PooledResource
     {
-	Image* Image;
-	Buffer* Buffer;
 	bool External;
     };
 
@@ -130,23 +262,60 @@ private:
 	RWByteBufferViewHandle RWByteBufferHandle;
 	StructuredBufferViewHandle StructuredBufferHandle;
 	RWStructuredBufferViewHandle RWStructuredBufferHandle;
+	bool Cached;
+    };
+
+    struct CachedResourceView
+    {
+	ResourceView View;
+	ResourceViewDescription Description;
+	uint64_t ResourceId;
+	uint64_t LastUsedFrame;
     };
 
-    struct SubresourceUsage
+    struct PassResourceAccess
     {
 	uint16_t PassHandle;
-	ResourceStateAndStage InitialResourceState;
-	ResourceStateAndStage FinalResourceState;
+	uint32_t ResourceIndex;
+	bool Write;
+    };
+
+    // what the passes do with a resource, FirstPass is UINT16_MAX if no pass uses it
+    struct ResourceUsageInfo
+    {
+	uint32_t UsageFlags;
+	uint16_t FirstPass;
+	uint16_t LastPass;
+	uint16_t QueueIndex;
+	PipelineStageFlags StageMask;
+	bool SingleQueue;
+    };
+
+    // a resource that is only alive between its first and last pass and can share memory with others
+    struct TransientResource
+    {
+	uint32_t ResourceIndex;
+	uint16_t FirstPass;
+	uint16_t LastPass;
+	uint16_t QueueIndex;
+	PipelineStageFlags StageMask;
+	MemoryRequirements MemoryRequirements;
+	uint64_t Offset;
     };
 
     struct PassData
     {
-	RecordFunc RecordFunc;
+	PassClosure Closure;
 	const char* Name;
 	Queue* Queue;
 	uint32_t SignalValue;
-	eastl::vector<Barrier> BeforeBarriers;
-	eastl::vector<Barrier> AfterBarriers;
+	uint32_t UsageOffset;
+	uint32_t UsageCount;
+	// the before barriers are followed by the after barriers
+	uint32_t BarrierOffset;
+	uint32_t BeforeBarrierCount;
+	uint32_t AfterBarrierCount;
+	bool Culled;
     };
 
     struct Batch
@@ -157,18 +326,98 @@ private:
 	PipelineStageFlags WaitDstStageMasks[3];
 	uint64_t WaitValues[3];
 	uint64_t SignalValue;
+	uint32_t CommandOffset;
+	uint32_t CommandCount;
 	bool LastBatchOnQueue;
     };
 
+    struct RecordChunk
+    {
+	Queue* Queue;
+	uint16_t PassIndexOffset;
+	uint16_t PassIndexCount;
+    };
+
+    // a barrier without the objects it was generated for, EventIndex is UINT32_MAX if it is not split
+    struct CompiledBarrier
+    {
+	Barrier Barrier;
+	uint32_t ResourceIndex;
+	uint32_t EventIndex;
+    };
+
+    // the before barriers of a pass are followed by its after barriers
+    struct CompiledPass
+    {
+	uint16_t PassIndex;
+	bool Culled;
+	uint32_t BarrierOffset;
+	uint32_t BeforeBarrierCount;
+	uint32_t AfterBarrierCount;
+    };
+
+    struct CompiledExternalState
+    {
+	uint32_t ResourceIndex;
+	uint32_t SubresourceIndex;
+	uint16_t QueueIndex;
+	ResourceStateAndStage StateAndStage;
+    };
+
+    // everything derived from the structure of the graph. passes are in execution order with the index they were added with,
+    // semaphore values of the batches are relative to the values at the start of the frame
+    struct Compilation
+    {
+	// the key the compilation was built from, compared on lookup so a colliding hash is not taken for the same graph
+	eastl::vector<uint32_t> Key;
+	eastl::vector<CompiledPass> Passes;
+	eastl::vector<CompiledBarrier> Barriers;
+	// native form of the barriers, owned by the compilation and updated with the objects of the frame using it
+	LoweredBarriers* Lowered;
+	uint32_t ExternalReleaseBarrierOffsets[3];
+	uint32_t ExternalReleaseBarrierCounts[3];
+	eastl::vector<Batch> Batches;
+	eastl::vector<ResourceUsageInfo> ResourceUsageInfos;
+	eastl::bitvector<> CulledResources;
+	eastl::vector<CompiledExternalState> ExternalStates;
+	eastl::vector<AttachmentLoadOp> UsageLoadOps;
+	eastl::vector<AttachmentStoreOp> UsageStoreOps;
+	uint32_t EventCount;
+	uint32_t UncoalescedBarrierCount;
+	uint32_t UnreducedBatchCount;
+	uint32_t UnreducedWaitCount;
+	uint64_t LastUsedFrame;
+    };
+
     struct FrameGPUResources
     {
 	eastl::vector<Resource> Resources;
 	eastl::vector<ResourceView> ResourceViews;
 	CommandFramePool CommandFramePool;
-	uint64_t FinalWaitValues[3] = {};
+	TransientResourcePool ResourcePool;
+	eastl::hash_multimap<size_t, CachedResourceView> ViewCache;
+	uint64_t FinalWaitValues[3]    = {};
+	QueryPool* TimestampQueryPool  = nullptr;
+	QueryPool* StatisticsQueryPool = nullptr;
+	eastl::vector<PassTiming> PassTimings;
+	eastl::vector<MemoryHeap*> TransientHeaps;
+	uint64_t CalibrationGPUTimestamp = 0;
+	uint64_t CalibrationCPUTimestamp = 0;
+	bool Calibrated			 = false;
     };
 
-    static constexpr size_t FRAME_COUNT = 2;
+    void DestroyResourceView(const ResourceView& view) noexcept;
+    static size_t HashViewDescription(const ResourceViewDescription& viewDesc, uint64_t resourceId) noexcept;
+    static bool IsSameView(const ResourceViewDescription& left, const ResourceViewDescription& right) noexcept;
+
+    static constexpr size_t FRAME_COUNT				     = 2;
+    static constexpr uint32_t MIN_PASSES_PER_RECORD_CHUNK	     = 4;
+    static constexpr uint32_t MIN_USAGES_PER_COMPILE_CHUNK	     = 1024;
+    static constexpr uint32_t MIN_QUERY_POOL_PASS_COUNT		     = 64;
+    static constexpr uint32_t MAX_UNUSED_POOLED_RESOURCE_FRAMES	     = 8;
+    static constexpr uint32_t MAX_UNUSED_COMPILATION_FRAMES	     = 64;
+    static constexpr size_t MIN_FRAME_ARENA_SIZE		     = 1024 * 1024;
+    static constexpr QueryPipelineStatisticFlags PIPELINE_STATISTICS = QueryPipelineStatisticFlags::INPUT_ASSEMBLY_VERTICES_BIT | QueryPipelineStatisticFlags::INPUT_ASSEMBLY_PRIMITIVES_BIT | QueryPipelineStatisticFlags::VERTEX_SHADER_INVOCATIONS_BIT | QueryPipelineStatisticFlags::CLIPPING_INVOCATIONS_BIT | QueryPipelineStatisticFlags::CLIPPING_PRIMITIVES_BIT | QueryPipelineStatisticFlags::PIXEL_SHADER_INVOCATIONS_BIT | QueryPipelineStatisticFlags::COMPUTE_SHADER_INVOCATIONS_BIT;
 
     uint64_t m_frame = 0;
     GraphicsAdapter* m_adapter;
@@ -176,14 +425,104 @@ private:
     Semaphore* m_semaphores[3];
     uint64_t* m_semaphoreValues[3];
     ResourceViewRegistry* m_resourceViewRegistry;
+    ThreadPool* m_threadPool;
+    bool m_timestampsSupported[3];
+    bool m_pipelineStatisticsEnabled = false;
+    bool m_memoryAliasingEnabled     = true;
+    bool m_passCullingEnabled	     = true;
+    bool m_passSchedulingEnabled     = false;
+    bool m_compilationCacheEnabled   = true;
+    bool m_deferredRecordingEnabled  = true;
 
     eastl::vector<ResourceDescription> m_resourceDescriptions;
     eastl::vector<ResourceViewDescription> m_viewDescriptions;
     eastl::bitvector<> m_culledResources;
-    eastl::vector<eastl::vector<SubresourceUsage>> m_subresourceUsages;
+    eastl::vector<ResourceUsageInfo> m_resourceUsageInfos;
+    eastl::vector<PassResourceAccess> m_passResourceAccesses;
     eastl::vector<PassData> m_passData;
     eastl::vector<Batch> m_recordBatches;
-    eastl::vector<Barrier> m_externalReleaseBarriers[3];
+    eastl::vector<RecordChunk> m_recordChunks;
+    eastl::vector<Command*> m_recordedCommands;
+    // one per record chunk, reused across frames so the stream memory stays allocated
+    eastl::vector<CommandStream> m_commandStreams;
+    // resources compiled together on one thread, chunk i covers the resources [offsets[i], offsets[i + 1])
+    eastl::vector<uint32_t> m_resourceChunkOffsets;
+    // event of every pair of passes a split barrier begins and ends at
+    eastl::hash_map<uint32_t, Event*> m_splitBarrierEvents;
+    eastl::vector<PassTiming> m_passTimings;
+    eastl::vector<uint64_t> m_queryResults;
+    eastl::vector<TransientResource> m_transientResources;
+    // stages of the resources that previously occupied the memory of a resource, indexed by resource
+    eastl::vector<PipelineStageFlags> m_aliasingBarrierStages;
+    TransientMemoryStatistics m_transientMemoryStatistics = {};
+    PassScheduler m_passScheduler;
+    // new position of every pass, indexed by the original one
+    eastl::vector<uint16_t> m_passOrder;
+    eastl::vector<uint16_t> m_passRemap;
+    uint32_t m_uncoalescedBarrierCount = 0;
+    uint32_t m_unreducedBatchCount     = 0;
+    uint32_t m_unreducedWaitCount      = 0;
+    RenderGraphStatistics m_statistics = {};
+    // structure of the graph the compilation cache is keyed by. the passes are appended as they are added, the rest of the graph in Execute.
+    // it keeps its capacity, so a graph of the same size allocates nothing
+    eastl::vector<uint32_t> m_compilationKey;
+    // hash of the pass part of the key, updated as the passes are added
+    size_t m_passHash = 0;
+    // compilation applied this frame, nullptr if the graph was compiled from scratch
+    const Compilation* m_compilation = nullptr;
+    eastl::hash_map<size_t, Compilation> m_compilationCache;
+    eastl::vector<Event*> m_compilationEvents;
+    // barriers of this frame in their native form, one group per barrier slot: the before and after barriers of every pass followed by the external releases of every queue.
+    // owned by the compilation cache if the compilation was stored, destroyed in NextFrame otherwise
+    LoweredBarriers* m_loweredBarriers = nullptr;
+    bool m_loweredBarriersCached       = false;
+
+    // usages of all passes in the order they were added, one per subresource. every pass owns a range of them
+    eastl::vector<uint32_t> m_usageSubresources;
+    eastl::vector<ResourceStateAndStage> m_usageInitialStates;
+    eastl::vector<ResourceStateAndStage> m_usageFinalStates;
+    // whether the previous contents of the subresource are needed by the usage and its contents by a later one, handed to the passes by the Registry
+    eastl::vector<AttachmentLoadOp> m_usageLoadOps;
+    eastl::vector<AttachmentStoreOp> m_usageStoreOps;
+    uint32_t m_subresourceCount = 0;
+
+    // everything below lives in the frame arena and is gone in the next frame.
+    // usages of every subresource in execution order without culled passes, subresource i owns the range [offsets[i], offsets[i + 1])
+    uint32_t* m_subresourceUsageOffsets = nullptr;
+    uint32_t* m_subresourceUsageIndices = nullptr;
+    uint16_t* m_subresourceUsagePasses	= nullptr;
+    // barriers of all passes followed by the release barriers for external resources of every queue
+    Barrier* m_barriers				= nullptr;
+    uint32_t m_barrierCount			= 0;
+    uint32_t m_externalReleaseBarrierOffsets[3] = {};
+    uint32_t m_externalReleaseBarrierCounts[3]	= {};
+    LinearAllocator* m_frameArena		= nullptr;
+    size_t m_frameArenaSize			= MIN_FRAME_ARENA_SIZE;
+    // what did not fit into the arena this frame, it grows by that much in NextFrame
+    size_t m_frameArenaOverflowSize = 0;
+    eastl::vector<void*> m_frameArenaOverflowAllocations;
 
     FrameGPUResources m_frameResources[FRAME_COUNT];
-};
\ No newline at end of file
+};
+
+template<typename RecordFunc>
+void RenderGraph::AddPass(const char* name, QueueType queueType, size_t usageCount, const ResourceUsageDescription* usageDesc, RecordFunc&& recordFunc) noexcept
+{
+    using Func = eastl::decay_t<RecordFunc>;
+
+    PassClosure closure = {};
+    closure.Data	= new(AllocateFrameMemory(sizeof(Func), alignof(Func))) Func(eastl::forward<RecordFunc>(recordFunc));
+    closure.Invoke	= [](void* data, Command* command, const Registry& registry)
+    {
+	(*static_cast<Func*>(data))(command, registry);
+    };
+    if constexpr(!eastl::is_trivially_destructible<Func>::value)
+    {
+	closure.Destroy = [](void* data)
+	{
+	    static_cast<Func*>(data)->~Func();
+	};
+    }
+
+    AddPassClosure(name, queueType, usageCount, usageDesc, closure);
+}
\ No newline at end of file
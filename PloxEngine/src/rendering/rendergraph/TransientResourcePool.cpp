@@ -0,0 +1,249 @@
+//
+// Created by Ploxie on 2023-06-21.
+//
+#include "TransientResourcePool.h"
+#include "core/Assert.h"
+#include "rendering/GraphicsAdapter.h"
+#include "utility/Utilities.h"
+#include <cstring>
+
+static size_t HashDescription(const ImageCreateInfo& createInfo, bool unbound);
+static size_t HashDescription(const BufferCreateInfo& createInfo, MemoryPropertyFlags requiredFlags, bool unbound);
+static bool IsEqual(const ImageCreateInfo& left, const ImageCreateInfo& right);
+static bool IsEqual(const BufferCreateInfo& left, const BufferCreateInfo& right);
+
+TransientResourcePool::~TransientResourcePool() noexcept
+{
+    Clear();
+}
+
+void TransientResourcePool::Initialize(GraphicsAdapter* adapter, uint32_t maxUnusedFrames) noexcept
+{
+    m_adapter	      = adapter;
+    m_maxUnusedFrames = maxUnusedFrames;
+}
+
+void TransientResourcePool::AcquireImage(const ImageCreateInfo& createInfo, bool unbound, const char* name, PooledResource* resource) noexcept
+{
+    const size_t key = HashDescription(createInfo, unbound);
+
+    auto range = m_entries.equal_range(key);
+    for(auto it = range.first; it != range.second; ++it)
+    {
+	const auto& pooled = it->second.Resource;
+	if(pooled.Image && pooled.Unbound == unbound && IsEqual(pooled.Image->GetDescription(), createInfo))
+	{
+	    *resource = pooled;
+	    m_entries.erase(it);
+	    ++m_statistics.Hits;
+	    --m_statistics.PooledCount;
+	    return;
+	}
+    }
+
+    *resource	      = {};
+    resource->Key     = key;
+    resource->Id      = m_nextId++;
+    resource->Unbound = unbound;
+
+    if(unbound)
+    {
+	m_adapter->CreateUnboundImage(createInfo, &resource->Image);
+    }
+    else
+    {
+	m_adapter->CreateImage(createInfo, MemoryPropertyFlags::DEVICE_LOCAL_BIT, {}, false, &resource->Image);
+    }
+    m_adapter->SetDebugObjectName(ObjectType::IMAGE, resource->Image, name);
+    ++m_statistics.Misses;
+}
+
+void TransientResourcePool::AcquireBuffer(const BufferCreateInfo& createInfo, MemoryPropertyFlags requiredFlags, MemoryPropertyFlags preferredFlags, bool unbound, const char* name, PooledResource* resource) noexcept
+{
+    const size_t key = HashDescription(createInfo, requiredFlags, unbound);
+
+    auto range = m_entries.equal_range(key);
+    for(auto it = range.first; it != range.second; ++it)
+    {
+	const auto& pooled = it->second.Resource;
+	if(pooled.Buffer && pooled.Unbound == unbound && pooled.RequiredFlags == requiredFlags && IsEqual(pooled.Buffer->GetDescription(), createInfo))
+	{
+	    *resource = pooled;
+	    m_entries.erase(it);
+	    ++m_statistics.Hits;
+	    --m_statistics.PooledCount;
+	    return;
+	}
+    }
+
+    *resource		    = {};
+    resource->Key	    = key;
+    resource->Id	    = m_nextId++;
+    resource->RequiredFlags = requiredFlags;
+    resource->Unbound	    = unbound;
+
+    if(unbound)
+    {
+	m_adapter->CreateUnboundBuffer(createInfo, &resource->Buffer);
+    }
+    else
+    {
+	m_adapter->CreateBuffer(createInfo, requiredFlags, preferredFlags, false, &resource->Buffer);
+    }
+    m_adapter->SetDebugObjectName(ObjectType::BUFFER, resource->Buffer, name);
+    ++m_statistics.Misses;
+}
+
+void TransientResourcePool::Recreate(PooledResource* resource, const char* name) noexcept
+{
+    ASSERT(resource->Unbound);
+
+    if(resource->Image)
+    {
+	const ImageCreateInfo createInfo = resource->Image->GetDescription();
+	m_adapter->DestroyImage(resource->Image);
+	m_adapter->CreateUnboundImage(createInfo, &resource->Image);
+	m_adapter->SetDebugObjectName(ObjectType::IMAGE, resource->Image, name);
+    }
+    else
+    {
+	const BufferCreateInfo createInfo = resource->Buffer->GetDescription();
+	m_adapter->DestroyBuffer(resource->Buffer);
+	m_adapter->CreateUnboundBuffer(createInfo, &resource->Buffer);
+	m_adapter->SetDebugObjectName(ObjectType::BUFFER, resource->Buffer, name);
+    }
+
+    resource->Id	 = m_nextId++;
+    resource->Heap	 = nullptr;
+    resource->HeapOffset = 0;
+    resource->Bound	 = false;
+    ++m_statistics.Misses;
+}
+
+void TransientResourcePool::Release(const PooledResource& resource, uint64_t frame) noexcept
+{
+    // an unbound resource that never got memory cannot be placed anywhere later on
+    if(resource.Unbound && (!resource.Bound || !resource.Heap))
+    {
+	Destroy(resource);
+	return;
+    }
+
+    Entry entry		= {};
+    entry.Resource	= resource;
+    entry.LastUsedFrame = frame;
+
+    m_entries.insert(eastl::make_pair(resource.Key, entry));
+    ++m_statistics.PooledCount;
+}
+
+void TransientResourcePool::Evict(uint64_t frame) noexcept
+{
+    for(auto it = m_entries.begin(); it != m_entries.end();)
+    {
+	if(it->second.LastUsedFrame + m_maxUnusedFrames < frame)
+	{
+	    Destroy(it->second.Resource);
+	    it = m_entries.erase(it);
+	    ++m_statistics.Evictions;
+	    --m_statistics.PooledCount;
+	}
+	else
+	{
+	    ++it;
+	}
+    }
+}
+
+void TransientResourcePool::EvictMemoryHeap(const MemoryHeap* heap) noexcept
+{
+    for(auto it = m_entries.begin(); it != m_entries.end();)
+    {
+	if(it->second.Resource.Unbound && it->second.Resource.Heap == heap)
+	{
+	    Destroy(it->second.Resource);
+	    it = m_entries.erase(it);
+	    ++m_statistics.Evictions;
+	    --m_statistics.PooledCount;
+	}
+	else
+	{
+	    ++it;
+	}
+    }
+}
+
+void TransientResourcePool::Clear() noexcept
+{
+    for(auto& entry: m_entries)
+    {
+	Destroy(entry.second.Resource);
+    }
+    m_entries.clear();
+    m_statistics.PooledCount = 0;
+}
+
+const TransientResourcePoolStatistics& TransientResourcePool::GetStatistics() const noexcept
+{
+    return m_statistics;
+}
+
+void TransientResourcePool::Destroy(const PooledResource& resource) noexcept
+{
+    if(resource.Image)
+    {
+	m_adapter->DestroyImage(resource.Image);
+    }
+    else if(resource.Buffer)
+    {
+	m_adapter->DestroyBuffer(resource.Buffer);
+    }
+}
+
+static size_t HashDescription(const ImageCreateInfo& createInfo, bool unbound)
+{
+    size_t hash = 0;
+    Util::HashCombine(hash, createInfo.Width);
+    Util::HashCombine(hash, createInfo.Height);
+    Util::HashCombine(hash, createInfo.Depth);
+    Util::HashCombine(hash, createInfo.Levels);
+    Util::HashCombine(hash, createInfo.Layers);
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.Samples));
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.ImageType));
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.Format));
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.CreateFlags));
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.UsageFlags));
+    Util::HashCombine(hash, unbound);
+    return hash;
+}
+
+static size_t HashDescription(const BufferCreateInfo& createInfo, MemoryPropertyFlags requiredFlags, bool unbound)
+{
+    size_t hash = 0;
+    Util::HashCombine(hash, createInfo.Size);
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.CreateFlags));
+    Util::HashCombine(hash, static_cast<uint32_t>(createInfo.UsageFlags));
+    Util::HashCombine(hash, static_cast<uint32_t>(requiredFlags));
+    Util::HashCombine(hash, unbound);
+    return hash;
+}
+
+static bool IsEqual(const ImageCreateInfo& left, const ImageCreateInfo& right)
+{
+    return left.Width == right.Width &&
+	   left.Height == right.Height &&
+	   left.Depth == right.Depth &&
+	   left.Levels == right.Levels &&
+	   left.Layers == right.Layers &&
+	   left.Samples == right.Samples &&
+	   left.ImageType == right.ImageType &&
+	   left.Format == right.Format &&
+	   left.CreateFlags == right.CreateFlags &&
+	   left.UsageFlags == right.UsageFlags &&
+	   memcmp(&left.OptimizedClearValue, &right.OptimizedClearValue, sizeof(ClearValue)) == 0;
+}
+
+static bool IsEqual(const BufferCreateInfo& left, const BufferCreateInfo& right)
+{
+    return left.Size == right.Size && left.CreateFlags == right.CreateFlags && left.UsageFlags == right.UsageFlags;
+}
\ No newline at end of file
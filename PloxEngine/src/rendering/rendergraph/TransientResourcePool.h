@@ -0,0 +1,81 @@
+//
+// Created by Ploxie on 2023-06-21.
+//
+
+#pragma once
+#include "EASTL/hash_map.h"
+#include "rendering/types/Buffer.h"
+#include "rendering/types/Image.h"
+#include <cstdint>
+
+class GraphicsAdapter;
+class MemoryHeap;
+
+// Id changes whenever the pool creates a new object, so it can key data derived from the resource.
+// Heap and HeapOffset are where an unbound resource was placed, Heap is nullptr if that memory no longer exists
+struct PooledResource
+{
+    Image* Image		      = nullptr;
+    Buffer* Buffer		      = nullptr;
+    MemoryHeap* Heap		      = nullptr;
+    uint64_t HeapOffset		      = 0;
+    size_t Key			      = 0;
+    uint64_t Id			      = 0;
+    MemoryPropertyFlags RequiredFlags = static_cast<MemoryPropertyFlags>(0);
+    bool Unbound		      = false;
+    bool Bound			      = false;
+};
+
+struct TransientResourcePoolStatistics
+{
+    uint64_t Hits;
+    uint64_t Misses;
+    uint64_t Evictions;
+    uint32_t PooledCount;
+};
+
+// recycles the transient resources of a frame slot instead of creating and destroying them every frame
+class TransientResourcePool
+{
+public:
+    explicit TransientResourcePool() noexcept = default;
+    ~TransientResourcePool() noexcept;
+
+    TransientResourcePool(const TransientResourcePool&)		    = delete;
+    TransientResourcePool(const TransientResourcePool&&)	    = delete;
+    TransientResourcePool& operator=(const TransientResourcePool&)  = delete;
+    TransientResourcePool& operator=(const TransientResourcePool&&) = delete;
+
+    void Initialize(GraphicsAdapter* adapter, uint32_t maxUnusedFrames) noexcept;
+
+    // returns a released resource with the same description or creates a new one
+    void AcquireImage(const ImageCreateInfo& createInfo, bool unbound, const char* name, PooledResource* resource) noexcept;
+    void AcquireBuffer(const BufferCreateInfo& createInfo, MemoryPropertyFlags requiredFlags, MemoryPropertyFlags preferredFlags, bool unbound, const char* name, PooledResource* resource) noexcept;
+    // memory can only be bound once, so an unbound resource that has to move gets replaced by a new one
+    void Recreate(PooledResource* resource, const char* name) noexcept;
+    // the gpu has to be done with the resource
+    void Release(const PooledResource& resource, uint64_t frame) noexcept;
+
+    // destroys released resources that were not acquired in the last maxUnusedFrames frames
+    void Evict(uint64_t frame) noexcept;
+    void EvictMemoryHeap(const MemoryHeap* heap) noexcept;
+    void Clear() noexcept;
+
+    const TransientResourcePoolStatistics& GetStatistics() const noexcept;
+
+private:
+    struct Entry
+    {
+	PooledResource Resource;
+	uint64_t LastUsedFrame;
+    };
+
+    void Destroy(const PooledResource& resource) noexcept;
+
+private:
+    GraphicsAdapter* m_adapter = nullptr;
+    uint32_t m_maxUnusedFrames = 8;
+    uint64_t m_nextId	       = 1;
+    eastl::hash_multimap<size_t, Entry> m_entries;
+    TransientResourcePoolStatistics m_statistics = {};
+};
\ No newline at end of file
@@ -6,12 +6,18 @@
 #include "rendering/GraphicsAdapter.h"
 #include "rendering/rendergraph/RenderGraph.h"
 
-RenderView::RenderView(GraphicsAdapter* adapter, ResourceViewRegistry* viewRegistry, DescriptorSetLayout* offsetBufferSetLayout, uint32_t width, uint32_t height) noexcept
+RenderView::RenderView(GraphicsAdapter* adapter, ResourceViewRegistry* viewRegistry, StreamingUploader* uploader, DescriptorSetLayout* offsetBufferSetLayout, uint32_t width, uint32_t height) noexcept
     : m_adapter(adapter), m_resourceRegistry(viewRegistry), m_width(width), m_height(height), m_resources({})
 {
     CreateImageResources(width, height);
 
-    m_cubePass = new CubePass(adapter, offsetBufferSetLayout);
+    m_cubePass = new CubePass(adapter, uploader, offsetBufferSetLayout);
+}
+
+RenderView::~RenderView() noexcept
+{
+    delete m_cubePass;
+    m_adapter->DestroyImage(m_resources.ResultImage);
 }
 
 void RenderView::Render(const RenderView::Data& data, RenderGraph* renderGraph) noexcept
@@ -12,6 +12,7 @@
 #include <cstdint>
 
 class DescriptorSetLayout;
+class StreamingUploader;
 
 class RenderView
 {
@@ -26,7 +27,8 @@ public:
     };
 
 public:
-    explicit RenderView(GraphicsAdapter* adapter, ResourceViewRegistry* viewRegistry, DescriptorSetLayout* offsetBufferSetLayout, uint32_t width, uint32_t height) noexcept;
+    explicit RenderView(GraphicsAdapter* adapter, ResourceViewRegistry* viewRegistry, StreamingUploader* uploader, DescriptorSetLayout* offsetBufferSetLayout, uint32_t width, uint32_t height) noexcept;
+    ~RenderView() noexcept;
 
     void Render(const Data& data, RenderGraph* renderGraph) noexcept;
 
@@ -8,6 +8,7 @@
 class Image;
 class Buffer;
 class Queue;
+class Event;
 
 enum class PipelineStageFlags
 {
@@ -57,7 +58,8 @@ enum class BarrierFlags
     QUEUE_OWNERSHIP_AQUIRE     = 1u << 1u,
     FIRST_ACCESS_IN_SUBMISSION = 1u << 2u,
     BARRIER_BEGIN	       = 1u << 3u,
-    BARRIER_END		       = 1u << 4u
+    BARRIER_END		       = 1u << 4u,
+    ALIASING		       = 1u << 5u
 };
 DEF_ENUM_FLAG_OPERATORS(BarrierFlags);
 
@@ -81,4 +83,6 @@ struct Barrier
     Queue* m_dstQueue;
     ImageSubresourceRange m_imageSubresourceRange;
     BarrierFlags m_flags;
+    // set on both halves of a split barrier, nullptr makes the end a regular barrier
+    const Event* m_event;
 };
\ No newline at end of file
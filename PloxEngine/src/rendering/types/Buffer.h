@@ -54,6 +54,13 @@ struct BufferCreateInfo
     BufferUsageFlags UsageFlags	  = static_cast<BufferUsageFlags>(0);
 };
 
+struct BufferCopy
+{
+    uint64_t SrcOffset;
+    uint64_t DstOffset;
+    uint64_t Size;
+};
+
 struct MemoryRange
 {
     uint64_t m_offset;
@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include "Barrier.h"
 #include "Buffer.h"
+#include "ComputePipeline.h"
 #include "DescriptorSet.h"
 #include "GraphicsPipeline.h"
+#include "QueryPool.h"
 
 class ImageSubresourceRange;
 class Barrier;
+class LoweredBarriers;
 
 enum class StencilFaceFlags
 {
@@ -59,6 +63,7 @@ public:
     virtual void Begin()																			    = 0;
     virtual void End()																				    = 0;
     virtual void BindPipeline(const GraphicsPipeline* pipeline)															    = 0;
+    virtual void BindPipeline(const ComputePipeline* pipeline)															    = 0;
     virtual void SetViewports(uint32_t firstViewport, uint32_t viewportCount, const Viewport* viewports)									    = 0;
     virtual void SetScissors(uint32_t firstScissor, uint32_t scissorCount, const Rect* scissors)										    = 0;
     virtual void SetLineWidth(float lineWidth)																	    = 0;
@@ -69,31 +74,33 @@ public:
     virtual void SetStencilWriteMask(StencilFaceFlags faceMask, uint32_t writeMask)												    = 0;
     virtual void SetStencilReference(StencilFaceFlags faceMask, uint32_t reference)												    = 0;
     virtual void BindDescriptorSets(const GraphicsPipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets) = 0;
-    //virtual void bindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)  = 0;
+    virtual void BindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)  = 0;
     virtual void BindIndexBuffer(const Buffer* buffer, uint64_t offset, IndexType indexType)						     = 0;
     virtual void BindVertexBuffers(uint32_t firstBinding, uint32_t count, const Buffer* const* buffers, uint64_t* offsets)		     = 0;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)			     = 0;
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) = 0;
     //virtual void drawIndirect(const Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)									    = 0;
     //virtual void drawIndexedIndirect(const Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)								    = 0;
-    //virtual void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)											    = 0;
-    //virtual void dispatchIndirect(const Buffer* buffer, uint64_t offset)								 = 0;
-    //virtual void copyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions)		 = 0;
+    virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)											    = 0;
+    virtual void DispatchIndirect(const Buffer* buffer, uint64_t offset)								 = 0;
+    virtual void CopyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions)		 = 0;
     virtual void CopyImage(const Image* srcImage, const Image* dstImage, uint32_t regionCount, const ImageCopy* regions) = 0;
-    //virtual void copyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions) = 0;
+    virtual void CopyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions) = 0;
     //virtual void copyImageToBuffer(const Image* srcImage, const Buffer* dstBuffer, uint32_t regionCount, const BufferImageCopy* regions) = 0;
-    //virtual void updateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data) = 0;
+    // dataSize has to be a multiple of 4 and at most 65536 bytes
+    virtual void UpdateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data) = 0;
     //virtual void fillBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t size, uint32_t data)								  = 0;
     virtual void ClearColorImage(const Image* image, const ClearColorValue* color, uint32_t rangeCount, const ImageSubresourceRange* ranges)			  = 0;
     virtual void ClearDepthStencilImage(const Image* image, const ClearDepthStencilValue* depthStencil, uint32_t rangeCount, const ImageSubresourceRange* ranges) = 0;
     virtual void Barrier(uint32_t count, const Barrier* barriers)												  = 0;
-    //virtual void beginQuery(const QueryPool* queryPool, uint32_t query) = 0;
-    //virtual void endQuery(const QueryPool* queryPool, uint32_t query) = 0;
-    //virtual void resetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount) = 0;
-    //virtual void writeTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query) = 0;
-    //virtual void copyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset) = 0;
-    virtual void PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values) = 0;
-    //virtual void pushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)									     = 0;
+    virtual void Barrier(const LoweredBarriers* loweredBarriers, uint32_t group)										  = 0;
+    virtual void BeginQuery(const QueryPool* queryPool, uint32_t query)												  = 0;
+    virtual void EndQuery(const QueryPool* queryPool, uint32_t query)												  = 0;
+    virtual void ResetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount)								  = 0;
+    virtual void WriteTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query)							  = 0;
+    virtual void CopyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset)	  = 0;
+    virtual void PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)		  = 0;
+    virtual void PushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)									     = 0;
     virtual void BeginRenderPass(uint32_t colorAttachmentCount, ColorAttachmentDescription* colorAttachments, DepthStencilAttachmentDescription* depthStencilAttachment, const Rect& renderArea, bool rwTextureBufferAccess) = 0;
     virtual void EndRenderPass()																							     = 0;
     //virtual void insertDebugLabel(const char *label)																					     = 0;
@@ -0,0 +1,21 @@
+//
+// Created by Ploxie on 2023-07-01.
+//
+
+#pragma once
+#include "GraphicsPipeline.h"
+
+struct ComputePipelineCreateInfo
+{
+    ShaderStageCreateInfo ComputeShader;
+    PipelineLayoutCreateInfo LayoutCreateInfo;
+};
+
+class ComputePipeline
+{
+public:
+    virtual ~ComputePipeline()							    = default;
+    virtual void* GetNativeHandle() const					    = 0;
+    virtual uint32_t GetDescriptorSetLayoutCount() const			    = 0;
+    virtual const DescriptorSetLayout* GetDescriptorSetLayout(uint32_t index) const = 0;
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+//
+// Created by Ploxie on 2023-06-27.
+//
+
+#pragma once
+
+// set by one command and waited on by a later one on the same queue, the work in between can overlap with the wait
+class Event
+{
+public:
+    virtual ~Event()			  = default;
+    virtual void* GetNativeHandle() const = 0;
+    // the gpu has to be done with all commands using the event
+    virtual void Reset() = 0;
+};
\ No newline at end of file
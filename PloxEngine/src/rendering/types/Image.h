@@ -76,6 +76,19 @@ struct ImageCopy
     Extent3D m_extent;
 };
 
+// BufferRowLength and BufferImageHeight are in texels, 0 means tightly packed
+struct BufferImageCopy
+{
+    uint64_t BufferOffset;
+    uint32_t BufferRowLength;
+    uint32_t BufferImageHeight;
+    uint32_t MipLevel;
+    uint32_t BaseArrayLayer;
+    uint32_t LayerCount;
+    Offset3D Offset;
+    Extent3D Extent;
+};
+
 struct ImageCreateInfo
 {
     uint32_t Width		 = 1;
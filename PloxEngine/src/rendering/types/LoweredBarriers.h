@@ -0,0 +1,18 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#pragma once
+#include "Barrier.h"
+
+// groups of barriers translated into the form the backend records, created by GraphicsAdapter::CreateLoweredBarriers.
+// the translation of the states, stages and queues is done once, recording a group with Command::Barrier only hands the result to the backend
+class LoweredBarriers
+{
+public:
+    virtual ~LoweredBarriers() = default;
+
+    // resolves the images, buffers and events of barriers, which have the layout the object was created with.
+    // barriers whose before stages or flags changed since the last update are translated again, the other states have to stay the same
+    virtual void Update(const Barrier* barriers) = 0;
+};
\ No newline at end of file
@@ -0,0 +1,31 @@
+//
+// Created by Ploxie on 2023-06-18.
+//
+
+#pragma once
+#include "Buffer.h"
+#include <cstdint>
+
+struct MemoryRequirements
+{
+    uint64_t Size	    = 0;
+    uint64_t Alignment	    = 1;
+    uint32_t MemoryTypeBits = 0;
+};
+
+struct MemoryHeapCreateInfo
+{
+    uint64_t Size		       = 0;
+    uint32_t MemoryTypeBits	       = ~0u;
+    MemoryPropertyFlags RequiredFlags  = MemoryPropertyFlags::DEVICE_LOCAL_BIT;
+    MemoryPropertyFlags PreferredFlags = static_cast<MemoryPropertyFlags>(0);
+};
+
+// a block of memory that unbound images and buffers can be placed into, resources placed at overlapping ranges alias each other
+class MemoryHeap
+{
+public:
+    virtual ~MemoryHeap()				       = default;
+    virtual void* GetNativeHandle() const		       = 0;
+    virtual const MemoryHeapCreateInfo& GetDescription() const = 0;
+};
\ No newline at end of file
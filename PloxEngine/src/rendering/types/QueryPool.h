@@ -0,0 +1,47 @@
+//
+// Created by Ploxie on 2023-06-15.
+//
+
+#pragma once
+#include "utility/Enum.h"
+#include <cstdint>
+
+enum class QueryType
+{
+    OCCLUSION,
+    PIPELINE_STATISTICS,
+    TIMESTAMP
+};
+
+enum class QueryPipelineStatisticFlags
+{
+    INPUT_ASSEMBLY_VERTICES_BIT	    = 1u << 0u,
+    INPUT_ASSEMBLY_PRIMITIVES_BIT   = 1u << 1u,
+    VERTEX_SHADER_INVOCATIONS_BIT   = 1u << 2u,
+    GEOMETRY_SHADER_INVOCATIONS_BIT = 1u << 3u,
+    GEOMETRY_SHADER_PRIMITIVES_BIT  = 1u << 4u,
+    CLIPPING_INVOCATIONS_BIT	    = 1u << 5u,
+    CLIPPING_PRIMITIVES_BIT	    = 1u << 6u,
+    PIXEL_SHADER_INVOCATIONS_BIT    = 1u << 7u,
+    HULL_SHADER_PATCHES_BIT	    = 1u << 8u,
+    DOMAIN_SHADER_INVOCATIONS_BIT   = 1u << 9u,
+    COMPUTE_SHADER_INVOCATIONS_BIT  = 1u << 10u,
+};
+DEF_ENUM_FLAG_OPERATORS(QueryPipelineStatisticFlags)
+
+struct QueryPoolCreateInfo
+{
+    QueryType QueryType				   = QueryType::TIMESTAMP;
+    uint32_t QueryCount				   = 1;
+    QueryPipelineStatisticFlags PipelineStatistics = static_cast<QueryPipelineStatisticFlags>(0);
+};
+
+class QueryPool
+{
+public:
+    virtual ~QueryPool()				      = default;
+    virtual void* GetNativeHandle() const		      = 0;
+    virtual const QueryPoolCreateInfo& GetDescription() const = 0;
+    // copies 64 bit results to the host without waiting, returns false if any of the queries is not available yet
+    virtual bool GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t dataSize, void* data, uint64_t stride) const = 0;
+};
\ No newline at end of file
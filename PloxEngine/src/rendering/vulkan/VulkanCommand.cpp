@@ -3,179 +3,21 @@
 //
 #include "VulkanCommand.h"
 #include "core/Assert.h"
+#include "core/Profiler.h"
 #include "rendering/RenderUtilities.h"
 #include "rendering/types/Barrier.h"
 #include "rendering/types/Buffer.h"
 #include "utility/memory/DefaultAllocator.h"
 #include "volk.h"
 #include "VulkanBuffer.h"
+#include "VulkanComputePipeline.h"
 #include "VulkanGraphicsAdapter.h"
 #include "VulkanGraphicsPipeline.h"
+#include "VulkanLoweredBarriers.h"
 #include "VulkanUtilities.h"
 
 static constexpr uint32_t MEMORY_SIZE = 1024 * 256;
 
-struct ResourceStateInfo
-{
-    VkPipelineStageFlags m_stageMask;
-    VkAccessFlags m_accessMask;
-    VkImageLayout m_layout;
-    bool m_readAccess;
-    bool m_writeAccess;
-};
-
-static ResourceStateInfo GetResourceStateInfo(ResourceState state, VkPipelineStageFlags stageFlags, bool isImage, Format imageFormat)
-{
-    ResourceStateInfo result {};
-
-    if(state == ResourceState::UNDEFINED)
-    {
-	result = { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED, false, false };
-	return result;
-    }
-
-    if((state & ResourceState::READ_RESOURCE) != 0)
-    {
-	result.m_stageMask |= stageFlags;
-	result.m_accessMask |= VK_ACCESS_SHADER_READ_BIT;
-	result.m_layout	    = RenderUtilities::IsDepthFormat(imageFormat) || RenderUtilities::IsStencilFormat(imageFormat) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::READ_DEPTH_STENCIL) != 0)
-    {
-	ASSERT(isImage);
-	result.m_stageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-	result.m_accessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-	result.m_layout	    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::READ_CONSTANT_BUFFER) != 0)
-    {
-	ASSERT(!isImage);
-	result.m_stageMask |= stageFlags;
-	result.m_accessMask |= VK_ACCESS_UNIFORM_READ_BIT;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::READ_VERTEX_BUFFER) != 0)
-    {
-	ASSERT(!isImage);
-	result.m_stageMask |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-	result.m_accessMask |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::READ_INDEX_BUFFER) != 0)
-    {
-	ASSERT(!isImage);
-	result.m_stageMask |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-	result.m_accessMask |= VK_ACCESS_INDEX_READ_BIT;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::READ_INDIRECT_BUFFER) != 0)
-    {
-	ASSERT(!isImage);
-	result.m_stageMask |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-	result.m_accessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::READ_TRANSFER) != 0)
-    {
-	ASSERT(!isImage || state == ResourceState::READ_TRANSFER); // READ_TRANSFER is an exclusive state on image resources
-	result.m_stageMask |= VK_PIPELINE_STAGE_TRANSFER_BIT;
-	result.m_accessMask |= VK_ACCESS_TRANSFER_READ_BIT;
-	result.m_layout	    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-	result.m_readAccess = true;
-    }
-
-    if((state & ResourceState::WRITE_DEPTH_STENCIL) != 0)
-    {
-	ASSERT(isImage);
-	ASSERT(state == ResourceState::WRITE_DEPTH_STENCIL);
-	result.m_stageMask   = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-	result.m_accessMask  = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-	result.m_writeAccess = true;
-    }
-
-    if((state & ResourceState::WRITE_COLOR_ATTACHMENT) != 0)
-    {
-	ASSERT(isImage);
-	ASSERT(state == ResourceState::WRITE_COLOR_ATTACHMENT);
-	result.m_stageMask   = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	result.m_accessMask  = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-	result.m_writeAccess = true;
-    }
-
-    if((state & ResourceState::WRITE_TRANSFER) != 0)
-    {
-	ASSERT(state == ResourceState::WRITE_TRANSFER);
-	result.m_stageMask   = VK_PIPELINE_STAGE_TRANSFER_BIT;
-	result.m_accessMask  = VK_ACCESS_TRANSFER_WRITE_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	result.m_writeAccess = true;
-    }
-
-    if((state & ResourceState::CLEAR_RESOURCE) != 0)
-    {
-	ASSERT(state == ResourceState::CLEAR_RESOURCE);
-	result.m_stageMask   = VK_PIPELINE_STAGE_TRANSFER_BIT;
-	result.m_accessMask  = VK_ACCESS_TRANSFER_WRITE_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	result.m_writeAccess = true;
-    }
-
-    if((state & ResourceState::RW_RESOURCE) != 0)
-    {
-	ASSERT(state == ResourceState::RW_RESOURCE);
-	result.m_stageMask   = stageFlags;
-	result.m_accessMask  = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_GENERAL;
-	result.m_readAccess  = true;
-	result.m_writeAccess = true;
-    }
-
-    if((state & ResourceState::RW_RESOURCE_READ_ONLY) != 0)
-    {
-	ASSERT(state == ResourceState::RW_RESOURCE_READ_ONLY);
-	result.m_stageMask   = stageFlags;
-	result.m_accessMask  = VK_ACCESS_SHADER_READ_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_GENERAL;
-	result.m_readAccess  = true;
-	result.m_writeAccess = false;
-    }
-
-    if((state & ResourceState::RW_RESOURCE_WRITE_ONLY) != 0)
-    {
-	ASSERT(state == ResourceState::RW_RESOURCE_WRITE_ONLY);
-	result.m_stageMask   = stageFlags;
-	result.m_accessMask  = VK_ACCESS_SHADER_WRITE_BIT;
-	result.m_layout	     = VK_IMAGE_LAYOUT_GENERAL;
-	result.m_readAccess  = false;
-	result.m_writeAccess = true;
-    }
-
-    if((state & ResourceState::PRESENT) != 0)
-    {
-	ASSERT(isImage);
-	ASSERT(state == ResourceState::PRESENT);
-	result.m_stageMask   = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-	result.m_accessMask  = 0;
-	result.m_layout	     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-	result.m_readAccess  = true;
-	result.m_writeAccess = false;
-    }
-
-    result.m_layout = isImage ? result.m_layout : VK_IMAGE_LAYOUT_UNDEFINED;
-
-    return result;
-};
-
 VulkanCommand::VulkanCommand(VkCommandBuffer commandBuffer, VulkanGraphicsAdapter* adapter) noexcept
     : m_commandBuffer(commandBuffer), m_adapter(adapter), m_memoryAllocation(DefaultAllocator::Get(), DefaultAllocator::Get()->allocate(MEMORY_SIZE), MEMORY_SIZE), m_allocator(static_cast<char*>(m_memoryAllocation.GetAllocation()), MEMORY_SIZE, "VulkanCommand Linear Allocator")
 {
@@ -209,6 +51,15 @@ void VulkanCommand::BindPipeline(const GraphicsPipeline* pipeline)
     pipelineVk->BindStaticSamplerSet(m_commandBuffer);
 }
 
+void VulkanCommand::BindPipeline(const ComputePipeline* pipeline)
+{
+    const auto* pipelineVk = dynamic_cast<const VulkanComputePipeline*>(pipeline);
+    ASSERT(pipelineVk);
+
+    vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, static_cast<VkPipeline>(pipeline->GetNativeHandle()));
+    pipelineVk->BindStaticSamplerSet(m_commandBuffer);
+}
+
 void VulkanCommand::SetViewports(uint32_t firstViewport, uint32_t viewportCount, const Viewport* viewports)
 {
     vkCmdSetViewport(m_commandBuffer, firstViewport, viewportCount, reinterpret_cast<const VkViewport*>(viewports));
@@ -273,6 +124,25 @@ void VulkanCommand::BindDescriptorSets(const GraphicsPipeline* pipeline, uint32_
     vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, firstSet, count, descriptorSets, offsetCount, offsets);
 }
 
+void VulkanCommand::BindDescriptorSets(const ComputePipeline* pipeline, uint32_t firstSet, uint32_t count, const DescriptorSet* const* sets, uint32_t offsetCount, uint32_t* offsets)
+{
+    LinearAllocatorFrame allocatorFrame(&m_allocator);
+
+    const auto* pipelineVk = dynamic_cast<const VulkanComputePipeline*>(pipeline);
+    ASSERT(pipelineVk);
+
+    VkPipelineLayout pipelineLayout = pipelineVk->GetLayout();
+
+    auto* descriptorSets = allocatorFrame.AllocateArray<VkDescriptorSet>(count);
+
+    for(size_t i = 0; i < count; i++)
+    {
+	descriptorSets[i] = static_cast<VkDescriptorSet>(sets[i]->GetNativeHandle());
+    }
+
+    vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, firstSet, count, descriptorSets, offsetCount, offsets);
+}
+
 void VulkanCommand::BindIndexBuffer(const Buffer* buffer, uint64_t offset, IndexType indexType)
 {
     const auto* buf = dynamic_cast<const VulkanBuffer*>(buffer);
@@ -305,6 +175,28 @@ void VulkanCommand::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uin
     vkCmdDrawIndexed(m_commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+void VulkanCommand::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    vkCmdDispatch(m_commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+void VulkanCommand::DispatchIndirect(const Buffer* buffer, uint64_t offset)
+{
+    const auto* buf = dynamic_cast<const VulkanBuffer*>(buffer);
+    ASSERT(buf);
+
+    vkCmdDispatchIndirect(m_commandBuffer, (VkBuffer) buf->GetNativeHandle(), offset);
+}
+
+void VulkanCommand::CopyBuffer(const Buffer* srcBuffer, const Buffer* dstBuffer, uint32_t regionCount, const BufferCopy* regions)
+{
+    const auto* srcBufferVk = dynamic_cast<const VulkanBuffer*>(srcBuffer);
+    const auto* dstBufferVk = dynamic_cast<const VulkanBuffer*>(dstBuffer);
+    ASSERT(srcBufferVk && dstBufferVk);
+
+    vkCmdCopyBuffer(m_commandBuffer, (VkBuffer) srcBufferVk->GetNativeHandle(), (VkBuffer) dstBufferVk->GetNativeHandle(), regionCount, reinterpret_cast<const VkBufferCopy*>(regions));
+}
+
 void VulkanCommand::CopyImage(const Image* srcImage, const Image* dstImage, uint32_t regionCount, const ImageCopy* regions)
 {
     LinearAllocatorFrame linearAllocatorFrame(&m_allocator);
@@ -331,6 +223,43 @@ void VulkanCommand::CopyImage(const Image* srcImage, const Image* dstImage, uint
     vkCmdCopyImage(m_commandBuffer, srcImageVk, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImageVk, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regionCount, regionsVk);
 }
 
+void VulkanCommand::CopyBufferToImage(const Buffer* srcBuffer, const Image* dstImage, uint32_t regionCount, const BufferImageCopy* regions)
+{
+    LinearAllocatorFrame linearAllocatorFrame(&m_allocator);
+
+    const auto* srcBufferVk = dynamic_cast<const VulkanBuffer*>(srcBuffer);
+    ASSERT(srcBufferVk);
+
+    const VkImage dstImageVk		= (VkImage) dstImage->GetNativeHandle();
+    const VkImageAspectFlags aspectMask = VulkanUtilities::GetImageAspectMask(VulkanUtilities::Translate(dstImage->GetDescription().Format));
+
+    auto* regionsVk = linearAllocatorFrame.AllocateArray<VkBufferImageCopy>(regionCount);
+
+    for(size_t i = 0; i < regionCount; ++i)
+    {
+	const auto& region = regions[i];
+	regionsVk[i]	   = {
+		  region.BufferOffset,
+		  region.BufferRowLength,
+		  region.BufferImageHeight,
+		  { aspectMask, region.MipLevel, region.BaseArrayLayer, region.LayerCount },
+		  *reinterpret_cast<const VkOffset3D*>(&region.Offset),
+		  *reinterpret_cast<const VkExtent3D*>(&region.Extent),
+	};
+    }
+
+    vkCmdCopyBufferToImage(m_commandBuffer, (VkBuffer) srcBufferVk->GetNativeHandle(), dstImageVk, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regionCount, regionsVk);
+}
+
+void VulkanCommand::UpdateBuffer(const Buffer* dstBuffer, uint64_t dstOffset, uint64_t dataSize, const void* data)
+{
+    const auto* bufferVk = dynamic_cast<const VulkanBuffer*>(dstBuffer);
+    ASSERT(bufferVk);
+    ASSERT(dataSize % 4 == 0 && dataSize <= 65536);
+
+    vkCmdUpdateBuffer(m_commandBuffer, (VkBuffer) bufferVk->GetNativeHandle(), dstOffset, dataSize, data);
+}
+
 void VulkanCommand::ClearColorImage(const Image* image, const ClearColorValue* color, uint32_t rangeCount, const ImageSubresourceRange* ranges)
 {
     LinearAllocatorFrame allocatorFrame(&m_allocator);
@@ -368,90 +297,74 @@ void VulkanCommand::Barrier(uint32_t count, const class Barrier* barriers)
 {
     LinearAllocatorFrame allocatorFrame(&m_allocator);
 
-    uint32_t imageBarrierCount	= 0;
-    uint32_t bufferBarrierCount = 0;
-
-    auto* imageBarriers		   = allocatorFrame.AllocateArray<VkImageMemoryBarrier>(count);
-    auto* bufferBarriers	   = allocatorFrame.AllocateArray<VkBufferMemoryBarrier>(count);
-    VkMemoryBarrier memoryBarrier  = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
-    VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    auto* infos = allocatorFrame.AllocateArray<VulkanBarrierInfo>(count);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	infos[i] = VulkanLoweredBarriers::GetBarrierInfo(barriers[i]);
+    }
 
-    for(size_t i = 0; i < count; i++)
+    VulkanBarrierBatch batch = {};
     {
-	const auto& barrier = barriers[i];
-	ASSERT((bool) barrier.m_image != (bool) barrier.m_buffer);
+	batch.ImageBarriers[0]	= allocatorFrame.AllocateArray<VkImageMemoryBarrier>(count);
+	batch.ImageBarriers[1]	= allocatorFrame.AllocateArray<VkImageMemoryBarrier>(count);
+	batch.BufferBarriers[0] = allocatorFrame.AllocateArray<VkBufferMemoryBarrier>(count);
+	batch.BufferBarriers[1] = allocatorFrame.AllocateArray<VkBufferMemoryBarrier>(count);
+	batch.SetEvents		= allocatorFrame.AllocateArray<VkEvent>(count);
+	batch.SetEventStages	= allocatorFrame.AllocateArray<VkPipelineStageFlags>(count);
+	batch.WaitEvents	= allocatorFrame.AllocateArray<VkEvent>(count);
+    }
 
-	if((barrier.m_flags & BarrierFlags::BARRIER_BEGIN) != 0)
-	{
-	    continue;
-	}
+    VulkanLoweredBarriers::Lower(count, barriers, infos, batch);
+    VulkanLoweredBarriers::Record(m_commandBuffer, batch);
+}
 
-	const auto imageFormat	   = barrier.m_image ? barrier.m_image->GetDescription().Format : Format::UNDEFINED;
-	const auto beforeStateInfo = GetResourceStateInfo(barrier.m_stateBefore, VulkanUtilities::Translate(barrier.m_stagesBefore), bool(barrier.m_image), imageFormat);
-	const auto afterStateInfo  = GetResourceStateInfo(barrier.m_stateAfter, VulkanUtilities::Translate(barrier.m_stagesAfter), bool(barrier.m_image), imageFormat);
+void VulkanCommand::Barrier(const LoweredBarriers* loweredBarriers, uint32_t group)
+{
+    const auto* loweredBarriersVk = dynamic_cast<const VulkanLoweredBarriers*>(loweredBarriers);
+    ASSERT(loweredBarriersVk);
 
-	const bool queueAcquire = (barrier.m_flags & BarrierFlags::QUEUE_OWNERSHIP_AQUIRE) != 0;
-	const bool queueRelease = (barrier.m_flags & BarrierFlags::QUEUE_OWNERSHIP_RELEASE) != 0;
+    loweredBarriersVk->Record(m_commandBuffer, group);
+}
 
-	const bool imageBarrierRequired	    = barrier.m_image && (beforeStateInfo.m_layout != afterStateInfo.m_layout || queueAcquire || queueRelease);
-	const bool bufferBarrierRequired    = barrier.m_buffer && (queueAcquire || queueRelease);
-	const bool memoryBarrierRequired    = beforeStateInfo.m_writeAccess && !imageBarrierRequired && !bufferBarrierRequired;
-	const bool executionBarrierRequired = beforeStateInfo.m_writeAccess || afterStateInfo.m_writeAccess || memoryBarrierRequired || bufferBarrierRequired || imageBarrierRequired;
+void VulkanCommand::BeginQuery(const QueryPool* queryPool, uint32_t query)
+{
+    vkCmdBeginQuery(m_commandBuffer, (VkQueryPool) queryPool->GetNativeHandle(), query, 0);
+}
 
-	const auto* srcQueue = dynamic_cast<const VulkanQueue*>(barrier.m_srcQueue);
-	const auto* dstQueue = dynamic_cast<const VulkanQueue*>(barrier.m_dstQueue);
+void VulkanCommand::EndQuery(const QueryPool* queryPool, uint32_t query)
+{
+    vkCmdEndQuery(m_commandBuffer, (VkQueryPool) queryPool->GetNativeHandle(), query);
+}
 
-	if(imageBarrierRequired)
-	{
-	    const auto& subResRange		     = barrier.m_imageSubresourceRange;
-	    const VkImageAspectFlags imageAspectMask = VulkanUtilities::GetImageAspectMask(VulkanUtilities::Translate(barrier.m_image->GetDescription().Format));
+void VulkanCommand::ResetQueryPool(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+    vkCmdResetQueryPool(m_commandBuffer, (VkQueryPool) queryPool->GetNativeHandle(), firstQuery, queryCount);
+}
 
-	    auto& imageBarrier = imageBarriers[imageBarrierCount++];
-	    imageBarrier       = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-	    {
-		imageBarrier.srcAccessMask	 = queueAcquire ? 0 : beforeStateInfo.m_accessMask;
-		imageBarrier.dstAccessMask	 = queueRelease ? 0 : afterStateInfo.m_accessMask;
-		imageBarrier.oldLayout		 = beforeStateInfo.m_layout;
-		imageBarrier.newLayout		 = afterStateInfo.m_layout;
-		imageBarrier.srcQueueFamilyIndex = barrier.m_srcQueue ? srcQueue->GetQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
-		imageBarrier.dstQueueFamilyIndex = barrier.m_dstQueue ? dstQueue->GetQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
-		imageBarrier.image		 = static_cast<VkImage>(barrier.m_image->GetNativeHandle());
-		imageBarrier.subresourceRange	 = { imageAspectMask, subResRange.BaseMipLevel, subResRange.LevelCount, subResRange.BaseArrayLayer, subResRange.LayerCount };
-	    }
-	}
-	else if(bufferBarrierRequired)
-	{
-	    auto& bufferBarrier = bufferBarriers[bufferBarrierCount++];
-	    bufferBarrier	= { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
-	    {
-		bufferBarrier.srcAccessMask	  = queueAcquire ? 0 : beforeStateInfo.m_accessMask;
-		bufferBarrier.dstAccessMask	  = queueRelease ? 0 : afterStateInfo.m_accessMask;
-		bufferBarrier.srcQueueFamilyIndex = barrier.m_srcQueue ? srcQueue->GetQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
-		bufferBarrier.dstQueueFamilyIndex = barrier.m_dstQueue ? dstQueue->GetQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
-		bufferBarrier.buffer		  = static_cast<VkBuffer>(barrier.m_buffer->GetNativeHandle());
-		bufferBarrier.offset		  = 0;
-		bufferBarrier.size		  = VK_WHOLE_SIZE;
-	    }
-	}
+void VulkanCommand::WriteTimestamp(PipelineStageFlags pipelineStage, const QueryPool* queryPool, uint32_t query)
+{
+    const auto stageVk = static_cast<VkPipelineStageFlagBits>(VulkanUtilities::Translate(pipelineStage));
+    vkCmdWriteTimestamp(m_commandBuffer, stageVk, (VkQueryPool) queryPool->GetNativeHandle(), query);
+}
 
-	if(memoryBarrierRequired)
-	{
-	    memoryBarrier.srcAccessMask = beforeStateInfo.m_accessMask;
-	    memoryBarrier.dstAccessMask = afterStateInfo.m_accessMask;
-	}
+void VulkanCommand::CopyQueryPoolResults(const QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount, const Buffer* dstBuffer, uint64_t dstOffset)
+{
+    const auto* bufferVk = dynamic_cast<const VulkanBuffer*>(dstBuffer);
+    ASSERT(bufferVk);
 
-	if(executionBarrierRequired)
+    // pipeline statistics queries write one value per enabled statistic
+    const QueryPoolCreateInfo& description = queryPool->GetDescription();
+    uint32_t resultCount		   = 1;
+    if(description.QueryType == QueryType::PIPELINE_STATISTICS)
+    {
+	resultCount = 0;
+	for(uint32_t bits = static_cast<uint32_t>(description.PipelineStatistics); bits != 0; bits &= bits - 1)
 	{
-	    srcStages |= queueAcquire ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : beforeStateInfo.m_stageMask;
-	    dstStages |= queueRelease ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : afterStateInfo.m_stageMask;
+	    ++resultCount;
 	}
     }
 
-    if(bufferBarrierCount || imageBarrierCount || memoryBarrier.srcAccessMask || srcStages != VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT || dstStages != VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
-    {
-	vkCmdPipelineBarrier(m_commandBuffer, srcStages, dstStages, 0, 1, &memoryBarrier, bufferBarrierCount, bufferBarriers, imageBarrierCount, imageBarriers);
-    }
+    vkCmdCopyQueryPoolResults(m_commandBuffer, (VkQueryPool) queryPool->GetNativeHandle(), firstQuery, queryCount, (VkBuffer) bufferVk->GetNativeHandle(), dstOffset, resultCount * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
 }
 
 void VulkanCommand::PushConstants(const GraphicsPipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
@@ -461,8 +374,17 @@ void VulkanCommand::PushConstants(const GraphicsPipeline* pipeline, ShaderStageF
     vkCmdPushConstants(m_commandBuffer, pipelineVk->GetLayout(), VulkanUtilities::Translate(stageFlags), offset, size, values);
 }
 
+void VulkanCommand::PushConstants(const ComputePipeline* pipeline, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    const auto* pipelineVk = dynamic_cast<const VulkanComputePipeline*>(pipeline);
+    ASSERT(pipelineVk);
+    vkCmdPushConstants(m_commandBuffer, pipelineVk->GetLayout(), VulkanUtilities::Translate(stageFlags), offset, size, values);
+}
+
 void VulkanCommand::BeginRenderPass(uint32_t colorAttachmentCount, ColorAttachmentDescription* colorAttachments, DepthStencilAttachmentDescription* depthStencilAttachment, const Rect& renderArea, bool rwTextureBufferAccess)
 {
+    PROFILE_FUNCTION();
+
     ASSERT(colorAttachmentCount <= 8);
 
     if(m_adapter->IsDynamicRenderingExtensionSupported())
@@ -0,0 +1,76 @@
+//
+// Created by Ploxie on 2023-07-01.
+//
+#include "VulkanComputePipeline.h"
+#include "core/Assert.h"
+#include "volk.h"
+#include "VulkanGraphicsAdapter.h"
+#include "VulkanUtilities.h"
+
+VulkanComputePipeline::VulkanComputePipeline(VulkanGraphicsAdapter* adapter, const ComputePipelineCreateInfo& createInfo)
+    : m_pipeline(VK_NULL_HANDLE), m_pipelineLayout(VK_NULL_HANDLE), m_adapter(adapter)
+{
+    VkDevice device = adapter->GetDevice();
+
+    VkShaderModule shaderModule			= VK_NULL_HANDLE;
+    VkPipelineShaderStageCreateInfo shaderStage = {};
+    VulkanUtilities::CreateShaderStage(device, createInfo.ComputeShader, VK_SHADER_STAGE_COMPUTE_BIT, shaderModule, shaderStage);
+
+    // Create Pipeline layout
+    m_descriptorSetLayoutCount = createInfo.LayoutCreateInfo.DescriptorSetLayoutCount;
+    for(uint32_t i = 0; i < m_descriptorSetLayoutCount; ++i)
+    {
+	m_descriptorSetLayouts[i] = createInfo.LayoutCreateInfo.DescriptorSetLayoutDeclarations[i].Layout;
+    }
+    m_staticSamplerDescriptorSetIndex = createInfo.LayoutCreateInfo.StaticSamplerSet;
+    VulkanUtilities::CreatePipelineLayout(device, createInfo.LayoutCreateInfo, m_pipelineLayout, m_staticSamplerDescriptorSetLayout, m_staticSamplerDescriptorPool, m_staticSamplerDescriptorSet, m_staticSamplers);
+
+    VkComputePipelineCreateInfo pipelineInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    {
+	pipelineInfo.stage		= shaderStage;
+	pipelineInfo.layout		= m_pipelineLayout;
+	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+	pipelineInfo.basePipelineIndex	= 0;
+    }
+
+    VulkanUtilities::checkResult(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline), "Failed to create compute pipeline!");
+
+    vkDestroyShaderModule(device, shaderModule, nullptr);
+}
+VulkanComputePipeline::~VulkanComputePipeline()
+{
+    VkDevice device = m_adapter->GetDevice();
+    vkDestroyPipeline(device, m_pipeline, nullptr);
+    vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_staticSamplerDescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_staticSamplerDescriptorSetLayout, nullptr);
+
+    for(auto* sampler: m_staticSamplers)
+    {
+	vkDestroySampler(device, sampler, nullptr);
+    }
+}
+void* VulkanComputePipeline::GetNativeHandle() const
+{
+    return m_pipeline;
+}
+uint32_t VulkanComputePipeline::GetDescriptorSetLayoutCount() const
+{
+    return m_descriptorSetLayoutCount;
+}
+const DescriptorSetLayout* VulkanComputePipeline::GetDescriptorSetLayout(uint32_t index) const
+{
+    ASSERT(index < m_descriptorSetLayoutCount);
+    return m_descriptorSetLayouts[index];
+}
+VkPipelineLayout VulkanComputePipeline::GetLayout() const
+{
+    return m_pipelineLayout;
+}
+void VulkanComputePipeline::BindStaticSamplerSet(VkCommandBuffer cmdBuffer) const
+{
+    if(m_staticSamplerDescriptorSet != VK_NULL_HANDLE)
+    {
+	vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, m_staticSamplerDescriptorSetIndex, 1, &m_staticSamplerDescriptorSet, 0, nullptr);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+//
+// Created by Ploxie on 2023-07-01.
+//
+
+#pragma once
+#include "eastl/fixed_vector.h"
+#include "rendering/types/ComputePipeline.h"
+#include "vulkan/vulkan.h"
+
+class VulkanGraphicsAdapter;
+
+class VulkanComputePipeline : public ComputePipeline
+{
+public:
+    explicit VulkanComputePipeline(VulkanGraphicsAdapter* adapter, const ComputePipelineCreateInfo& createInfo);
+    VulkanComputePipeline(VulkanComputePipeline&)		    = delete;
+    VulkanComputePipeline(VulkanComputePipeline&&)		    = delete;
+    VulkanComputePipeline& operator=(const VulkanComputePipeline&)  = delete;
+    VulkanComputePipeline& operator=(const VulkanComputePipeline&&) = delete;
+    ~VulkanComputePipeline() override;
+
+    void* GetNativeHandle() const override;
+    uint32_t GetDescriptorSetLayoutCount() const override;
+    const DescriptorSetLayout* GetDescriptorSetLayout(uint32_t index) const override;
+    VkPipelineLayout GetLayout() const;
+    void BindStaticSamplerSet(VkCommandBuffer cmdBuffer) const;
+
+private:
+    VkPipeline m_pipeline;
+    VkPipelineLayout m_pipelineLayout;
+    VulkanGraphicsAdapter* m_adapter;
+    uint32_t m_staticSamplerDescriptorSetIndex;
+    VkDescriptorSetLayout m_staticSamplerDescriptorSetLayout;
+    VkDescriptorPool m_staticSamplerDescriptorPool;
+    VkDescriptorSet m_staticSamplerDescriptorSet;
+    eastl::fixed_vector<VkSampler, 16> m_staticSamplers;
+    uint32_t m_descriptorSetLayoutCount;
+    const DescriptorSetLayout* m_descriptorSetLayouts[4];
+};
\ No newline at end of file
@@ -0,0 +1,29 @@
+//
+// Created by Ploxie on 2023-06-27.
+//
+#include "VulkanEvent.h"
+#include "volk.h"
+#include "VulkanUtilities.h"
+
+VulkanEvent::VulkanEvent(VkDevice device)
+    : m_device(device), m_event(VK_NULL_HANDLE)
+{
+    VkEventCreateInfo createInfo = { VK_STRUCTURE_TYPE_EVENT_CREATE_INFO };
+
+    VulkanUtilities::checkResult(vkCreateEvent(m_device, &createInfo, nullptr, &m_event), "Failed to create Event!");
+}
+
+VulkanEvent::~VulkanEvent()
+{
+    vkDestroyEvent(m_device, m_event, nullptr);
+}
+
+void* VulkanEvent::GetNativeHandle() const
+{
+    return m_event;
+}
+
+void VulkanEvent::Reset()
+{
+    VulkanUtilities::checkResult(vkResetEvent(m_device, m_event), "Failed to reset Event!");
+}
\ No newline at end of file
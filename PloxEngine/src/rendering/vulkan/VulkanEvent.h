@@ -0,0 +1,26 @@
+//
+// Created by Ploxie on 2023-06-27.
+//
+
+#pragma once
+#include "rendering/types/Event.h"
+#include "vulkan/vulkan.h"
+
+class VulkanEvent : public Event
+{
+public:
+    explicit VulkanEvent(VkDevice device);
+    ~VulkanEvent();
+
+    VulkanEvent(VulkanEvent&)			= delete;
+    VulkanEvent(VulkanEvent&&)			= delete;
+    VulkanEvent& operator=(const VulkanEvent&)	= delete;
+    VulkanEvent& operator=(const VulkanEvent&&) = delete;
+
+    void* GetNativeHandle() const override;
+    void Reset() override;
+
+private:
+    VkDevice m_device;
+    VkEvent m_event;
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 //
 #include "VulkanGraphicsAdapter.h"
 #include "core/Assert.h"
+#include "core/Clock.h"
 #include "core/logger.h"
 #include "eastl/string.h"
 #include "platform/window/Window.h"
@@ -12,16 +13,22 @@
 #include "volk.h"
 #include "VulkanBuffer.h"
 #include "VulkanCommandPool.h"
+#include "VulkanComputePipeline.h"
 #include "VulkanDescriptorSet.h"
 #include "VulkanDeviceInfo.h"
+#include "VulkanEvent.h"
 #include "VulkanFrameBufferCache.h"
 #include "VulkanGraphicsPipeline.h"
+#include "VulkanLoweredBarriers.h"
 #include "VulkanMemoryAllocator.h"
+#include "VulkanMemoryHeap.h"
+#include "VulkanQueryPool.h"
 #include "VulkanRenderPassCache.h"
 #include "VulkanSwapchain.h"
 #include "VulkanUtilities.h"
 
 #undef CreateSemaphore
+#undef CreateEvent
 
 
 static VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(
@@ -47,7 +54,7 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(
 
 VulkanGraphicsAdapter::VulkanGraphicsAdapter(void* windowHandle, bool debugLayer)
     : m_graphicsPipelineMemoryPool(sizeof(VulkanGraphicsPipeline), 64, "VulkanGraphicsPipeline Pool Allocator"),
-      //m_computePipelineMemoryPool(sizeof(VulkanComputePipeline), 64, "VulkanComputePipeline Pool Allocator"),
+      m_computePipelineMemoryPool(sizeof(VulkanComputePipeline), 64, "VulkanComputePipeline Pool Allocator"),
       m_commandPoolMemoryPool(sizeof(VulkanCommandPool), 32, "VulkanCommandListPool Pool Allocator"),
       m_imageMemoryPool(sizeof(VulkanImage), 1024, "VulkanImage Pool Allocator"),
       m_bufferMemoryPool(sizeof(VulkanBuffer), 1024, "VulkanBuffer Pool Allocator"),
@@ -55,9 +62,12 @@ VulkanGraphicsAdapter::VulkanGraphicsAdapter(void* windowHandle, bool debugLayer
       m_bufferViewMemoryPool(sizeof(VulkanBufferView), 64, "VulkanBufferView Pool Allocator"),
       //m_samplerMemoryPool(sizeof(VulkanSampler), 16, "VulkanSampler Pool Allocator"),
       m_semaphoreMemoryPool(sizeof(VulkanSemaphore), 16, "VulkanSemaphore Pool Allocator"),
-      //m_queryPoolMemoryPool(sizeof(VulkanQueryPool), 16, "VulkanQueryPool Pool Allocator"),
+      m_queryPoolMemoryPool(sizeof(VulkanQueryPool), 16, "VulkanQueryPool Pool Allocator"),
+      m_eventMemoryPool(sizeof(VulkanEvent), 64, "VulkanEvent Pool Allocator"),
+      m_memoryHeapMemoryPool(sizeof(VulkanMemoryHeap), 16, "VulkanMemoryHeap Pool Allocator"),
       m_descriptorSetPoolMemoryPool(sizeof(VulkanDescriptorSetPool), 16, "VulkanDescriptorSetPool Pool Allocator"),
-      m_descriptorSetLayoutMemoryPool(sizeof(VulkanDescriptorSetLayout), 16, "VulkanDescriptorSetLayout Pool Allocator")
+      m_descriptorSetLayoutMemoryPool(sizeof(VulkanDescriptorSetLayout), 16, "VulkanDescriptorSetLayout Pool Allocator"),
+      m_loweredBarriersMemoryPool(sizeof(VulkanLoweredBarriers), 16, "VulkanLoweredBarriers Pool Allocator")
 {
     if(volkInitialize() != VK_SUCCESS)
     {
@@ -343,10 +353,33 @@ VulkanGraphicsAdapter::VulkanGraphicsAdapter(void* windowHandle, bool debugLayer
 	    m_dynamicRenderingExtensionSupport = selectedDevice.HasFeatures(requiredDynamicRenderingFeatures) && selectedDevice.AddExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
 	}
 
+	// Enabled Non-Required Features
+	{
+	    VkPhysicalDeviceFeatures pipelineStatisticsFeatures = {};
+	    pipelineStatisticsFeatures.pipelineStatisticsQuery	= VK_TRUE;
+	    m_pipelineStatisticsQuerySupported			= selectedDevice.HasFeatures(pipelineStatisticsFeatures);
+	}
+
+	// Check Calibrateable Time Domains
+	{
+	    uint32_t timeDomainCount = 0;
+	    vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_physicalDevice, &timeDomainCount, nullptr);
+	    eastl::vector<VkTimeDomainEXT> timeDomains(timeDomainCount);
+	    vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_physicalDevice, &timeDomainCount, timeDomains.data());
+
+	    for(auto timeDomain: timeDomains)
+	    {
+		m_deviceTimeDomainSupported |= timeDomain == VK_TIME_DOMAIN_DEVICE_EXT;
+	    }
+	}
+
 	m_properties = selectedDevice.GetProperties();
 
 	// Enabled features
-	auto deviceFeatures	      = requiredFeatures;
+	auto deviceFeatures = requiredFeatures;
+	{
+	    deviceFeatures.pipelineStatisticsQuery = m_pipelineStatisticsQuerySupported ? VK_TRUE : VK_FALSE;
+	}
 	auto dynamicRenderingFeatures = requiredDynamicRenderingFeatures;
 	{
 	    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
@@ -413,6 +446,7 @@ VulkanGraphicsAdapter::VulkanGraphicsAdapter(void* windowHandle, bool debugLayer
 
 VulkanGraphicsAdapter::~VulkanGraphicsAdapter()
 {
+    delete m_swapchain;
     delete m_renderPassCache;
 }
 
@@ -424,6 +458,14 @@ void VulkanGraphicsAdapter::CreateGraphicsPipeline(uint32_t count, const Graphic
     }
 }
 
+void VulkanGraphicsAdapter::CreateComputePipeline(uint32_t count, const ComputePipelineCreateInfo* createInfo, ComputePipeline** pipelines)
+{
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	pipelines[i] = ALLOC_NEW(&m_computePipelineMemoryPool, VulkanComputePipeline)(this, createInfo[i]);
+    }
+}
+
 void VulkanGraphicsAdapter::CreateCommandPool(const Queue* queue, CommandPool** commandPool)
 {
     const auto* queueVk = dynamic_cast<const VulkanQueue*>(queue);
@@ -459,22 +501,7 @@ void VulkanGraphicsAdapter::CreateImage(const ImageCreateInfo& imageCreateInfo,
 	allocInfo.DedicatedAllocation = dedicated;
     }
 
-    VkImageCreateInfo createInfo { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
-    {
-	createInfo.flags		 = VulkanUtilities::Translate(imageCreateInfo.CreateFlags);
-	createInfo.imageType		 = VulkanUtilities::Translate(imageCreateInfo.ImageType);
-	createInfo.format		 = VulkanUtilities::Translate(imageCreateInfo.Format);
-	createInfo.extent		 = { imageCreateInfo.Width, imageCreateInfo.Height, imageCreateInfo.Depth };
-	createInfo.mipLevels		 = imageCreateInfo.Levels;
-	createInfo.arrayLayers		 = imageCreateInfo.Layers;
-	createInfo.samples		 = static_cast<VkSampleCountFlagBits>(imageCreateInfo.Samples);
-	createInfo.tiling		 = VK_IMAGE_TILING_OPTIMAL;
-	createInfo.usage		 = VulkanUtilities::Translate(imageCreateInfo.UsageFlags);
-	createInfo.sharingMode		 = VK_SHARING_MODE_EXCLUSIVE;
-	createInfo.queueFamilyIndexCount = 0;
-	createInfo.pQueueFamilyIndices	 = nullptr;
-	createInfo.initialLayout	 = VK_IMAGE_LAYOUT_UNDEFINED;
-    }
+    VkImageCreateInfo createInfo = TranslateImageCreateInfo(imageCreateInfo);
 
     VkImage nativeHandle	       = VK_NULL_HANDLE;
     VulkanAllocationHandle allocHandle = 0;
@@ -484,6 +511,16 @@ void VulkanGraphicsAdapter::CreateImage(const ImageCreateInfo& imageCreateInfo,
     *image = ALLOC_NEW(&m_imageMemoryPool, VulkanImage)(nativeHandle, allocHandle, imageCreateInfo);
 }
 
+void VulkanGraphicsAdapter::CreateUnboundImage(const ImageCreateInfo& imageCreateInfo, Image** image)
+{
+    VkImageCreateInfo createInfo = TranslateImageCreateInfo(imageCreateInfo);
+
+    VkImage nativeHandle = VK_NULL_HANDLE;
+    VulkanUtilities::checkResult(vkCreateImage(m_device, &createInfo, nullptr, &nativeHandle), "Failed to create Image!");
+
+    *image = ALLOC_NEW(&m_imageMemoryPool, VulkanImage)(nativeHandle, nullptr, imageCreateInfo);
+}
+
 void VulkanGraphicsAdapter::CreateImageView(const ImageViewCreateInfo* imageViewCreateInfo, ImageView** imageView)
 {
     *imageView = ALLOC_NEW(&m_imageViewMemoryPool, VulkanImageView)(m_device, *imageViewCreateInfo);
@@ -542,33 +579,8 @@ void VulkanGraphicsAdapter::CreateBuffer(const BufferCreateInfo& bufferCreateInf
     allocInfo.PreferredFlags	  = VulkanUtilities::Translate(preferredMemoryPropertyFlags);
     allocInfo.DedicatedAllocation = dedicated;
 
-    uint32_t queueFamilyIndices[] = {
-	m_graphicsQueue.m_queueFamily,
-	m_computeQueue.m_queueFamily,
-	m_transferQueue.m_queueFamily
-    };
-
-    uint32_t queueFamilyIndexCount = 0;
     uint32_t uniqueQueueFamilyIndices[3];
-
-    uniqueQueueFamilyIndices[queueFamilyIndexCount++] = queueFamilyIndices[0];
-
-    if(queueFamilyIndices[1] != queueFamilyIndices[0])
-    {
-	uniqueQueueFamilyIndices[queueFamilyIndexCount++] = queueFamilyIndices[1];
-    }
-    if(queueFamilyIndices[2] != queueFamilyIndices[1] && queueFamilyIndices[2] != queueFamilyIndices[0])
-    {
-	uniqueQueueFamilyIndices[queueFamilyIndexCount++] = queueFamilyIndices[2];
-    }
-
-    VkBufferCreateInfo createInfo { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-    createInfo.flags		     = VulkanUtilities::Translate(bufferCreateInfo.CreateFlags);
-    createInfo.size		     = bufferCreateInfo.Size;
-    createInfo.usage		     = VulkanUtilities::Translate(bufferCreateInfo.UsageFlags);
-    createInfo.sharingMode	     = VK_SHARING_MODE_CONCURRENT;
-    createInfo.queueFamilyIndexCount = queueFamilyIndexCount;
-    createInfo.pQueueFamilyIndices   = uniqueQueueFamilyIndices;
+    VkBufferCreateInfo createInfo = TranslateBufferCreateInfo(bufferCreateInfo, uniqueQueueFamilyIndices);
 
     VkBuffer nativeHandle	       = VK_NULL_HANDLE;
     VulkanAllocationHandle allocHandle = 0;
@@ -578,6 +590,17 @@ void VulkanGraphicsAdapter::CreateBuffer(const BufferCreateInfo& bufferCreateInf
     *buffer = ALLOC_NEW(&m_bufferMemoryPool, VulkanBuffer)(nativeHandle, allocHandle, bufferCreateInfo, m_allocator, this);
 }
 
+void VulkanGraphicsAdapter::CreateUnboundBuffer(const BufferCreateInfo& bufferCreateInfo, Buffer** buffer)
+{
+    uint32_t uniqueQueueFamilyIndices[3];
+    VkBufferCreateInfo createInfo = TranslateBufferCreateInfo(bufferCreateInfo, uniqueQueueFamilyIndices);
+
+    VkBuffer nativeHandle = VK_NULL_HANDLE;
+    VulkanUtilities::checkResult(vkCreateBuffer(m_device, &createInfo, nullptr, &nativeHandle), "Failed to create Buffer!");
+
+    *buffer = ALLOC_NEW(&m_bufferMemoryPool, VulkanBuffer)(nativeHandle, nullptr, bufferCreateInfo, m_allocator, this);
+}
+
 void VulkanGraphicsAdapter::CreateBufferView(const BufferViewCreateInfo* bufferViewCreateInfo, BufferView** bufferView)
 {
     *bufferView = ALLOC_NEW(&m_bufferViewMemoryPool, VulkanBufferView)(m_device, *bufferViewCreateInfo);
@@ -641,7 +664,103 @@ void VulkanGraphicsAdapter::CreateDescriptorSetLayout(uint32_t bindingCount, con
     *descriptorSetLayout = ALLOC_NEW(&m_descriptorSetLayoutMemoryPool, VulkanDescriptorSetLayout)(m_device, bindingCount, bindingsVk, bindingFlagsVk);
 }
 
-void VulkanGraphicsAdapter::DestroyCommandPool(CommandPool* commandPool)
+void VulkanGraphicsAdapter::CreateQueryPool(const QueryPoolCreateInfo& queryPoolCreateInfo, QueryPool** queryPool)
+{
+    ASSERT_MSG(queryPoolCreateInfo.QueryType != QueryType::PIPELINE_STATISTICS || m_pipelineStatisticsQuerySupported, "Pipeline statistics queries are not supported by this device!");
+    *queryPool = ALLOC_NEW(&m_queryPoolMemoryPool, VulkanQueryPool)(m_device, queryPoolCreateInfo);
+}
+
+void VulkanGraphicsAdapter::CreateEvent(Event** event)
+{
+    *event = ALLOC_NEW(&m_eventMemoryPool, VulkanEvent)(m_device);
+}
+
+void VulkanGraphicsAdapter::CreateMemoryHeap(const MemoryHeapCreateInfo& memoryHeapCreateInfo, MemoryHeap** memoryHeap)
+{
+    VulkanAllocationCreateInfo allocInfo = {};
+    {
+	allocInfo.RequiredFlags	      = VulkanUtilities::Translate(memoryHeapCreateInfo.RequiredFlags);
+	allocInfo.PreferredFlags      = VulkanUtilities::Translate(memoryHeapCreateInfo.PreferredFlags);
+	allocInfo.DedicatedAllocation = true;
+    }
+
+    VkMemoryRequirements memoryRequirements = {};
+    {
+	memoryRequirements.size		  = memoryHeapCreateInfo.Size;
+	memoryRequirements.alignment	  = 1;
+	memoryRequirements.memoryTypeBits = memoryHeapCreateInfo.MemoryTypeBits;
+    }
+
+    VulkanAllocationHandle allocHandle = 0;
+    VulkanUtilities::checkResult(m_allocator->Allocate(allocInfo, memoryRequirements, nullptr, allocHandle), "Failed to allocate MemoryHeap!");
+
+    *memoryHeap = ALLOC_NEW(&m_memoryHeapMemoryPool, VulkanMemoryHeap)(m_allocator, allocHandle, memoryHeapCreateInfo);
+}
+
+void VulkanGraphicsAdapter::GetMemoryRequirements(const Image* image, MemoryRequirements* memoryRequirements)
+{
+    VkMemoryRequirements requirementsVk;
+    vkGetImageMemoryRequirements(m_device, (VkImage) image->GetNativeHandle(), &requirementsVk);
+
+    memoryRequirements->Size	       = requirementsVk.size;
+    memoryRequirements->Alignment      = requirementsVk.alignment;
+    memoryRequirements->MemoryTypeBits = requirementsVk.memoryTypeBits;
+}
+
+void VulkanGraphicsAdapter::GetMemoryRequirements(const Buffer* buffer, MemoryRequirements* memoryRequirements)
+{
+    VkMemoryRequirements requirementsVk;
+    vkGetBufferMemoryRequirements(m_device, (VkBuffer) buffer->GetNativeHandle(), &requirementsVk);
+
+    memoryRequirements->Size	       = requirementsVk.size;
+    memoryRequirements->Alignment      = requirementsVk.alignment;
+    memoryRequirements->MemoryTypeBits = requirementsVk.memoryTypeBits;
+}
+
+void VulkanGraphicsAdapter::BindMemory(Image* image, MemoryHeap* memoryHeap, uint64_t offset)
+{
+    auto* heapVk = dynamic_cast<VulkanMemoryHeap*>(memoryHeap);
+    ASSERT(heapVk);
+
+    VulkanUtilities::checkResult(vkBindImageMemory(m_device, (VkImage) image->GetNativeHandle(), heapVk->GetMemory(), heapVk->GetOffset() + offset), "Failed to bind Image memory!");
+}
+
+void VulkanGraphicsAdapter::BindMemory(Buffer* buffer, MemoryHeap* memoryHeap, uint64_t offset)
+{
+    auto* heapVk = dynamic_cast<VulkanMemoryHeap*>(memoryHeap);
+    ASSERT(heapVk);
+
+    VulkanUtilities::checkResult(vkBindBufferMemory(m_device, (VkBuffer) buffer->GetNativeHandle(), heapVk->GetMemory(), heapVk->GetOffset() + offset), "Failed to bind Buffer memory!");
+}
+
+void VulkanGraphicsAdapter::CreateLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets, LoweredBarriers** loweredBarriers)
+{
+    *loweredBarriers = ALLOC_NEW(&m_loweredBarriersMemoryPool, VulkanLoweredBarriers)(count, barriers, groupCount, groupOffsets);
+}
+
+void VulkanGraphicsAdapter::DestroyGraphicsPipelineImmediate(GraphicsPipeline* pipeline)
+{
+    if(pipeline)
+    {
+	auto* pipelineVk = dynamic_cast<VulkanGraphicsPipeline*>(pipeline);
+	ASSERT(pipelineVk);
+
+	ALLOC_DELETE(&m_graphicsPipelineMemoryPool, pipelineVk);
+    }
+}
+
+void VulkanGraphicsAdapter::DestroyComputePipelineImmediate(ComputePipeline* pipeline)
+{
+    if(pipeline)
+    {
+	auto* pipelineVk = dynamic_cast<VulkanComputePipeline*>(pipeline);
+	ASSERT(pipelineVk);
+
+	ALLOC_DELETE(&m_computePipelineMemoryPool, pipelineVk);
+    }
+}
+
+void VulkanGraphicsAdapter::DestroyCommandPoolImmediate(CommandPool* commandPool)
 {
     if(commandPool)
     {
@@ -652,18 +771,37 @@ void VulkanGraphicsAdapter::DestroyCommandPool(CommandPool* commandPool)
     }
 }
 
-void VulkanGraphicsAdapter::DestroyImage(Image* image)
+void VulkanGraphicsAdapter::DestroySemaphoreImmediate(Semaphore* semaphore)
+{
+    if(semaphore)
+    {
+	auto* semaphoreVk = dynamic_cast<VulkanSemaphore*>(semaphore);
+	ASSERT(semaphoreVk);
+
+	ALLOC_DELETE(&m_semaphoreMemoryPool, semaphoreVk);
+    }
+}
+
+void VulkanGraphicsAdapter::DestroyImageImmediate(Image* image)
 {
     if(image)
     {
 	auto* imageVk = dynamic_cast<VulkanImage*>(image);
 	assert(imageVk);
-	m_allocator->DestroyImage((VkImage) imageVk->GetNativeHandle(), reinterpret_cast<VulkanAllocationHandle>(imageVk->GetAllocationHandle()));
+	if(imageVk->GetAllocationHandle())
+	{
+	    m_allocator->DestroyImage((VkImage) imageVk->GetNativeHandle(), reinterpret_cast<VulkanAllocationHandle>(imageVk->GetAllocationHandle()));
+	}
+	else
+	{
+	    // the memory belongs to a MemoryHeap
+	    vkDestroyImage(m_device, (VkImage) imageVk->GetNativeHandle(), nullptr);
+	}
 
 	ALLOC_DELETE(&m_imageMemoryPool, imageVk);
     }
 }
-void VulkanGraphicsAdapter::DestroyImageView(ImageView* imageView)
+void VulkanGraphicsAdapter::DestroyImageViewImmediate(ImageView* imageView)
 {
     if(imageView)
     {
@@ -673,18 +811,25 @@ void VulkanGraphicsAdapter::DestroyImageView(ImageView* imageView)
 	ALLOC_DELETE(&m_imageViewMemoryPool, viewVk);
     }
 }
-void VulkanGraphicsAdapter::DestroyBuffer(Buffer* buffer)
+void VulkanGraphicsAdapter::DestroyBufferImmediate(Buffer* buffer)
 {
     if(buffer)
     {
 	auto* bufferVk = dynamic_cast<VulkanBuffer*>(buffer);
 	assert(bufferVk);
-	m_allocator->DestroyBuffer((VkBuffer) bufferVk->GetNativeHandle(), reinterpret_cast<VulkanAllocationHandle>(bufferVk->GetAllocationHandle()));
+	if(bufferVk->GetAllocationHandle())
+	{
+	    m_allocator->DestroyBuffer((VkBuffer) bufferVk->GetNativeHandle(), reinterpret_cast<VulkanAllocationHandle>(bufferVk->GetAllocationHandle()));
+	}
+	else
+	{
+	    vkDestroyBuffer(m_device, (VkBuffer) bufferVk->GetNativeHandle(), nullptr);
+	}
 
 	ALLOC_DELETE(&m_bufferMemoryPool, bufferVk);
     }
 }
-void VulkanGraphicsAdapter::DestroyBufferView(BufferView* bufferView)
+void VulkanGraphicsAdapter::DestroyBufferViewImmediate(BufferView* bufferView)
 {
     if(bufferView)
     {
@@ -695,7 +840,7 @@ void VulkanGraphicsAdapter::DestroyBufferView(BufferView* bufferView)
     }
 }
 
-void VulkanGraphicsAdapter::DestroyDescriptorSetPool(DescriptorSetPool* descriptorSetPool)
+void VulkanGraphicsAdapter::DestroyDescriptorSetPoolImmediate(DescriptorSetPool* descriptorSetPool)
 {
     if(descriptorSetPool)
     {
@@ -706,7 +851,7 @@ void VulkanGraphicsAdapter::DestroyDescriptorSetPool(DescriptorSetPool* descript
     }
 }
 
-void VulkanGraphicsAdapter::DestroyDescriptorSetLayout(DescriptorSetLayout* descriptorSetLayout)
+void VulkanGraphicsAdapter::DestroyDescriptorSetLayoutImmediate(DescriptorSetLayout* descriptorSetLayout)
 {
     if(descriptorSetLayout)
     {
@@ -717,6 +862,50 @@ void VulkanGraphicsAdapter::DestroyDescriptorSetLayout(DescriptorSetLayout* desc
     }
 }
 
+void VulkanGraphicsAdapter::DestroyQueryPoolImmediate(QueryPool* queryPool)
+{
+    if(queryPool)
+    {
+	auto* poolVk = dynamic_cast<VulkanQueryPool*>(queryPool);
+	ASSERT(poolVk);
+
+	ALLOC_DELETE(&m_queryPoolMemoryPool, poolVk);
+    }
+}
+
+void VulkanGraphicsAdapter::DestroyEventImmediate(Event* event)
+{
+    if(event)
+    {
+	auto* eventVk = dynamic_cast<VulkanEvent*>(event);
+	ASSERT(eventVk);
+
+	ALLOC_DELETE(&m_eventMemoryPool, eventVk);
+    }
+}
+
+void VulkanGraphicsAdapter::DestroyMemoryHeapImmediate(MemoryHeap* memoryHeap)
+{
+    if(memoryHeap)
+    {
+	auto* heapVk = dynamic_cast<VulkanMemoryHeap*>(memoryHeap);
+	ASSERT(heapVk);
+
+	ALLOC_DELETE(&m_memoryHeapMemoryPool, heapVk);
+    }
+}
+
+void VulkanGraphicsAdapter::DestroyLoweredBarriers(LoweredBarriers* loweredBarriers)
+{
+    if(loweredBarriers)
+    {
+	auto* loweredBarriersVk = dynamic_cast<VulkanLoweredBarriers*>(loweredBarriers);
+	ASSERT(loweredBarriersVk);
+
+	ALLOC_DELETE(&m_loweredBarriersMemoryPool, loweredBarriersVk);
+    }
+}
+
 bool VulkanGraphicsAdapter::ActivateFullscreen(Window* window)
 {
     if(m_swapchain == nullptr || !m_fullscreenExclusiveSupported)
@@ -753,13 +942,102 @@ Queue* VulkanGraphicsAdapter::GetTransferQueue()
     return &m_transferQueue;
 }
 
+bool VulkanGraphicsAdapter::IsPipelineStatisticsQuerySupported() const
+{
+    return m_pipelineStatisticsQuerySupported;
+}
+
+bool VulkanGraphicsAdapter::GetCalibratedTimestamp(uint64_t* gpuTimestamp, uint64_t* cpuTimestamp)
+{
+    if(!m_deviceTimeDomainSupported)
+    {
+	return false;
+    }
+
+    VkCalibratedTimestampInfoEXT timestampInfo = { VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT };
+    {
+	timestampInfo.timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    }
+
+    // only the device domain is sampled so this also works where no host domain matching Clock is exposed,
+    // the cpu side is bracketed instead and the midpoint is taken as the sample time
+    uint64_t maxDeviation = 0;
+    const uint64_t before = Clock::Now();
+    const VkResult result = vkGetCalibratedTimestampsEXT(m_device, 1, &timestampInfo, gpuTimestamp, &maxDeviation);
+    const uint64_t after  = Clock::Now();
+    if(result != VK_SUCCESS)
+    {
+	return false;
+    }
+
+    *cpuTimestamp = before + (after - before) / 2;
+    return true;
+}
+
+VkImageCreateInfo VulkanGraphicsAdapter::TranslateImageCreateInfo(const ImageCreateInfo& imageCreateInfo) const
+{
+    VkImageCreateInfo createInfo { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    {
+	createInfo.flags		 = VulkanUtilities::Translate(imageCreateInfo.CreateFlags);
+	createInfo.imageType		 = VulkanUtilities::Translate(imageCreateInfo.ImageType);
+	createInfo.format		 = VulkanUtilities::Translate(imageCreateInfo.Format);
+	createInfo.extent		 = { imageCreateInfo.Width, imageCreateInfo.Height, imageCreateInfo.Depth };
+	createInfo.mipLevels		 = imageCreateInfo.Levels;
+	createInfo.arrayLayers		 = imageCreateInfo.Layers;
+	createInfo.samples		 = static_cast<VkSampleCountFlagBits>(imageCreateInfo.Samples);
+	createInfo.tiling		 = VK_IMAGE_TILING_OPTIMAL;
+	createInfo.usage		 = VulkanUtilities::Translate(imageCreateInfo.UsageFlags);
+	createInfo.sharingMode		 = VK_SHARING_MODE_EXCLUSIVE;
+	createInfo.queueFamilyIndexCount = 0;
+	createInfo.pQueueFamilyIndices	 = nullptr;
+	createInfo.initialLayout	 = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+    return createInfo;
+}
+
+VkBufferCreateInfo VulkanGraphicsAdapter::TranslateBufferCreateInfo(const BufferCreateInfo& bufferCreateInfo, uint32_t (&queueFamilyIndices)[3]) const
+{
+    const uint32_t familyIndices[] = {
+	m_graphicsQueue.m_queueFamily,
+	m_computeQueue.m_queueFamily,
+	m_transferQueue.m_queueFamily
+    };
+
+    uint32_t queueFamilyIndexCount = 0;
+
+    queueFamilyIndices[queueFamilyIndexCount++] = familyIndices[0];
+
+    if(familyIndices[1] != familyIndices[0])
+    {
+	queueFamilyIndices[queueFamilyIndexCount++] = familyIndices[1];
+    }
+    if(familyIndices[2] != familyIndices[1] && familyIndices[2] != familyIndices[0])
+    {
+	queueFamilyIndices[queueFamilyIndexCount++] = familyIndices[2];
+    }
+
+    VkBufferCreateInfo createInfo { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    createInfo.flags		     = VulkanUtilities::Translate(bufferCreateInfo.CreateFlags);
+    createInfo.size		     = bufferCreateInfo.Size;
+    createInfo.usage		     = VulkanUtilities::Translate(bufferCreateInfo.UsageFlags);
+    createInfo.sharingMode	     = VK_SHARING_MODE_CONCURRENT;
+    createInfo.queueFamilyIndexCount = queueFamilyIndexCount;
+    createInfo.pQueueFamilyIndices   = queueFamilyIndices;
+
+    return createInfo;
+}
+
 VkRenderPass VulkanGraphicsAdapter::GetRenderPass(const VulkanRenderPassDescription& renderPassDescription)
 {
+    // render passes may be requested concurrently by command lists recorded on different threads
+    SpinLockHolder lockHolder(m_renderPassCacheLock);
     return m_renderPassCache->GetRenderPass(renderPassDescription);
 }
 
 VkFramebuffer VulkanGraphicsAdapter::GetFrameBuffer(const VulkanFrameBufferDescription& frameBufferDescription)
 {
+    SpinLockHolder lockHolder(m_frameBufferCacheLock);
     return m_frameBufferCache->GetFrameBuffer(frameBufferDescription);
 }
 
@@ -797,8 +1075,8 @@ void VulkanGraphicsAdapter::SetDebugObjectName(ObjectType type, void* object, co
 		info.objectHandle = (uint64_t) reinterpret_cast<Image*>(object)->GetNativeHandle();
 		break;
 	    case ObjectType::QUERY_POOL:
-		info.objectType = VK_OBJECT_TYPE_QUERY_POOL;
-		//info.objectHandle = (uint64_t) reinterpret_cast<QueryPool*>(object)->GetNativeHandle();
+		info.objectType	  = VK_OBJECT_TYPE_QUERY_POOL;
+		info.objectHandle = (uint64_t) reinterpret_cast<QueryPool*>(object)->GetNativeHandle();
 		break;
 	    case ObjectType::BUFFER_VIEW:
 		info.objectType	  = VK_OBJECT_TYPE_BUFFER_VIEW;
@@ -813,8 +1091,8 @@ void VulkanGraphicsAdapter::SetDebugObjectName(ObjectType type, void* object, co
 		info.objectHandle = (uint64_t) reinterpret_cast<GraphicsPipeline*>(object)->GetNativeHandle();
 		break;
 	    case ObjectType::COMPUTE_PIPELINE:
-		info.objectType = VK_OBJECT_TYPE_PIPELINE;
-		//info.objectHandle = (uint64_t) reinterpret_cast<ComputePipeline*>(object)->GetNativeHandle();
+		info.objectType	  = VK_OBJECT_TYPE_PIPELINE;
+		info.objectHandle = (uint64_t) reinterpret_cast<ComputePipeline*>(object)->GetNativeHandle();
 		break;
 	    case ObjectType::DESCRIPTOR_SET_LAYOUT:
 		info.objectType	  = VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT;
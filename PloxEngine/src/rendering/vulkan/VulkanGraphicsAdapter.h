@@ -7,6 +7,7 @@
 #include "rendering/GraphicsAdapter.h"
 #include "rendering/types/DescriptorSet.h"
 #include "utility/memory/PoolAllocator.h"
+#include "utility/SpinLock.h"
 #include "VulkanFrameBufferDescription.h"
 #include "VulkanInstanceProperties.h"
 #include "VulkanQueue.h"
@@ -19,6 +20,7 @@ class VulkanRenderPassCache;
 class VulkanMemoryAllocator;
 
 #undef CreateSemaphore
+#undef CreateEvent
 
 namespace Vulkan
 {
@@ -36,6 +38,7 @@ public:
     ~VulkanGraphicsAdapter() override;
 
     void CreateGraphicsPipeline(uint32_t count, const GraphicsPipelineCreateInfo* createInfo, GraphicsPipeline** pipelines) override;
+    void CreateComputePipeline(uint32_t count, const ComputePipelineCreateInfo* createInfo, ComputePipeline** pipelines) override;
     void CreateCommandPool(const Queue* queue, CommandPool** commandPool) override;
     void CreateSwapchain(const Queue* presentQueue, unsigned int width, unsigned int height, Window* window, PresentMode presentMode, Swapchain** swapchain) override;
     void CreateSemaphore(uint64_t initialValue, Semaphore** semaphore) override;
@@ -46,14 +49,18 @@ public:
     void CreateBufferView(const BufferViewCreateInfo* bufferViewCreateInfo, BufferView** bufferView) override;
     void CreateDescriptorSetPool(uint32_t maxSets, const DescriptorSetLayout* descriptorSetLayout, DescriptorSetPool** descriptorSetPool) override;
     void CreateDescriptorSetLayout(uint32_t bindingCount, const DescriptorSetLayoutBinding* bindings, DescriptorSetLayout** descriptorSetLayout) override;
+    void CreateQueryPool(const QueryPoolCreateInfo& queryPoolCreateInfo, QueryPool** queryPool) override;
+    void CreateEvent(Event** event) override;
+    void CreateMemoryHeap(const MemoryHeapCreateInfo& memoryHeapCreateInfo, MemoryHeap** memoryHeap) override;
+    void CreateUnboundImage(const ImageCreateInfo& imageCreateInfo, Image** image) override;
+    void CreateUnboundBuffer(const BufferCreateInfo& bufferCreateInfo, Buffer** buffer) override;
+    void GetMemoryRequirements(const Image* image, MemoryRequirements* memoryRequirements) override;
+    void GetMemoryRequirements(const Buffer* buffer, MemoryRequirements* memoryRequirements) override;
+    void BindMemory(Image* image, MemoryHeap* memoryHeap, uint64_t offset) override;
+    void BindMemory(Buffer* buffer, MemoryHeap* memoryHeap, uint64_t offset) override;
+    void CreateLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets, LoweredBarriers** loweredBarriers) override;
 
-    void DestroyCommandPool(CommandPool* commandPool) override;
-    void DestroyImage(Image* image) override;
-    void DestroyImageView(ImageView* imageView) override;
-    void DestroyBuffer(Buffer* buffer) override;
-    void DestroyBufferView(BufferView* bufferView) override;
-    void DestroyDescriptorSetPool(DescriptorSetPool* descriptorSetPool) override;
-    void DestroyDescriptorSetLayout(DescriptorSetLayout* descriptorSetLayout) override;
+    void DestroyLoweredBarriers(LoweredBarriers* loweredBarriers) override;
 
     bool ActivateFullscreen(Window* window) override;
 
@@ -63,6 +70,9 @@ public:
     Queue* GetComputeQueue() override;
     Queue* GetTransferQueue() override;
 
+    bool IsPipelineStatisticsQuerySupported() const override;
+    bool GetCalibratedTimestamp(uint64_t* gpuTimestamp, uint64_t* cpuTimestamp) override;
+
     void SetDebugObjectName(ObjectType type, void* object, const char* name) override;
 
     VkRenderPass GetRenderPass(const VulkanRenderPassDescription& renderPassDescription);
@@ -70,6 +80,25 @@ public:
 
     bool IsDynamicRenderingExtensionSupported();
 
+protected:
+    void DestroyGraphicsPipelineImmediate(GraphicsPipeline* pipeline) override;
+    void DestroyComputePipelineImmediate(ComputePipeline* pipeline) override;
+    void DestroyCommandPoolImmediate(CommandPool* commandPool) override;
+    void DestroySemaphoreImmediate(Semaphore* semaphore) override;
+    void DestroyImageImmediate(Image* image) override;
+    void DestroyImageViewImmediate(ImageView* imageView) override;
+    void DestroyBufferImmediate(Buffer* buffer) override;
+    void DestroyBufferViewImmediate(BufferView* bufferView) override;
+    void DestroyDescriptorSetPoolImmediate(DescriptorSetPool* descriptorSetPool) override;
+    void DestroyDescriptorSetLayoutImmediate(DescriptorSetLayout* descriptorSetLayout) override;
+    void DestroyQueryPoolImmediate(QueryPool* queryPool) override;
+    void DestroyEventImmediate(Event* event) override;
+    void DestroyMemoryHeapImmediate(MemoryHeap* memoryHeap) override;
+
+private:
+    VkImageCreateInfo TranslateImageCreateInfo(const ImageCreateInfo& imageCreateInfo) const;
+    VkBufferCreateInfo TranslateBufferCreateInfo(const BufferCreateInfo& bufferCreateInfo, uint32_t (&queueFamilyIndices)[3]) const;
+
 private:
     VkInstance m_instance			   = VK_NULL_HANDLE;
     VkDevice m_device				   = VK_NULL_HANDLE;
@@ -85,7 +114,7 @@ private:
     VulkanSwapchain* m_swapchain		   = nullptr;
     VulkanMemoryAllocator* m_allocator		   = nullptr;
     DynamicPoolAllocator m_graphicsPipelineMemoryPool;
-    //DynamicPoolAllocator m_computePipelineMemoryPool;
+    DynamicPoolAllocator m_computePipelineMemoryPool;
     DynamicPoolAllocator m_commandPoolMemoryPool;
     DynamicPoolAllocator m_imageMemoryPool;
     DynamicPoolAllocator m_bufferMemoryPool;
@@ -93,10 +122,17 @@ private:
     DynamicPoolAllocator m_bufferViewMemoryPool;
     //DynamicPoolAllocator m_samplerMemoryPool;
     DynamicPoolAllocator m_semaphoreMemoryPool;
-    //DynamicPoolAllocator m_queryPoolMemoryPool;
+    DynamicPoolAllocator m_queryPoolMemoryPool;
+    DynamicPoolAllocator m_eventMemoryPool;
+    DynamicPoolAllocator m_memoryHeapMemoryPool;
     DynamicPoolAllocator m_descriptorSetPoolMemoryPool;
     DynamicPoolAllocator m_descriptorSetLayoutMemoryPool;
+    DynamicPoolAllocator m_loweredBarriersMemoryPool;
+    SpinLock m_renderPassCacheLock;
+    SpinLock m_frameBufferCacheLock;
     bool m_dynamicRenderingExtensionSupport = false;
     bool m_supportsMemoryBudgetExtension    = false;
     bool m_fullscreenExclusiveSupported	    = false;
+    bool m_pipelineStatisticsQuerySupported = false;
+    bool m_deviceTimeDomainSupported	    = false;
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 // Created by Ploxie on 2023-05-17.
 //
 #include "VulkanGraphicsPipeline.h"
-#include "platform/Platform.h"
 #include "rendering/RenderUtilities.h"
 #include "volk.h"
 #include "VulkanDescriptorSet.h"
@@ -10,9 +9,6 @@
 #include "VulkanRenderPassDescription.h"
 #include "VulkanUtilities.h"
 
-static void CreateShaderStage(VkDevice device, const ShaderStageCreateInfo& stageDesc, VkShaderStageFlagBits stageFlag, VkShaderModule& shaderModule, VkPipelineShaderStageCreateInfo& stageCreateInfo);
-static void CreatePipelineLayout(VkDevice device, const PipelineLayoutCreateInfo& layoutCreateInfo, VkPipelineLayout& pipelineLayout, VkDescriptorSetLayout& staticSamplerDescriptorSetLayout, VkDescriptorPool& staticDescriptorPool, VkDescriptorSet& staticSamplerDescriptorSet, eastl::fixed_vector<VkSampler, 16>& staticSamplers);
-
 VulkanGraphicsPipeline::VulkanGraphicsPipeline(VulkanGraphicsAdapter* adapter, const GraphicsPipelineCreateInfo& createInfo)
     : m_pipeline(VK_NULL_HANDLE), m_pipelineLayout(VK_NULL_HANDLE), m_adapter(adapter)
 {
@@ -26,31 +22,31 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline(VulkanGraphicsAdapter* adapter, c
     {
 	if(createInfo.VertexShader.Path[0])
 	{
-	    CreateShaderStage(device, createInfo.VertexShader, VK_SHADER_STAGE_VERTEX_BIT, shaderModules[stageCount], shaderStages[stageCount]);
+	    VulkanUtilities::CreateShaderStage(device, createInfo.VertexShader, VK_SHADER_STAGE_VERTEX_BIT, shaderModules[stageCount], shaderStages[stageCount]);
 	    stageCount++;
 	}
 
 	if(createInfo.HullShader.Path[0])
 	{
-	    CreateShaderStage(device, createInfo.HullShader, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, shaderModules[stageCount], shaderStages[stageCount]);
+	    VulkanUtilities::CreateShaderStage(device, createInfo.HullShader, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, shaderModules[stageCount], shaderStages[stageCount]);
 	    stageCount++;
 	}
 
 	if(createInfo.DomainShader.Path[0])
 	{
-	    CreateShaderStage(device, createInfo.DomainShader, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT, shaderModules[stageCount], shaderStages[stageCount]);
+	    VulkanUtilities::CreateShaderStage(device, createInfo.DomainShader, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT, shaderModules[stageCount], shaderStages[stageCount]);
 	    stageCount++;
 	}
 
 	if(createInfo.GeometryShader.Path[0])
 	{
-	    CreateShaderStage(device, createInfo.GeometryShader, VK_SHADER_STAGE_GEOMETRY_BIT, shaderModules[stageCount], shaderStages[stageCount]);
+	    VulkanUtilities::CreateShaderStage(device, createInfo.GeometryShader, VK_SHADER_STAGE_GEOMETRY_BIT, shaderModules[stageCount], shaderStages[stageCount]);
 	    stageCount++;
 	}
 
 	if(createInfo.PixelShader.Path[0])
 	{
-	    CreateShaderStage(device, createInfo.PixelShader, VK_SHADER_STAGE_FRAGMENT_BIT, shaderModules[stageCount], shaderStages[stageCount]);
+	    VulkanUtilities::CreateShaderStage(device, createInfo.PixelShader, VK_SHADER_STAGE_FRAGMENT_BIT, shaderModules[stageCount], shaderStages[stageCount]);
 	    stageCount++;
 	}
     }
@@ -127,7 +123,7 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline(VulkanGraphicsAdapter* adapter, c
 
     // Create Pipeline layout
     m_staticSamplerDescriptorSetIndex = createInfo.LayoutCreateInfo.StaticSamplerSet;
-    CreatePipelineLayout(device, createInfo.LayoutCreateInfo, m_pipelineLayout, m_staticSamplerDescriptorSetLayout, m_staticSamplerDescriptorPool, m_staticSamplerDescriptorSet, m_staticSamplers);
+    VulkanUtilities::CreatePipelineLayout(device, createInfo.LayoutCreateInfo, m_pipelineLayout, m_staticSamplerDescriptorSetLayout, m_staticSamplerDescriptorPool, m_staticSamplerDescriptorSet, m_staticSamplers);
 
     VkPipelineVertexInputStateCreateInfo vertexInputState = { VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
     VkVertexInputBindingDescription vertexBindingDescriptions[VertexInputState::MAX_VERTEX_BINDING_DESCRIPTIONS];
@@ -322,140 +318,4 @@ void VulkanGraphicsPipeline::BindStaticSamplerSet(VkCommandBuffer cmdBuffer) con
     {
 	vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, m_staticSamplerDescriptorSetIndex, 1, &m_staticSamplerDescriptorSet, 0, nullptr);
     }
-}
-
-static void CreateShaderStage(VkDevice device, const ShaderStageCreateInfo& stageDesc, VkShaderStageFlagBits stageFlag, VkShaderModule& shaderModule, VkPipelineShaderStageCreateInfo& stageCreateInfo)
-{
-    char path[ShaderStageCreateInfo::MAX_PATH_LENGTH + 5];
-    strcpy_s(path, stageDesc.Path);
-    strcat_s(path, ".spv");
-    size_t codeSize = Platform::Size(path);
-    char* code	    = new char[codeSize];
-    Platform::ReadFile(path, codeSize, code, true);
-    VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
-    createInfo.codeSize			= codeSize;
-    createInfo.pCode			= reinterpret_cast<const uint32_t*>(code);
-
-    VulkanUtilities::checkResult(vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule), "Failed to create shader module!");
-
-    delete[] code;
-
-    stageCreateInfo	   = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
-    stageCreateInfo.stage  = stageFlag;
-    stageCreateInfo.module = shaderModule;
-    stageCreateInfo.pName  = "main";
-}
-
-static void CreatePipelineLayout(
-    VkDevice device,
-    const PipelineLayoutCreateInfo& layoutCreateInfo,
-    VkPipelineLayout& pipelineLayout,
-    VkDescriptorSetLayout& staticSamplerDescriptorSetLayout,
-    VkDescriptorPool& staticSamplerDescriptorPool,
-    VkDescriptorSet& staticSamplerDescriptorSet,
-    eastl::fixed_vector<VkSampler, 16>& staticSamplers)
-{
-    staticSamplerDescriptorSetLayout = VK_NULL_HANDLE;
-    staticSamplerDescriptorPool	     = VK_NULL_HANDLE;
-    staticSamplerDescriptorSet	     = VK_NULL_HANDLE;
-    staticSamplers.clear();
-
-    // create static sampler set
-    if(layoutCreateInfo.StaticSamplerCount > 0)
-    {
-	staticSamplers.reserve(layoutCreateInfo.StaticSamplerCount);
-	eastl::fixed_vector<VkDescriptorSetLayoutBinding, 16> staticSamplerBindings;
-	staticSamplerBindings.reserve(layoutCreateInfo.StaticSamplerCount);
-
-	for(size_t i = 0; i < layoutCreateInfo.StaticSamplerCount; ++i)
-	{
-	    const auto& staticSamplerDesc = layoutCreateInfo.StaticSamplerDescriptions[i];
-
-	    VkSamplerCreateInfo samplerCreateInfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
-	    {
-		samplerCreateInfo.magFilter		  = VulkanUtilities::Translate(staticSamplerDesc.MagFilter);
-		samplerCreateInfo.minFilter		  = VulkanUtilities::Translate(staticSamplerDesc.MinFilter);
-		samplerCreateInfo.mipmapMode		  = VulkanUtilities::Translate(staticSamplerDesc.MipmapMode);
-		samplerCreateInfo.addressModeU		  = VulkanUtilities::Translate(staticSamplerDesc.AddressModeU);
-		samplerCreateInfo.addressModeV		  = VulkanUtilities::Translate(staticSamplerDesc.AddressModeV);
-		samplerCreateInfo.addressModeW		  = VulkanUtilities::Translate(staticSamplerDesc.AddressModeW);
-		samplerCreateInfo.mipLodBias		  = staticSamplerDesc.MipLodBias;
-		samplerCreateInfo.anisotropyEnable	  = staticSamplerDesc.AnisotropyEnable;
-		samplerCreateInfo.maxAnisotropy		  = staticSamplerDesc.MaxAnisotropy;
-		samplerCreateInfo.compareEnable		  = staticSamplerDesc.CompareEnable;
-		samplerCreateInfo.compareOp		  = VulkanUtilities::Translate(staticSamplerDesc.CompareOp);
-		samplerCreateInfo.minLod		  = staticSamplerDesc.MinLod;
-		samplerCreateInfo.maxLod		  = staticSamplerDesc.MaxLod;
-		samplerCreateInfo.borderColor		  = VulkanUtilities::Translate(staticSamplerDesc.BorderColor);
-		samplerCreateInfo.unnormalizedCoordinates = staticSamplerDesc.UnnormalizedCoordinates;
-	    }
-
-	    VkSampler sampler = {};
-	    VulkanUtilities::checkResult(vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler), "Failed to create Sampler!");
-	    staticSamplers.push_back(sampler);
-
-	    VkDescriptorSetLayoutBinding binding = {};
-	    {
-		binding.binding		   = staticSamplerDesc.Binding;
-		binding.descriptorType	   = VK_DESCRIPTOR_TYPE_SAMPLER;
-		binding.descriptorCount	   = 1;
-		binding.stageFlags	   = VulkanUtilities::Translate(staticSamplerDesc.StageFlags);
-		binding.pImmutableSamplers = &staticSamplers.back();
-	    }
-
-	    staticSamplerBindings.push_back(binding);
-	}
-
-	VkDescriptorSetLayoutCreateInfo samplerSetLayoutCreateInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
-	{
-	    samplerSetLayoutCreateInfo.bindingCount = layoutCreateInfo.StaticSamplerCount;
-	    samplerSetLayoutCreateInfo.pBindings    = staticSamplerBindings.data();
-	}
-
-	VulkanUtilities::checkResult(vkCreateDescriptorSetLayout(device, &samplerSetLayoutCreateInfo, nullptr, &staticSamplerDescriptorSetLayout), "Failed to create static sampler descriptor set layout!");
-
-	VkDescriptorPoolSize descriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLER, layoutCreateInfo.StaticSamplerCount };
-	VkDescriptorPoolCreateInfo staticSamplerDescriptorPoolCreateInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
-	{
-	    staticSamplerDescriptorPoolCreateInfo.maxSets	= 1;
-	    staticSamplerDescriptorPoolCreateInfo.poolSizeCount = 1;
-	    staticSamplerDescriptorPoolCreateInfo.pPoolSizes	= &descriptorPoolSize;
-	}
-
-	VulkanUtilities::checkResult(vkCreateDescriptorPool(device, &staticSamplerDescriptorPoolCreateInfo, nullptr, &staticSamplerDescriptorPool), "Failed to create static sampler descriptor pool!");
-
-	VkDescriptorSetAllocateInfo staticSamplerDescriptorSetAllocateInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
-	{
-	    staticSamplerDescriptorSetAllocateInfo.descriptorPool     = staticSamplerDescriptorPool;
-	    staticSamplerDescriptorSetAllocateInfo.descriptorSetCount = 1;
-	    staticSamplerDescriptorSetAllocateInfo.pSetLayouts	      = &staticSamplerDescriptorSetLayout;
-	}
-
-	VulkanUtilities::checkResult(vkAllocateDescriptorSets(device, &staticSamplerDescriptorSetAllocateInfo, &staticSamplerDescriptorSet), "Failed to allocate static sampler descriptor set!");
-    }
-
-    VkDescriptorSetLayout layouts[5];
-    for(size_t i = 0; i < layoutCreateInfo.DescriptorSetLayoutCount; ++i)
-    {
-	auto* layout = dynamic_cast<VulkanDescriptorSetLayout*>(layoutCreateInfo.DescriptorSetLayoutDeclarations[i].Layout);
-	assert(layout);
-	layouts[i] = static_cast<VkDescriptorSetLayout>(layout->GetNativeHandle());
-    }
-    if(staticSamplerDescriptorSetLayout != VK_NULL_HANDLE)
-    {
-	layouts[layoutCreateInfo.StaticSamplerSet] = staticSamplerDescriptorSetLayout;
-    }
-
-    VkPushConstantRange pushConstantRange;
-    pushConstantRange.stageFlags = VulkanUtilities::Translate(layoutCreateInfo.PushConstStageFlags);
-    pushConstantRange.offset	 = 0;
-    pushConstantRange.size	 = layoutCreateInfo.PushConstRange;
-
-    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-    pipelineLayoutCreateInfo.setLayoutCount	    = (staticSamplerDescriptorSetLayout != VK_NULL_HANDLE) ? (layoutCreateInfo.DescriptorSetLayoutCount + 1) : layoutCreateInfo.DescriptorSetLayoutCount;
-    pipelineLayoutCreateInfo.pSetLayouts	    = layouts;
-    pipelineLayoutCreateInfo.pushConstantRangeCount = layoutCreateInfo.PushConstRange > 0 ? 1 : 0;
-    pipelineLayoutCreateInfo.pPushConstantRanges    = layoutCreateInfo.PushConstRange > 0 ? &pushConstantRange : nullptr;
-
-    VulkanUtilities::checkResult(vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout), "Failed to create PipelineLayout!");
 }
\ No newline at end of file
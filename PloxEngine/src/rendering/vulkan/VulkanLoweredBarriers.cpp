@@ -0,0 +1,437 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+#include "VulkanLoweredBarriers.h"
+#include "core/Assert.h"
+#include "rendering/RenderUtilities.h"
+#include "rendering/types/Buffer.h"
+#include "rendering/types/Event.h"
+#include "rendering/types/Image.h"
+#include "volk.h"
+#include "VulkanQueue.h"
+#include "VulkanUtilities.h"
+
+static ResourceStateInfo GetResourceStateInfo(ResourceState state, VkPipelineStageFlags stageFlags, bool isImage, Format imageFormat)
+{
+    ResourceStateInfo result {};
+
+    if(state == ResourceState::UNDEFINED)
+    {
+	result = { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED, false, false };
+	return result;
+    }
+
+    if((state & ResourceState::READ_RESOURCE) != 0)
+    {
+	result.m_stageMask |= stageFlags;
+	result.m_accessMask |= VK_ACCESS_SHADER_READ_BIT;
+	result.m_layout	    = RenderUtilities::IsDepthFormat(imageFormat) || RenderUtilities::IsStencilFormat(imageFormat) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::READ_DEPTH_STENCIL) != 0)
+    {
+	ASSERT(isImage);
+	result.m_stageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	result.m_accessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+	result.m_layout	    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::READ_CONSTANT_BUFFER) != 0)
+    {
+	ASSERT(!isImage);
+	result.m_stageMask |= stageFlags;
+	result.m_accessMask |= VK_ACCESS_UNIFORM_READ_BIT;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::READ_VERTEX_BUFFER) != 0)
+    {
+	ASSERT(!isImage);
+	result.m_stageMask |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+	result.m_accessMask |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::READ_INDEX_BUFFER) != 0)
+    {
+	ASSERT(!isImage);
+	result.m_stageMask |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+	result.m_accessMask |= VK_ACCESS_INDEX_READ_BIT;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::READ_INDIRECT_BUFFER) != 0)
+    {
+	ASSERT(!isImage);
+	result.m_stageMask |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+	result.m_accessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::READ_TRANSFER) != 0)
+    {
+	ASSERT(!isImage || state == ResourceState::READ_TRANSFER); // READ_TRANSFER is an exclusive state on image resources
+	result.m_stageMask |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+	result.m_accessMask |= VK_ACCESS_TRANSFER_READ_BIT;
+	result.m_layout	    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	result.m_readAccess = true;
+    }
+
+    if((state & ResourceState::WRITE_DEPTH_STENCIL) != 0)
+    {
+	ASSERT(isImage);
+	ASSERT(state == ResourceState::WRITE_DEPTH_STENCIL);
+	result.m_stageMask   = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	result.m_accessMask  = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	result.m_writeAccess = true;
+    }
+
+    if((state & ResourceState::WRITE_COLOR_ATTACHMENT) != 0)
+    {
+	ASSERT(isImage);
+	ASSERT(state == ResourceState::WRITE_COLOR_ATTACHMENT);
+	result.m_stageMask   = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	result.m_accessMask  = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	result.m_writeAccess = true;
+    }
+
+    if((state & ResourceState::WRITE_TRANSFER) != 0)
+    {
+	ASSERT(state == ResourceState::WRITE_TRANSFER);
+	result.m_stageMask   = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	result.m_accessMask  = VK_ACCESS_TRANSFER_WRITE_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	result.m_writeAccess = true;
+    }
+
+    if((state & ResourceState::CLEAR_RESOURCE) != 0)
+    {
+	ASSERT(state == ResourceState::CLEAR_RESOURCE);
+	result.m_stageMask   = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	result.m_accessMask  = VK_ACCESS_TRANSFER_WRITE_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	result.m_writeAccess = true;
+    }
+
+    if((state & ResourceState::RW_RESOURCE) != 0)
+    {
+	ASSERT(state == ResourceState::RW_RESOURCE);
+	result.m_stageMask   = stageFlags;
+	result.m_accessMask  = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_GENERAL;
+	result.m_readAccess  = true;
+	result.m_writeAccess = true;
+    }
+
+    if((state & ResourceState::RW_RESOURCE_READ_ONLY) != 0)
+    {
+	ASSERT(state == ResourceState::RW_RESOURCE_READ_ONLY);
+	result.m_stageMask   = stageFlags;
+	result.m_accessMask  = VK_ACCESS_SHADER_READ_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_GENERAL;
+	result.m_readAccess  = true;
+	result.m_writeAccess = false;
+    }
+
+    if((state & ResourceState::RW_RESOURCE_WRITE_ONLY) != 0)
+    {
+	ASSERT(state == ResourceState::RW_RESOURCE_WRITE_ONLY);
+	result.m_stageMask   = stageFlags;
+	result.m_accessMask  = VK_ACCESS_SHADER_WRITE_BIT;
+	result.m_layout	     = VK_IMAGE_LAYOUT_GENERAL;
+	result.m_readAccess  = false;
+	result.m_writeAccess = true;
+    }
+
+    if((state & ResourceState::PRESENT) != 0)
+    {
+	ASSERT(isImage);
+	ASSERT(state == ResourceState::PRESENT);
+	result.m_stageMask   = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	result.m_accessMask  = 0;
+	result.m_layout	     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	result.m_readAccess  = true;
+	result.m_writeAccess = false;
+    }
+
+    result.m_layout = isImage ? result.m_layout : VK_IMAGE_LAYOUT_UNDEFINED;
+
+    return result;
+}
+
+VulkanLoweredBarriers::VulkanLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets)
+    : m_groupOffsets(groupOffsets, groupOffsets + groupCount + 1)
+{
+    ASSERT(m_groupOffsets.back() <= count);
+
+    m_infos.resize(count);
+    m_stagesBefore.resize(count);
+    m_flags.resize(count);
+    m_slots.resize(count);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+	m_infos[i]	  = GetBarrierInfo(barriers[i]);
+	m_stagesBefore[i] = barriers[i].m_stagesBefore;
+	m_flags[i]	  = barriers[i].m_flags;
+    }
+
+    // the arrays are never resized again, so the batches can point into them
+    m_imageBarriers.resize(count * 2);
+    m_bufferBarriers.resize(count * 2);
+    m_setEvents.resize(count);
+    m_setEventStages.resize(count);
+    m_waitEvents.resize(count);
+
+    m_batches.resize(groupCount);
+    for(uint32_t group = 0; group < groupCount; ++group)
+    {
+	const uint32_t offset	    = m_groupOffsets[group];
+	const uint32_t barrierCount = m_groupOffsets[group + 1] - offset;
+
+	auto& batch		= m_batches[group];
+	batch.ImageBarriers[0]	= m_imageBarriers.data() + offset * 2;
+	batch.ImageBarriers[1]	= m_imageBarriers.data() + offset * 2 + barrierCount;
+	batch.BufferBarriers[0] = m_bufferBarriers.data() + offset * 2;
+	batch.BufferBarriers[1] = m_bufferBarriers.data() + offset * 2 + barrierCount;
+	batch.SetEvents		= m_setEvents.data() + offset;
+	batch.SetEventStages	= m_setEventStages.data() + offset;
+	batch.WaitEvents	= m_waitEvents.data() + offset;
+
+	Lower(barrierCount, barriers + offset, m_infos.data() + offset, batch, m_slots.data() + offset);
+    }
+}
+
+void VulkanLoweredBarriers::Update(const Barrier* barriers)
+{
+    for(size_t group = 0; group < m_batches.size(); ++group)
+    {
+	const uint32_t offset = m_groupOffsets[group];
+	const uint32_t end    = m_groupOffsets[group + 1];
+
+	// the stages and access masks of a batch are combined from all of its barriers, so a changed barrier lowers its whole group again
+	bool changed = false;
+	for(uint32_t i = offset; i < end; ++i)
+	{
+	    if(barriers[i].m_stagesBefore != m_stagesBefore[i] || barriers[i].m_flags != m_flags[i])
+	    {
+		m_infos[i]	  = GetBarrierInfo(barriers[i]);
+		m_stagesBefore[i] = barriers[i].m_stagesBefore;
+		m_flags[i]	  = barriers[i].m_flags;
+		changed		  = true;
+	    }
+	}
+
+	if(changed)
+	{
+	    Lower(end - offset, barriers + offset, m_infos.data() + offset, m_batches[group], m_slots.data() + offset);
+	    continue;
+	}
+
+	// everything else stays where it was placed, only the handles of the objects are replaced
+	for(uint32_t i = offset; i < end; ++i)
+	{
+	    const auto& barrier = barriers[i];
+	    const auto& slot	= m_slots[i];
+	    if(slot.NativeIndex != UINT32_MAX)
+	    {
+		if(barrier.m_image)
+		{
+		    m_imageBarriers[offset * 2 + slot.NativeIndex].image = static_cast<VkImage>(barrier.m_image->GetNativeHandle());
+		}
+		else
+		{
+		    m_bufferBarriers[offset * 2 + slot.NativeIndex].buffer = static_cast<VkBuffer>(barrier.m_buffer->GetNativeHandle());
+		}
+	    }
+	    if(slot.EventIndex != UINT32_MAX)
+	    {
+		auto& events			 = (barrier.m_flags & BarrierFlags::BARRIER_BEGIN) != 0 ? m_setEvents : m_waitEvents;
+		events[offset + slot.EventIndex] = static_cast<VkEvent>(barrier.m_event->GetNativeHandle());
+	    }
+	}
+    }
+}
+
+void VulkanLoweredBarriers::Record(VkCommandBuffer commandBuffer, uint32_t group) const
+{
+    ASSERT(group < m_batches.size());
+    Record(commandBuffer, m_batches[group]);
+}
+
+VulkanBarrierInfo VulkanLoweredBarriers::GetBarrierInfo(const Barrier& barrier)
+{
+    ASSERT((bool) barrier.m_image != (bool) barrier.m_buffer);
+
+    const auto* srcQueue   = dynamic_cast<const VulkanQueue*>(barrier.m_srcQueue);
+    const auto* dstQueue   = dynamic_cast<const VulkanQueue*>(barrier.m_dstQueue);
+    const auto imageFormat = barrier.m_image ? barrier.m_image->GetDescription().Format : Format::UNDEFINED;
+
+    VulkanBarrierInfo info = {};
+    {
+	info.BeforeStateInfo = GetResourceStateInfo(barrier.m_stateBefore, VulkanUtilities::Translate(barrier.m_stagesBefore), bool(barrier.m_image), imageFormat);
+	info.AfterStateInfo  = GetResourceStateInfo(barrier.m_stateAfter, VulkanUtilities::Translate(barrier.m_stagesAfter), bool(barrier.m_image), imageFormat);
+	info.ImageAspectMask = barrier.m_image ? VulkanUtilities::GetImageAspectMask(VulkanUtilities::Translate(imageFormat)) : 0;
+	info.SrcQueueFamily  = srcQueue ? srcQueue->GetQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
+	info.DstQueueFamily  = dstQueue ? dstQueue->GetQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
+    }
+    return info;
+}
+
+void VulkanLoweredBarriers::Lower(uint32_t count, const Barrier* barriers, const VulkanBarrierInfo* infos, VulkanBarrierBatch& batch, VulkanBarrierSlot* slots)
+{
+    for(size_t i = 0; i < 2; ++i)
+    {
+	batch.ImageBarrierCounts[i]  = 0;
+	batch.BufferBarrierCounts[i] = 0;
+	batch.MemoryBarriers[i]	     = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+	batch.SrcStages[i]	     = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	batch.DstStages[i]	     = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    }
+    batch.SetEventCount	 = 0;
+    batch.WaitEventCount = 0;
+
+    for(size_t i = 0; i < count; i++)
+    {
+	const auto& barrier	    = barriers[i];
+	const auto& beforeStateInfo = infos[i].BeforeStateInfo;
+	const auto& afterStateInfo  = infos[i].AfterStateInfo;
+
+	VulkanBarrierSlot slot = { UINT32_MAX, UINT32_MAX };
+
+	// the begin of a split barrier only sets its event once the previous usage is done
+	if((barrier.m_flags & BarrierFlags::BARRIER_BEGIN) != 0)
+	{
+	    if(barrier.m_event)
+	    {
+		const auto eventVk = static_cast<VkEvent>(barrier.m_event->GetNativeHandle());
+		uint32_t eventIdx  = 0;
+		while(eventIdx < batch.SetEventCount && batch.SetEvents[eventIdx] != eventVk)
+		{
+		    ++eventIdx;
+		}
+		if(eventIdx == batch.SetEventCount)
+		{
+		    batch.SetEvents[batch.SetEventCount]	= eventVk;
+		    batch.SetEventStages[batch.SetEventCount++] = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		}
+		batch.SetEventStages[eventIdx] |= beforeStateInfo.m_stageMask;
+		slot.EventIndex = eventIdx;
+	    }
+	    if(slots)
+	    {
+		slots[i] = slot;
+	    }
+	    continue;
+	}
+
+	// the source stages of the wait have to be exactly the stages the events were set at
+	const bool waitEvent = (barrier.m_flags & BarrierFlags::BARRIER_END) != 0 && barrier.m_event;
+	const size_t setIdx  = waitEvent ? 1 : 0;
+	if(waitEvent)
+	{
+	    const auto eventVk = static_cast<VkEvent>(barrier.m_event->GetNativeHandle());
+	    uint32_t eventIdx  = 0;
+	    while(eventIdx < batch.WaitEventCount && batch.WaitEvents[eventIdx] != eventVk)
+	    {
+		++eventIdx;
+	    }
+	    if(eventIdx == batch.WaitEventCount)
+	    {
+		batch.WaitEvents[batch.WaitEventCount++] = eventVk;
+	    }
+	    batch.SrcStages[1] |= beforeStateInfo.m_stageMask;
+	    slot.EventIndex = eventIdx;
+	}
+
+	const bool queueAcquire = (barrier.m_flags & BarrierFlags::QUEUE_OWNERSHIP_AQUIRE) != 0;
+	const bool queueRelease = (barrier.m_flags & BarrierFlags::QUEUE_OWNERSHIP_RELEASE) != 0;
+	const bool aliasing	= (barrier.m_flags & BarrierFlags::ALIASING) != 0;
+
+	const bool imageBarrierRequired	    = barrier.m_image && (beforeStateInfo.m_layout != afterStateInfo.m_layout || queueAcquire || queueRelease);
+	const bool bufferBarrierRequired    = barrier.m_buffer && (queueAcquire || queueRelease);
+	const bool memoryBarrierRequired    = beforeStateInfo.m_writeAccess && !imageBarrierRequired && !bufferBarrierRequired;
+	const bool executionBarrierRequired = beforeStateInfo.m_writeAccess || afterStateInfo.m_writeAccess || memoryBarrierRequired || bufferBarrierRequired || imageBarrierRequired;
+
+	if(imageBarrierRequired)
+	{
+	    const auto& subResRange = barrier.m_imageSubresourceRange;
+
+	    slot.NativeIndex   = static_cast<uint32_t>(setIdx) * count + batch.ImageBarrierCounts[setIdx];
+	    auto& imageBarrier = batch.ImageBarriers[setIdx][batch.ImageBarrierCounts[setIdx]++];
+	    imageBarrier       = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+	    {
+		imageBarrier.srcAccessMask	 = queueAcquire ? 0 : beforeStateInfo.m_accessMask;
+		imageBarrier.dstAccessMask	 = queueRelease ? 0 : afterStateInfo.m_accessMask;
+		imageBarrier.oldLayout		 = beforeStateInfo.m_layout;
+		imageBarrier.newLayout		 = afterStateInfo.m_layout;
+		imageBarrier.srcQueueFamilyIndex = infos[i].SrcQueueFamily;
+		imageBarrier.dstQueueFamilyIndex = infos[i].DstQueueFamily;
+		imageBarrier.image		 = static_cast<VkImage>(barrier.m_image->GetNativeHandle());
+		imageBarrier.subresourceRange	 = { infos[i].ImageAspectMask, subResRange.BaseMipLevel, subResRange.LevelCount, subResRange.BaseArrayLayer, subResRange.LayerCount };
+	    }
+	}
+	else if(bufferBarrierRequired)
+	{
+	    slot.NativeIndex	= static_cast<uint32_t>(setIdx) * count + batch.BufferBarrierCounts[setIdx];
+	    auto& bufferBarrier = batch.BufferBarriers[setIdx][batch.BufferBarrierCounts[setIdx]++];
+	    bufferBarrier	= { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+	    {
+		bufferBarrier.srcAccessMask	  = queueAcquire ? 0 : beforeStateInfo.m_accessMask;
+		bufferBarrier.dstAccessMask	  = queueRelease ? 0 : afterStateInfo.m_accessMask;
+		bufferBarrier.srcQueueFamilyIndex = infos[i].SrcQueueFamily;
+		bufferBarrier.dstQueueFamilyIndex = infos[i].DstQueueFamily;
+		bufferBarrier.buffer		  = static_cast<VkBuffer>(barrier.m_buffer->GetNativeHandle());
+		bufferBarrier.offset		  = 0;
+		bufferBarrier.size		  = VK_WHOLE_SIZE;
+	    }
+	}
+
+	if(memoryBarrierRequired)
+	{
+	    batch.MemoryBarriers[setIdx].srcAccessMask |= beforeStateInfo.m_accessMask;
+	    batch.MemoryBarriers[setIdx].dstAccessMask |= afterStateInfo.m_accessMask;
+	}
+
+	// writes of the previous resource in the same memory have to finish before this one starts using it
+	if(aliasing)
+	{
+	    batch.MemoryBarriers[setIdx].srcAccessMask |= VK_ACCESS_MEMORY_WRITE_BIT;
+	    batch.MemoryBarriers[setIdx].dstAccessMask |= afterStateInfo.m_accessMask;
+	    batch.SrcStages[setIdx] |= VulkanUtilities::Translate(barrier.m_stagesBefore);
+	    batch.DstStages[setIdx] |= afterStateInfo.m_stageMask;
+	}
+
+	if(executionBarrierRequired)
+	{
+	    batch.SrcStages[setIdx] |= queueAcquire ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : beforeStateInfo.m_stageMask;
+	    batch.DstStages[setIdx] |= queueRelease ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : afterStateInfo.m_stageMask;
+	}
+
+	if(slots)
+	{
+	    slots[i] = slot;
+	}
+    }
+}
+
+void VulkanLoweredBarriers::Record(VkCommandBuffer commandBuffer, const VulkanBarrierBatch& batch)
+{
+    if(batch.BufferBarrierCounts[0] || batch.ImageBarrierCounts[0] || batch.MemoryBarriers[0].srcAccessMask || batch.SrcStages[0] != VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT || batch.DstStages[0] != VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+    {
+	vkCmdPipelineBarrier(commandBuffer, batch.SrcStages[0], batch.DstStages[0], 0, 1, &batch.MemoryBarriers[0], batch.BufferBarrierCounts[0], batch.BufferBarriers[0], batch.ImageBarrierCounts[0], batch.ImageBarriers[0]);
+    }
+
+    if(batch.WaitEventCount)
+    {
+	vkCmdWaitEvents(commandBuffer, batch.WaitEventCount, batch.WaitEvents, batch.SrcStages[1], batch.DstStages[1], 1, &batch.MemoryBarriers[1], batch.BufferBarrierCounts[1], batch.BufferBarriers[1], batch.ImageBarrierCounts[1], batch.ImageBarriers[1]);
+    }
+
+    for(uint32_t i = 0; i < batch.SetEventCount; ++i)
+    {
+	vkCmdSetEvent(commandBuffer, batch.SetEvents[i], batch.SetEventStages[i]);
+    }
+}
\ No newline at end of file
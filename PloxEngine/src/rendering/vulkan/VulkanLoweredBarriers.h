@@ -0,0 +1,87 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#pragma once
+#include "EASTL/vector.h"
+#include "rendering/types/LoweredBarriers.h"
+#include "vulkan/vulkan.h"
+
+struct ResourceStateInfo
+{
+    VkPipelineStageFlags m_stageMask;
+    VkAccessFlags m_accessMask;
+    VkImageLayout m_layout;
+    bool m_readAccess;
+    bool m_writeAccess;
+};
+
+// everything about a barrier that does not depend on the objects it refers to
+struct VulkanBarrierInfo
+{
+    ResourceStateInfo BeforeStateInfo;
+    ResourceStateInfo AfterStateInfo;
+    VkImageAspectFlags ImageAspectMask;
+    uint32_t SrcQueueFamily;
+    uint32_t DstQueueFamily;
+};
+
+// the native form of one Command::Barrier call. index 0 is the regular pipeline barrier, index 1 the ends of split barriers that wait on their events.
+// every array has room for one entry per barrier
+struct VulkanBarrierBatch
+{
+    VkImageMemoryBarrier* ImageBarriers[2];
+    VkBufferMemoryBarrier* BufferBarriers[2];
+    uint32_t ImageBarrierCounts[2];
+    uint32_t BufferBarrierCounts[2];
+    VkMemoryBarrier MemoryBarriers[2];
+    VkPipelineStageFlags SrcStages[2];
+    VkPipelineStageFlags DstStages[2];
+    VkEvent* SetEvents;
+    VkPipelineStageFlags* SetEventStages;
+    VkEvent* WaitEvents;
+    uint32_t SetEventCount;
+    uint32_t WaitEventCount;
+};
+
+// where Lower placed a barrier, both are UINT32_MAX if there is none. NativeIndex is the image or buffer barrier it became, counted from ImageBarriers[0] or BufferBarriers[0]
+// of its batch, which the entries of index 1 follow after count barriers. EventIndex is its entry in SetEvents or WaitEvents
+struct VulkanBarrierSlot
+{
+    uint32_t NativeIndex;
+    uint32_t EventIndex;
+};
+
+class VulkanLoweredBarriers : public LoweredBarriers
+{
+public:
+    explicit VulkanLoweredBarriers(uint32_t count, const Barrier* barriers, uint32_t groupCount, const uint32_t* groupOffsets);
+
+    VulkanLoweredBarriers(VulkanLoweredBarriers&)		    = delete;
+    VulkanLoweredBarriers(VulkanLoweredBarriers&&)		    = delete;
+    VulkanLoweredBarriers& operator=(const VulkanLoweredBarriers&)  = delete;
+    VulkanLoweredBarriers& operator=(const VulkanLoweredBarriers&&) = delete;
+
+    void Update(const Barrier* barriers) override;
+    void Record(VkCommandBuffer commandBuffer, uint32_t group) const;
+
+    static VulkanBarrierInfo GetBarrierInfo(const Barrier& barrier);
+    // builds the native barriers of count barriers into the arrays of batch, slots receives where each of them was placed if it is not nullptr
+    static void Lower(uint32_t count, const Barrier* barriers, const VulkanBarrierInfo* infos, VulkanBarrierBatch& batch, VulkanBarrierSlot* slots = nullptr);
+    static void Record(VkCommandBuffer commandBuffer, const VulkanBarrierBatch& batch);
+
+private:
+    eastl::vector<uint32_t> m_groupOffsets;
+    eastl::vector<VulkanBarrierInfo> m_infos;
+    // what the infos were translated from, the before stages and flags of resources placed into shared memory change between frames
+    eastl::vector<PipelineStageFlags> m_stagesBefore;
+    eastl::vector<BarrierFlags> m_flags;
+    eastl::vector<VulkanBarrierSlot> m_slots;
+    // the batch of a group points at the entries [2 * offset, 2 * offset + 2 * count) of the barrier arrays and [offset, offset + count) of the event arrays
+    eastl::vector<VulkanBarrierBatch> m_batches;
+    eastl::vector<VkImageMemoryBarrier> m_imageBarriers;
+    eastl::vector<VkBufferMemoryBarrier> m_bufferBarriers;
+    eastl::vector<VkEvent> m_setEvents;
+    eastl::vector<VkPipelineStageFlags> m_setEventStages;
+    eastl::vector<VkEvent> m_waitEvents;
+};
\ No newline at end of file
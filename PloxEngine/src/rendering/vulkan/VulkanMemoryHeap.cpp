@@ -0,0 +1,34 @@
+//
+// Created by Ploxie on 2023-06-18.
+//
+#include "VulkanMemoryHeap.h"
+
+VulkanMemoryHeap::VulkanMemoryHeap(VulkanMemoryAllocator* allocator, VulkanAllocationHandle allocHandle, const MemoryHeapCreateInfo& createInfo)
+    : m_allocator(allocator), m_allocHandle(allocHandle), m_description(createInfo)
+{
+}
+
+VulkanMemoryHeap::~VulkanMemoryHeap()
+{
+    m_allocator->Free(m_allocHandle);
+}
+
+void* VulkanMemoryHeap::GetNativeHandle() const
+{
+    return GetMemory();
+}
+
+const MemoryHeapCreateInfo& VulkanMemoryHeap::GetDescription() const
+{
+    return m_description;
+}
+
+VkDeviceMemory VulkanMemoryHeap::GetMemory() const
+{
+    return m_allocator->GetAllocationInfo(m_allocHandle).Memory;
+}
+
+VkDeviceSize VulkanMemoryHeap::GetOffset() const
+{
+    return m_allocator->GetAllocationInfo(m_allocHandle).Offset;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+//
+// Created by Ploxie on 2023-06-18.
+//
+
+#pragma once
+#include "rendering/types/MemoryHeap.h"
+#include "VulkanMemoryAllocator.h"
+
+class VulkanMemoryHeap : public MemoryHeap
+{
+public:
+    explicit VulkanMemoryHeap(VulkanMemoryAllocator* allocator, VulkanAllocationHandle allocHandle, const MemoryHeapCreateInfo& createInfo);
+    ~VulkanMemoryHeap();
+
+    VulkanMemoryHeap(VulkanMemoryHeap&)			  = delete;
+    VulkanMemoryHeap(VulkanMemoryHeap&&)		  = delete;
+    VulkanMemoryHeap& operator=(const VulkanMemoryHeap&)  = delete;
+    VulkanMemoryHeap& operator=(const VulkanMemoryHeap&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const MemoryHeapCreateInfo& GetDescription() const override;
+    VkDeviceMemory GetMemory() const;
+    VkDeviceSize GetOffset() const;
+
+private:
+    VulkanMemoryAllocator* m_allocator;
+    VulkanAllocationHandle m_allocHandle;
+    MemoryHeapCreateInfo m_description;
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+//
+// Created by Ploxie on 2023-06-15.
+//
+#include "VulkanQueryPool.h"
+#include "core/Assert.h"
+#include "volk.h"
+#include "VulkanUtilities.h"
+
+VulkanQueryPool::VulkanQueryPool(VkDevice device, const QueryPoolCreateInfo& createInfo)
+    : m_device(device), m_queryPool(VK_NULL_HANDLE), m_description(createInfo)
+{
+    ASSERT(createInfo.QueryCount > 0);
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    {
+	queryPoolCreateInfo.queryType	       = VulkanUtilities::Translate(createInfo.QueryType);
+	queryPoolCreateInfo.queryCount	       = createInfo.QueryCount;
+	queryPoolCreateInfo.pipelineStatistics = createInfo.QueryType == QueryType::PIPELINE_STATISTICS ? VulkanUtilities::Translate(createInfo.PipelineStatistics) : 0;
+    }
+
+    VulkanUtilities::checkResult(vkCreateQueryPool(m_device, &queryPoolCreateInfo, nullptr, &m_queryPool), "Failed to create QueryPool!");
+}
+
+VulkanQueryPool::~VulkanQueryPool()
+{
+    vkDestroyQueryPool(m_device, m_queryPool, nullptr);
+}
+
+void* VulkanQueryPool::GetNativeHandle() const
+{
+    return m_queryPool;
+}
+
+const QueryPoolCreateInfo& VulkanQueryPool::GetDescription() const
+{
+    return m_description;
+}
+
+bool VulkanQueryPool::GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t dataSize, void* data, uint64_t stride) const
+{
+    ASSERT(firstQuery + queryCount <= m_description.QueryCount);
+
+    // no WAIT_BIT: the caller polls and drops results that are not ready instead of stalling the frame
+    const VkResult result = vkGetQueryPoolResults(m_device, m_queryPool, firstQuery, queryCount, dataSize, data, stride, VK_QUERY_RESULT_64_BIT);
+    if(result == VK_NOT_READY)
+    {
+	return false;
+    }
+
+    VulkanUtilities::checkResult(result, "Failed to get QueryPool results!");
+    return true;
+}
\ No newline at end of file
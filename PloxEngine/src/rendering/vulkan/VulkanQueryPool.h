@@ -0,0 +1,28 @@
+//
+// Created by Ploxie on 2023-06-15.
+//
+
+#pragma once
+#include "rendering/types/QueryPool.h"
+#include "vulkan/vulkan.h"
+
+class VulkanQueryPool : public QueryPool
+{
+public:
+    explicit VulkanQueryPool(VkDevice device, const QueryPoolCreateInfo& createInfo);
+    ~VulkanQueryPool();
+
+    VulkanQueryPool(VulkanQueryPool&)			= delete;
+    VulkanQueryPool(VulkanQueryPool&&)			= delete;
+    VulkanQueryPool& operator=(const VulkanQueryPool&)	= delete;
+    VulkanQueryPool& operator=(const VulkanQueryPool&&) = delete;
+
+    void* GetNativeHandle() const override;
+    const QueryPoolCreateInfo& GetDescription() const override;
+    bool GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t dataSize, void* data, uint64_t stride) const override;
+
+private:
+    VkDevice m_device;
+    VkQueryPool m_queryPool;
+    QueryPoolCreateInfo m_description;
+};
\ No newline at end of file
@@ -3,12 +3,14 @@
 //
 
 #pragma once
+#include "eastl/fixed_vector.h"
 #include "rendering/types/Barrier.h"
 #include "rendering/types/Buffer.h"
 #include "rendering/types/Command.h"
 #include "rendering/types/Format.h"
 #include "rendering/types/GraphicsPipeline.h"
 #include "rendering/types/ImageView.h"
+#include "rendering/types/QueryPool.h"
 #include "vulkan/vulkan.h"
 
 namespace VulkanUtilities
@@ -49,5 +51,11 @@ namespace VulkanUtilities
     VkImageUsageFlags Translate(ImageUsageFlags flags);
     VkDescriptorBindingFlags Translate(DescriptorBindingFlags flags);
     VkIndexType Translate(IndexType indexType);
+    VkQueryType Translate(QueryType queryType);
+    VkQueryPipelineStatisticFlags Translate(QueryPipelineStatisticFlags flags);
+
+    // shared by the graphics and compute pipelines
+    void CreateShaderStage(VkDevice device, const ShaderStageCreateInfo& stageDesc, VkShaderStageFlagBits stageFlag, VkShaderModule& shaderModule, VkPipelineShaderStageCreateInfo& stageCreateInfo);
+    void CreatePipelineLayout(VkDevice device, const PipelineLayoutCreateInfo& layoutCreateInfo, VkPipelineLayout& pipelineLayout, VkDescriptorSetLayout& staticSamplerDescriptorSetLayout, VkDescriptorPool& staticSamplerDescriptorPool, VkDescriptorSet& staticSamplerDescriptorSet, eastl::fixed_vector<VkSampler, 16>& staticSamplers);
 
 } // namespace VulkanUtilities
\ No newline at end of file
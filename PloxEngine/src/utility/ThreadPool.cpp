@@ -0,0 +1,134 @@
+//
+// Created by Ploxie on 2023-06-02.
+//
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(uint32_t threadCount) noexcept
+{
+    if(threadCount == 0)
+    {
+	threadCount = eastl::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    // the calling thread participates as thread 0
+    m_threads.reserve(threadCount - 1);
+    for(uint32_t i = 1; i < threadCount; ++i)
+    {
+	m_threads.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_shutdown = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for(auto& thread: m_threads)
+    {
+	thread.join();
+    }
+}
+
+void ThreadPool::ParallelFor(uint32_t taskCount, const TaskFunc& func) noexcept
+{
+    if(taskCount == 0)
+    {
+	return;
+    }
+
+    if(taskCount == 1 || m_threads.empty())
+    {
+	for(uint32_t i = 0; i < taskCount; ++i)
+	{
+	    func(i, 0);
+	}
+	return;
+    }
+
+    {
+	// wait for stragglers of the previous dispatch before touching the shared state
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]()
+	{
+	    return m_activeWorkers == 0;
+	});
+
+	m_func	    = &func;
+	m_taskCount = taskCount;
+	m_nextTask.store(0, eastl::memory_order_relaxed);
+	m_completedTasks.store(0, eastl::memory_order_relaxed);
+	++m_generation;
+    }
+    m_wakeCondition.notify_all();
+
+    RunTasks(&func, taskCount, 0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this, taskCount]()
+    {
+	return m_completedTasks.load(eastl::memory_order_acquire) == taskCount;
+    });
+}
+
+uint32_t ThreadPool::GetThreadCount() const noexcept
+{
+    return static_cast<uint32_t>(m_threads.size()) + 1;
+}
+
+void ThreadPool::WorkerLoop(uint32_t threadIndex) noexcept
+{
+    uint64_t generation = 0;
+
+    while(true)
+    {
+	const TaskFunc* func = nullptr;
+	uint32_t taskCount   = 0;
+	{
+	    std::unique_lock<std::mutex> lock(m_mutex);
+	    m_wakeCondition.wait(lock, [this, generation]()
+	    {
+		return m_shutdown || m_generation != generation;
+	    });
+
+	    if(m_shutdown)
+	    {
+		return;
+	    }
+
+	    generation = m_generation;
+	    func       = m_func;
+	    taskCount  = m_taskCount;
+	    ++m_activeWorkers;
+	}
+
+	RunTasks(func, taskCount, threadIndex);
+
+	{
+	    std::lock_guard<std::mutex> lock(m_mutex);
+	    --m_activeWorkers;
+	}
+	m_doneCondition.notify_all();
+    }
+}
+
+void ThreadPool::RunTasks(const TaskFunc* func, uint32_t taskCount, uint32_t threadIndex) noexcept
+{
+    uint32_t completed = 0;
+    uint32_t taskIndex = m_nextTask.fetch_add(1, eastl::memory_order_relaxed);
+    while(taskIndex < taskCount)
+    {
+	(*func)(taskIndex, threadIndex);
+	++completed;
+	taskIndex = m_nextTask.fetch_add(1, eastl::memory_order_relaxed);
+    }
+
+    if(completed > 0 && m_completedTasks.fetch_add(completed, eastl::memory_order_acq_rel) + completed == taskCount)
+    {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_doneCondition.notify_all();
+    }
+}
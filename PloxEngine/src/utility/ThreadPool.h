@@ -0,0 +1,48 @@
+//
+// Created by Ploxie on 2023-06-02.
+//
+
+#pragma once
+#include "EASTL/atomic.h"
+#include "EASTL/internal/function.h"
+#include "EASTL/vector.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+class ThreadPool
+{
+public:
+    // taskIndex is in [0, taskCount), threadIndex is in [0, GetThreadCount()) and 0 is always the calling thread
+    using TaskFunc = eastl::function<void(uint32_t taskIndex, uint32_t threadIndex)>;
+
+public:
+    explicit ThreadPool(uint32_t threadCount = 0) noexcept;
+    ~ThreadPool() noexcept;
+
+    ThreadPool(const ThreadPool&)	      = delete;
+    ThreadPool(const ThreadPool&&)	      = delete;
+    ThreadPool& operator=(const ThreadPool&)  = delete;
+    ThreadPool& operator=(const ThreadPool&&) = delete;
+
+    void ParallelFor(uint32_t taskCount, const TaskFunc& func) noexcept;
+    uint32_t GetThreadCount() const noexcept;
+
+private:
+    void WorkerLoop(uint32_t threadIndex) noexcept;
+    void RunTasks(const TaskFunc* func, uint32_t taskCount, uint32_t threadIndex) noexcept;
+
+private:
+    eastl::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    const TaskFunc* m_func   = nullptr;
+    uint32_t m_taskCount     = 0;
+    uint32_t m_activeWorkers = 0;
+    uint64_t m_generation    = 0;
+    bool m_shutdown	     = false;
+    eastl::atomic<uint32_t> m_nextTask { 0 };
+    eastl::atomic<uint32_t> m_completedTasks { 0 };
+};
@@ -11,12 +11,18 @@ DefaultAllocator* DefaultAllocator::Get() noexcept
 
 void* DefaultAllocator::allocate(size_t n, int flags) noexcept
 {
+#ifdef ALLOCATION_TRACKING_ENABLED
+    m_allocationCount.fetch_add(1, eastl::memory_order_relaxed);
+#endif // ALLOCATION_TRACKING_ENABLED
     void* ptr = malloc(n);
     return ptr;
 }
 
 void* DefaultAllocator::allocate(size_t n, size_t alignment, size_t offset, int flags) noexcept
 {
+#ifdef ALLOCATION_TRACKING_ENABLED
+    m_allocationCount.fetch_add(1, eastl::memory_order_relaxed);
+#endif // ALLOCATION_TRACKING_ENABLED
     void* ptr = malloc(n);
     return ptr;
 }
@@ -36,6 +42,13 @@ void DefaultAllocator::set_name(const char* pName) noexcept
     m_name = pName;
 }
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+uint64_t DefaultAllocator::GetAllocationCount() const noexcept
+{
+    return m_allocationCount.load(eastl::memory_order_relaxed);
+}
+#endif // ALLOCATION_TRACKING_ENABLED
+
 void* operator new(size_t size, void* pObjMem, PlacementNewDummy dummy) noexcept
 {
     ASSERT(pObjMem);
@@ -4,6 +4,9 @@
 
 #pragma once
 #include "IAllocator.h"
+#ifdef ALLOCATION_TRACKING_ENABLED
+    #include "EASTL/atomic.h"
+#endif // ALLOCATION_TRACKING_ENABLED
 
 class DefaultAllocator : public IAllocator
 {
@@ -16,6 +19,14 @@ public:
     const char* get_name() const noexcept override;
     void set_name(const char* pName) noexcept override;
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+    // since the start of the process, the global operator new allocates through here as well
+    uint64_t GetAllocationCount() const noexcept;
+#endif // ALLOCATION_TRACKING_ENABLED
+
 private:
     const char* m_name = "Default Allocator";
+#ifdef ALLOCATION_TRACKING_ENABLED
+    eastl::atomic<uint64_t> m_allocationCount = 0;
+#endif // ALLOCATION_TRACKING_ENABLED
 };
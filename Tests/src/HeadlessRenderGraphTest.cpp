@@ -0,0 +1,174 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#include "core/Logger.h"
+#include "rendering/GraphicsAdapter.h"
+#include "rendering/null/NullQueue.h"
+#include "rendering/rendergraph/RenderGraph.h"
+#include "rendering/ResourceViewRegistry.h"
+#include "rendering/types/CommandPool.h"
+#include "TestUtilities.h"
+#include "utility/ThreadPool.h"
+
+#undef CreateSemaphore
+
+// a submission waiting on a value no other queue has submitted a signal for yet stays pending until that signal is submitted
+static void TestWaitBeforeSignal(GraphicsAdapter* adapter)
+{
+    auto* graphicsQueue = dynamic_cast<NullQueue*>(adapter->GetGraphicsQueue());
+    auto* computeQueue	= dynamic_cast<NullQueue*>(adapter->GetComputeQueue());
+    computeQueue->SetSimulatedLatency(1000000);
+
+    Semaphore* computeSemaphore	 = nullptr;
+    Semaphore* graphicsSemaphore = nullptr;
+    adapter->CreateSemaphore(0, &computeSemaphore);
+    adapter->CreateSemaphore(0, &graphicsSemaphore);
+
+    CommandPool* commandPool = nullptr;
+    adapter->CreateCommandPool(graphicsQueue, &commandPool);
+    Command* command = nullptr;
+    commandPool->Allocate(1, &command);
+    command->Begin();
+    command->End();
+
+    const uint64_t waitValue		= 1;
+    const uint64_t signalValues[2]	= { 1, 2 };
+    const Semaphore* waitSemaphores[]	= { computeSemaphore };
+    const Semaphore* signalSemaphores[] = { graphicsSemaphore };
+
+    SubmitInfo waitingInfo	     = {};
+    waitingInfo.WaitSemaphoreCount   = 1;
+    waitingInfo.WaitSemaphores	     = waitSemaphores;
+    waitingInfo.WaitValues	     = &waitValue;
+    waitingInfo.CommandCount	     = 1;
+    waitingInfo.Commands	     = &command;
+    waitingInfo.SignalSemaphoreCount = 1;
+    waitingInfo.SignalSemaphores     = signalSemaphores;
+    waitingInfo.SignalValues	     = &signalValues[0];
+    graphicsQueue->Submit(1, &waitingInfo);
+
+    // ordered behind the blocked submission even though it does not wait itself
+    SubmitInfo followingInfo	       = {};
+    followingInfo.SignalSemaphoreCount = 1;
+    followingInfo.SignalSemaphores     = signalSemaphores;
+    followingInfo.SignalValues	       = &signalValues[1];
+    graphicsQueue->Submit(1, &followingInfo);
+
+    CHECK(graphicsQueue->GetPendingSubmissionCount() == 2);
+    CHECK(graphicsQueue->GetStatistics().BlockedSubmissionCount == 2);
+    CHECK(graphicsSemaphore->GetCompletedValue() == 0);
+
+    const Semaphore* computeSignalSemaphores[] = { computeSemaphore };
+    SubmitInfo signalingInfo		       = {};
+    signalingInfo.SignalSemaphoreCount	       = 1;
+    signalingInfo.SignalSemaphores	       = computeSignalSemaphores;
+    signalingInfo.SignalValues		       = &waitValue;
+    computeQueue->Submit(1, &signalingInfo);
+
+    CHECK(graphicsQueue->GetPendingSubmissionCount() == 0);
+    CHECK(graphicsQueue->GetCompletionTime() >= computeQueue->GetCompletionTime());
+
+    graphicsSemaphore->Wait(2);
+    CHECK(computeSemaphore->GetCompletedValue() == 1);
+
+    computeQueue->SetSimulatedLatency(0);
+    adapter->DestroyCommandPool(commandPool);
+    adapter->DestroySemaphore(computeSemaphore);
+    adapter->DestroySemaphore(graphicsSemaphore);
+}
+
+// frames using all three queues must never leave a submission waiting on a signal that was not submitted before it
+static void TestRenderGraphFrames(GraphicsAdapter* adapter)
+{
+    constexpr uint32_t FRAME_COUNT = 16;
+
+    Semaphore* semaphores[3]	= {};
+    uint64_t semaphoreValues[3] = {};
+    for(auto*& semaphore: semaphores)
+    {
+	adapter->CreateSemaphore(0, &semaphore);
+    }
+
+    NullQueue* queues[] = {
+	dynamic_cast<NullQueue*>(adapter->GetGraphicsQueue()),
+	dynamic_cast<NullQueue*>(adapter->GetComputeQueue()),
+	dynamic_cast<NullQueue*>(adapter->GetTransferQueue()),
+    };
+    uint64_t blockedSubmissionCounts[3] = {};
+    for(size_t i = 0; i < 3; ++i)
+    {
+	blockedSubmissionCounts[i] = queues[i]->GetStatistics().BlockedSubmissionCount;
+    }
+
+    auto* threadPool	       = new ThreadPool();
+    auto* resourceViewRegistry = new ResourceViewRegistry(adapter);
+    auto* renderGraph	       = new RenderGraph(adapter, semaphores, semaphoreValues, resourceViewRegistry, threadPool);
+
+    for(uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+	renderGraph->NextFrame();
+
+	ResourceHandle uploadBuffer	  = renderGraph->CreateBuffer(BufferDescription::Create("Upload Buffer", 1024, BufferUsageFlags::TRANSFER_DST_BIT | BufferUsageFlags::TRANSFER_SRC_BIT));
+	ResourceHandle simulationBuffer	  = renderGraph->CreateBuffer(BufferDescription::Create("Simulation Buffer", 1024, BufferUsageFlags::TRANSFER_DST_BIT | BufferUsageFlags::RW_BYTE_BUFFER_BIT));
+	ResourceHandle resultBuffer	  = renderGraph->CreateBuffer(BufferDescription::Create("Result Buffer", 1024, BufferUsageFlags::TRANSFER_DST_BIT));
+	ResourceViewHandle uploadView	  = renderGraph->CreateBufferView(BufferViewDescription::CreateDefault("Upload View", uploadBuffer, renderGraph));
+	ResourceViewHandle simulationView = renderGraph->CreateBufferView(BufferViewDescription::CreateDefault("Simulation View", simulationBuffer, renderGraph));
+	ResourceViewHandle resultView	  = renderGraph->CreateBufferView(BufferViewDescription::CreateDefault("Result View", resultBuffer, renderGraph));
+	renderGraph->MarkOutput(resultBuffer);
+
+	ResourceUsageDescription uploadUsage = { uploadView, { ResourceState::WRITE_TRANSFER, PipelineStageFlags::TRANSFER_BIT } };
+	renderGraph->AddPass("Upload", QueueType::TRANSFER, 1, &uploadUsage, [](Command*, const Registry&) {});
+
+	ResourceUsageDescription simulateUsages[] = {
+	    { uploadView, { ResourceState::READ_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	    { simulationView, { ResourceState::WRITE_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	};
+	renderGraph->AddPass("Simulate", QueueType::COMPUTE, eastl::size(simulateUsages), simulateUsages, [](Command*, const Registry&) {});
+
+	ResourceUsageDescription resolveUsages[] = {
+	    { simulationView, { ResourceState::READ_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	    { resultView, { ResourceState::WRITE_TRANSFER, PipelineStageFlags::TRANSFER_BIT } },
+	};
+	renderGraph->AddPass("Resolve", QueueType::GRAPHICS, eastl::size(resolveUsages), resolveUsages, [](Command*, const Registry&) {});
+
+	resourceViewRegistry->FlushChanges();
+	renderGraph->Execute();
+	resourceViewRegistry->SwapSets();
+
+	CHECK(renderGraph->GetStatistics().CulledPassCount == 0);
+	CHECK(renderGraph->GetStatistics().WaitCount >= 2);
+    }
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+	CHECK(queues[i]->GetStatistics().BlockedSubmissionCount == blockedSubmissionCounts[i]);
+	CHECK(queues[i]->GetPendingSubmissionCount() == 0);
+
+	semaphores[i]->Wait(semaphoreValues[i]);
+    }
+    CHECK(semaphoreValues[0] >= FRAME_COUNT);
+
+    delete renderGraph;
+    delete resourceViewRegistry;
+    delete threadPool;
+
+    for(auto* semaphore: semaphores)
+    {
+	adapter->DestroySemaphore(semaphore);
+    }
+}
+
+int main()
+{
+    Logger::Initialize();
+
+    GraphicsAdapter* adapter = GraphicsAdapter::Create(nullptr, false, GraphicsBackendType::HEADLESS);
+
+    TestWaitBeforeSignal(adapter);
+    TestRenderGraphFrames(adapter);
+
+    delete adapter;
+
+    return g_failedCheckCount;
+}
\ No newline at end of file
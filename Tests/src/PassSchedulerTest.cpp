@@ -0,0 +1,130 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#include "core/Logger.h"
+#include "EASTL/vector.h"
+#include "rendering/rendergraph/PassScheduler.h"
+#include "TestUtilities.h"
+
+struct Dependency
+{
+    uint16_t Producer;
+    uint16_t Consumer;
+};
+
+static eastl::vector<uint16_t> Schedule(PassScheduler& scheduler, const eastl::vector<uint32_t>& queueIndices, const eastl::vector<bool>& culled, const eastl::vector<Dependency>& dependencies)
+{
+    scheduler.Reset(queueIndices.size());
+    for(size_t i = 0; i < queueIndices.size(); ++i)
+    {
+	scheduler.SetPass(static_cast<uint16_t>(i), queueIndices[i], culled[i]);
+    }
+    for(const auto& dependency: dependencies)
+    {
+	scheduler.AddDependency(dependency.Producer, dependency.Consumer);
+    }
+
+    eastl::vector<uint16_t> order(queueIndices.size());
+    scheduler.Schedule(order.data());
+    return order;
+}
+
+// every pass is scheduled exactly once and after all of its producers
+static void CheckOrder(const eastl::vector<uint16_t>& order, const eastl::vector<Dependency>& dependencies)
+{
+    eastl::vector<uint32_t> positions(order.size(), UINT32_MAX);
+    for(uint32_t position = 0; position < order.size(); ++position)
+    {
+	CHECK(order[position] < order.size() && positions[order[position]] == UINT32_MAX);
+	positions[order[position]] = position;
+    }
+
+    for(const auto& dependency: dependencies)
+    {
+	CHECK(dependency.Producer == dependency.Consumer || positions[dependency.Producer] < positions[dependency.Consumer]);
+    }
+}
+
+// a generated graph shaped like a frame, passes mostly consume what recent passes produced
+static void TestGeneratedGraph()
+{
+    constexpr uint16_t PASS_COUNT = 256;
+
+    eastl::vector<uint32_t> queueIndices(PASS_COUNT);
+    eastl::vector<bool> culled(PASS_COUNT);
+    eastl::vector<Dependency> dependencies;
+
+    uint32_t random = 12345;
+    auto next	    = [&random]()
+    {
+	random = random * 1664525u + 1013904223u;
+	return random >> 8;
+    };
+
+    for(uint16_t i = 0; i < PASS_COUNT; ++i)
+    {
+	queueIndices[i] = next() % 4 == 0 ? 1 + next() % 2 : 0;
+	culled[i]	= next() % 8 == 0;
+
+	const uint32_t producerCount = i == 0 ? 0 : next() % 4;
+	for(uint32_t j = 0; j < producerCount; ++j)
+	{
+	    const uint16_t distance = static_cast<uint16_t>(1 + next() % eastl::min<uint32_t>(i, 16));
+	    // duplicates and self dependencies are passed through like the render graph does for every subresource
+	    dependencies.push_back({ static_cast<uint16_t>(i - distance), i });
+	    if(next() % 4 == 0)
+	    {
+		dependencies.push_back({ static_cast<uint16_t>(i - distance), i });
+		dependencies.push_back({ i, i });
+	    }
+	}
+    }
+
+    PassScheduler scheduler;
+    const eastl::vector<uint16_t> order = Schedule(scheduler, queueIndices, culled, dependencies);
+    CheckOrder(order, dependencies);
+
+    // the scheduler is reused every frame, so the same graph has to result in the same order again
+    CHECK(Schedule(scheduler, queueIndices, culled, dependencies) == order);
+    PassScheduler otherScheduler;
+    CHECK(Schedule(otherScheduler, queueIndices, culled, dependencies) == order);
+}
+
+// independent passes are grouped by queue with the async work first, culled passes go before them
+static void TestQueueGrouping()
+{
+    const eastl::vector<uint32_t> queueIndices = { 0, 1, 0, 1, 0 };
+    const eastl::vector<bool> culled	       = { false, false, false, false, true };
+    const eastl::vector<uint16_t> expected     = { 4, 1, 3, 0, 2 };
+
+    PassScheduler scheduler;
+    const eastl::vector<uint16_t> order = Schedule(scheduler, queueIndices, culled, {});
+    CheckOrder(order, {});
+    CHECK(order == expected);
+}
+
+// a chain alternating between queues can not be reordered
+static void TestChain()
+{
+    const eastl::vector<uint32_t> queueIndices = { 0, 1, 0, 2 };
+    const eastl::vector<bool> culled	       = { false, false, false, false };
+    const eastl::vector<Dependency> chain      = { { 0, 1 }, { 1, 2 }, { 2, 3 } };
+    const eastl::vector<uint16_t> expected     = { 0, 1, 2, 3 };
+
+    PassScheduler scheduler;
+    const eastl::vector<uint16_t> order = Schedule(scheduler, queueIndices, culled, chain);
+    CheckOrder(order, chain);
+    CHECK(order == expected);
+}
+
+int main()
+{
+    Logger::Initialize();
+
+    TestGeneratedGraph();
+    TestQueueGrouping();
+    TestChain();
+
+    return g_failedCheckCount;
+}
\ No newline at end of file
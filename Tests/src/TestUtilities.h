@@ -0,0 +1,18 @@
+//
+// Created by Ploxie on 2023-07-04.
+//
+
+#pragma once
+#include "core/Logger.h"
+
+// failed checks are logged and counted, a test returns the count from main so ctest sees any failure
+#define CHECK(expr)                                                                         \
+    {                                                                                       \
+	if(!(expr))                                                                         \
+	{                                                                                   \
+	    LOG_CORE_ERROR("{0}:{1}: CHECK({2}) failed", __FILE__, __LINE__, #expr);        \
+	    ++g_failedCheckCount;                                                           \
+	}                                                                                   \
+    }
+
+inline int g_failedCheckCount = 0;
\ No newline at end of file